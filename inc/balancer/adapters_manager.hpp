@@ -31,6 +31,7 @@
 #include <vector>
 #include <random>
 #include <unordered_map>
+#include <limits>
 #include <algorithm>
 #include <functional>
 
@@ -46,6 +47,7 @@
 #include "balancer/balancer_consts.hpp"
 #include "balancer/balancer_parameters.hpp"
 #include "balancer/translator_adapter.hpp"
+#include "balancer/routing_policy.hpp"
 
 using namespace std;
 
@@ -86,33 +88,151 @@ namespace uva {
                         shared_mutex m_adapters_mutex;
                         //The list of the dapters
                         adapters_list m_adapters;
-                        //Stores the random number generator for the target entry
+                        //Stores the load weights distribution for the target entry
                         discrete_distribution<uint32_t> m_distribution;
 
                         /**
-                         * Allows to get the translation server adapter to do the next translation.
+                         * Allows to get the translation server adapter to do the next translation,
+                         * the job load is reserved on the returned adapter as part of the choice.
                          * This function synchronizes the retrieval on the adapters mutex.
+                         * @param policy the routing policy to choose the adapter with
+                         * @param num_sents the number of sentences in the translation job
                          * @return the translation server adapter to do the next translation
                          *         or NULL if the there is no adapters available.
                          */
-                        inline translator_adapter* get_adapter() {
-                            //Add the adapter to the list of adapters
-                            {
-                                shared_guard guard(m_adapters_mutex);
-                                switch (m_adapters.size()) {
-                                    case 0:
-                                        return NULL;
-                                    case 1:
-                                        return m_adapters[0];
-                                    default:
-                                        return m_adapters[m_distribution(m_generator)];
-                                }
+                        inline translator_adapter* get_adapter(const routing_policy_enum policy, const uint64_t num_sents) {
+                            shared_guard guard(m_adapters_mutex);
+                            translator_adapter * adapter = NULL;
+                            switch (m_adapters.size()) {
+                                case 0:
+                                    return NULL;
+                                case 1:
+                                    adapter = m_adapters[0];
+                                    break;
+                                default:
+                                    switch (policy) {
+                                        case routing_policy_enum::ROUTING_LEAST_WORK:
+                                            return get_least_work_adapter(num_sents);
+                                        case routing_policy_enum::ROUTING_TWO_CHOICES:
+                                            return get_two_choices_adapter(num_sents);
+                                        case routing_policy_enum::ROUTING_WEIGHTED_RANDOM:
+                                        default:
+                                            adapter = m_adapters[sample_adapter_idx()];
+                                            break;
+                                    }
                             }
+                            //The choice does not depend on the load, so just reserve it
+                            adapter->reserve_job(num_sents);
+                            return adapter;
                         }
 
                     private:
-                        //Stores the random engine generator to be used
-                        default_random_engine m_generator;
+
+                        /**
+                         * Allows to sample the adapter index proportionally to the load weights.
+                         * The random engine is per thread as the sampling is done under a shared lock.
+                         * @return the sampled adapter index
+                         */
+                        inline uint32_t sample_adapter_idx() {
+                            static thread_local default_random_engine generator;
+                            return m_distribution(generator);
+                        }
+
+                        /**
+                         * Allows to get the per sentence latency to assume for the adapters that did not
+                         * respond yet, this is the average of the known latencies of the given adapters.
+                         * @param adapters the adapters to consider
+                         * @param num_adapters the number of adapters to consider
+                         * @return the default per sentence latency, is 1.0 if none of the latencies is known
+                         */
+                        static inline double get_def_sent_latency(translator_adapter * const * adapters, const size_t num_adapters) {
+                            double sum_latency = 0.0;
+                            size_t num_known = 0;
+                            for (size_t idx = 0; idx < num_adapters; ++idx) {
+                                const double latency = adapters[idx]->get_avg_sent_latency();
+                                if (latency > 0.0) {
+                                    sum_latency += latency;
+                                    ++num_known;
+                                }
+                            }
+                            return (num_known > 0) ? (sum_latency / num_known) : 1.0;
+                        }
+
+                        /**
+                         * Allows to compute the work the adapter would have with the new job, this
+                         * is the expected time to translate its outstanding sentences, i.e. their
+                         * number times the average per sentence latency, per unit of load weight.
+                         * The adapters with zero load weight are only to be used as the last resort.
+                         * @param adapter the adapter, not NULL
+                         * @param num_act_sents the number of outstanding sentences of the adapter
+                         * @param num_sents the number of sentences in the new job
+                         * @param def_latency the per sentence latency to assume if the adapter's one is not known yet
+                         * @return the adapter's work
+                         */
+                        static inline double get_work(const translator_adapter * adapter, const uint64_t num_act_sents,
+                                const uint64_t num_sents, const double def_latency) {
+                            const uint32_t weight = adapter->get_weight();
+                            if (weight > 0) {
+                                const double latency = adapter->get_avg_sent_latency();
+                                return static_cast<double> (num_act_sents + num_sents) *
+                                        ((latency > 0.0) ? latency : def_latency) / weight;
+                            } else {
+                                return numeric_limits<double>::infinity();
+                            }
+                        }
+
+                        /**
+                         * Allows to get the adapter with the least work and to reserve the job load on it,
+                         * must be called under the adapters lock. The load is reserved only if the adapter's
+                         * load did not change since it was chosen, otherwise the choice is made again.
+                         * @param num_sents the number of sentences in the new job
+                         * @return the adapter with the least work
+                         */
+                        inline translator_adapter* get_least_work_adapter(const uint64_t num_sents) {
+                            while (true) {
+                                const double def_latency = get_def_sent_latency(m_adapters.data(), m_adapters.size());
+                                translator_adapter * best = m_adapters[0];
+                                uint64_t best_act_sents = best->get_num_act_sents();
+                                double best_work = get_work(best, best_act_sents, num_sents, def_latency);
+                                for (auto iter = m_adapters.begin() + 1; iter != m_adapters.end(); ++iter) {
+                                    const uint64_t num_act_sents = (*iter)->get_num_act_sents();
+                                    const double work = get_work(*iter, num_act_sents, num_sents, def_latency);
+                                    if (work < best_work) {
+                                        best = *iter;
+                                        best_act_sents = num_act_sents;
+                                        best_work = work;
+                                    }
+                                }
+                                if (best->try_reserve_job(best_act_sents, num_sents)) {
+                                    return best;
+                                }
+                            }
+                        }
+
+                        /**
+                         * Allows to sample two adapters proportionally to their load weights, to get the
+                         * one with the least work and to reserve the job load on it, must be called under
+                         * the adapters lock. The load is reserved only if the adapter's load did not
+                         * change since it was chosen, otherwise the choice is made again.
+                         * @param num_sents the number of sentences in the new job
+                         * @return the chosen adapter
+                         */
+                        inline translator_adapter* get_two_choices_adapter(const uint64_t num_sents) {
+                            while (true) {
+                                translator_adapter * const choices[] = {
+                                    m_adapters[sample_adapter_idx()], m_adapters[sample_adapter_idx()]
+                                };
+                                const double def_latency = get_def_sent_latency(choices, 2);
+                                const uint64_t first_act_sents = choices[0]->get_num_act_sents();
+                                const uint64_t second_act_sents = choices[1]->get_num_act_sents();
+                                const bool is_second = (get_work(choices[1], second_act_sents, num_sents, def_latency) <
+                                        get_work(choices[0], first_act_sents, num_sents, def_latency));
+                                if (is_second ? choices[1]->try_reserve_job(second_act_sents, num_sents) :
+                                        choices[0]->try_reserve_job(first_act_sents, num_sents)) {
+                                    return is_second ? choices[1] : choices[0];
+                                }
+                            }
+                        }
                     } target_entry;
 
                     /**
@@ -227,7 +347,8 @@ namespace uva {
                      * Reports the run-time information
                      */
                     inline void report_run_time_info() {
-                        LOG_USAGE << "Translation servers (#" << m_adapters_data.size() << "): " << END_LOG;
+                        LOG_USAGE << "Translation servers (#" << m_adapters_data.size() << "), routing policy: "
+                                << routing_val_to_str(m_params.m_routing_policy) << END_LOG;
                         for (auto iter = m_adapters_data.begin(); iter != m_adapters_data.end(); ++iter) {
                             iter->second.m_adapter.report_run_time_info();
                         }
@@ -267,7 +388,7 @@ namespace uva {
                         }
 
                         //Return the advised adapter
-                        return target->get_adapter();
+                        return target->get_adapter(m_params.m_routing_policy, trans_req->get_num_sentences());
                     }
 
                     /**
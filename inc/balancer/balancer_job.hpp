@@ -27,6 +27,7 @@
 #define BALANCER_JOB_HPP
 
 #include <ostream>
+#include <chrono>
 
 #include "common/utils/id_manager.hpp"
 #include "common/utils/exceptions.hpp"
@@ -46,6 +47,7 @@
 #include "balancer/translator_adapter.hpp"
 
 using namespace std;
+using namespace std::chrono;
 
 using namespace uva::utils;
 using namespace uva::utils::exceptions;
@@ -146,7 +148,8 @@ namespace uva {
                     m_register_wait_func(register_wait_func), m_schedule_failed_func(schedule_failed_func),
                     m_resp_send_func(resp_send_func), m_phase(phase::REQUEST_PHASE),
                     m_state(state::ACTIVE_STATE), m_err_msg(""), m_bal_job_id(m_id_mgr.get_next_id()),
-                    m_adapter_uid(server_id::UNDEFINED_SERVER_ID) {
+                    m_adapter_uid(server_id::UNDEFINED_SERVER_ID), m_adapter(NULL),
+                    m_num_sents(trans_req->get_num_sentences()), m_send_time() {
                     }
 
                     /**
@@ -246,6 +249,8 @@ namespace uva {
                                         //We are actively awaiting for the server response
                                     case state::ACTIVE_STATE:
                                     {
+                                        //The server has responded, release its load
+                                        release_adapter(true);
                                         //Store the translation job response
                                         m_trans_resp = trans_resp;
                                         //Now we are in the reply phase, the reply is to be sent to the client
@@ -287,6 +292,29 @@ namespace uva {
                         }
                     }
 
+                    /**
+                     * Allows to forward the incoming translation job partial response to the client.
+                     * The partial response is only forwarded if the job is actively awaiting for the
+                     * translation job response, as otherwise the client is not there or it will get
+                     * an error response for all the job sentences. The job does not take ownership
+                     * of the partial response.
+                     * @param part_resp the pointer to the received translation job partial response.
+                     */
+                    inline void send_part_resp(trans_job_resp_in * part_resp) {
+                        recursive_guard guard(m_g_lock);
+
+                        if ((m_phase == phase::RESPONSE_PHASE) && (m_state == state::ACTIVE_STATE)) {
+                            //Change the job id in the response to the stored - original - one
+                            part_resp->set_job_id(m_job_id);
+                            //Send the response to the client through the sender function
+                            m_resp_send_func(m_session_id, *part_resp->get_message());
+                        } else {
+                            LOG_DEBUG << "Dropping a partial response of the balancer job "
+                                    << to_string(m_bal_job_id) << " in phase: " << to_string(m_phase)
+                                    << ", state: " << to_string(m_state) << END_LOG;
+                        }
+                    }
+
                     /**
                      * Allows to cancel the given translation job by telling all the translation tasks to stop.
                      * Calling this method indicates that the job is canceled due to the client disconnect
@@ -308,9 +336,10 @@ namespace uva {
                                 //Waiting for the translation response, will be triggered by the translator
                             case phase::RESPONSE_PHASE:
                             {
-                                //Notify the problem, the translation was canceled
-                                schedule_failed_job_reply(state::CANCELED_STATE,
-                                        "The job was requested to be canceled!");
+                                //Mark the state as canceled but keep awaiting the response, the server
+                                //is still translating so its load is released once it responds or fails
+                                m_state = state::CANCELED_STATE;
+                                m_err_msg = "The job was requested to be canceled!";
                                 break;
                             }
                                 //The reply is already sent to the client, nothing to be done
@@ -438,6 +467,9 @@ namespace uva {
                         //This must not be happening it is an internal error
                         LOG_DEBUG << "Failed job: " << err_msg << END_LOG;
 
+                        //Release the server load if the job was sent
+                        release_adapter(false);
+
                         //The job has been sent, change the phase
                         m_phase = phase::REPLY_PHASE;
                         //Change the state to the given one
@@ -461,7 +493,7 @@ namespace uva {
                         switch (m_state) {
                             case state::ACTIVE_STATE:
                             {
-                                //Get the translator's adapter
+                                //Get the translator's adapter, the job load is reserved on it by the choice
                                 translator_adapter * adapter = m_choose_adapt_func(m_trans_req);
 
                                 //Check if the adapter is present
@@ -470,6 +502,9 @@ namespace uva {
                                     m_adapter_uid = adapter->get_server_id();
                                     //Prepare the request with the new job id
                                     m_trans_req->set_job_id(m_bal_job_id);
+                                    //Store the adapter to release the job load, the response may come any time
+                                    m_adapter = adapter;
+                                    m_send_time = steady_clock::now();
                                     //Attempt sending the request through the adapter
                                     try {
                                         adapter->send(m_trans_req->get_message());
@@ -503,6 +538,20 @@ namespace uva {
                         }
                     }
 
+                    /**
+                     * Allows to release the load of the job on the translation server adapter, if any.
+                     * Is to be called once the job is not awaiting the server's response any more.
+                     * This method is not synchronized. It must be called from a thread safe context.
+                     * @param is_resp true if the server responded, otherwise false
+                     */
+                    inline void release_adapter(const bool is_resp) {
+                        if (m_adapter != NULL) {
+                            const double latency = duration_cast<duration<double>>(steady_clock::now() - m_send_time).count();
+                            m_adapter->notify_job_done(m_num_sents, latency, is_resp);
+                            m_adapter = NULL;
+                        }
+                    }
+
                     /**
                      * Allows to prepare an error reply to the client. The response is filled 
                      * in with the original text and the job id but with an error status.
@@ -561,8 +610,8 @@ namespace uva {
                                 //In the failed state we send an error response
                             case state::FAILED_STATE:
                             {
-                                //Create a response 
-                                trans_job_resp_out resp;
+                                //Create a response, it is small so it is written as JSON
+                                trans_job_resp_out resp(false);
                                 //Fill it in with data
                                 prepare_error_reply(resp);
                                 //Send to the client
@@ -636,6 +685,15 @@ namespace uva {
 
                     //Stores the adapter uid, is initialized after the adapter is retrieved
                     server_id_type m_adapter_uid;
+
+                    //Stores the pointer to the adapter the job is sent to, NULL if not awaiting a response
+                    translator_adapter * m_adapter;
+
+                    //Stores the number of sentences in the job
+                    const uint64_t m_num_sents;
+
+                    //Stores the time the job was sent to the translation server
+                    steady_clock::time_point m_send_time;
                 };
             }
         }
@@ -199,6 +199,8 @@ namespace uva {
                     inline void notify_translation_response(const server_id_type server_id, trans_job_resp_in * trans_job_resp) {
                         //Get the job id
                         const job_id_type bal_job_id = trans_job_resp->get_job_id();
+                        //Check if this is a partial response, it is not stored in the job
+                        const bool is_part = trans_job_resp->is_part();
 
                         LOG_DEBUG << "Got translation job response: " << to_string(bal_job_id) << END_LOG;
 
@@ -221,8 +223,10 @@ namespace uva {
                                 //Get the balancer job
                                 bal_job_ptr bal_job = iter->second;
 
-                                //Set the translation response into the job
-                                if (bal_job->set_trans_job_resp(trans_job_resp)) {
+                                //The partial responses are forwarded to the client right away
+                                if (is_part) {
+                                    bal_job->send_part_resp(trans_job_resp);
+                                } else if (bal_job->set_trans_job_resp(trans_job_resp)) {
                                     //The job was actively waiting for a response,
                                     //so put it into the outgoing pool.
                                     m_outgoing_pool.plan_new_task(bal_job);
@@ -237,6 +241,11 @@ namespace uva {
                                         << "longer present, the server response is ignored!" << END_LOG;
                             }
                         }
+
+                        //The partial response has been forwarded, if possible, and is no longer needed
+                        if (is_part) {
+                            delete trans_job_resp;
+                        }
                     }
 
                     /**
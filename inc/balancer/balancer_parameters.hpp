@@ -36,6 +36,8 @@
 #include "common/utils/exceptions.hpp"
 #include "common/utils/logging/logger.hpp"
 
+#include "balancer/routing_policy.hpp"
+
 using namespace std;
 
 using namespace uva::utils::logging;
@@ -144,6 +146,10 @@ namespace uva {
                     static const string SE_TRANSLATION_SERVER_NAMES_PARAM_NAME;
                     //Stores the server reconnection time out parameter name
                     static const string SC_RECONNECT_TIME_OUT_PARAM_NAME;
+                    //Stores the translation server routing policy parameter name
+                    static const string SE_ROUTING_POLICY_PARAM_NAME;
+                    //Stores the default translation server routing policy
+                    static const string SE_DEF_ROUTING_POLICY;
 
                     //The delimiter for the translation server names
                     static const string TRANS_SERV_NAMES_DELIMITER_STR;
@@ -158,13 +164,21 @@ namespace uva {
                     //reconnect to a disconnected translation server.
                     uint32_t m_recon_time_out;
 
+                    //Stores the name of the translation server routing policy
+                    string m_routing_policy_name;
+
+                    //Stores the translation server routing policy
+                    routing_policy_enum m_routing_policy;
+
                     //Stores the mapping from the translation server name to its configuration data
                     map<string, trans_server_params> m_trans_servers;
 
                     /**
                      * The basic constructor
                      */
-                    balancer_parameters_struct() {
+                    balancer_parameters_struct()
+                    : m_routing_policy_name(SE_DEF_ROUTING_POLICY),
+                    m_routing_policy(routing_policy_enum::ROUTING_UNDEFINED) {
                     }
 
                     /**
@@ -219,6 +233,11 @@ namespace uva {
                                 string("Invalid reconnection time out: ") +
                                 to_string(m_recon_time_out) + string(" must be > 0!"));
 
+                        m_routing_policy = routing_str_to_val(m_routing_policy_name);
+                        ASSERT_CONDITION_THROW((m_routing_policy == routing_policy_enum::ROUTING_UNDEFINED),
+                                string("Invalid routing policy: '") + m_routing_policy_name +
+                                string("', expected one of: weighted_random, least_work, two_choices!"));
+
                         //Iterate over the clients and finalize them as well
                         for (auto iter = m_trans_servers.begin(); iter != m_trans_servers.end(); ++iter) {
                             iter->second.finalize();
@@ -255,6 +274,8 @@ namespace uva {
                             << " = " << params.m_num_req_threads
                             << ", " << balancer_parameters::SE_NUM_RESP_THREADS_PARAM_NAME
                             << " = " << params.m_num_resp_threads
+                            << ", " << balancer_parameters::SE_ROUTING_POLICY_PARAM_NAME
+                            << " = " << routing_val_to_str(params.m_routing_policy)
                             << ", translation servers (" << params.m_trans_servers.size(
                             ) << ") = [ ";
                     //Dump the translation server's configurations
@@ -0,0 +1,103 @@
+/*
+ * File:   routing_policy.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 17, 2026, 9:10 PM
+ */
+
+#ifndef ROUTING_POLICY_HPP
+#define ROUTING_POLICY_HPP
+
+#include <string>
+
+#include "common/utils/text/string_utils.hpp"
+
+using namespace std;
+
+using namespace uva::utils::text;
+
+namespace uva {
+    namespace smt {
+        namespace bpbd {
+            namespace balancer {
+
+                /* This enumeration defines the policy of choosing the translation server for a job.
+                 * The weighted random policy samples the servers proportionally to their load weights.
+                 * The least work policy takes the server with the smallest number of outstanding
+                 * sentences per unit of the load weight. The two choices policy samples two servers
+                 * proportionally to their load weights and takes the one with the least work.
+                 */
+                enum routing_policy_enum {
+                    ROUTING_UNDEFINED = 0,
+                    ROUTING_WEIGHTED_RANDOM = ROUTING_UNDEFINED + 1,
+                    ROUTING_LEAST_WORK = ROUTING_WEIGHTED_RANDOM + 1,
+                    ROUTING_TWO_CHOICES = ROUTING_LEAST_WORK + 1
+                };
+
+                /**
+                 * Allows to convert the routing policy value into a string
+                 * @param policy the routing policy value
+                 * @return the corresponding string
+                 */
+                inline string routing_val_to_str(const routing_policy_enum policy) {
+                    switch (policy) {
+                        case routing_policy_enum::ROUTING_WEIGHTED_RANDOM:
+                            return string("weighted_random");
+                        case routing_policy_enum::ROUTING_LEAST_WORK:
+                            return string("least_work");
+                        case routing_policy_enum::ROUTING_TWO_CHOICES:
+                            return string("two_choices");
+                        default:
+                            return string("undef");
+                    }
+                }
+
+                /**
+                 * Allows to convert the routing policy name
+                 * (weighted_random, least_work, two_choices) into the corresponding policy.
+                 * @param policy_str the routing policy name string
+                 * @return the corresponding policy or ROUTING_UNDEFINED if not recognized
+                 */
+                inline routing_policy_enum routing_str_to_val(string policy_str) {
+                    //Turn into trimmed low-case string
+                    to_lower(trim(policy_str));
+                    //Compare with constant literals
+                    if (policy_str.compare(routing_val_to_str(routing_policy_enum::ROUTING_WEIGHTED_RANDOM)) == 0) {
+                        return routing_policy_enum::ROUTING_WEIGHTED_RANDOM;
+                    } else {
+                        if (policy_str.compare(routing_val_to_str(routing_policy_enum::ROUTING_LEAST_WORK)) == 0) {
+                            return routing_policy_enum::ROUTING_LEAST_WORK;
+                        } else {
+                            if (policy_str.compare(routing_val_to_str(routing_policy_enum::ROUTING_TWO_CHOICES)) == 0) {
+                                return routing_policy_enum::ROUTING_TWO_CHOICES;
+                            } else {
+                                return routing_policy_enum::ROUTING_UNDEFINED;
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif /* ROUTING_POLICY_HPP */
+
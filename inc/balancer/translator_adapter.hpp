@@ -27,6 +27,7 @@
 #define TRANSLATOR_ADAPTER_HPP
 
 #include <future>
+#include <atomic>
 
 #include "common/utils/exceptions.hpp"
 #include "common/utils/logging/logger.hpp"
@@ -79,6 +80,7 @@ namespace uva {
                  *      Re-connects to the disconnected server
                  *      Send translation requests
                  *      Receive translation responses
+                 *      Keeps track of the outstanding work and the observed latency
                  */
                 class translator_adapter : public websocket_client_creator {
                 public:
@@ -90,7 +92,9 @@ namespace uva {
                     : m_server_id(m_ids_manager.get_next_id()), m_p_params(NULL),
                     m_trans_resp_func(NULL), m_adapter_disc_func(NULL),
                     m_client(NULL), m_is_enabled(false), m_is_connected(false),
-                    m_is_connecting(false), m_lock_con(), m_notify_conn_closed_func() {
+                    m_is_connecting(false), m_lock_con(), m_notify_conn_closed_func(),
+                    m_num_act_jobs(0), m_num_act_sents(0), m_lock_stats(),
+                    m_num_done_jobs(0), m_avg_sent_latency(0.0) {
                     }
 
                     /**
@@ -243,8 +247,22 @@ namespace uva {
                             }
                         }
 
+                        //Get the load statistics
+                        uint64_t num_done_jobs = 0;
+                        double avg_sent_latency = 0.0;
+                        {
+                            scoped_guard guard(m_lock_stats);
+                            num_done_jobs = m_num_done_jobs;
+                            avg_sent_latency = get_avg_sent_latency();
+                        }
+
                         LOG_USAGE << "\t" << m_p_params->m_server_name << "(uid:"
-                                << to_string(m_server_id) << ") -> " << status << END_LOG;
+                                << to_string(m_server_id) << ") -> " << status
+                                << ", weight: " << to_string(get_weight())
+                                << ", active jobs/sentences: " << to_string(get_num_act_jobs())
+                                << "/" << to_string(get_num_act_sents())
+                                << ", done jobs: " << to_string(num_done_jobs)
+                                << ", avg. sentence latency: " << avg_sent_latency << " sec." << END_LOG;
                     }
 
                     /**
@@ -271,6 +289,82 @@ namespace uva {
                         return m_p_params->m_load_weight;
                     }
 
+                    /**
+                     * Allows to get the number of jobs sent to the server and not yet finished
+                     * @return the number of outstanding jobs
+                     */
+                    inline uint32_t get_num_act_jobs() const {
+                        return m_num_act_jobs.load(memory_order_relaxed);
+                    }
+
+                    /**
+                     * Allows to get the number of sentences sent to the server and not yet finished
+                     * @return the number of outstanding sentences
+                     */
+                    inline uint64_t get_num_act_sents() const {
+                        return m_num_act_sents.load(memory_order_relaxed);
+                    }
+
+                    /**
+                     * Allows to get the moving average of the per sentence latency of the server
+                     * @return the average per sentence latency, in seconds, or zero if the server did not respond yet
+                     */
+                    inline double get_avg_sent_latency() const {
+                        return m_avg_sent_latency.load(memory_order_relaxed);
+                    }
+
+                    /**
+                     * Allows to reserve the load of a job that is about to be sent to the server
+                     * @param num_sents the number of sentences in the job
+                     */
+                    inline void reserve_job(const uint64_t num_sents) {
+                        m_num_act_jobs.fetch_add(1, memory_order_relaxed);
+                        m_num_act_sents.fetch_add(num_sents, memory_order_relaxed);
+                    }
+
+                    /**
+                     * Allows to reserve the load of a job that is about to be sent to the server,
+                     * only if the number of the outstanding sentences is still the one the server
+                     * was chosen with, i.e. no other job was routed to or finished by it since.
+                     * @param num_act_sents the number of outstanding sentences the server was chosen with
+                     * @param num_sents the number of sentences in the job
+                     * @return true if the load is reserved, otherwise false
+                     */
+                    inline bool try_reserve_job(uint64_t num_act_sents, const uint64_t num_sents) {
+                        if (m_num_act_sents.compare_exchange_strong(num_act_sents,
+                                num_act_sents + num_sents, memory_order_relaxed)) {
+                            m_num_act_jobs.fetch_add(1, memory_order_relaxed);
+                            return true;
+                        }
+                        return false;
+                    }
+
+                    /**
+                     * Allows to notify the adapter that a previously sent job is finished.
+                     * The latency is only accounted for if the server did respond.
+                     * @param num_sents the number of sentences in the job
+                     * @param latency the time between sending the job and getting the response, in seconds
+                     * @param is_resp true if the server responded, false if the job failed or was not sent
+                     */
+                    inline void notify_job_done(const uint64_t num_sents, const double latency, const bool is_resp) {
+                        m_num_act_jobs.fetch_sub(1, memory_order_relaxed);
+                        m_num_act_sents.fetch_sub(num_sents, memory_order_relaxed);
+
+                        if (is_resp && (num_sents > 0)) {
+                            scoped_guard guard(m_lock_stats);
+                            //Keep the exponentially weighted moving average of the per sentence latency
+                            const double sent_latency = latency / num_sents;
+                            if (m_num_done_jobs == 0) {
+                                m_avg_sent_latency.store(sent_latency, memory_order_relaxed);
+                            } else {
+                                const double avg_sent_latency = get_avg_sent_latency();
+                                m_avg_sent_latency.store(avg_sent_latency +
+                                        LATENCY_AVG_FACTOR * (sent_latency - avg_sent_latency), memory_order_relaxed);
+                            }
+                            ++m_num_done_jobs;
+                        }
+                    }
+
                     /**
                      * Allows to send the string message to the server
                      * @param msg the string message to be send
@@ -294,6 +388,7 @@ namespace uva {
                         //Check on the message type
                         switch (json_msg->get_msg_type()) {
                             case msg_type::MESSAGE_TRANS_JOB_RESP:
+                            case msg_type::MESSAGE_TRANS_JOB_PART_RESP:
                             {
                                 //Create a new job response message
                                 trans_job_resp_in * job_resp_msg = new trans_job_resp_in(json_msg);
@@ -445,6 +540,20 @@ namespace uva {
                     ready_conn_notifier_type m_notify_conn_ready_func;
                     //Stores the function needed to notify about closed connection
                     closed_conn_notifier_type m_notify_conn_closed_func;
+
+                    //Stores the weight of the latest job in the average sentence latency
+                    static constexpr double LATENCY_AVG_FACTOR = 0.1;
+                    //Stores the number of jobs sent to the server and not yet finished
+                    atomic<uint32_t> m_num_act_jobs;
+                    //Stores the number of sentences sent to the server and not yet finished
+                    atomic<uint64_t> m_num_act_sents;
+                    //Stores the synchronization mutex for the latency statistics updates
+                    mutex m_lock_stats;
+                    //Stores the number of jobs the server responded to
+                    uint64_t m_num_done_jobs;
+                    //Stores the moving average of the per sentence latency, in seconds,
+                    //is updated under the statistics lock but is read without locking
+                    atomic<double> m_avg_sent_latency;
                 };
 
             }
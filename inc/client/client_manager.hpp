@@ -214,6 +214,17 @@ namespace uva {
                      */
                     virtual void set_job_response(RESPONSE_TYPE * job_resp_msg) = 0;
 
+                    /**
+                     * Will be called when a message of another than the expected type arrives from
+                     * the server. The sub-classes expecting other messages shall override it.
+                     * If the message type is known then the message ownership is taken.
+                     * @param json_msg the received message, not NULL
+                     * @return true if the message type is known, otherwise false
+                     */
+                    virtual bool set_other_response(incoming_msg * json_msg) {
+                        return false;
+                    }
+
                     /**
                      * Will be called when all job responses are received.
                      * If could not process the results MUST THROW!
@@ -274,8 +285,11 @@ namespace uva {
                      * @param json_msg a pointer to the json incoming message, not NULL
                      */
                     inline void notify_new_msg(incoming_msg * json_msg) {
-                        //Increment the number of received jobs
-                        m_num_done_jobs++;
+                        //Increment the number of received jobs, only the job
+                        //response messages of the expected type finish a job
+                        if (json_msg->get_msg_type() == MSG_TYPE) {
+                            m_num_done_jobs++;
+                        }
 
                         //If we are not stopping then set the response
                         if (!m_is_stopping) {
@@ -298,8 +312,11 @@ namespace uva {
                                 }
                                     break;
                                 default:
-                                    THROW_EXCEPTION(string("Unexpected incoming message type: ") +
-                                            to_string(json_msg->get_msg_type()));
+                                    //Let the sub-class process the other message types, if it can
+                                    if (!set_other_response(json_msg)) {
+                                        THROW_EXCEPTION(string("Unexpected incoming message type: ") +
+                                                to_string(json_msg->get_msg_type()));
+                                    }
                             }
                         } else {
                             //Discard the translation job response
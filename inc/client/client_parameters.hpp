@@ -70,6 +70,10 @@ namespace uva {
                     static const int32_t CL_DEF_PRIORITY_VAL;
                     //Stores the default value for the flag to request translation info
                     static const bool CL_DEF_IS_TRANS_INFO_VAL;
+                    //Stores the default value for the flag to request results streaming
+                    static const bool CL_DEF_IS_STREAM_VAL;
+                    //Stores the default value for the flag to request the binary translation messages
+                    static const bool CL_DEF_IS_BIN_MSGS_VAL;
 
                     //The main client configuration section name
                     static const string CL_CONFIG_SECTION_NAME;
@@ -88,6 +92,8 @@ namespace uva {
                     static const string CL_PRIORITY_PARAM_NAME;
                     //The translation into request flag parameter name
                     static const string CL_IS_TRANS_INFO_PARAM_NAME;
+                    //The results streaming request flag parameter name
+                    static const string CL_IS_STREAM_PARAM_NAME;
 
                     //The source file name with the text to translate
                     string m_source_file;
@@ -107,6 +113,8 @@ namespace uva {
 
                     //The flag indicating whether the client requests the translation details from the translation server or not.
                     bool m_is_trans_info;
+                    //The flag indicating whether the client requests the translation server to stream the finished sentences.
+                    bool m_is_stream;
                     //The maximum number of source sentences to send per translation request
                     uint64_t m_max_sent;
                     //The minimum number of source sentences to send per translation request
@@ -124,7 +132,7 @@ namespace uva {
                     m_pre_params("pre-processor"),
                     m_trans_params("translation"),
                     m_post_params("post-processor"),
-                    m_is_trans_info(false), m_max_sent(0),
+                    m_is_trans_info(false), m_is_stream(false), m_max_sent(0),
                     m_min_sent(0), m_priority(0) {
                     }
 
@@ -204,6 +212,8 @@ namespace uva {
                             << params.m_priority
                             << ", translation info = "
                             << (params.m_is_trans_info ? "ON" : "OFF")
+                            << ", results streaming = "
+                            << (params.m_is_stream ? "ON" : "OFF")
                             << " }";
                 }
             }
@@ -55,10 +55,13 @@ namespace uva {
                          * @param source_text the text in the source language to translate
                          * @param target_lang the target language string
                          * @param is_trans_info true if the client should requests the translation info from the server
+                         * @param is_stream true if the client requests the server to stream the finished sentences
+                         * @param is_bin true if the request is to be written in the binary form
                          */
                         trans_job_req_out(const job_id_type job_id, const int32_t priority, const string & source_lang,
-                                vector<string> & source_text, const string & target_lang, const bool is_trans_info)
-                        : outgoing_msg(msg_type::MESSAGE_TRANS_JOB_REQ), trans_job_req(), m_job_id(job_id) {
+                                vector<string> & source_text, const string & target_lang, const bool is_trans_info,
+                                const bool is_stream, const bool is_bin)
+                        : outgoing_msg(msg_type::MESSAGE_TRANS_JOB_REQ, is_bin), trans_job_req(), m_job_id(job_id) {
                             m_writer.String(JOB_ID_FIELD_NAME);
                             m_writer.Uint64(job_id);
                             m_writer.String(PRIORITY_NAME);
@@ -69,6 +72,8 @@ namespace uva {
                             m_writer.String(target_lang.c_str());
                             m_writer.String(IS_TRANS_INFO_FIELD_NAME);
                             m_writer.Bool(is_trans_info);
+                            m_writer.String(IS_STREAM_FIELD_NAME);
+                            m_writer.Bool(is_stream);
                             
                             //Add the source sentences one by one in an array
                             m_writer.String(SOURCE_SENTENCES_FIELD_NAME);
@@ -81,7 +86,8 @@ namespace uva {
                             LOG_DEBUG << "Translation job request, job id: " << m_job_id
                                     << " source language: " << source_lang
                                     << " target language: " << target_lang
-                                    << " translation info flag: " << is_trans_info << END_LOG;
+                                    << " translation info flag: " << is_trans_info
+                                    << " streaming flag: " << is_stream << END_LOG;
                         }
 
                         /**
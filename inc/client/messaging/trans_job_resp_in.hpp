@@ -41,7 +41,9 @@ namespace uva {
                 namespace messaging {
 
                     /**
-                     * This class represents an incoming translation job response
+                     * This class represents an incoming translation job response or
+                     * an incoming translation job partial response, the latter has no
+                     * status and stores the results of a range of the job sentences.
                      */
                     class trans_job_resp_in : public trans_job_resp {
                     public:
@@ -103,8 +105,24 @@ namespace uva {
                          * @return the client-issued job id
                          */
                         inline void set_job_id(job_id_type job_id) {
-                            Document & json = m_inc_msg->get_json();
-                            json[JOB_ID_FIELD_NAME] = job_id;
+                            m_inc_msg->set_uint64_field(JOB_ID_FIELD_NAME, job_id);
+                        }
+
+                        /**
+                         * Allows to check whether this is a partial response
+                         * @return true if this is a translation job partial response, otherwise false
+                         */
+                        inline bool is_part() const {
+                            return (m_inc_msg->get_msg_type() == msg_type::MESSAGE_TRANS_JOB_PART_RESP);
+                        }
+
+                        /**
+                         * Allows to get the index of the first target data sentence within the job
+                         * @return the index of the first target data sentence, 0 if not specified
+                         */
+                        inline uint64_t get_sent_idx() const {
+                            const Document & json = m_inc_msg->get_json();
+                            return json.HasMember(SENT_IDX_FIELD_NAME) ? json[SENT_IDX_FIELD_NAME].GetUint64() : 0;
                         }
 
                         /**
@@ -102,6 +102,31 @@ namespace uva {
                             return m_data_obj->HasMember(STACK_LOAD_FIELD_NAME);
                         }
 
+                        /**
+                         * Allows to get the number of allocated stack states
+                         * @return the number of allocated stack states
+                         */
+                        inline uint64_t get_stack_states() const {
+                            return m_data_obj->operator [](STACK_STATES_FIELD_NAME).GetUint64();
+                        }
+
+                        /**
+                         * Allows to get the number of bytes allocated for the stack states
+                         * @return the number of bytes allocated for the stack states
+                         */
+                        inline uint64_t get_stack_mem() const {
+                            return m_data_obj->operator [](STACK_MEM_FIELD_NAME).GetUint64();
+                        }
+
+                        /**
+                         * Allows to check if the stack memory usage is present
+                         * @return true if the stack memory usage is present, otherwise false
+                         */
+                        inline bool has_stack_mem() const {
+                            return m_data_obj->HasMember(STACK_STATES_FIELD_NAME) &&
+                                    m_data_obj->HasMember(STACK_MEM_FIELD_NAME);
+                        }
+
                         /**
                          * Allows to replace a stored reference to a JSON object with a new reference.
                          * @param data_obj the reference to a new JSON object
@@ -110,6 +135,14 @@ namespace uva {
                             m_data_obj = &data_obj;
                         }
 
+                        /**
+                         * Allows to check if there is a reference to a JSON object stored
+                         * @return true if the JSON object reference is set, otherwise false
+                         */
+                        inline bool has_sent_data() const {
+                            return (m_data_obj != NULL);
+                        }
+
                     private:
                         //Stores the pointer to the encapsulated JSON object
                         const Value * m_data_obj;
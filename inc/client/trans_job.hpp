@@ -26,6 +26,8 @@
 #ifndef TRANS_JOB_HPP
 #define TRANS_JOB_HPP
 
+#include <vector>
+
 #include "trans_job_status.hpp"
 #include "common/utils/exceptions.hpp"
 
@@ -55,8 +57,8 @@ namespace uva {
                      * The basic constructor that does default-initialization of the structure fields
                      */
                     trans_job()
-                    : m_num_sentences(0), m_request(NULL), m_response(NULL),
-                    m_status(trans_job_status::STATUS_UNDEFINED) {
+                    : m_num_sentences(0), m_first_sent_num(0), m_num_written(0), m_request(NULL),
+                    m_response(NULL), m_status(trans_job_status::STATUS_UNDEFINED) {
                     }
 
                     /**
@@ -70,14 +72,23 @@ namespace uva {
                         if (m_response != NULL) {
                             delete m_response;
                         }
+                        for (auto iter = m_part_responses.begin(); iter != m_part_responses.end(); ++iter) {
+                            delete *iter;
+                        }
                     }
 
                     //The number of sentences to be translated
                     uint32_t m_num_sentences;
+                    //The number of the first job sentence within the source text
+                    uint32_t m_first_sent_num;
+                    //The number of the first job sentences already written into the output
+                    uint32_t m_num_written;
                     //The pointer to the job request
                     trans_job_req_out * m_request;
                     //The pointer to the job response
                     trans_job_resp_in * m_response;
+                    //The pointers to the job partial responses, if streamed, that are not written yet
+                    vector<trans_job_resp_in *> m_part_responses;
                     //Stores the flag indicating whether the job was failed to send
                     trans_job_status m_status;
                 };
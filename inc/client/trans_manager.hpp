@@ -63,9 +63,9 @@ namespace uva {
                  * This is the client side translation manager class. It's task
                  * is to get the source text from a file and then split it into
                  * a number of translation jobs that will be sent to the
-                 * translation server. The finished translation jobs are collected
-                 * and once all of them are finished the resulting text is written
-                 * into the output file.
+                 * translation server. The finished translation jobs and the streamed
+                 * sentences are written into the output as soon as all the preceding
+                 * ones are written, the written responses are then freed.
                  */
                 class trans_manager : public client_manager<msg_type::MESSAGE_TRANS_JOB_RESP, trans_job_resp_in> {
                 public:
@@ -88,7 +88,8 @@ namespace uva {
                             stringstream & input, stringstream & output)
                     : client_manager(params.m_trans_params),
                     m_params(params), m_input(input), m_output(output),
-                    m_act_num_req(0), m_exp_num_resp(0), m_act_num_resp(0) {
+                    m_act_num_req(0), m_exp_num_resp(0), m_act_num_resp(0),
+                    m_info_file(params.m_target_file + ".log"), m_write_lock(), m_write_job_idx(0) {
                         //Create the list of translation jobs
                         create_translation_jobs();
                     }
@@ -176,6 +177,8 @@ namespace uva {
 
                         //Check if the job with the given id is known
                         if (m_ids_to_jobs_map.find(job_id) != m_ids_to_jobs_map.end()) {
+                            scoped_guard guard(m_write_lock);
+
                             //Register the job in the administration
                             m_ids_to_jobs_map[job_id]->m_response = trans_job_resp;
 
@@ -188,6 +191,9 @@ namespace uva {
                             LOG_INFO1 << "The job " << job_id << " is finished, "
                                     << m_act_num_resp << "/" << m_exp_num_resp
                                     << "." << END_LOG;
+
+                            //Write the results of the finished jobs, in the source text order
+                            write_finished_jobs();
                         } else {
                             THROW_EXCEPTION(string("The received job response id ") +
                                     to_string(job_id) + string(" is not known!"));
@@ -197,51 +203,46 @@ namespace uva {
                     /**
                      * @see client_manager
                      */
-                    virtual void process_results() override {
-                        //Get the names for the translation and info files
-                        const string info_file_name = m_params.m_target_file + ".log";
-
-                        //Open the report file and the info file
-                        ofstream info_file(info_file_name);
-                        //Declare the variable to store the line cursor
-                        uint32_t line_cursor = 1;
+                    virtual bool set_other_response(incoming_msg * json_msg) override {
+                        if (json_msg->get_msg_type() == msg_type::MESSAGE_TRANS_JOB_PART_RESP) {
+                            //Create a new job partial response message
+                            trans_job_resp_in * part_resp = new trans_job_resp_in(json_msg);
+                            try {
+                                //Set the newly received job partial response
+                                set_job_part_response(part_resp);
+                            } catch (std::exception & ex) {
+                                LOG_ERROR << ex.what() << END_LOG;
+                                //Delete the message as it was not set
+                                delete part_resp;
+                            }
+                            return true;
+                        } else {
+                            return false;
+                        }
+                    }
 
-                        LOG_INFO << "Storing logging into '" << info_file_name << "'" << END_LOG;
+                    /**
+                     * @see client_manager
+                     */
+                    virtual void process_results() override {
+                        LOG_INFO << "Storing logging into '" << m_params.m_target_file << ".log'" << END_LOG;
 
                         try {
-                            ASSERT_CONDITION_THROW(!info_file.is_open(), string("Could not open: ") + info_file_name);
-
-                            //Go through the translation job data and write it into the files
-                            for (auto it = m_jobs_list.begin(); (it != m_jobs_list.end()); ++it) {
-                                //Get the translation job data
-                                const trans_job_ptr job = *it;
-
-                                //Compute the first and last sentence numbers for the case the job is not completed
-                                const uint32_t fis = line_cursor;
-                                const uint32_t lis = fis + job->m_num_sentences - 1;
-                                //Get the client-side job status
-                                const trans_job_status & status = job->m_status;
-
-                                //Log the client status
-                                info_file << "----------------------------------------------------" << std::endl;
-                                info_file << "Job id: " << to_string(job->m_request->get_job_id())
-                                        << ", sentences [" << to_string(fis) << ":"
-                                        << to_string(lis) << "], client status: '" << status << "'" << std::endl;
-
-                                //If the status is that the response is received, log it
-                                if (status == trans_job_status::STATUS_RES_RECEIVED) {
-                                    process_job_result(fis, lis, job, m_output, info_file);
-                                }
+                            ASSERT_CONDITION_THROW(!m_info_file.is_open(),
+                                    string("Could not open: ") + m_params.m_target_file + string(".log"));
+
+                            scoped_guard guard(m_write_lock);
 
-                                //Set the line cursor to the next line
-                                line_cursor = lis + 1;
+                            //Go through the translation jobs that are not written yet and write them into the files
+                            for (; m_write_job_idx < m_jobs_list.size(); ++m_write_job_idx) {
+                                write_job(m_jobs_list[m_write_job_idx]);
                             }
                         } catch (std::exception & e) {
                             LOG_ERROR << "Could not dump results: " << e.what() << END_LOG;
                         }
 
                         //Close the info file
-                        info_file.close();
+                        m_info_file.close();
                     }
 
                 private:
@@ -270,6 +271,43 @@ namespace uva {
                     //Store the actual number of responses
                     atomic<uint32_t> m_act_num_resp;
 
+                    //Stores the file to write the translation info into
+                    ofstream m_info_file;
+                    //Stores the lock to synchronize the results writing
+                    mutex m_write_lock;
+                    //Stores the index of the first job in the jobs list that is not written yet,
+                    //all the jobs before it are written and their responses are freed
+                    size_t m_write_job_idx;
+
+                    /**
+                     * Allows to store the translation job partial response, the
+                     * partial responses are all received before the job response.
+                     * The streamed sentences are written as soon as all the preceding
+                     * ones are, so only the out of order ones are kept.
+                     * @param part_resp the translation job partial response
+                     */
+                    inline void set_job_part_response(trans_job_resp_in * part_resp) {
+                        //Get the job id to work with
+                        const job_id_type job_id = part_resp->get_job_id();
+
+                        LOG_DEBUG << "Got the translation job partial response for job id: " << to_string(job_id) << END_LOG;
+
+                        //Check if the job with the given id is known
+                        auto iter = m_ids_to_jobs_map.find(job_id);
+                        if (iter != m_ids_to_jobs_map.end()) {
+                            scoped_guard guard(m_write_lock);
+
+                            //Register the partial response in the administration
+                            iter->second->m_part_responses.push_back(part_resp);
+
+                            //Write the streamed sentences and the finished jobs, in the source text order
+                            write_finished_jobs();
+                        } else {
+                            THROW_EXCEPTION(string("The received job partial response id ") +
+                                    to_string(job_id) + string(" is not known!"));
+                        }
+                    }
+
                     /**
                      * Allows to compute the number of sentences to send with the next request
                      * @return the number of sentences to send with the next request
@@ -287,6 +325,8 @@ namespace uva {
                      */
                     void create_translation_jobs() {
                         LOG_DEBUG << "Reading text from the source file ..." << END_LOG;
+                        //Stores the number of the next source sentence
+                        uint32_t sent_num = 1;
                         bool is_done = false;
                         while (!is_done) {
                             //Get the number of sentences to send in the next request
@@ -326,9 +366,12 @@ namespace uva {
                                 //Create the translation job request 
                                 data->m_request = new trans_job_req_out(job_id, m_params.m_priority,
                                         m_params.m_source_lang, source_text, m_params.m_target_lang,
-                                        m_params.m_is_trans_info);
+                                        m_params.m_is_trans_info, m_params.m_is_stream,
+                                        m_params.m_trans_params.m_is_bin_msgs);
                                 //Store the number of sentences in the translation request
                                 data->m_num_sentences = num_read;
+                                data->m_first_sent_num = sent_num;
+                                sent_num += num_read;
                                 //Mark the job sending as good in the administration
                                 data->m_status = trans_job_status::STATUS_REQ_INITIALIZED;
 
@@ -344,63 +387,215 @@ namespace uva {
                     }
 
                     /**
-                     * Allows to store the response data
-                     * @param fis the first sentence number 
-                     * @param resp the translation job response
-                     * @param output the stream to write the translated text into
-                     * @param info_file the file to write the translation info into
+                     * Allows to put the response sentence data into the job sentence data list
+                     * @param resp the translation job response or partial response
+                     * @param sents the job sentence data list to fill in
                      */
-                    inline void process_task_result(uint32_t fis, trans_job_resp_in * resp,
-                            stringstream & output, ofstream & info_file) {
-                        //If the result is ok or partial then just put the text into the file
+                    static inline void add_sent_data(trans_job_resp_in * resp, vector<trans_sent_data_in> & sents) {
+                        //Get the index of the first response sentence within the job
+                        size_t sent_idx = resp->get_sent_idx();
+                        //Copy the sentence data wrappers into the list
                         const trans_sent_data_in * sent_data = resp->next_send_data();
+                        while ((sent_data != NULL) && (sent_idx < sents.size())) {
+                            sents[sent_idx++] = *sent_data;
+                            sent_data = resp->next_send_data();
+                        }
+                    }
+
+                    /**
+                     * Allows to write the finished translation jobs and the streamed sentences
+                     * in the source text order, i.e. starting from the first not written job
+                     * until the first job that is not finished. Must be called under the lock.
+                     */
+                    inline void write_finished_jobs() {
+                        while (m_write_job_idx < m_jobs_list.size()) {
+                            const trans_job_ptr job = m_jobs_list[m_write_job_idx];
+
+                            //Write the streamed sentences following the written ones, if any
+                            write_part_responses(job);
+
+                            //Stop at the first job that is not finished yet
+                            if (job->m_status != trans_job_status::STATUS_RES_RECEIVED) {
+                                break;
+                            }
+
+                            write_job(job);
+                            ++m_write_job_idx;
+                        }
+                    }
+
+                    /**
+                     * Allows to write the translation job data into the files and to free its responses
+                     * @param job the translation job data
+                     */
+                    inline void write_job(const trans_job_ptr job) {
+                        //Write the streamed sentences following the written ones, if any
+                        write_part_responses(job);
+
+                        //Log the job info, unless it is logged with the streamed sentences
+                        if (job->m_num_written == 0) {
+                            write_job_header(job);
+                        }
+
+                        //If the status is that the response is received, log it
+                        if (job->m_status == trans_job_status::STATUS_RES_RECEIVED) {
+                            process_job_result(job);
+                        }
+
+                        //Free the job responses, they are written
+                        for (auto iter = job->m_part_responses.begin(); iter != job->m_part_responses.end(); ++iter) {
+                            delete *iter;
+                        }
+                        job->m_part_responses.clear();
+                        if (job->m_response != NULL) {
+                            delete job->m_response;
+                            job->m_response = NULL;
+                        }
+                    }
+
+                    /**
+                     * Allows to write the translation job info header into the info file
+                     * @param job the translation job data
+                     */
+                    inline void write_job_header(const trans_job_ptr job) {
+                        m_info_file << "----------------------------------------------------" << std::endl;
+                        m_info_file << "Job id: " << to_string(job->m_request->get_job_id())
+                                << ", sentences [" << to_string(job->m_first_sent_num) << ":"
+                                << to_string(job->m_first_sent_num + job->m_num_sentences - 1)
+                                << "], client status: '" << job->m_status << "'" << std::endl;
+                    }
 
-                        //Check if there is sentence data present
-                        if (sent_data != NULL) {
-                            while (sent_data != NULL) {
-                                LOG_DEBUG3 << "Translation: " << sent_data->get_trans_text() << END_LOG;
-                                //Dump the translated text
-                                output << sent_data->get_trans_text() << std::endl;
-                                //Get the sentence status code
-                                const status_code code = sent_data->get_status_code();
-                                //Dump the status code and message and the translation info such as stack loads
-                                info_file << "--" << std::endl << "Sentence: " << to_string(fis)
-                                        << " translation status: '" << code << "'";
-                                //Log the message only if it is present.
-                                if (!sent_data->get_status_msg().empty()) {
-                                    info_file << ", message: " << sent_data->get_status_msg();
+                    /**
+                     * Allows to write the streamed sentences that directly follow the
+                     * written ones and to free the partial responses that are written.
+                     * @param job the translation job data
+                     */
+                    inline void write_part_responses(const trans_job_ptr job) {
+                        vector<trans_job_resp_in *> & parts = job->m_part_responses;
+                        auto iter = parts.begin();
+                        while (iter != parts.end()) {
+                            if ((*iter)->get_sent_idx() <= job->m_num_written) {
+                                write_sent_data(job, *iter);
+                                delete *iter;
+                                parts.erase(iter);
+                                //The next sentences could have been received before
+                                iter = parts.begin();
+                            } else {
+                                ++iter;
+                            }
+                        }
+                    }
+
+                    /**
+                     * Allows to write the partial response sentences that directly follow the written ones
+                     * @param job the translation job data
+                     * @param resp the translation job partial response
+                     */
+                    inline void write_sent_data(const trans_job_ptr job, trans_job_resp_in * resp) {
+                        size_t sent_idx = resp->get_sent_idx();
+                        const trans_sent_data_in * sent_data = resp->next_send_data();
+                        while ((sent_data != NULL) && (sent_idx < job->m_num_sentences)) {
+                            //Skip the sentences that are already written, if any
+                            if ((sent_idx == job->m_num_written) && sent_data->has_sent_data()) {
+                                //Log the job info before its first sentence
+                                if (job->m_num_written == 0) {
+                                    write_job_header(job);
                                 }
-                                info_file << std::endl;
-                                //Log the stack loads if present
-                                if (sent_data->has_stack_load()) {
-                                    info_file << "Multi-stack loads: [ ";
-                                    const Value & loads = sent_data->get_stack_load();
-                                    for (auto iter = loads.Begin(); iter != loads.End(); ++iter) {
-                                        info_file << iter->GetUint() << "% ";
-                                    }
-                                    info_file << "]" << std::endl;
+                                process_sent_result(job->m_first_sent_num + sent_idx, sent_data, m_output, m_info_file);
+                                ++job->m_num_written;
+                            }
+                            ++sent_idx;
+                            sent_data = resp->next_send_data();
+                        }
+                    }
+
+                    /**
+                     * Allows to store the response data of the sentences that are not written yet
+                     * @param job the translation job data
+                     */
+                    inline void process_task_result(const trans_job_ptr job) {
+                        //Collect the sentence data of the streamed and the job responses
+                        vector<trans_sent_data_in> sents(job->m_num_sentences);
+                        for (auto iter = job->m_part_responses.begin(); iter != job->m_part_responses.end(); ++iter) {
+                            add_sent_data(*iter, sents);
+                        }
+                        add_sent_data(job->m_response, sents);
+
+                        //Check if there is sentence data present, the written sentences count
+                        bool is_present = (job->m_num_written > 0);
+                        for (size_t idx = job->m_num_written; idx < sents.size(); ++idx) {
+                            is_present |= sents[idx].has_sent_data();
+                        }
+
+                        if (is_present) {
+                            uint32_t fis = job->m_first_sent_num + job->m_num_written;
+                            for (size_t idx = job->m_num_written; idx < sents.size(); ++idx) {
+                                //Get the sentence data
+                                const trans_sent_data_in * sent_data = &sents[idx];
+                                //Check if the sentence data is missing, e.g. was not streamed
+                                if (sent_data->has_sent_data()) {
+                                    process_sent_result(fis, sent_data, m_output, m_info_file);
+                                } else {
+                                    LOG_DEBUG << "Missing target sentence " << fis << " for job: "
+                                            << job->m_response->get_job_id() << END_LOG;
+                                    //Keep the line numbering of the output
+                                    m_output << std::endl;
+                                    m_info_file << "--" << std::endl << "Sentence: " << to_string(fis)
+                                            << " translation is missing" << std::endl;
                                 }
-                                //Move to the next sentence if present
-                                sent_data = resp->next_send_data();
                                 //Increment the sentence number
                                 ++fis;
                             }
+                            job->m_num_written = job->m_num_sentences;
                         } else {
                             //There is no sentence data present!
-                            LOG_DEBUG << "Missing target sentences for job: " << resp->get_job_id() << END_LOG;
+                            LOG_DEBUG << "Missing target sentences for job: " << job->m_response->get_job_id() << END_LOG;
+                        }
+                    }
+
+                    /**
+                     * Allows to store the sentence response data
+                     * @param fis the sentence number
+                     * @param sent_data the sentence data, present
+                     * @param output the stream to write the translated text into
+                     * @param info_file the file to write the translation info into
+                     */
+                    inline void process_sent_result(const uint32_t fis, const trans_sent_data_in * sent_data,
+                            stringstream & output, ofstream & info_file) {
+                        LOG_DEBUG3 << "Translation: " << sent_data->get_trans_text() << END_LOG;
+                        //Dump the translated text
+                        output << sent_data->get_trans_text() << std::endl;
+                        //Get the sentence status code
+                        const status_code code = sent_data->get_status_code();
+                        //Dump the status code and message and the translation info such as stack loads
+                        info_file << "--" << std::endl << "Sentence: " << to_string(fis)
+                                << " translation status: '" << code << "'";
+                        //Log the message only if it is present.
+                        if (!sent_data->get_status_msg().empty()) {
+                            info_file << ", message: " << sent_data->get_status_msg();
+                        }
+                        info_file << std::endl;
+                        //Log the stack loads if present
+                        if (sent_data->has_stack_load()) {
+                            info_file << "Multi-stack loads: [ ";
+                            const Value & loads = sent_data->get_stack_load();
+                            for (auto iter = loads.Begin(); iter != loads.End(); ++iter) {
+                                info_file << iter->GetUint() << "% ";
+                            }
+                            info_file << "]" << std::endl;
+                        }
+                        //Log the stack memory usage if present
+                        if (sent_data->has_stack_mem()) {
+                            info_file << "Multi-stack states: " << sent_data->get_stack_states()
+                                    << ", memory: " << sent_data->get_stack_mem() << " bytes" << std::endl;
                         }
                     }
 
                     /**
                      * Allows to write the received translation job replies into the file
-                     * @param fis the first sentence number 
-                     * @param lis the last sentence number
                      * @param job the translation job data
-                     * @param output the stream to write the translation result into
-                     * @param info_file the file to write the translation info into
                      */
-                    inline void process_job_result(const uint32_t fis, const uint32_t lis,
-                            const trans_job_ptr job, stringstream & output, ofstream & info_file) {
+                    inline void process_job_result(const trans_job_ptr job) {
                         //Get the response pointer
                         trans_job_resp_in * resp = job->m_response;
 
@@ -414,7 +609,7 @@ namespace uva {
                             }
 
                             //Dump the server response info
-                            info_file << "Server response status: '" << code << "', "
+                            m_info_file << "Server response status: '" << code << "', "
                                     << "message: " << resp->get_status_msg() << std::endl;
 
                             //Dump the sentences data
@@ -422,15 +617,15 @@ namespace uva {
                                 if ((code != status_code::RESULT_UNDEFINED)&&
                                         (code != status_code::RESULT_UNKNOWN)) {
                                     //If the server response status is workable, then log the data
-                                    process_task_result(fis, resp, output, info_file);
+                                    process_task_result(job);
                                 } else {
                                     THROW_EXCEPTION(string("Unexpected server response status: '") +
                                             (string) code + string("', can not process job results!"));
                                 }
                             }
                         } catch (std::exception & e) {
-                            LOG_ERROR << "Could not dump data for sentences [" << to_string(fis)
-                                    << ":" << to_string(lis) << "]: " << e.what() << END_LOG;
+                            LOG_ERROR << "Could not dump data for sentences [" << to_string(job->m_first_sent_num) << ":"
+                                    << to_string(job->m_first_sent_num + job->m_num_sentences - 1) << "]: " << e.what() << END_LOG;
                         }
                     }
                 };
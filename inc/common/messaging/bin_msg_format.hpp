@@ -0,0 +1,87 @@
+/*
+ * File:   bin_msg_format.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 17, 2026, 7:05 PM
+ */
+
+#ifndef BIN_MSG_FORMAT_HPP
+#define BIN_MSG_FORMAT_HPP
+
+#include <cstdint>
+
+namespace uva {
+    namespace smt {
+        namespace bpbd {
+            namespace common {
+                namespace messaging {
+
+                    /**
+                     * This namespace stores the constants of the compact binary message format.
+                     * A binary message is the magic prefix followed by the message's SAX events,
+                     * each event is a one byte tag followed by the event data, if any. The numbers
+                     * are stored in the fixed-width host byte order, which is little-endian on all
+                     * the supported platforms. A string is stored as its 32 bit length followed by
+                     * its characters and a terminating zero, so that it can be used in place. An
+                     * object's member names and values are just the alternating events within it.
+                     */
+                    namespace bin_msg {
+                        //Stores the binary message magic prefix, includes the format version
+                        static constexpr char MAGIC[] = {'B', 'P', 'B', 1};
+                        //Stores the binary message magic prefix length
+                        static constexpr size_t MAGIC_LEN = sizeof (MAGIC);
+
+                        /**
+                         * This enumeration stores the binary message event tags
+                         */
+                        enum event_tag : uint8_t {
+                            //The null value, no data
+                            NULL_TAG = 0,
+                            //The false value, no data
+                            FALSE_TAG = 1,
+                            //The true value, no data
+                            TRUE_TAG = 2,
+                            //The negative integer value, the int64_t data
+                            INT_TAG = 3,
+                            //The non-negative integer value, the uint64_t data
+                            UINT_TAG = 4,
+                            //The floating point value, the double data
+                            DOUBLE_TAG = 5,
+                            //The string value or member name, the uint32_t length and the zero-terminated characters
+                            STRING_TAG = 6,
+                            //The object begin, no data
+                            OBJECT_BEGIN_TAG = 7,
+                            //The object end, no data
+                            OBJECT_END_TAG = 8,
+                            //The array begin, no data
+                            ARRAY_BEGIN_TAG = 9,
+                            //The array end, no data
+                            ARRAY_END_TAG = 10
+                        };
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif /* BIN_MSG_FORMAT_HPP */
+
@@ -0,0 +1,239 @@
+/*
+ * File:   bin_msg_reader.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 17, 2026, 7:20 PM
+ */
+
+#ifndef BIN_MSG_READER_HPP
+#define BIN_MSG_READER_HPP
+
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <utility>
+
+#include "common/utils/exceptions.hpp"
+#include "common/utils/logging/logger.hpp"
+
+#include "common/messaging/bin_msg_format.hpp"
+
+#include "rapidjson/rapidjson.h"
+
+using namespace std;
+
+using namespace uva::utils::logging;
+using namespace uva::utils::exceptions;
+
+namespace uva {
+    namespace smt {
+        namespace bpbd {
+            namespace common {
+                namespace messaging {
+
+                    /**
+                     * This class reads a message in the compact binary form and replays its
+                     * SAX events to a rapidjson handler, e.g. a JSON document or a JSON writer.
+                     * It is a generator as expected by the rapidjson document's Populate method.
+                     * The strings are given to the handler as not to be copied, so that a JSON
+                     * document refers to the strings within the binary data, which must then
+                     * outlive the document. The message must be a single object, the events are
+                     * checked to be well nested and the object member names to be strings, before
+                     * they are given to the handler. The malformed data causes an exception.
+                     */
+                    class bin_msg_reader {
+                    public:
+                        //Typedef the top-level unsigned integer members list: the member names and value offsets
+                        typedef vector<pair<const char *, size_t> > uint_fields_list;
+
+                        /**
+                         * The basic constructor
+                         * @param data the binary message data, must outlive the reader
+                         * @param size the binary message data size
+                         * @param p_fields the pointer to the list to store the top-level unsigned
+                         *                 integer members into, or NULL if they are not needed
+                         */
+                        bin_msg_reader(const char * data, const size_t size, uint_fields_list * p_fields = NULL)
+                        : m_data(data), m_size(size), m_p_fields(p_fields) {
+                        }
+
+                        /**
+                         * Allows to check whether the data is a binary message, by its magic prefix
+                         * @param data the message data
+                         * @param size the message data size
+                         * @return true if the data starts with the binary message magic prefix
+                         */
+                        static inline bool is_bin_msg(const char * data, const size_t size) {
+                            return (size >= bin_msg::MAGIC_LEN) &&
+                                    (memcmp(data, bin_msg::MAGIC, bin_msg::MAGIC_LEN) == 0);
+                        }
+
+                        /**
+                         * Allows to replay the message events to the handler
+                         * @param handler the rapidjson SAX handler
+                         * @return true, the malformed data causes an exception
+                         */
+                        template<typename handler_type>
+                        bool operator()(handler_type & handler) const {
+                            ASSERT_CONDITION_THROW(!is_bin_msg(m_data, m_size),
+                                    "The binary message magic prefix is not found!");
+
+                            //Stores the open objects and arrays with the number of events within each
+                            vector<scope_entry> scopes;
+                            //Stores the number of the top-level values and the last top-level member name
+                            size_t num_roots = 0;
+                            const char * name = NULL;
+
+                            size_t pos = bin_msg::MAGIC_LEN;
+                            while (pos < m_size) {
+                                const uint8_t tag = static_cast<uint8_t> (m_data[pos++]);
+
+                                //Check that the event is allowed at its place
+                                if (scopes.empty()) {
+                                    ASSERT_CONDITION_THROW(((num_roots != 0) || (tag != bin_msg::OBJECT_BEGIN_TAG)),
+                                            "The binary message is not a single object!");
+                                } else {
+                                    //An object expects a member name or its end after a member value
+                                    const scope_entry & scope = scopes.back();
+                                    const bool is_name_pos = scope.m_is_object && (scope.m_count % 2 == 0);
+                                    ASSERT_CONDITION_THROW(is_name_pos && (tag != bin_msg::STRING_TAG) && (tag != bin_msg::OBJECT_END_TAG),
+                                            "The binary message object member name is not a string!");
+                                    ASSERT_CONDITION_THROW(((tag == bin_msg::OBJECT_END_TAG) && !is_name_pos) ||
+                                            ((tag == bin_msg::ARRAY_END_TAG) && scope.m_is_object),
+                                            "Mismatched binary message object or array end!");
+                                }
+
+                                switch (tag) {
+                                    case bin_msg::OBJECT_BEGIN_TAG:
+                                        handler.StartObject();
+                                        scopes.push_back({true, 0});
+                                        continue;
+                                    case bin_msg::ARRAY_BEGIN_TAG:
+                                        handler.StartArray();
+                                        scopes.push_back({false, 0});
+                                        continue;
+                                    case bin_msg::OBJECT_END_TAG:
+                                        ASSERT_CONDITION_THROW(scopes.empty(), "Unexpected binary message object end!");
+                                        handler.EndObject(scopes.back().m_count / 2);
+                                        scopes.pop_back();
+                                        break;
+                                    case bin_msg::ARRAY_END_TAG:
+                                        ASSERT_CONDITION_THROW(scopes.empty(), "Unexpected binary message array end!");
+                                        handler.EndArray(scopes.back().m_count);
+                                        scopes.pop_back();
+                                        break;
+                                    case bin_msg::NULL_TAG:
+                                        handler.Null();
+                                        break;
+                                    case bin_msg::FALSE_TAG:
+                                        handler.Bool(false);
+                                        break;
+                                    case bin_msg::TRUE_TAG:
+                                        handler.Bool(true);
+                                        break;
+                                    case bin_msg::INT_TAG:
+                                        handler.Int64(get_number<int64_t>(pos));
+                                        break;
+                                    case bin_msg::UINT_TAG:
+                                        //Remember the top-level member value offset
+                                        if ((m_p_fields != NULL) && (scopes.size() == 1) && (scopes.back().m_count % 2 == 1)) {
+                                            m_p_fields->push_back(make_pair(name, pos));
+                                        }
+                                        handler.Uint64(get_number<uint64_t>(pos));
+                                        break;
+                                    case bin_msg::DOUBLE_TAG:
+                                        handler.Double(get_number<double>(pos));
+                                        break;
+                                    case bin_msg::STRING_TAG:
+                                    {
+                                        const uint32_t length = get_number<uint32_t>(pos);
+                                        ASSERT_CONDITION_THROW(((m_size - pos) <= length) || (m_data[pos + length] != '\0'),
+                                                "Truncated binary message string!");
+                                        const char * str = m_data + pos;
+                                        pos += length + 1;
+                                        //Remember the top-level member name
+                                        if ((scopes.size() == 1) && (scopes.back().m_count % 2 == 0)) {
+                                            name = str;
+                                        }
+                                        handler.String(str, length, false);
+                                        break;
+                                    }
+                                    default:
+                                        THROW_EXCEPTION(string("Unknown binary message event tag: ") + to_string(tag));
+                                }
+
+                                //Count the finished value within its enclosing object or array
+                                if (scopes.empty()) {
+                                    ++num_roots;
+                                } else {
+                                    ++scopes.back().m_count;
+                                }
+                            }
+
+                            ASSERT_CONDITION_THROW((!scopes.empty() || (num_roots != 1)),
+                                    "Truncated or malformed binary message!");
+
+                            return true;
+                        }
+
+                    private:
+
+                        /**
+                         * This structure stores an open object or array
+                         */
+                        struct scope_entry {
+                            //Stores the flag indicating whether this is an object or an array
+                            bool m_is_object;
+                            //Stores the number of events within, the object member names included
+                            rapidjson::SizeType m_count;
+                        };
+
+                        //Stores the binary message data
+                        const char * m_data;
+                        //Stores the binary message data size
+                        const size_t m_size;
+                        //Stores the pointer to the top-level unsigned integer members list or NULL
+                        uint_fields_list * m_p_fields;
+
+                        /**
+                         * Allows to read a fixed-width number
+                         * @param pos [in/out] the number position, is moved behind the number
+                         * @return the number
+                         */
+                        template<typename num_type>
+                        inline num_type get_number(size_t & pos) const {
+                            ASSERT_CONDITION_THROW(((m_size - pos) < sizeof (num_type)),
+                                    "Truncated binary message number!");
+                            num_type value;
+                            memcpy(&value, m_data + pos, sizeof (num_type));
+                            pos += sizeof (num_type);
+                            return value;
+                        }
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif /* BIN_MSG_READER_HPP */
+
@@ -0,0 +1,187 @@
+/*
+ * File:   bin_msg_writer.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 17, 2026, 7:10 PM
+ */
+
+#ifndef BIN_MSG_WRITER_HPP
+#define BIN_MSG_WRITER_HPP
+
+#include <string>
+#include <cstring>
+#include <cstdint>
+
+#include "common/messaging/bin_msg_format.hpp"
+
+#include "rapidjson/rapidjson.h"
+
+using namespace std;
+
+namespace uva {
+    namespace smt {
+        namespace bpbd {
+            namespace common {
+                namespace messaging {
+
+                    /**
+                     * This class writes a message in the compact binary form. It implements
+                     * the rapidjson SAX handler interface, as does the JSON writer, so it is
+                     * used to write the outgoing messages and to convert a JSON document into
+                     * the binary form by accepting the writer. Contrary to the JSON writer no
+                     * characters are escaped and no numbers are formatted.
+                     */
+                    class bin_msg_writer {
+                    public:
+                        //Typedef the rapidjson size type used in the handler interface
+                        typedef rapidjson::SizeType SizeType;
+
+                        /**
+                         * The basic constructor
+                         */
+                        bin_msg_writer() : m_data() {
+                            reset();
+                        }
+
+                        /**
+                         * Allows to re-set the writer, all the written data is cleared
+                         */
+                        inline void reset() {
+                            m_data.clear();
+                            m_data.append(bin_msg::MAGIC, bin_msg::MAGIC_LEN);
+                        }
+
+                        /**
+                         * Allows to get the written message data
+                         * @return the binary message data
+                         */
+                        inline const string & get_data() const {
+                            return m_data;
+                        }
+
+                        //The rapidjson SAX handler methods, see rapidjson::Writer. An object member
+                        //name is written as a string and the member and element counts are not stored.
+
+                        bool Null() {
+                            put_tag(bin_msg::NULL_TAG);
+                            return true;
+                        }
+
+                        bool Bool(const bool value) {
+                            put_tag(value ? bin_msg::TRUE_TAG : bin_msg::FALSE_TAG);
+                            return true;
+                        }
+
+                        bool Int(const int value) {
+                            return Int64(value);
+                        }
+
+                        bool Uint(const unsigned value) {
+                            return Uint64(value);
+                        }
+
+                        bool Int64(const int64_t value) {
+                            //The non-negative values are always stored as unsigned
+                            if (value >= 0) {
+                                return Uint64(static_cast<uint64_t> (value));
+                            }
+                            put_tag(bin_msg::INT_TAG);
+                            put_number(value);
+                            return true;
+                        }
+
+                        bool Uint64(const uint64_t value) {
+                            put_tag(bin_msg::UINT_TAG);
+                            put_number(value);
+                            return true;
+                        }
+
+                        bool Double(const double value) {
+                            put_tag(bin_msg::DOUBLE_TAG);
+                            put_number(value);
+                            return true;
+                        }
+
+                        bool String(const char * str) {
+                            return String(str, static_cast<SizeType> (strlen(str)));
+                        }
+
+                        bool String(const char * str, const SizeType length, const bool copy = false) {
+                            put_tag(bin_msg::STRING_TAG);
+                            put_number(static_cast<uint32_t> (length));
+                            m_data.append(str, length);
+                            m_data.push_back('\0');
+                            return true;
+                        }
+
+                        bool Key(const char * str, const SizeType length, const bool copy = false) {
+                            return String(str, length, copy);
+                        }
+
+                        bool StartObject() {
+                            put_tag(bin_msg::OBJECT_BEGIN_TAG);
+                            return true;
+                        }
+
+                        bool EndObject(const SizeType num_members = 0) {
+                            put_tag(bin_msg::OBJECT_END_TAG);
+                            return true;
+                        }
+
+                        bool StartArray() {
+                            put_tag(bin_msg::ARRAY_BEGIN_TAG);
+                            return true;
+                        }
+
+                        bool EndArray(const SizeType num_elements = 0) {
+                            put_tag(bin_msg::ARRAY_END_TAG);
+                            return true;
+                        }
+
+                    private:
+                        //Stores the written message data
+                        string m_data;
+
+                        /**
+                         * Allows to write the event tag
+                         * @param tag the event tag
+                         */
+                        inline void put_tag(const bin_msg::event_tag tag) {
+                            m_data.push_back(static_cast<char> (tag));
+                        }
+
+                        /**
+                         * Allows to write a fixed-width number
+                         * @param value the number to write
+                         */
+                        template<typename num_type>
+                        inline void put_number(const num_type value) {
+                            m_data.append(reinterpret_cast<const char *> (&value), sizeof (num_type));
+                        }
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif /* BIN_MSG_WRITER_HPP */
+
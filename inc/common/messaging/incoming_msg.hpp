@@ -26,7 +26,12 @@
 #ifndef INCOMING_MSG_HPP
 #define INCOMING_MSG_HPP
 
+#include <cstring>
+#include <algorithm>
+
 #include "common/messaging/msg_base.hpp"
+#include "common/messaging/bin_msg_reader.hpp"
+#include "common/messaging/bin_msg_writer.hpp"
 
 #include "rapidjson/document.h"
 #include "rapidjson/writer.h"
@@ -42,6 +47,10 @@ namespace uva {
 
                     /**
                      * This class represents a JSON message begin sent between the client and the server.
+                     * The message is received either as a JSON string or in the compact binary form. In
+                     * the latter case the message keeps the binary data and the JSON document strings
+                     * refer to it, so the received strings are not copied. The binary data is also sent
+                     * as is, when the message is forwarded in the binary form.
                      */
                     class incoming_msg : public msg_base {
                     public:
@@ -49,7 +58,7 @@ namespace uva {
                         /**
                          * The basic constructor
                          */
-                        incoming_msg() : msg_base(), m_json() {
+                        incoming_msg() : msg_base(), m_json(), m_bin_data(), m_is_bin_data(false), m_uint_fields() {
                             //Nothing to be done here
                         }
 
@@ -86,10 +95,35 @@ namespace uva {
                         }
 
                         /**
-                         * Allows to get the message type
-                         * @return the message type
+                         * Allows to de-serialize the binary message, the data is taken over
+                         * and is kept as the JSON document strings refer to it.
+                         * @param data the binary message data to be parsed
                          */
-                        inline msg_type get_msg_type() const {
+                        inline void de_serialize_bin(string && data) {
+                            //Take over the data, the strings must refer to the kept data
+                            m_bin_data = move(data);
+                            m_uint_fields.clear();
+
+                            //De-serialize the data and catch any exception, convert it into our type
+                            try {
+                                bin_msg_reader reader(m_bin_data.data(), m_bin_data.size(), &m_uint_fields);
+                                m_json.Populate(reader);
+                            } catch (std::exception & ex) {
+                                LOG_ERROR << "An exception when parsing a binary message: " << ex.what() << END_LOG;
+                                THROW_EXCEPTION(ex.what());
+                            }
+
+                            //The binary data represents the message
+                            m_is_bin_data = true;
+
+                            //Verify that the version number is good
+                            verify_protocol_version();
+                        }
+
+                        /**
+                         * @see msg_base
+                         */
+                        virtual msg_type get_msg_type() const override {
                             //This is a primitive way to cast to the enumeration type 
                             //from an integer. Later we could introduce a fancier way 
                             //with all sorts of checks but this shall do it for now.
@@ -122,9 +156,53 @@ namespace uva {
                             return buffer.GetString();
                         }
 
+                        /**
+                         * @see msg_base
+                         */
+                        virtual string serialize_bin() const override {
+                            if (m_is_bin_data) {
+                                //The received binary data is still up to date
+                                return m_bin_data;
+                            } else {
+                                bin_msg_writer writer;
+                                m_json.Accept(writer);
+                                return writer.get_data();
+                            }
+                        }
+
+                        /**
+                         * Allows to set the top-level unsigned integer member value. If the
+                         * message was received in the binary form then the value is also
+                         * patched in the binary data, so that it does not need re-serializing.
+                         * @param name the member name
+                         * @param value the member value
+                         */
+                        inline void set_uint64_field(const char * name, const uint64_t value) {
+                            m_json[name] = value;
+
+                            if (m_is_bin_data) {
+                                auto iter = find_if(m_uint_fields.begin(), m_uint_fields.end(),
+                                        [name] (const bin_msg_reader::uint_fields_list::value_type & field) {
+                                            return (field.first != NULL) && (strcmp(field.first, name) == 0);
+                                        });
+                                if (iter != m_uint_fields.end()) {
+                                    memcpy(&m_bin_data[iter->second], &value, sizeof (value));
+                                } else {
+                                    //The binary data is out-dated, the document is to be serialized
+                                    m_is_bin_data = false;
+                                }
+                            }
+                        }
+
                     protected:
                         //Stores the json document representing the message
                         Document m_json;
+                        //Stores the received binary message data, the document strings refer to it
+                        string m_bin_data;
+                        //Stores the flag indicating whether the binary data represents the message
+                        bool m_is_bin_data;
+                        //Stores the top-level unsigned integer members of the binary message
+                        bin_msg_reader::uint_fields_list m_uint_fields;
 
                         /**
                          * Allows to check if the protocol version is fine.
@@ -70,7 +70,10 @@ namespace uva {
                         //The post-processor job request message
                         MESSAGE_POST_PROC_JOB_REQ = 7,
                         //The post-processor job response message
-                        MESSAGE_POST_PROC_JOB_RESP = 8
+                        MESSAGE_POST_PROC_JOB_RESP = 8,
+                        //The translation job partial response message, is streamed
+                        //for the finished sentences before the job response message
+                        MESSAGE_TRANS_JOB_PART_RESP = 9
                     };
 
                     /**
@@ -82,11 +85,13 @@ namespace uva {
                     class msg_base {
                     public:
                         //Stores the version of the message protocol
-                        static constexpr uint32_t PROTOCOL_VERSION = 1;
+                        static constexpr uint32_t PROTOCOL_VERSION = 2;
                         //Stores the protocol version attribute name
                         static const char * PROT_VER_FIELD_NAME;
                         //Stores the message type attribute name
                         static const char * MSG_TYPE_FIELD_NAME;
+                        //Stores the WebSocket sub-protocol name negotiated for the binary messages
+                        static const char * BIN_SUB_PROTOCOL_NAME;
 
                         /**
                          * The basic constructor
@@ -107,6 +112,31 @@ namespace uva {
                          * @return the string representation of the message
                          */
                         virtual string serialize() const = 0;
+
+                        /**
+                         * Allows to serialize the message into the compact binary form
+                         * @return the binary representation of the message
+                         */
+                        virtual string serialize_bin() const = 0;
+
+                        /**
+                         * Allows to get the message type
+                         * @return the message type
+                         */
+                        virtual msg_type get_msg_type() const = 0;
+
+                        /**
+                         * Allows to check whether the message can be sent in the binary form, if the
+                         * binary messages are negotiated. These are the bulk translation job requests
+                         * and responses, all the other messages are always sent as JSON.
+                         * @return true if the message can be sent in the binary form, otherwise false
+                         */
+                        inline bool is_bin_msg_type() const {
+                            const msg_type type = get_msg_type();
+                            return (type == msg_type::MESSAGE_TRANS_JOB_REQ) ||
+                                    (type == msg_type::MESSAGE_TRANS_JOB_RESP) ||
+                                    (type == msg_type::MESSAGE_TRANS_JOB_PART_RESP);
+                        }
                     };
                 }
             }
@@ -0,0 +1,170 @@
+/*
+ * File:   msg_writer.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 17, 2026, 9:40 PM
+ */
+
+#ifndef MSG_WRITER_HPP
+#define MSG_WRITER_HPP
+
+#include <string>
+
+#include "common/messaging/bin_msg_writer.hpp"
+
+#include "rapidjson/writer.h"
+#include "rapidjson/prettywriter.h" // for stringify JSON
+#include "rapidjson/stringbuffer.h"
+
+using namespace std;
+using namespace rapidjson;
+
+namespace uva {
+    namespace smt {
+        namespace bpbd {
+            namespace common {
+                namespace messaging {
+
+                    //The JSON writer type, can be configures to use two variants
+                    //typedef PrettyWriter<StringBuffer> JSONWriter; //This one is good for testing, to make JSON more readable
+                    typedef Writer<StringBuffer> JSONWriter; //This one is good for production, works faster, no extra characters
+
+                    /**
+                     * This class writes an outgoing message either as JSON text or in the
+                     * compact binary form, the mode is fixed on construction. It implements
+                     * the part of the rapidjson SAX handler interface used by the messages.
+                     */
+                    class msg_writer {
+                    public:
+                        //Typedef the rapidjson size type used in the handler interface
+                        typedef rapidjson::SizeType SizeType;
+
+                        /**
+                         * The basic constructor
+                         * @param is_bin true if the message is to be written in the binary form, otherwise JSON
+                         */
+                        msg_writer(const bool is_bin)
+                        : m_is_bin(is_bin), m_buffer(), m_json_writer(m_buffer), m_bin_writer() {
+                        }
+
+                        /**
+                         * Allows to re-set the writer, all the written data is cleared
+                         */
+                        inline void reset() {
+                            if (m_is_bin) {
+                                m_bin_writer.reset();
+                            } else {
+                                m_buffer.Clear();
+                                m_json_writer.Reset(m_buffer);
+                            }
+                        }
+
+                        /**
+                         * Allows to check whether the message is written in the binary form
+                         * @return true if the message is written in the binary form, otherwise false
+                         */
+                        inline bool is_bin() const {
+                            return m_is_bin;
+                        }
+
+                        /**
+                         * Allows to get the written JSON text, is only valid in the JSON mode
+                         * @return the JSON message text
+                         */
+                        inline const char * get_json() const {
+                            return m_buffer.GetString();
+                        }
+
+                        /**
+                         * Allows to get the written binary data, is only valid in the binary mode
+                         * @return the binary message data
+                         */
+                        inline const string & get_bin() const {
+                            return m_bin_writer.get_data();
+                        }
+
+                        //The rapidjson SAX handler methods, forwarded to the writer of the mode
+
+                        bool Bool(const bool value) {
+                            return m_is_bin ? m_bin_writer.Bool(value) : m_json_writer.Bool(value);
+                        }
+
+                        bool Int(const int value) {
+                            return m_is_bin ? m_bin_writer.Int(value) : m_json_writer.Int(value);
+                        }
+
+                        bool Uint(const unsigned value) {
+                            return m_is_bin ? m_bin_writer.Uint(value) : m_json_writer.Uint(value);
+                        }
+
+                        bool Int64(const int64_t value) {
+                            return m_is_bin ? m_bin_writer.Int64(value) : m_json_writer.Int64(value);
+                        }
+
+                        bool Uint64(const uint64_t value) {
+                            return m_is_bin ? m_bin_writer.Uint64(value) : m_json_writer.Uint64(value);
+                        }
+
+                        bool Double(const double value) {
+                            return m_is_bin ? m_bin_writer.Double(value) : m_json_writer.Double(value);
+                        }
+
+                        bool String(const char * str) {
+                            return m_is_bin ? m_bin_writer.String(str) : m_json_writer.String(str);
+                        }
+
+                        bool String(const char * str, const SizeType length) {
+                            return m_is_bin ? m_bin_writer.String(str, length) : m_json_writer.String(str, length);
+                        }
+
+                        bool StartObject() {
+                            return m_is_bin ? m_bin_writer.StartObject() : m_json_writer.StartObject();
+                        }
+
+                        bool EndObject() {
+                            return m_is_bin ? m_bin_writer.EndObject() : m_json_writer.EndObject();
+                        }
+
+                        bool StartArray() {
+                            return m_is_bin ? m_bin_writer.StartArray() : m_json_writer.StartArray();
+                        }
+
+                        bool EndArray() {
+                            return m_is_bin ? m_bin_writer.EndArray() : m_json_writer.EndArray();
+                        }
+
+                    private:
+                        //Stores the flag indicating whether the message is written in the binary form
+                        const bool m_is_bin;
+                        //Stores the string buffer to where the JSON string will be written
+                        StringBuffer m_buffer;
+                        //Stores the JSON writer
+                        JSONWriter m_json_writer;
+                        //Stores the binary writer
+                        bin_msg_writer m_bin_writer;
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif /* MSG_WRITER_HPP */
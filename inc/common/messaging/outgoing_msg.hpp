@@ -27,8 +27,11 @@
 #define OUTGOING_MSG_HPP
 
 #include "common/messaging/msg_base.hpp"
+#include "common/messaging/msg_writer.hpp"
+#include "common/messaging/bin_msg_reader.hpp"
+#include "common/messaging/bin_msg_writer.hpp"
 
-#include "rapidjson/prettywriter.h" // for stringify JSON
+#include "rapidjson/document.h"
 
 using namespace rapidjson;
 
@@ -38,12 +41,11 @@ namespace uva {
             namespace common {
                 namespace messaging {
 
-                    //The JSON writer type, can be configures to use two variants
-                    //typedef PrettyWriter<StringBuffer> JSONWriter; //This one is good for testing, to make JSON more readable
-                    typedef Writer<StringBuffer> JSONWriter; //This one is good for production, works faster, no extra characters
-
                     /**
                      * This class represents a JSON message begin sent between the client and the server.
+                     * The message is written as JSON text, or in the compact binary form if it is to be sent
+                     * to a peer that has negotiated the binary messages. If the message is then requested
+                     * in the other form, it is converted.
                      */
                     class outgoing_msg : public msg_base {
                     public:
@@ -51,9 +53,10 @@ namespace uva {
                         /**
                          * The basic constructor
                          * @param type the message type
+                         * @param is_bin true if the message is to be written in the binary form, default is false
                          */
-                        outgoing_msg(msg_type type)
-                        : msg_base(), m_type(type), m_string_buf(), m_is_slzd(false), m_writer(m_string_buf) {
+                        outgoing_msg(msg_type type, const bool is_bin = false)
+                        : msg_base(), m_type(type), m_is_slzd(false), m_writer(is_bin) {
                             //Initialize the outgoing message with the protocol version, type data and etc
                             initialize_object();
                         }
@@ -66,32 +69,55 @@ namespace uva {
                         }
 
                         /**
-                         * Allows to serialize the outgoing message into a string
+                         * Allows to serialize the outgoing message into a JSON string
                          * @return the string representation of the message
                          */
                         virtual string serialize() const override {
-                            if (!m_is_slzd) {
-                                //Finish the object, the const casts are needed
-                                const_cast<JSONWriter&> (m_writer).EndObject();
-                                //Set the serialization flag
-                                const_cast<bool&>(m_is_slzd) = true;
+                            finish_object();
+                            if (m_writer.is_bin()) {
+                                //Convert the binary message into JSON
+                                StringBuffer buffer;
+                                JSONWriter writer(buffer);
+                                const string & data = m_writer.get_bin();
+                                bin_msg_reader(data.data(), data.size())(writer);
+                                return buffer.GetString();
+                            } else {
+                                return m_writer.get_json();
+                            }
+                        }
+
+                        /**
+                         * @see msg_base
+                         */
+                        virtual string serialize_bin() const override {
+                            finish_object();
+                            if (m_writer.is_bin()) {
+                                return m_writer.get_bin();
+                            } else {
+                                //Convert the JSON message into the binary form
+                                Document json;
+                                json.Parse<kParseFullPrecisionFlag>(m_writer.get_json());
+                                bin_msg_writer writer;
+                                json.Accept(writer);
+                                return writer.get_data();
                             }
+                        }
 
-                            //Return the serialized string
-                            return m_string_buf.GetString();
+                        /**
+                         * @see msg_base
+                         */
+                        virtual msg_type get_msg_type() const override {
+                            return m_type;
                         }
 
                         /**
                          * Allows to re-set the outgoing messages
                          */
                         inline void reset() {
-                            //Clear the buffer
-                            m_string_buf.Clear();
-                            //Re-set the writer to the cleared buffer
-                            m_writer.Reset(m_string_buf);
+                            //Re-set the writer, this clears the written data
+                            m_writer.reset();
                             //Clear the serialization flag
                             m_is_slzd = false;
-
                             //Initialize the outgoing message with the protocol version, type data and etc
                             initialize_object();
                         }
@@ -99,16 +125,24 @@ namespace uva {
                     private:
                         //Stores the message type
                         msg_type m_type;
-
-                        //Stores the string buffer to where the JSON string will be written
-                        StringBuffer m_string_buf;
-
                         //Stores the flag indicating whether or not the message was serialized
                         bool m_is_slzd;
 
+                        /**
+                         * Allows to finish the message object, if not finished yet
+                         */
+                        inline void finish_object() const {
+                            if (!m_is_slzd) {
+                                //Finish the object, the const casts are needed
+                                const_cast<msg_writer&> (m_writer).EndObject();
+                                //Set the serialization flag
+                                const_cast<bool&> (m_is_slzd) = true;
+                            }
+                        }
+
                     protected:
-                        //Stores the JSON writer to be used for streaming response.
-                        JSONWriter m_writer;
+                        //Stores the message writer to be used for streaming response.
+                        msg_writer m_writer;
 
                         /**
                          * Initialize the outgoing message with the protocol version, type data and etc
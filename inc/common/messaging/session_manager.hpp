@@ -25,6 +25,7 @@
 
 #include <map>
 #include <unordered_map>
+#include <unordered_set>
 #include <functional>
 
 #include <websocketpp/server.hpp>
@@ -69,12 +70,14 @@ namespace uva {
                     public:
 
                         //Declare the response setting function for the translation job.
-                        typedef function<void(websocketpp::connection_hdl, const string &) > response_sender;
+                        typedef function<void(websocketpp::connection_hdl, const msg_base &) > response_sender;
 
                         //Declare the session to connection handler maps and iterators;
                         typedef std::map<websocketpp::connection_hdl, session_id_type, std::owner_less<websocketpp::connection_hdl>> sessions_map_type;
                         typedef std::unordered_map<session_id_type, websocketpp::connection_hdl> handlers_map_type;
                         typedef handlers_map_type::iterator handlers_map_iter_type;
+                        //Declare the set of sessions that have negotiated the binary messages
+                        typedef std::unordered_set<session_id_type> bin_sessions_set_type;
 
                         /**
                          * The basic class constructor
@@ -102,8 +105,9 @@ namespace uva {
                          * Allows to create and register a new session object, synchronized.
                          * If for some reason a new session can not be opened, an exception is thrown.
                          * @param hdl [in] the connection handler to identify the session object.
+                         * @param is_bin [in] true if the connection has negotiated the binary messages, default is false
                          */
-                        inline void open_session(websocketpp::connection_hdl hdl) {
+                        inline void open_session(websocketpp::connection_hdl hdl, const bool is_bin = false) {
                             //Use the scoped mutex lock to avoid race conditions
                             scoped_guard guard(m_lock);
 
@@ -116,6 +120,10 @@ namespace uva {
                                 session_id = m_session_id_mgr.get_next_id();
                                 //Add the handler to session id mapping
                                 m_handlers[session_id] = hdl;
+                                //Remember if the session responses are to be written in the binary form
+                                if (is_bin) {
+                                    m_bin_sessions.insert(session_id);
+                                }
                             } else {
                                 LOG_WARNING << "The same connection handler already exists and has a session!" << END_LOG;
                             }
@@ -146,6 +154,7 @@ namespace uva {
                                 m_sessions.erase(hdl);
                                 if (session_id != session_id::UNDEFINED_SESSION_ID) {
                                     m_handlers.erase(session_id);
+                                    m_bin_sessions.erase(session_id);
                                 }
                             }
                             LOG_DEBUG << "Session : " << session_id << " internal mappings "
@@ -161,6 +170,18 @@ namespace uva {
 
                     protected:
 
+                        /**
+                         * Allows to check whether the given session has negotiated the binary messages
+                         * @param session_id the session id
+                         * @return true if the session responses are to be written in the binary form
+                         */
+                        inline bool is_bin_session(const session_id_type session_id) {
+                            //Use the scoped mutex lock to avoid race conditions
+                            scoped_guard guard(m_lock);
+
+                            return (m_bin_sessions.count(session_id) != 0);
+                        }
+
                         /**
                          * Allows to send the response from the given session
                          * @param session_id the session id
@@ -174,18 +195,15 @@ namespace uva {
                             ASSERT_SANITY_THROW(!m_sender_func,
                                     "The sender function of the translation manager is not set!");
 
-                            //Serialize the message
-                            const string data = msg.serialize();
-
                             //Retrieve the connection handler based on the session id
                             websocketpp::connection_hdl hdl = get_session_hdl(session_id);
 
                             //If the sender function is present, and the handler is not expired
                             if (!hdl.expired()) {
-                                LOG_DEBUG << "Sending translation job response: " << data << END_LOG;
+                                LOG_DEBUG << "Sending translation job response, type: " << msg.get_msg_type() << END_LOG;
 
-                                //Send the response to the client
-                                m_sender_func(hdl, data);
+                                //Send the response to the client, the sender serializes it
+                                m_sender_func(hdl, msg);
 
                                 //The send was successful
                                 return true;
@@ -212,7 +230,10 @@ namespace uva {
                         inline session_id_type get_session_id(const websocketpp::connection_hdl hdl) {
                             scoped_guard guard(m_lock);
 
-                            session_id_type session_id = m_sessions[hdl];
+                            //Do not use the [] operator as it would re-insert the handler of a closed session
+                            auto iter = m_sessions.find(hdl);
+                            const session_id_type session_id = (iter != m_sessions.end()) ?
+                                    iter->second : session_id::UNDEFINED_SESSION_ID;
 
                             LOG_DEBUG << "Received a translation request from session: " << session_id << END_LOG;
 
@@ -227,14 +248,15 @@ namespace uva {
                         /**
                          * Allows to get the session handler for the given session id
                          * @param session_id the session id
-                         * @return the corresponding session handler
+                         * @return the corresponding session handler, an expired one if the session is closed
                          */
-                        inline websocketpp::connection_hdl & get_session_hdl(const session_id_type session_id) {
+                        inline websocketpp::connection_hdl get_session_hdl(const session_id_type session_id) {
                             //Use the scoped mutex lock to avoid race conditions
                             scoped_guard guard(m_lock);
 
-                            //Get the connection handler for the session
-                            return m_handlers[session_id];
+                            //Get the connection handler for the session, do not re-insert a closed one
+                            auto iter = m_handlers.find(session_id);
+                            return (iter != m_handlers.end()) ? iter->second : websocketpp::connection_hdl();
                         }
 
                     private:
@@ -252,6 +274,9 @@ namespace uva {
 
                         //Stores the session id to connection handler mappings
                         handlers_map_type m_handlers;
+
+                        //Stores the ids of the sessions that have negotiated the binary messages
+                        bin_sessions_set_type m_bin_sessions;
                     };
                 }
             }
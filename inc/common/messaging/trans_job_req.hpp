@@ -49,8 +49,20 @@ namespace uva {
                         static const char * TARGET_LANG_FIELD_NAME;
                         //Stores the translation info flag attribute name
                         static const char * IS_TRANS_INFO_FIELD_NAME;
+                        //Stores the results streaming flag attribute name
+                        static const char * IS_STREAM_FIELD_NAME;
                         //Stores the source sentences attribute name
                         static const char * SOURCE_SENTENCES_FIELD_NAME;
+                        //Stores the optional feature weights attribute name
+                        static const char * WEIGHTS_FIELD_NAME;
+                        //Stores the feature weights' language model weight attribute name
+                        static const char * LM_WEIGHT_FIELD_NAME;
+                        //Stores the feature weights' translation model weights attribute name
+                        static const char * TM_WEIGHTS_FIELD_NAME;
+                        //Stores the feature weights' word penalty weight attribute name
+                        static const char * WP_WEIGHT_FIELD_NAME;
+                        //Stores the feature weights' reordering model weights attribute name
+                        static const char * RM_WEIGHTS_FIELD_NAME;
 
                         /**
                          * The basic constructor
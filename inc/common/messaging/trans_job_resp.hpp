@@ -43,6 +43,8 @@ namespace uva {
                         static const char * JOB_ID_FIELD_NAME;
                         //The target data field name
                         static const char * TARGET_DATA_FIELD_NAME;
+                        //The index of the first target data sentence within the job field name
+                        static const char * SENT_IDX_FIELD_NAME;
 
                         /**
                          * The basic constructor
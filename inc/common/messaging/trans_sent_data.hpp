@@ -48,6 +48,10 @@ namespace uva {
                         static const char * TRANS_TEXT_FIELD_NAME;
                         //The target data field name
                         static const char * STACK_LOAD_FIELD_NAME;
+                        //The number of allocated stack states field name
+                        static const char * STACK_STATES_FIELD_NAME;
+                        //The number of stack state memory bytes field name
+                        static const char * STACK_MEM_FIELD_NAME;
 
                         //Typedef the loads array data structure for storing the stack load percent values
                         typedef vector<int64_t> stack_loads;
@@ -57,6 +57,9 @@ static inline void get_client_params(
             cs_params.m_tls_ciphers = get_string(ini, section,
                     websocket_client_params::WC_TLS_CIPHERS_PARAM_NAME, "", false);
         }
+        //The binary messages are an optional parameter, the server may still only support JSON
+        cs_params.m_is_bin_msgs = get_bool(ini, section,
+                websocket_client_params::WC_IS_BIN_MSGS_PARAM_NAME, "false", false);
     }
 }
 
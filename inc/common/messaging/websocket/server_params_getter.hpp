@@ -29,7 +29,7 @@
 #include "common/messaging/websocket/server_params_getter.hpp"
 
 /**
- * Allows to get the server-related TLS parameters
+ * Allows to get the server-related I/O and TLS parameters
  * @param ini the ini file to get the parameters from
  * @param section the section to get them from
  * @param ws_params the parameters structure to be filled in
@@ -37,6 +37,16 @@
 static inline void get_server_params(
         INI<> & ini, const string & section,
         websocket_server_params& ws_params) {
+    //Get the number of the I/O threads, optional
+    ws_params.m_num_io_threads = get_integer<uint16_t>(ini, section,
+            websocket_server_params::WS_NUM_IO_THREADS_PARAM_NAME,
+            websocket_server_params::WS_DEF_NUM_IO_THREADS, false);
+
+    //Get the per thread log buffer size, optional
+    ws_params.m_log_buffer_size = get_integer<uint32_t>(ini, section,
+            websocket_server_params::WS_LOG_BUFFER_SIZE_PARAM_NAME,
+            websocket_server_params::WS_DEF_LOG_BUFFER_SIZE, false);
+
     //Process the TLS related parameters
     ws_params.m_is_tls_server = get_bool(ini, section,
             websocket_server_params::WS_IS_TLS_SERVER_PARAM_NAME, "false", IS_TLS_SUPPORT);
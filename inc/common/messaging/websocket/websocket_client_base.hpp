@@ -62,7 +62,10 @@ namespace uva {
                          * job request to the server and receiving the result.
                          * This server is parameterized by the client's ASIO
                          * configuration type. This allows to specify the 
-                         * availability of TLS support.
+                         * availability of TLS support. If requested by the
+                         * parameters and accepted by the server then the
+                         * translation job requests are sent in the compact
+                         * binary form.
                          * 
                          * @param ASIO_CONFIG the web socket client configuration type:
                          *     websocketpp::config::asio_tls_client
@@ -103,7 +106,7 @@ namespace uva {
                             : websocket_client(),
                             m_client(), m_params(params),
                             m_started(false), m_stopped(false),
-                            m_opened(false), m_closed(false),
+                            m_opened(false), m_closed(false), m_is_bin_msgs(false),
                             m_notify_new_msg(notify_new_msg),
                             m_notify_conn_close(notify_conn_close),
                             m_notify_conn_open(notify_conn_open),
@@ -146,6 +149,12 @@ namespace uva {
                                     typename client_type::connection_ptr con = m_client.get_connection(m_params.m_server_uri, ec);
                                     ASSERT_CONDITION_THROW(ec, string("Get Connection (") + m_params.m_server_uri + string(") Error: ") + ec.message());
 
+                                    //Request the binary messages if needed, the server decides
+                                    if (m_params.m_is_bin_msgs) {
+                                        con->add_subprotocol(msg_base::BIN_SUB_PROTOCOL_NAME, ec);
+                                        ASSERT_CONDITION_THROW(ec, string("Add sub-protocol Error: ") + ec.message());
+                                    }
+
                                     // Grab a handle for this connection so we can talk to it in a thread
                                     // safe manor after the event loop starts.
                                     m_hdl = con->get_handle();
@@ -217,13 +226,18 @@ namespace uva {
                                 //Declare the error code
                                 websocketpp::lib::error_code ec;
 
-                                //Serialize the message
-                                const string msg_str = message->serialize();
+                                if (m_is_bin_msgs && message->is_bin_msg_type()) {
+                                    //Try to send the binary translation job request
+                                    m_client.send(m_hdl, message->serialize_bin(), websocketpp::frame::opcode::binary, ec);
+                                } else {
+                                    //Serialize the message
+                                    const string msg_str = message->serialize();
 
-                                LOG_DEBUG << "Serialized translation request: \n" << msg_str << END_LOG;
+                                    LOG_DEBUG << "Serialized translation request: \n" << msg_str << END_LOG;
 
-                                //Try to send the translation job request
-                                m_client.send(m_hdl, msg_str, websocketpp::frame::opcode::text, ec);
+                                    //Try to send the translation job request
+                                    m_client.send(m_hdl, msg_str, websocketpp::frame::opcode::text, ec);
+                                }
 
                                 // The most likely error that we will get is that the connection is
                                 // not in the right state. Usually this means we tried to send a
@@ -259,13 +273,20 @@ namespace uva {
 
                                 //Try parsing the incoming message
                                 try {
-                                    //Get the message string
-                                    string msg_str = msg->get_payload();
+                                    if (msg->get_opcode() == websocketpp::frame::opcode::binary) {
+                                        LOG_DEBUG << "Got a binary translation server message" << END_LOG;
+
+                                        //De-serialize the message, it takes over the payload
+                                        json_msg->de_serialize_bin(move(msg->get_raw_payload()));
+                                    } else {
+                                        //Get the message string
+                                        string msg_str = msg->get_payload();
 
-                                    LOG_DEBUG << "Got translation server message: " << msg_str << END_LOG;
+                                        LOG_DEBUG << "Got translation server message: " << msg_str << END_LOG;
 
-                                    //De-serialize the message from string
-                                    json_msg->de_serialize(msg_str);
+                                        //De-serialize the message from string
+                                        json_msg->de_serialize(msg_str);
+                                    }
 
                                     //Set the message to the client
                                     m_notify_new_msg(json_msg);
@@ -283,6 +304,18 @@ namespace uva {
                             inline void on_open(websocketpp::connection_hdl hdl) {
                                 LOG_DEBUG << "Connection opened!" << END_LOG;
 
+                                //Check whether the server has accepted the binary messages, the
+                                //client connection does not store the selected sub-protocol
+                                if (m_params.m_is_bin_msgs) {
+                                    typename client_type::connection_ptr con = m_client.get_con_from_hdl(hdl);
+                                    m_is_bin_msgs = (con->get_response_header("Sec-WebSocket-Protocol")
+                                            == msg_base::BIN_SUB_PROTOCOL_NAME);
+                                    if (!m_is_bin_msgs) {
+                                        LOG_WARNING << "The server '" << m_params.m_server_uri
+                                                << "' does not support the binary messages, using JSON!" << END_LOG;
+                                    }
+                                }
+
                                 //Do not lock the notification, as that might be blocking as well
                                 {
                                     scoped_guard guard(m_lock_con);
@@ -403,6 +436,9 @@ namespace uva {
                             a_bool_flag m_opened;
                             a_bool_flag m_closed;
 
+                            //Stores the flag indicating whether the binary messages are negotiated
+                            a_bool_flag m_is_bin_msgs;
+
                             //Stores the server message setting function
                             new_msg_notifier m_notify_new_msg;
                             //Stores the connection close notifier
@@ -75,6 +75,9 @@ namespace uva {
                             //Stores the client TLS ciphers parameter name
                             static const string WC_TLS_CIPHERS_PARAM_NAME;
 
+                            //Stores the client binary messages parameter name
+                            static const string WC_IS_BIN_MSGS_PARAM_NAME;
+
                             //Stores the name of the server
                             string m_server_name;
                             //The port to listen to
@@ -87,6 +90,8 @@ namespace uva {
                             string m_tls_mode_name;
                             //Stores the client's ciphers, or an empty string for defaults
                             string m_tls_ciphers;
+                            //Stores the flag indicating whether the binary messages are to be requested
+                            bool m_is_bin_msgs;
 
                             /**
                              * The basic constructor, finalization is required!
@@ -96,7 +101,7 @@ namespace uva {
                             m_server_uri(""), m_is_tls_client(false),
                             m_tls_mode(tls_mode_enum::MOZILLA_UNDEFINED),
                             m_tls_mode_name(tls_val_to_str(tls_mode_enum::MOZILLA_UNDEFINED)),
-                            m_tls_ciphers("") {
+                            m_tls_ciphers(""), m_is_bin_msgs(false) {
                             }
 
                             /**
@@ -108,7 +113,7 @@ namespace uva {
                             m_server_uri(""), m_is_tls_client(false),
                             m_tls_mode(tls_mode_enum::MOZILLA_UNDEFINED),
                             m_tls_mode_name(tls_val_to_str(tls_mode_enum::MOZILLA_UNDEFINED)),
-                            m_tls_ciphers("") {
+                            m_tls_ciphers(""), m_is_bin_msgs(false) {
                             }
 
                             /**
@@ -127,7 +132,7 @@ namespace uva {
                             m_server_uri(server_uri), m_is_tls_client(false),
                             m_tls_mode(tls_mode_enum::MOZILLA_UNDEFINED),
                             m_tls_mode_name(tls_mode_name),
-                            m_tls_ciphers(tls_ciphers) {
+                            m_tls_ciphers(tls_ciphers), m_is_bin_msgs(false) {
                             }
 
                             /**
@@ -224,6 +229,7 @@ namespace uva {
                                 this->m_tls_mode = other.m_tls_mode;
                                 this->m_tls_mode_name = other.m_tls_mode_name;
                                 this->m_tls_ciphers = other.m_tls_ciphers;
+                                this->m_is_bin_msgs = other.m_is_bin_msgs;
                                 return *this;
                             }
                         };
@@ -256,6 +262,8 @@ namespace uva {
                             } else {
                                 stream << "false";
                             }
+                            stream << ", " << websocket_client_params::WC_IS_BIN_MSGS_PARAM_NAME
+                                    << " = " << (params.m_is_bin_msgs ? "true" : "false");
                             return stream << "}";
                         }
                     }
@@ -26,11 +26,15 @@
 #ifndef WEBSOCKET_SERVER_HPP
 #define WEBSOCKET_SERVER_HPP
 
+#include <thread>
+#include <vector>
+#include <algorithm>
 #include <iostream>
 #include <functional>
 
 #include "common/utils/exceptions.hpp"
 #include "common/utils/logging/logger.hpp"
+#include "common/utils/threads/keyed_task_pool.hpp"
 
 #define ASIO_STANDALONE
 #include <websocketpp/server.hpp>
@@ -71,6 +75,7 @@ using namespace websocketpp::log;
 
 using namespace uva::utils::logging;
 using namespace uva::utils::exceptions;
+using namespace uva::utils::threads;
 
 using namespace uva::smt::bpbd::server::messaging;
 using namespace uva::smt::bpbd::processor::messaging;
@@ -88,7 +93,15 @@ namespace uva {
                     /**
                      * Represents the base class for the web socket server.
                      * Contains the common needed functionality. It is also a
-                     * template class parameterized by the asio configuration
+                     * template class parameterized by the asio configuration.
+                     * The asio I/O service is run by a configurable number of
+                     * threads, the handlers of one connection are serialized
+                     * by its strand. The received messages are parsed and
+                     * dispatched by a pool of workers, so that the I/O threads
+                     * are not blocked, the messages of one connection are
+                     * handled in the order they were received. The clients
+                     * requesting the binary messages sub-protocol get the
+                     * translation job responses in the compact binary form.
                      * 
                      * @param TLS_CLASS the TLS class which defines the server type and mode
                      */
@@ -122,6 +135,24 @@ namespace uva {
                             }
                             con->set_status(websocketpp::http::status_code::ok);
                         }
+
+                        /**
+                         * This handler is called during the WebSocket handshake, it selects
+                         * the binary messages sub-protocol if it is requested by the client.
+                         * @param hdl the connection handler
+                         * @return true as the connection is always accepted
+                         */
+                        bool on_validate(websocketpp::connection_hdl hdl) {
+                            typename TLS_CLASS::server_type::connection_ptr con
+                                    = m_server.get_con_from_hdl(hdl);
+
+                            const vector<string> & protocols = con->get_requested_subprotocols();
+                            if (find(protocols.begin(), protocols.end(), msg_base::BIN_SUB_PROTOCOL_NAME) != protocols.end()) {
+                                LOG_DEBUG << "The client requested the binary messages." << END_LOG;
+                                con->select_subprotocol(msg_base::BIN_SUB_PROTOCOL_NAME);
+                            }
+                            return true;
+                        }
                     public:
 
                         /**
@@ -129,7 +160,7 @@ namespace uva {
                          * @param params the websocket server parameters
                          */
                         websocket_server(const websocket_server_params & params) :
-                        m_params(params) {
+                        m_params(params), m_parse_pool(params.m_num_io_threads) {
                             //Set up access channels to only log interesting things
                             m_server.clear_access_channels(log::alevel::all);
                             m_server.set_access_channels(log::alevel::none);
@@ -148,6 +179,8 @@ namespace uva {
                                     bind(&websocket_server::close_session, this, _1));
                             m_server.set_http_handler(
                                     bind(&websocket_server::on_http, this, _1));
+                            m_server.set_validate_handler(
+                                    bind(&websocket_server::on_validate, this, _1));
 #if IS_TLS_SUPPORT
                             //If the TLS support is enabled and requested
                             if (params.m_is_tls_server) {
@@ -183,7 +216,20 @@ namespace uva {
                             LOG_DEBUG << "Starting the websockets server." << END_LOG;
                             //Start accepting the messages
                             m_server.start_accept();
+
+                            //Run the I/O service by the helper threads and the current one
+                            vector<thread> io_threads;
+                            for (uint16_t idx = 1; idx < m_params.m_num_io_threads; ++idx) {
+                                io_threads.emplace_back(thread([this] {
+                                    m_server.run();
+                                }));
+                            }
                             m_server.run();
+
+                            //Wait until the helper I/O threads are finished
+                            for (auto & io_thread : io_threads) {
+                                io_thread.join();
+                            }
                         }
 
                         /**
@@ -198,6 +244,10 @@ namespace uva {
                             //Stop listening to the (new) connections
                             m_server.stop_listening();
 
+                            LOG_DEBUG << "Stop parsing the received messages." << END_LOG;
+                            //Stop the message parsing pool, the not yet parsed messages are dropped
+                            m_parse_pool.stop();
+
                             //Send the remaining responses after the server stopped listening.
                             after_stop_listening();
 
@@ -256,6 +306,46 @@ namespace uva {
                             LOG_DEBUG << "The job response: ____" << reply_str << "____ is sent!" << END_LOG;
                         }
 
+                        /**
+                         * Allows to send the response message to the client associated with the given connection
+                         * handler. The message is sent in the binary form if the client has negotiated the binary
+                         * messages and the message type allows for that, otherwise it is sent as JSON.
+                         * @param hdl the connection handler to identify the connection
+                         * @param msg the response message
+                         */
+                        inline void send_msg_response(connection_hdl hdl, const msg_base & msg) {
+                            //Declare the error code
+                            lib::error_code ec;
+
+                            //Get the connection to check on the negotiated sub-protocol
+                            typename TLS_CLASS::server_type::connection_ptr con = m_server.get_con_from_hdl(hdl, ec);
+                            if (ec) {
+                                LOG_ERROR << "Failed sending a reply, the connection is lost: " << ec.message() << END_LOG;
+                                return;
+                            }
+
+                            if (msg.is_bin_msg_type() && (con->get_subprotocol() == msg_base::BIN_SUB_PROTOCOL_NAME)) {
+                                LOG_DEBUG << "Sending the binary job response" << END_LOG;
+                                ec = con->send(msg.serialize_bin(), opcode::binary);
+                                if (ec) {
+                                    LOG_ERROR << "Failed sending the binary reply: " << ec.message() << END_LOG;
+                                }
+                            } else {
+                                send_response(hdl, msg.serialize());
+                            }
+                        }
+
+                        /**
+                         * Allows to check whether the binary messages sub-protocol is selected for the connection
+                         * @param hdl the connection handler to identify the connection
+                         * @return true if the connection is there and has the binary messages sub-protocol
+                         */
+                        inline bool is_bin_sub_protocol(connection_hdl hdl) {
+                            lib::error_code ec;
+                            typename TLS_CLASS::server_type::connection_ptr con = m_server.get_con_from_hdl(hdl, ec);
+                            return !ec && (con->get_subprotocol() == msg_base::BIN_SUB_PROTOCOL_NAME);
+                        }
+
                         /**
                          * Allows to create and register a new session object, synchronized.
                          * If for some reason a new session can not be opened, an exception is thrown.
@@ -272,24 +362,50 @@ namespace uva {
                         virtual void close_session(websocketpp::connection_hdl hdl) = 0;
 
                         /**
-                         * Is called when the message is received by the server
+                         * Is called when the message is received by the server, on an
+                         * I/O thread. Plans the message handling to the parsing pool,
+                         * keyed by the connection, to keep the order of the messages.
                          * @param hdl the connection handler
                          * @param raw_msg the received message
                          */
                         virtual void on_message(websocketpp::connection_hdl hdl, message_ptr raw_msg) {
                             LOG_DEBUG << "Received a message!" << END_LOG;
 
+                            const size_t key = hash<void *>()(hdl.lock().get());
+                            m_parse_pool.plan(key, [this, hdl, raw_msg] {
+                                handle_message(hdl, raw_msg);
+                            });
+                        }
+
+                        /**
+                         * Is called by the parsing pool to parse and dispatch the received message
+                         * @param hdl the connection handler
+                         * @param raw_msg the received message
+                         */
+                        virtual void handle_message(websocketpp::connection_hdl hdl, message_ptr raw_msg) {
+
                             //Create an empty json message
                             incoming_msg * jmsg = new incoming_msg();
 
                             //De-serialize the message and then handle based on its type
                             try {
-                                string raw_msg_str = raw_msg->get_payload();
+                                if (raw_msg->get_opcode() == opcode::binary) {
+                                    LOG_DEBUG << "Received a binary msg" << END_LOG;
+
+                                    //The binary messages are only accepted if negotiated by the client
+                                    ASSERT_CONDITION_THROW(!is_bin_sub_protocol(hdl),
+                                            "The binary messages sub-protocol is not selected for this connection!");
 
-                                LOG_DEBUG << "Received JSON msg: " << raw_msg_str << END_LOG;
+                                    //De-serialize the message, it takes over the payload
+                                    jmsg->de_serialize_bin(move(raw_msg->get_raw_payload()));
+                                } else {
+                                    string raw_msg_str = raw_msg->get_payload();
 
-                                //De-serialize the message
-                                jmsg->de_serialize(raw_msg_str);
+                                    LOG_DEBUG << "Received JSON msg: " << raw_msg_str << END_LOG;
+
+                                    //De-serialize the message
+                                    jmsg->de_serialize(raw_msg_str);
+                                }
 
                                 //Handle the request message based on its type
                                 switch (jmsg->get_msg_type()) {
@@ -378,6 +494,8 @@ namespace uva {
                     private:
                         //Stores the server object of the type defines by the TLS class
                         typename TLS_CLASS::server_type m_server;
+                        //Stores the pool parsing and dispatching the received messages
+                        keyed_task_pool m_parse_pool;
                     };
                 }
             }
@@ -87,6 +87,18 @@ namespace uva {
                             //Stores the TLS temporary DH pem parameter name
                             static const string WS_TLS_DH_FILE_PARAM_NAME;
 
+                            //Stores the number of I/O threads parameter name
+                            static const string WS_NUM_IO_THREADS_PARAM_NAME;
+
+                            //Stores the default number of I/O threads
+                            static constexpr uint16_t WS_DEF_NUM_IO_THREADS = 1;
+
+                            //Stores the per thread log buffer size parameter name
+                            static const string WS_LOG_BUFFER_SIZE_PARAM_NAME;
+
+                            //Stores the default per thread log buffer size in Kb
+                            static constexpr uint32_t WS_DEF_LOG_BUFFER_SIZE = 64;
+
                             //The port to listen to
                             uint16_t m_server_port;
                             //The flag indicating whether the TLS server is running
@@ -103,6 +115,10 @@ namespace uva {
                             string m_tls_dh_file;
                             //Stores the client's ciphers, or an empty string for defaults
                             string m_tls_ciphers;
+                            //Stores the number of threads running the I/O and parsing the messages
+                            uint16_t m_num_io_threads;
+                            //Stores the per thread log buffer size in Kb, zero for the synchronous logging
+                            uint32_t m_log_buffer_size;
 
                             /**
                              * Allows to check if the file exists
@@ -118,6 +134,12 @@ namespace uva {
                              * Allows to finalize the parameters after loading.
                              */
                             virtual void finalize() {
+                                ASSERT_CONDITION_THROW((m_num_io_threads == 0),
+                                        string("The value of the ") +
+                                        WS_NUM_IO_THREADS_PARAM_NAME +
+                                        string(" configuration parameter of the") +
+                                        string(" WebSocket server must be positive!"));
+
 #if (!defined(WITH_TLS) || !WITH_TLS)
                                 ASSERT_CONDITION_THROW(m_is_tls_server,
                                         string("The value of the ") +
@@ -209,6 +231,10 @@ namespace uva {
                             stream << "WebSocket server parameters: {"
                                     << websocket_server_params::WS_SERVER_PORT_PARAM_NAME
                                     << " = " << params.m_server_port
+                                    << ", " << websocket_server_params::WS_NUM_IO_THREADS_PARAM_NAME
+                                    << " = " << params.m_num_io_threads
+                                    << ", " << websocket_server_params::WS_LOG_BUFFER_SIZE_PARAM_NAME
+                                    << " = " << params.m_log_buffer_size
                                     << ", " << websocket_server_params::WS_IS_TLS_SERVER_PARAM_NAME
                                     << " = ";
                             if (params.m_is_tls_server) {
@@ -328,6 +328,8 @@ namespace uva {
                  * Allows to print the prompt
                  */
                 inline void print_the_prompt() {
+                    //Write out the buffered log lines first
+                    logger::flush();
                     cout << ">> ";
                 }
 
@@ -51,6 +51,13 @@ namespace uva {
                  * @param num_threads the new number of threads
                  */
                 virtual void set_num_threads(const int32_t num_threads) = 0;
+
+                /**
+                 * Allows to notify the client that its run-time parameters have been changed from the command line
+                 */
+                virtual void notify_params_changed() {
+                    //Nothing to be done by default
+                }
             };
         }
     }
@@ -34,12 +34,14 @@
 #include "common/utils/logging/logger.hpp"
 #include "common/utils/exceptions.hpp"
 #include "common/utils/text/string_utils.hpp"
+#include "common/utils/hashing_utils.hpp"
 
 using namespace std;
 
 using namespace uva::utils::exceptions;
 using namespace uva::utils::logging;
 using namespace uva::utils::text;
+using namespace uva::utils::hashing;
 
 namespace uva {
     namespace utils {
@@ -134,10 +136,10 @@ namespace uva {
                 }
 
                 /**
-                 * The basic destructor
+                 * The basic destructor, is kept trivial for the queue to be
+                 * usable within the trivially destructible pooled objects
                  */
-                ~circular_queue() {
-                }
+                ~circular_queue() = default;
 
                 /**
                  * Allows to get a string representation of the queue.
@@ -191,6 +193,26 @@ namespace uva {
                     }
                 }
 
+                /**
+                 * Allows to compute the hash of the last elements of the queue, consistent
+                 * with is_equal_last, i.e. if is_equal_last returns true for two queues
+                 * with the same num_elems then their hash values are equal.
+                 * @param num_elems the number of last elements to hash
+                 * @param seed the seed to start hashing from
+                 * @return the hash value of the queue tail
+                 */
+                uint_fast64_t hash_last(const size_t num_elems, const uint_fast64_t seed) const {
+                    if (m_size >= num_elems) {
+                        //Hash the last num_elems elements
+                        return MurmurHash64A((m_elems + (m_size - num_elems)),
+                                num_elems * sizeof(elem_type), seed);
+                    } else {
+                        //Hash all the elements, the size is a part of the
+                        //hash as queues of different length are not equal
+                        return MurmurHash64A(m_elems, m_size * sizeof(elem_type), seed + m_size);
+                    }
+                }
+
                 /**
                  * Allows to empty the queue
                  */
@@ -31,11 +31,13 @@
 #include "common/utils/math_utils.hpp"
 #include "common/utils/hashing_utils.hpp"
 #include "common/utils/containers/array_utils.hpp"
+#include "common/utils/file/binary_image.hpp"
 
 using namespace std;
 using namespace uva::utils::hashing;
 using namespace uva::utils::math;
 using namespace uva::utils::containers::utils;
+using namespace uva::utils::file;
 
 namespace uva {
     namespace utils {
@@ -84,6 +86,40 @@ namespace uva {
                     //Allocate the elements, add an extra one, the 0'th 
                     //element will never be used its index is reserved.
                     m_elems = new ELEMENT_TYPE[num_elems + 1]();
+                    //The data is owned by the map
+                    m_is_mapped = false;
+                }
+
+                /**
+                 * The constructor that allows to instantiate the map from a binary image
+                 * previously written by write_image. The map data is used in place, it
+                 * is not copied, so the map is read-only and the image must outlive it.
+                 * @param image the binary image reader positioned at the map data
+                 */
+                explicit fixed_size_hashmap(binary_image_reader & image) : MAX_ELEMENT_INDEX(image.read<IDX_TYPE>()) {
+                    m_num_buckets = image.read<uint64_t>();
+                    m_buckets_capacity = m_num_buckets - 1;
+                    m_next_elem_idx = image.read<IDX_TYPE>();
+                    m_buckets = const_cast<IDX_TYPE *> (image.read_array<IDX_TYPE>(m_num_buckets));
+                    m_elems = const_cast<ELEMENT_TYPE *> (image.read_array<ELEMENT_TYPE>(MAX_ELEMENT_INDEX + 1));
+                    //The data is owned by the image
+                    m_is_mapped = true;
+
+                    LOG_DEBUG << "FSHM: mapped num_elems: " << MAX_ELEMENT_INDEX << ", m_num_buckets: "
+                            << m_num_buckets << END_LOG;
+                }
+
+                /**
+                 * Allows to write the map into a binary image, the map
+                 * can be then re-created from the image without copying.
+                 * @param image the binary image writer
+                 */
+                void write_image(binary_image_writer & image) const {
+                    image.write<IDX_TYPE>(MAX_ELEMENT_INDEX);
+                    image.write<uint64_t>(m_num_buckets);
+                    image.write<IDX_TYPE>(m_next_elem_idx);
+                    image.write_array(m_buckets, m_num_buckets);
+                    image.write_array(m_elems, MAX_ELEMENT_INDEX + 1);
                 }
 
                 /**
@@ -95,6 +131,9 @@ namespace uva {
                  * @return the reference to the new element
                  */
                 ELEMENT_TYPE & add_new_element(const uint_fast64_t key_uid) {
+                    //Check that the map is not a read-only mapped image
+                    ASSERT_SANITY_THROW(m_is_mapped, "Can not add elements to a memory-mapped map!");
+
                     //Check if the capacity is exceeded.
                     ASSERT_SANITY_THROW((m_next_elem_idx > MAX_ELEMENT_INDEX),
                             string("Used up all the elements, the last ") +
@@ -138,10 +177,12 @@ namespace uva {
                  *        key value of the element. It can be e.g. a hash value
                  *        of the key. Note that if one uses hash for a key uid
                  *        then he or she has to accept the risk of collisions.
-                 * @param key the key value of the element
+                 * @param key the key value of the element, can be of another type
+                 *        than KEY_TYPE if the element can be compared with it
                  * @return the pointer to the found element or NULL if nothing is found
                  */
-                ELEMENT_TYPE * get_element(const uint_fast64_t key_uid, const KEY_TYPE & key) const {
+                template<typename ANY_KEY_TYPE = KEY_TYPE>
+                ELEMENT_TYPE * get_element(const uint_fast64_t key_uid, const ANY_KEY_TYPE & key) const {
                     //Get the bucket index from the hash
                     uint_fast64_t bucket_idx = get_bucket_idx(key_uid);
 
@@ -166,11 +207,42 @@ namespace uva {
                     return NULL;
                 }
 
+                /**
+                 * Allows to prefetch the first bucket for the given key uid. When several elements are
+                 * to be retrieved one after another, prefetching all of their buckets first allows to
+                 * overlap the memory latencies of the look ups.
+                 * @param key_uid the unique identifier representing the key value of the element
+                 */
+                inline void prefetch_bucket(const uint_fast64_t key_uid) const {
+                    __builtin_prefetch(&m_buckets[get_bucket_idx(key_uid)]);
+                }
+
+                /**
+                 * Allows to get the index of the given element, the element must be stored in this map.
+                 * The index stays valid for the life time of the map and in its binary image.
+                 * @param elem the element stored in the map
+                 * @return the index of the element
+                 */
+                inline IDX_TYPE get_element_idx(const ELEMENT_TYPE & elem) const {
+                    ASSERT_SANITY_THROW((&elem < m_elems) || (&elem > (m_elems + MAX_ELEMENT_INDEX)),
+                            "The element is not stored in this map!");
+                    return static_cast<IDX_TYPE> (&elem - m_elems);
+                }
+
+                /**
+                 * Allows to get the elements array, the elements are to be accessed by the indexes
+                 * obtained with get_element_idx, the element at NO_ELEMENT_INDEX is never used
+                 * @return the pointer to the elements array
+                 */
+                inline const ELEMENT_TYPE * get_elements() const {
+                    return m_elems;
+                }
+
                 /**
                  * The basic destructor
                  */
                 ~fixed_size_hashmap() {
-                    if (m_elems != NULL) {
+                    if ((m_elems != NULL) && !m_is_mapped) {
                         //Free the allocated arrays
                         delete[] m_elems;
                         delete[] m_buckets;
@@ -192,6 +264,8 @@ namespace uva {
                 IDX_TYPE * m_buckets;
                 //Stores the array of reserved elements
                 ELEMENT_TYPE * m_elems;
+                //Stores the flag indicating that the data is memory mapped and not owned
+                bool m_is_mapped;
 
                 /**
                  * Sets the number of buckets as a power of two, based on the number of elements
@@ -0,0 +1,169 @@
+/*
+ * File:   object_pool.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 16, 2026, 2:05 PM
+ */
+
+#ifndef OBJECT_POOL_HPP
+#define OBJECT_POOL_HPP
+
+#include <vector>       // std::vector
+#include <type_traits>  // std::aligned_storage
+
+#include "common/utils/logging/logger.hpp"
+#include "common/utils/exceptions.hpp"
+
+using namespace std;
+using namespace uva::utils::logging;
+using namespace uva::utils::exceptions;
+
+namespace uva {
+    namespace utils {
+        namespace containers {
+
+            /**
+             * This class represents a pool of memory for objects of the same type.
+             * The memory is allocated in chunks of CHUNK_NUM_ELEMS objects and the
+             * freed object slots are kept in a free list to be re-used. The chunks
+             * are only released once the pool is destroyed, a reset makes all of
+             * them available again without releasing the memory. The pool is NOT
+             * thread safe and does not call any constructors or destructors.
+             * @param elem_type the type of the objects to allocate the memory for
+             * @param CHUNK_NUM_ELEMS the number of objects per memory chunk
+             */
+            template<typename elem_type, size_t CHUNK_NUM_ELEMS = 512 >
+            class object_pool {
+            public:
+
+                /**
+                 * The basic constructor
+                 */
+                object_pool() : m_free_slot(NULL), m_num_used_chunks(0), m_chunk_pos(CHUNK_NUM_ELEMS), m_num_allocs(0) {
+                }
+
+                /**
+                 * The basic destructor, releases all the memory chunks
+                 */
+                ~object_pool() {
+                    LOG_DEBUG1 << "Releasing the object pool with " << m_chunks.size() << " chunk(s), "
+                            << get_num_bytes() << " bytes, " << m_num_allocs << " allocation(s)" << END_LOG;
+                    for (auto chunk : m_chunks) {
+                        delete[] chunk;
+                    }
+                }
+
+                /**
+                 * Allows to allocate memory for one object
+                 * @return the pointer to the allocated memory
+                 */
+                inline void * allocate() {
+                    //Count the allocation
+                    ++m_num_allocs;
+
+                    //Re-use a free slot if there is one
+                    if (m_free_slot != NULL) {
+                        pool_slot * slot = m_free_slot;
+                        m_free_slot = slot->m_next;
+                        return slot;
+                    }
+
+                    //Move on to the next chunk if the current one is full,
+                    //the chunk is only allocated if there is no retained one
+                    if (m_chunk_pos == CHUNK_NUM_ELEMS) {
+                        if (m_num_used_chunks == m_chunks.size()) {
+                            m_chunks.push_back(new pool_slot[CHUNK_NUM_ELEMS]);
+                        }
+                        ++m_num_used_chunks;
+                        m_chunk_pos = 0;
+                    }
+
+                    return &m_chunks[m_num_used_chunks - 1][m_chunk_pos++];
+                }
+
+                /**
+                 * Allows to return the object memory back into the pool
+                 * @param ptr the pointer to the memory allocated by this pool
+                 */
+                inline void deallocate(void * ptr) {
+                    pool_slot * slot = static_cast<pool_slot *> (ptr);
+                    slot->m_next = m_free_slot;
+                    m_free_slot = slot;
+                }
+
+                /**
+                 * Allows to make all the pool memory available again at once. The
+                 * memory chunks are retained. All the objects allocated before are
+                 * dropped without returning their memory one by one, so they are
+                 * to be trivially destructible or destroyed by the caller first.
+                 */
+                inline void reset() {
+                    m_free_slot = NULL;
+                    m_num_used_chunks = 0;
+                    m_chunk_pos = CHUNK_NUM_ELEMS;
+                    m_num_allocs = 0;
+                }
+
+                /**
+                 * Allows to get the number of allocations done since the last reset
+                 * @return the number of allocations done since the last reset
+                 */
+                inline size_t get_num_allocs() const {
+                    return m_num_allocs;
+                }
+
+                /**
+                 * Allows to get the number of bytes allocated for the memory chunks
+                 * @return the number of bytes allocated for the memory chunks
+                 */
+                inline size_t get_num_bytes() const {
+                    return m_chunks.size() * CHUNK_NUM_ELEMS * sizeof (pool_slot);
+                }
+
+            private:
+
+                /**
+                 * The pool slot is either a free list element or an object storage
+                 */
+                union pool_slot {
+                    //The pointer to the next free slot
+                    pool_slot * m_next;
+                    //The object storage
+                    typename aligned_storage<sizeof (elem_type), alignof (elem_type)>::type m_data;
+                };
+
+                //Stores the memory chunks
+                vector<pool_slot *> m_chunks;
+                //Stores the head of the free slots list
+                pool_slot * m_free_slot;
+                //Stores the number of chunks in use, the last of them is the current one
+                size_t m_num_used_chunks;
+                //Stores the next unused position in the current chunk
+                size_t m_chunk_pos;
+                //Stores the number of allocations since the last reset
+                size_t m_num_allocs;
+            };
+        }
+    }
+}
+
+#endif /* OBJECT_POOL_HPP */
+
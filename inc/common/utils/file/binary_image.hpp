@@ -0,0 +1,328 @@
+/*
+ * File:   binary_image.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 16, 2026, 10:12 AM
+ */
+
+#ifndef BINARY_IMAGE_HPP
+#define BINARY_IMAGE_HPP
+
+#include <string>       // std::string
+#include <fstream>      // std::ofstream
+#include <cstring>      // std::memcmp
+#include <fcntl.h>      // std::open
+#include <unistd.h>     // std::close
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <errno.h>
+
+#include "common/utils/logging/logger.hpp"
+#include "common/utils/exceptions.hpp"
+
+using namespace std;
+using namespace uva::utils::logging;
+using namespace uva::utils::exceptions;
+
+namespace uva {
+    namespace utils {
+        namespace file {
+
+            //The alignment of the binary image sections, in bytes
+            static constexpr size_t BINARY_IMAGE_ALIGNMENT = 8;
+            //The length of the binary image magic marker, in bytes
+            static constexpr size_t BINARY_IMAGE_MAGIC_LEN = 8;
+
+            /**
+             * Allows to check if the given file starts with the given magic marker,
+             * i.e. whether it is a binary image of the expected kind.
+             * @param file_name the name of the file to check
+             * @param magic the magic marker of BINARY_IMAGE_MAGIC_LEN bytes
+             * @return true if the file exists and starts with the given marker
+             */
+            static inline bool is_binary_image(const string & file_name, const char * magic) {
+                char buffer[BINARY_IMAGE_MAGIC_LEN] = {};
+                ifstream file(file_name, ios::in | ios::binary);
+                if (file.is_open() && file.read(buffer, BINARY_IMAGE_MAGIC_LEN)) {
+                    return (memcmp(buffer, magic, BINARY_IMAGE_MAGIC_LEN) == 0);
+                }
+                return false;
+            }
+
+            /**
+             * This class allows to write a binary image file section by section.
+             * Every section is aligned to BINARY_IMAGE_ALIGNMENT bytes so that
+             * the image can be memory mapped and the data used in place.
+             */
+            class binary_image_writer {
+            public:
+
+                /**
+                 * The basic constructor
+                 * @param file_name the name of the image file to create
+                 */
+                binary_image_writer(const string & file_name)
+                : m_file_name(file_name), m_file(file_name, ios::out | ios::binary | ios::trunc), m_offset(0) {
+                    ASSERT_CONDITION_THROW(!m_file.is_open(), string("Could not create the binary image file: ") + file_name);
+                }
+
+                /**
+                 * The basic destructor
+                 */
+                virtual ~binary_image_writer() {
+                    close();
+                }
+
+                /**
+                 * Allows to write a single plain value into the image, the value is aligned
+                 * @param value the value to write
+                 */
+                template<typename value_type>
+                inline void write(const value_type & value) {
+                    write_array(&value, 1);
+                }
+
+                /**
+                 * Allows to write an array of plain values into the image, the array is aligned
+                 * @param values the pointer to the first array element
+                 * @param num_values the number of array elements
+                 */
+                template<typename value_type>
+                inline void write_array(const value_type * values, const size_t num_values) {
+                    align();
+                    const size_t num_bytes = num_values * sizeof (value_type);
+                    m_file.write(reinterpret_cast<const char *> (values), num_bytes);
+                    ASSERT_CONDITION_THROW(!m_file.good(), string("Failed writing into the binary image file: ") + m_file_name);
+                    m_offset += num_bytes;
+                }
+
+                /**
+                 * Allows to write a string into the image, the length goes first
+                 * @param str the string to write
+                 */
+                inline void write_string(const string & str) {
+                    write<uint64_t>(str.length());
+                    write_array(str.c_str(), str.length());
+                }
+
+                /**
+                 * Allows to get the number of bytes written so far
+                 * @return the number of bytes written so far
+                 */
+                inline size_t get_size() const {
+                    return m_offset;
+                }
+
+                /**
+                 * Allows to flush and close the image file
+                 */
+                inline void close() {
+                    if (m_file.is_open()) {
+                        m_file.close();
+                    }
+                }
+
+            private:
+                //Stores the image file name
+                const string m_file_name;
+                //Stores the output file stream
+                ofstream m_file;
+                //Stores the number of bytes written so far
+                size_t m_offset;
+
+                /**
+                 * Pads the file with zeros up to the next aligned offset
+                 */
+                inline void align() {
+                    static const char ZEROS[BINARY_IMAGE_ALIGNMENT] = {};
+                    const size_t rem = m_offset % BINARY_IMAGE_ALIGNMENT;
+                    if (rem != 0) {
+                        m_file.write(ZEROS, BINARY_IMAGE_ALIGNMENT - rem);
+                        m_offset += BINARY_IMAGE_ALIGNMENT - rem;
+                    }
+                }
+            };
+
+            /**
+             * This class allows to memory map a binary image file, written with
+             * binary_image_writer, and to read its sections in place. The file is
+             * mapped read-only and shared, so its pages are loaded lazily and are
+             * shared between all processes mapping the same image.
+             */
+            class binary_image_reader {
+            public:
+
+                /**
+                 * The basic constructor
+                 */
+                binary_image_reader() : m_begin_ptr(NULL), m_length(0), m_offset(0) {
+                }
+
+                /**
+                 * The basic destructor
+                 */
+                virtual ~binary_image_reader() {
+                    close();
+                }
+
+                /**
+                 * Allows to map the given image file into memory
+                 * @param file_name the image file name
+                 */
+                inline void open(const string & file_name) {
+                    ASSERT_CONDITION_THROW((m_begin_ptr != NULL), "The binary image is already open!");
+
+                    const int file_desc = ::open(file_name.c_str(), O_RDONLY);
+                    ASSERT_CONDITION_THROW((file_desc == -1), string("Could not open the binary image file: ") + file_name);
+
+                    errno = 0;
+                    struct stat file_stat;
+                    if (fstat(file_desc, &file_stat) < 0) {
+                        ::close(file_desc);
+                        THROW_EXCEPTION(string("Could not get the binary image file '") +
+                                file_name + string("' statistics: ") + strerror(errno));
+                    }
+                    m_length = file_stat.st_size;
+
+                    //Map the file as shared and read-only, no pre-faulting, the pages are loaded on demand
+                    void * begin_ptr = mmap(NULL, m_length, PROT_READ, MAP_SHARED, file_desc, 0);
+                    //The descriptor is not needed any more, the mapping stays valid
+                    ::close(file_desc);
+                    ASSERT_CONDITION_THROW((begin_ptr == MAP_FAILED), string("Could not memory map the binary image file '") +
+                            file_name + string("': ") + strerror(errno));
+
+                    m_begin_ptr = static_cast<const uint8_t *> (begin_ptr);
+                    m_offset = 0;
+
+                    LOG_INFO << "Mapped the binary image '" << file_name << "' size: " << SSTR(m_length) << " bytes." << END_LOG;
+                }
+
+                /**
+                 * Allows to check if the image is mapped
+                 * @return true if the image is mapped, otherwise false
+                 */
+                inline bool is_open() const {
+                    return (m_begin_ptr != NULL);
+                }
+
+                /**
+                 * Allows to read a single plain value from the image
+                 * @return the reference to the value inside the mapped image
+                 */
+                template<typename value_type>
+                inline const value_type & read() {
+                    return *read_array<value_type>(1);
+                }
+
+                /**
+                 * Allows to read an array of plain values from the image
+                 * @param num_values the number of array elements
+                 * @return the pointer to the first array element inside the mapped image
+                 */
+                template<typename value_type>
+                inline const value_type * read_array(const size_t num_values) {
+                    align();
+                    const size_t num_bytes = num_values * sizeof (value_type);
+                    ASSERT_CONDITION_THROW((m_offset + num_bytes > m_length),
+                            string("The binary image is truncated, need ") + to_string(num_bytes) +
+                            string(" bytes at offset ") + to_string(m_offset) +
+                            string(" with the image size ") + to_string(m_length));
+                    const value_type * ptr = reinterpret_cast<const value_type *> (m_begin_ptr + m_offset);
+                    m_offset += num_bytes;
+                    return ptr;
+                }
+
+                /**
+                 * Allows to read a single plain value from the image and to check it against
+                 * the expected value, e.g. the model parameter the image was built with.
+                 * @param expected the expected value
+                 * @param name the value name to be reported if the values differ
+                 */
+                template<typename value_type>
+                inline void read_check(const value_type expected, const string & name) {
+                    const value_type value = read<value_type>();
+                    ASSERT_CONDITION_THROW((value != expected), string("The binary image is built with ") +
+                            name + string(" = ") + to_string(value) + string(", configured: ") +
+                            to_string(expected) + string(", re-create the image!"));
+                }
+
+                /**
+                 * Allows to read an array of plain values from the image and to check it
+                 * against the expected values, e.g. the model weights the image was built with.
+                 * @param expected the expected values
+                 * @param num_values the number of array elements
+                 * @param name the array name to be reported if the values differ
+                 */
+                template<typename value_type>
+                inline void read_check_array(const value_type * expected, const size_t num_values, const string & name) {
+                    const value_type * values = read_array<value_type>(num_values);
+                    for (size_t idx = 0; idx < num_values; ++idx) {
+                        ASSERT_CONDITION_THROW((values[idx] != expected[idx]), string("The binary image is built with ") +
+                                name + string("[") + to_string(idx) + string("] = ") + to_string(values[idx]) +
+                                string(", configured: ") + to_string(expected[idx]) + string(", re-create the image!"));
+                    }
+                }
+
+                /**
+                 * Allows to read a string from the image, the length goes first
+                 * @return the copy of the read string
+                 */
+                inline string read_string() {
+                    const uint64_t length = read<uint64_t>();
+                    return string(read_array<char>(length), length);
+                }
+
+                /**
+                 * Allows to unmap the image
+                 */
+                inline void close() {
+                    if (m_begin_ptr != NULL) {
+                        munmap(const_cast<uint8_t *> (m_begin_ptr), m_length);
+                        m_begin_ptr = NULL;
+                        m_length = 0;
+                        m_offset = 0;
+                    }
+                }
+
+            private:
+                //Stores the pointer to the mapped image
+                const uint8_t * m_begin_ptr;
+                //Stores the mapped image length
+                size_t m_length;
+                //Stores the current read offset
+                size_t m_offset;
+
+                /**
+                 * Skips the padding up to the next aligned offset
+                 */
+                inline void align() {
+                    const size_t rem = m_offset % BINARY_IMAGE_ALIGNMENT;
+                    if (rem != 0) {
+                        m_offset += BINARY_IMAGE_ALIGNMENT - rem;
+                    }
+                }
+            };
+        }
+    }
+}
+
+#endif /* BINARY_IMAGE_HPP */
+
@@ -28,6 +28,7 @@
 
 #include <string>     // std::string
 #include <cmath>      // std::floor, std::sqrt
+#include <cstring>    // std::memcpy
 #include <stdint.h>   // srd::uint32_t
 
 #include "common/utils/logging/logger.hpp"
@@ -560,6 +561,33 @@ namespace uva {
 
             /*****************************************************************************************************/
 
+            /**
+             * Allows to mix a single 64 bit value into the given hash, the value
+             * is taken by value so no memory is read through an alien pointer type.
+             * @param hash the hash value to mix the value into
+             * @param value the value to be mixed in
+             * @return the resulting hash value
+             */
+            static inline uint_fast64_t mix_value_hash(const uint_fast64_t hash, uint_fast64_t value) {
+                value ^= hash + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+                return mix_fasthash(value);
+            }
+
+            /**
+             * Allows to mix a single float value into the given hash, the bits
+             * of the float are copied into an integer to avoid type punning.
+             * @param hash the hash value to mix the value into
+             * @param value the value to be mixed in
+             * @return the resulting hash value
+             */
+            static inline uint_fast64_t mix_value_hash(const uint_fast64_t hash, const float value) {
+                uint32_t bits = 0;
+                memcpy(&bits, &value, sizeof (bits));
+                return mix_value_hash(hash, static_cast<uint_fast64_t> (bits));
+            }
+
+            /*****************************************************************************************************/
+
             /**
              * The function used to compute hash in the application, uses one of the specific hashing functions above.
              * @param data the data to hash
@@ -0,0 +1,378 @@
+/*
+ * File:   async_log_sink.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 17, 2026, 7:45 PM
+ */
+
+#ifndef ASYNC_LOG_SINK_HPP
+#define ASYNC_LOG_SINK_HPP
+
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <iostream>
+#include <condition_variable>
+
+using namespace std;
+
+namespace uva {
+    namespace utils {
+        namespace logging {
+
+            //Defines the period, in milliseconds, of writing out the buffered log lines
+#define LOG_FLUSH_PERIOD_MSEC 20
+
+            /**
+             * This class represents the output sink of the finished log lines. By default the
+             * lines are written to the standard output right away, under a lock. Once started,
+             * the sink is asynchronous: each thread puts its lines into its own bounded ring
+             * buffer without any locking, and a background thread periodically writes the
+             * buffered lines out. If a thread's buffer is full the line is dropped and counted,
+             * the number of dropped lines is reported into the log. The lines longer than the
+             * buffer are written out right away, after the buffered ones. The lines of one thread
+             * keep their order, the lines of different threads are written buffer by buffer.
+             * This class is thread safe.
+             */
+            class async_log_sink {
+            public:
+
+                /**
+                 * Allows to get the sink instance
+                 * @return the sink instance
+                 */
+                static inline async_log_sink & get() {
+                    static async_log_sink sink;
+                    return sink;
+                }
+
+                /**
+                 * The basic destructor, writes out the buffered lines
+                 */
+                ~async_log_sink() {
+                    stop();
+                }
+
+                /**
+                 * Allows to make the sink asynchronous, if not yet
+                 * @param buffer_size the per thread buffer size in bytes, rounded up to a power of two
+                 */
+                inline void start(const size_t buffer_size) {
+                    unique_lock<mutex> guard(m_out_mutex);
+
+                    if (!m_is_async && (buffer_size > 0)) {
+                        m_buffer_size = 1;
+                        while (m_buffer_size < buffer_size) {
+                            m_buffer_size <<= 1;
+                        }
+                        m_is_stop = false;
+                        m_flusher = thread(&async_log_sink::flusher_loop, this);
+                        m_is_async = true;
+                    }
+                }
+
+                /**
+                 * Allows to make the sink synchronous again, writes out the buffered lines
+                 */
+                inline void stop() {
+                    {
+                        unique_lock<mutex> guard(m_out_mutex);
+                        if (!m_is_async) {
+                            return;
+                        }
+                        m_is_async = false;
+                        m_is_stop = true;
+                    }
+                    m_flush_cond.notify_one();
+                    m_flusher.join();
+
+                    //Write out whatever has been buffered since the last flush
+                    flush();
+                }
+
+                /**
+                 * Allows to write out all the buffered lines, blocks until done
+                 */
+                inline void flush() {
+                    unique_lock<mutex> guard(m_out_mutex);
+                    write_buffered();
+                }
+
+                /**
+                 * Allows to output the finished log line
+                 * @param line the log line including the end of line
+                 */
+                inline void write(const string & line) {
+                    if (m_is_async) {
+                        //Get the thread's buffer, register a new one if this is its first line
+                        static thread_local ring_holder holder;
+                        if (!holder.m_ring || (holder.m_ring->m_capacity != m_buffer_size)) {
+                            holder.reset(make_shared<log_ring>(m_buffer_size));
+                            unique_lock<mutex> guard(m_rings_mutex);
+                            m_rings.push_back(holder.m_ring);
+                        }
+                        if (line.length() > holder.m_ring->m_capacity) {
+                            //The line would never fit, write it out after the buffered ones
+                            unique_lock<mutex> guard(m_out_mutex);
+                            write_buffered();
+                            write_out(line);
+                        } else if (holder.m_ring->push(line.c_str(), line.length())) {
+                            //Wake up the flusher early if the buffer is getting full
+                            if (holder.m_ring->is_half_full()) {
+                                m_flush_cond.notify_one();
+                            }
+                        } else {
+                            m_num_dropped.fetch_add(1, memory_order_relaxed);
+                        }
+                    } else {
+                        unique_lock<mutex> guard(m_out_mutex);
+                        write_out(line);
+                    }
+                }
+
+                /**
+                 * Allows to get the number of the dropped log lines
+                 * @return the number of the lines dropped as the buffers were full
+                 */
+                inline uint64_t get_num_dropped() const {
+                    return m_num_dropped.load(memory_order_relaxed);
+                }
+
+            private:
+
+                /**
+                 * This structure represents a single producer single consumer ring
+                 * buffer of the log lines of a thread. The buffer only stores whole lines.
+                 */
+                struct log_ring {
+                    //Stores the buffer capacity, a power of two
+                    const size_t m_capacity;
+                    //Stores the buffer data
+                    char * m_data;
+                    //Stores the total number of bytes written, only changed by the owner thread
+                    atomic<size_t> m_head;
+                    //Stores the total number of bytes read, only changed by the flusher
+                    atomic<size_t> m_tail;
+                    //Stores the flag indicating that the owner thread has finished
+                    atomic<bool> m_is_dead;
+
+                    /**
+                     * The basic constructor
+                     * @param capacity the buffer capacity, a power of two
+                     */
+                    log_ring(const size_t capacity)
+                    : m_capacity(capacity), m_data(new char[capacity]),
+                    m_head(0), m_tail(0), m_is_dead(false) {
+                    }
+
+                    /**
+                     * The basic destructor
+                     */
+                    ~log_ring() {
+                        delete[] m_data;
+                    }
+
+                    /**
+                     * Allows to add a line into the buffer, called by the owner thread only
+                     * @param data the line characters
+                     * @param length the number of line characters
+                     * @return true if the line was added, false if there is not enough space
+                     */
+                    inline bool push(const char * data, const size_t length) {
+                        const size_t head = m_head.load(memory_order_relaxed);
+                        const size_t tail = m_tail.load(memory_order_acquire);
+                        if (length > m_capacity - (head - tail)) {
+                            return false;
+                        }
+                        copy_in(head, data, length);
+                        m_head.store(head + length, memory_order_release);
+                        return true;
+                    }
+
+                    /**
+                     * Allows to check if at least half of the buffer is used, called by the owner thread only
+                     * @return true if at least half of the buffer is used, otherwise false
+                     */
+                    inline bool is_half_full() const {
+                        return (m_head.load(memory_order_relaxed) - m_tail.load(memory_order_relaxed)) >= (m_capacity / 2);
+                    }
+
+                    /**
+                     * Allows to take all the buffered lines, called by the flusher only
+                     * @param out the string to append the lines to
+                     */
+                    inline void pop(string & out) {
+                        const size_t tail = m_tail.load(memory_order_relaxed);
+                        const size_t head = m_head.load(memory_order_acquire);
+                        if (head != tail) {
+                            const size_t begin = tail & (m_capacity - 1);
+                            const size_t first = min(head - tail, m_capacity - begin);
+                            out.append(m_data + begin, first);
+                            out.append(m_data, (head - tail) - first);
+                            m_tail.store(head, memory_order_release);
+                        }
+                    }
+
+                private:
+
+                    /**
+                     * Allows to copy the data into the buffer, wrapping around its end
+                     * @param head the total number of bytes written so far
+                     * @param data the data to copy
+                     * @param length the data length
+                     */
+                    inline void copy_in(const size_t head, const char * data, const size_t length) {
+                        const size_t begin = head & (m_capacity - 1);
+                        const size_t first = min(length, m_capacity - begin);
+                        memcpy(m_data + begin, data, first);
+                        memcpy(m_data, data + first, length - first);
+                    }
+                };
+
+                //Typedef the shared pointer to the ring buffer
+                typedef shared_ptr<log_ring> log_ring_ptr;
+
+                /**
+                 * This structure is the thread local holder of the thread's buffer,
+                 * it marks the buffer as dead once the thread has finished.
+                 */
+                struct ring_holder {
+                    //Stores the thread's buffer
+                    log_ring_ptr m_ring;
+
+                    /**
+                     * Allows to replace the buffer, the old one is marked as dead
+                     * @param ring the new buffer
+                     */
+                    inline void reset(const log_ring_ptr & ring) {
+                        if (m_ring) {
+                            m_ring->m_is_dead = true;
+                        }
+                        m_ring = ring;
+                    }
+
+                    /**
+                     * The basic destructor
+                     */
+                    ~ring_holder() {
+                        reset(log_ring_ptr());
+                    }
+                };
+
+                /**
+                 * The basic constructor
+                 */
+                async_log_sink()
+                : m_out_mutex(), m_is_async(false), m_is_stop(false), m_buffer_size(0),
+                m_flusher(), m_flush_cond(), m_rings_mutex(), m_rings(),
+                m_num_dropped(0), m_num_reported(0), m_out_buf() {
+                }
+
+                /**
+                 * Periodically writes out the buffered lines until the sink is stopped
+                 */
+                inline void flusher_loop() {
+                    unique_lock<mutex> guard(m_out_mutex);
+                    while (!m_is_stop) {
+                        m_flush_cond.wait_for(guard, chrono::milliseconds(LOG_FLUSH_PERIOD_MSEC));
+                        write_buffered();
+                    }
+                }
+
+                /**
+                 * Writes out the buffered lines and removes the buffers of the finished threads.
+                 * Must be called under the output lock, which makes it the only consumer.
+                 */
+                inline void write_buffered() {
+                    //Get the current buffers, the dead ones are removed after being emptied
+                    vector<log_ring_ptr> rings;
+                    {
+                        unique_lock<mutex> guard(m_rings_mutex);
+                        rings = m_rings;
+                        for (auto iter = m_rings.begin(); iter != m_rings.end();) {
+                            if ((*iter)->m_is_dead) {
+                                iter = m_rings.erase(iter);
+                            } else {
+                                ++iter;
+                            }
+                        }
+                    }
+
+                    m_out_buf.clear();
+                    for (auto iter = rings.begin(); iter != rings.end(); ++iter) {
+                        (*iter)->pop(m_out_buf);
+                    }
+
+                    //Report the newly dropped lines, if any
+                    const uint64_t num_dropped = get_num_dropped();
+                    if (num_dropped != m_num_reported) {
+                        m_out_buf += string("WARN: ") + to_string(num_dropped - m_num_reported) +
+                                string(" log line(s) dropped, the log buffer is full!\n");
+                        m_num_reported = num_dropped;
+                    }
+
+                    if (!m_out_buf.empty()) {
+                        write_out(m_out_buf);
+                    }
+                }
+
+                /**
+                 * Writes the text into the standard output, must be called under the output lock
+                 * @param text the text to write
+                 */
+                static inline void write_out(const string & text) {
+                    cout.write(text.c_str(), text.length());
+                    cout.flush();
+                }
+
+                //Stores the mutex of the output and of the buffers' consumer side
+                mutex m_out_mutex;
+                //Stores the flag indicating whether the sink is asynchronous
+                atomic<bool> m_is_async;
+                //Stores the flag indicating whether the flusher is to stop
+                bool m_is_stop;
+                //Stores the per thread buffer size in bytes
+                size_t m_buffer_size;
+                //Stores the thread writing out the buffered lines
+                thread m_flusher;
+                //Stores the condition variable to wake up the flusher
+                condition_variable m_flush_cond;
+                //Stores the mutex of the buffers list
+                mutex m_rings_mutex;
+                //Stores the buffers of the threads
+                vector<log_ring_ptr> m_rings;
+                //Stores the number of dropped lines
+                atomic<uint64_t> m_num_dropped;
+                //Stores the number of dropped lines reported so far
+                uint64_t m_num_reported;
+                //Stores the output buffer of the flusher
+                string m_out_buf;
+            };
+        }
+    }
+}
+
+#endif /* ASYNC_LOG_SINK_HPP */
@@ -36,6 +36,9 @@
 #include <time.h>    // std::clock std::clock_t
 #include <algorithm> //std::transform
 #include <string.h>
+#include <type_traits>
+
+#include "common/utils/logging/async_log_sink.hpp"
 
 using namespace std;
 
@@ -59,18 +62,199 @@ namespace uva {
             //Defines the log level from which the detailed timing info is available
             static constexpr debug_levels_enum PROGRESS_ACTIVE_LEVEL = INFO1;
             
+            //The maximum logging levels of the sub-systems, can be lowered at compile time
+            //to compile out the more detailed logging, e.g. -DLOG_MAX_LEVEL_SERVER=USAGE
+#ifndef LOG_MAX_LEVEL_SERVER
+#define LOG_MAX_LEVEL_SERVER INFO3
+#endif
+#ifndef LOG_MAX_LEVEL_BALANCER
+#define LOG_MAX_LEVEL_BALANCER INFO3
+#endif
+#ifndef LOG_MAX_LEVEL_PROCESSOR
+#define LOG_MAX_LEVEL_PROCESSOR INFO3
+#endif
+#ifndef LOG_MAX_LEVEL_CLIENT
+#define LOG_MAX_LEVEL_CLIENT INFO3
+#endif
+#ifndef LOG_MAX_LEVEL_COMMON
+#define LOG_MAX_LEVEL_COMMON INFO3
+#endif
+            
+            //The source tree root folder, with the trailing slash, is set by the build
+            //to be stripped from the source file paths before getting their sub-systems
+#ifndef LOG_SOURCE_ROOT
+#define LOG_SOURCE_ROOT ""
+#endif
+            
+            /**
+             * Allows to check if the string begins with the given prefix, at compile time
+             * @param str the string to check
+             * @param prefix the prefix to check for
+             * @return true if the string begins with the prefix, otherwise false
+             */
+            constexpr bool is_log_path_prefix(const char * str, const char * prefix) {
+                return (*prefix == '\0') || ((*str == *prefix) && is_log_path_prefix(str + 1, prefix + 1));
+            }
+            
             /**
-             * This structures stores the recursive synchronization mutex for logging.
-             * The mutex is to be recursive as functions called when logging can do the own logging.
+             * Allows to check if the string begins with the given prefix of the known length, at
+             * compile time. The halves are compared recursively, so the recursion depth is only
+             * logarithmic in the prefix length, the characters are still compared left to right.
+             * @param str the string to check
+             * @param prefix the prefix to check for
+             * @param len the prefix length
+             * @return true if the string begins with the prefix, otherwise false
              */
-            struct logging_synch {
-                //Define the recursive lock quard
-                typedef lock_guard<recursive_mutex> rec_scoped_lock;
-                //The recursive mutex to be used for logging
-                static inline recursive_mutex & m_mv() {
-                    static recursive_mutex mv;
-                    return mv;
+            constexpr bool is_log_path_equal(const char * str, const char * prefix, const size_t len) {
+                return (len == 0) || ((len == 1) ? (*str == *prefix) :
+                        (is_log_path_equal(str, prefix, len / 2) &&
+                        is_log_path_equal(str + len / 2, prefix + len / 2, len - len / 2)));
+            }
+            
+            /**
+             * Allows to get the smaller of the two logging levels, at compile time
+             * @param first the first level
+             * @param second the second level
+             * @return the smaller level
+             */
+            constexpr debug_levels_enum min_log_level(const debug_levels_enum first, const debug_levels_enum second) {
+                return (first < second) ? first : second;
+            }
+            
+            /**
+             * Allows to get the maximum logging level of the sub-system the source file belongs to,
+             * at compile time. The sub-system is defined by the file's folder in the source tree.
+             * @param path the source file path relative to the source tree root, or NULL if the
+             *             file is not within the source tree, then there is no sub-system limit
+             * @return the maximum logging level of the file
+             */
+            constexpr debug_levels_enum get_rel_file_max_level(const char * path) {
+                return (path == NULL) ? MAXIMUM_LOGGING_LEVEL :
+                        ((is_log_path_prefix(path, "inc/server/") || is_log_path_prefix(path, "src/server/")) ?
+                        min_log_level(MAXIMUM_LOGGING_LEVEL, debug_levels_enum::LOG_MAX_LEVEL_SERVER) :
+                        ((is_log_path_prefix(path, "inc/balancer/") || is_log_path_prefix(path, "src/balancer/")) ?
+                        min_log_level(MAXIMUM_LOGGING_LEVEL, debug_levels_enum::LOG_MAX_LEVEL_BALANCER) :
+                        ((is_log_path_prefix(path, "inc/processor/") || is_log_path_prefix(path, "src/processor/")) ?
+                        min_log_level(MAXIMUM_LOGGING_LEVEL, debug_levels_enum::LOG_MAX_LEVEL_PROCESSOR) :
+                        ((is_log_path_prefix(path, "inc/client/") || is_log_path_prefix(path, "src/client/")) ?
+                        min_log_level(MAXIMUM_LOGGING_LEVEL, debug_levels_enum::LOG_MAX_LEVEL_CLIENT) :
+                        ((is_log_path_prefix(path, "inc/common/") || is_log_path_prefix(path, "src/common/")) ?
+                        min_log_level(MAXIMUM_LOGGING_LEVEL, debug_levels_enum::LOG_MAX_LEVEL_COMMON) :
+                        MAXIMUM_LOGGING_LEVEL)))));
+            }
+            
+            /**
+             * Allows to get the maximum logging level of the source file, at compile time. Only the
+             * source tree root is stripped from the path, so the folder names elsewhere in the path
+             * do not define the sub-system.
+             * @param path the source file path, as given by __FILE__
+             * @return the maximum logging level of the file
+             */
+            constexpr debug_levels_enum get_file_max_level(const char * path) {
+                return get_rel_file_max_level(is_log_path_equal(path, LOG_SOURCE_ROOT, sizeof (LOG_SOURCE_ROOT) - 1) ?
+                        (path + sizeof (LOG_SOURCE_ROOT) - 1) : NULL);
+            }
+            
+            /**
+             * This class represents a log line being written. The line is formatted into the
+             * thread's line buffer, without any locking, and is given to the log sink once done.
+             * If the thread is already writing a log line, e.g. as a function called when
+             * logging does its own logging, then a new line buffer is used.
+             */
+            class log_line {
+            public:
+                
+                /**
+                 * The basic constructor
+                 * @param level the log level of the line
+                 */
+                inline log_line(debug_levels_enum level);
+                
+                /**
+                 * The constructor for the lines with the source code location
+                 * @param level the log level of the line
+                 * @param file the file name from which the logging was called
+                 * @param func the function from which the logging was called
+                 * @param line the line of code from which the logging was called
+                 */
+                inline log_line(debug_levels_enum level, const char * file, const char * func, const char * line);
+                
+                /**
+                 * The basic destructor, gives the line to the log sink
+                 */
+                ~log_line() {
+                    async_log_sink::get().write(m_buf->m_buf.m_text);
+                    if (m_is_own) {
+                        delete m_buf;
+                    } else {
+                        m_buf->m_buf.m_text.clear();
+                        m_buf->m_is_busy = false;
+                    }
+                }
+                
+                /**
+                 * Allows to get the line's output stream
+                 * @return the output stream
+                 */
+                inline std::ostream & get() {
+                    return m_buf->m_stream;
+                }
+                
+            private:
+                
+                /**
+                 * This class is the stream buffer appending the output to a string
+                 */
+                struct line_stream_buf : public streambuf {
+                    //Stores the line text
+                    string m_text;
+                    
+                    virtual int_type overflow(int_type ch) {
+                        if (ch != traits_type::eof()) {
+                            m_text.push_back(traits_type::to_char_type(ch));
+                        }
+                        return ch;
+                    }
+                    
+                    virtual streamsize xsputn(const char * data, streamsize length) {
+                        m_text.append(data, length);
+                        return length;
+                    }
+                };
+                
+                /**
+                 * This structure stores the line buffer and its output stream
+                 */
+                struct line_buffer {
+                    //Stores the stream buffer
+                    line_stream_buf m_buf;
+                    //Stores the output stream
+                    std::ostream m_stream;
+                    //Stores the flag indicating whether the buffer is in use
+                    bool m_is_busy;
+                    
+                    line_buffer() : m_buf(), m_stream(&m_buf), m_is_busy(false) {
+                    }
+                };
+                
+                /**
+                 * Allows to take the thread's line buffer or a new one if it is in use
+                 */
+                inline void take_buffer() {
+                    static thread_local line_buffer buffer;
+                    m_is_own = buffer.m_is_busy;
+                    if (m_is_own) {
+                        m_buf = new line_buffer();
+                    } else {
+                        m_buf = &buffer;
+                    }
+                    m_buf->m_is_busy = true;
                 }
+                
+                //Stores the line buffer
+                line_buffer * m_buf;
+                //Stores the flag indicating whether the line buffer is to be deleted
+                bool m_is_own;
             };
             
             //This Macro is used to convert numerival values to proper strings!
@@ -84,26 +268,30 @@ namespace uva {
             //Defines the progress bar update period in CPU seconds
 #define PROGRESS_UPDATE_PERIOD 0.05
             
+            //The maximum logging level of the current source file, is a compile time constant
+#define FILE_MAX_LOGGING_LEVEL \
+std::integral_constant<debug_levels_enum, get_file_max_level(__FILE__)>::value
+            
 #define LOGGER(level)                                               \
-if (level > MAXIMUM_LOGGING_LEVEL) ;                             \
+if (level > FILE_MAX_LOGGING_LEVEL) ;                            \
 else if (level > logger::get_reporting_level()) ;                 \
 else {                                                       \
-logging_synch::rec_scoped_lock lock(logging_synch::m_mv()); \
-logger::get(level)
+log_line log_line_obj(level);                               \
+log_line_obj.get()
             
 #define __FILENAME__ (strrchr(__FILE__, '/') ? strrchr(__FILE__, '/') + 1 : __FILE__)
             
 #define LOGGER_DEBUG(level)                                             \
-if (level > MAXIMUM_LOGGING_LEVEL) ;                                 \
+if (level > FILE_MAX_LOGGING_LEVEL) ;                                \
 else if (level > logger::get_reporting_level()) ;                     \
 else {                                                           \
-logging_synch::rec_scoped_lock lock(logging_synch::m_mv());     \
-logger::get(level, __FILENAME__, __FUNCTION__, LINE_STRING)
+log_line log_line_obj(level, __FILENAME__, __FUNCTION__, LINE_STRING); \
+log_line_obj.get()
             
             //The Macro commands to be used for logging data with different log levels,
             //For example, to log a warning one can use:
             //      LOG_WARNING << "This is a warning message!" << END_LOG;
-            //Here, the END_LOG is optional and is currently used for a new line only.
+            //Here, the END_LOG is compulsory as it ends the line and gives it to the log sink.
 #define LOG_ERROR   LOGGER_DEBUG(debug_levels_enum::ERROR)
 #define LOG_WARNING LOGGER(debug_levels_enum::WARNING)
 #define LOG_USAGE   LOGGER(debug_levels_enum::USAGE)
@@ -118,7 +306,7 @@ logger::get(level, __FILENAME__, __FUNCTION__, LINE_STRING)
 #define LOG_DEBUG3  LOGGER_DEBUG(debug_levels_enum::DEBUG3)
 #define LOG_DEBUG4  LOGGER_DEBUG(debug_levels_enum::DEBUG4)
             
-#define END_LOG     endl << flush; \
+#define END_LOG     '\n'; \
 }
             
             
@@ -245,25 +433,36 @@ logger::get(level, __FILENAME__, __FUNCTION__, LINE_STRING)
                 }
                 
                 /**
-                 * This methods allows to get the output stream for the given log-level
-                 * @param level the log level for the messages to print
-                 * @return the output stream object
+                 * This methods allows to get the string of the given log-level
+                 * @param level the log level
+                 * @return the log level string
                  */
-                static inline std::ostream& get(debug_levels_enum level) {
-                    return cout << m_debug_level_str()[level] << ":" << WHITE_SPACE_SEPARATOR;
+                static inline const string & get_level_str(debug_levels_enum level) {
+                    return m_debug_level_str()[level];
                 }
                 
                 /**
-                 * This methods allows to get the output stream for the given log-level
-                 * @param level the log level for the messages to print
-                 * @param file the file name from which the logging was called
-                 * @param func the function from which the logging was called
-                 * @param line the line of code from which the logging was called
-                 * @return the output stream object
+                 * Allows to make the logging asynchronous, i.e. the log lines are buffered per
+                 * thread and are written out by a background thread. Until then, and after the
+                 * stop_async is called, the log lines are written out right away.
+                 * @param buffer_size the per thread log buffer size in bytes, 0 for no buffering
                  */
-                static inline std::ostream& get(debug_levels_enum level, const char * file, const char * func, const char * line) {
-                    return cout << m_debug_level_str()[level] << WHITE_SPACE_SEPARATOR << "<"
-                    << file << "::" << func << "(...):" << line << ">:" << WHITE_SPACE_SEPARATOR;
+                static inline void start_async(const size_t buffer_size) {
+                    async_log_sink::get().start(buffer_size);
+                }
+                
+                /**
+                 * Allows to make the logging synchronous again, writes out the buffered lines
+                 */
+                static inline void stop_async() {
+                    async_log_sink::get().stop();
+                }
+                
+                /**
+                 * Allows to write out the buffered log lines, e.g. before writing to the console directly
+                 */
+                static inline void flush() {
+                    async_log_sink::get().flush();
                 }
                 
                 /**
@@ -308,6 +507,9 @@ logger::get(level, __FILENAME__, __FUNCTION__, LINE_STRING)
                             << WHITE_SPACE_SEPARATOR << msg << ":" << WHITE_SPACE_SEPARATOR;
                             m_prefix() = pref.str();
                             
+                            //Write out the buffered log lines first
+                            flush();
+                            
                             //Output the time string
                             cout << compute_time_string(m_begin_time(), m_time_str_len());
                             cout.flush();
@@ -474,6 +676,17 @@ logger::get(level, __FILENAME__, __FUNCTION__, LINE_STRING)
                 }
                 
             };
+            
+            log_line::log_line(debug_levels_enum level) {
+                take_buffer();
+                m_buf->m_stream << logger::get_level_str(level) << ":" << WHITE_SPACE_SEPARATOR;
+            }
+            
+            log_line::log_line(debug_levels_enum level, const char * file, const char * func, const char * line) {
+                take_buffer();
+                m_buf->m_stream << logger::get_level_str(level) << WHITE_SPACE_SEPARATOR << "<"
+                        << file << "::" << func << "(...):" << line << ">:" << WHITE_SPACE_SEPARATOR;
+            }
         }
     }
 }
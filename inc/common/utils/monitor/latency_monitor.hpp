@@ -0,0 +1,137 @@
+/*
+ * File:   latency_monitor.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 17, 2026, 3:25 PM
+ */
+
+#ifndef LATENCY_MONITOR_HPP
+#define LATENCY_MONITOR_HPP
+
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include "common/utils/exceptions.hpp"
+#include "common/utils/logging/logger.hpp"
+#include "common/utils/threads/threads.hpp"
+
+using namespace std;
+
+using namespace uva::utils::logging;
+using namespace uva::utils::exceptions;
+using namespace uva::utils::threads;
+
+namespace uva {
+    namespace utils {
+        namespace monitor {
+
+            /**
+             * This class allows to keep track of the latencies of the last
+             * finished requests and to report their percentiles. The latencies
+             * are stored in a ring buffer of a fixed capacity so that the
+             * report reflects the recent server load. This class is thread safe.
+             */
+            class latency_monitor {
+            public:
+
+                /**
+                 * The basic constructor
+                 * @param capacity the number of the last latencies to keep track of
+                 */
+                latency_monitor(const size_t capacity)
+                : m_capacity(capacity), m_mutex(), m_latencies(), m_next_idx(0), m_num_total(0) {
+                    ASSERT_CONDITION_THROW((capacity == 0), "The latency monitor capacity must be positive!");
+                    m_latencies.reserve(capacity);
+                }
+
+                /**
+                 * Allows to add a new latency value
+                 * @param latency the latency in seconds
+                 */
+                inline void add(const double latency) {
+                    scoped_guard guard(m_mutex);
+
+                    if (m_latencies.size() < m_capacity) {
+                        m_latencies.push_back(latency);
+                    } else {
+                        m_latencies[m_next_idx] = latency;
+                        m_next_idx = (m_next_idx + 1) % m_latencies.size();
+                    }
+                    ++m_num_total;
+                }
+
+                /**
+                 * Allows to report the latency percentiles of the last requests
+                 * @param prefix the report prefix
+                 */
+                inline void report_run_time_info(const string & prefix) {
+                    vector<double> latencies;
+                    uint64_t num_total = 0;
+                    {
+                        scoped_guard guard(m_mutex);
+                        latencies = m_latencies;
+                        num_total = m_num_total;
+                    }
+
+                    LOG_USAGE << prefix << ":" << END_LOG;
+                    if (latencies.empty()) {
+                        LOG_USAGE << "\t#finished: 0" << END_LOG;
+                    } else {
+                        const double p50 = get_percentile(latencies, 50);
+                        const double p99 = get_percentile(latencies, 99);
+                        LOG_USAGE << "\t#finished: " << num_total << ", over the last "
+                                << latencies.size() << " p50: " << p50 << ", p99: "
+                                << p99 << " sec." << END_LOG;
+                    }
+                }
+
+            protected:
+
+                /**
+                 * Allows to get the given percentile of the values, re-orders the values
+                 * @param values the non-empty values
+                 * @param percent the percentile to get, from 0 to 100
+                 * @return the percentile value
+                 */
+                static inline double get_percentile(vector<double> & values, const size_t percent) {
+                    const size_t idx = ((values.size() - 1) * percent) / 100;
+                    nth_element(values.begin(), values.begin() + idx, values.end());
+                    return values[idx];
+                }
+
+            private:
+                //Stores the maximum number of latencies to keep
+                const size_t m_capacity;
+                //Stores the mutex for accessing the latencies
+                mutex m_mutex;
+                //Stores the ring buffer of the latencies
+                vector<double> m_latencies;
+                //Stores the index of the oldest latency once the buffer is full
+                size_t m_next_idx;
+                //Stores the total number of added latencies
+                uint64_t m_num_total;
+            };
+        }
+    }
+}
+
+#endif /* LATENCY_MONITOR_HPP */
@@ -0,0 +1,253 @@
+/*
+ * File:   fork_join_pool.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 16, 2026, 11:05 PM
+ */
+
+#ifndef FORK_JOIN_POOL_HPP
+#define FORK_JOIN_POOL_HPP
+
+#include <deque>
+#include <vector>
+#include <exception>
+#include <algorithm>
+#include <functional>
+
+#include "common/utils/logging/logger.hpp"
+#include "common/utils/exceptions.hpp"
+#include "common/utils/threads/threads.hpp"
+
+using namespace std;
+
+using namespace uva::utils::logging;
+using namespace uva::utils::exceptions;
+
+namespace uva {
+    namespace utils {
+        namespace threads {
+
+            /**
+             * This class represents a fork/join pool of helper threads. A job consisting
+             * of a number of independent parts is run by the calling thread together with
+             * the helper threads, the call returns once all the parts are finished. The
+             * calling thread always takes part in the job execution, so a job is finished
+             * even if all the helper threads are busy. The pool is shared, i.e. several
+             * threads can run their jobs at the same time. This class is thread safe.
+             */
+            class fork_join_pool {
+            public:
+                //Typedef the job part function, the argument is the part index
+                typedef function<void(const size_t) > part_function;
+
+                /**
+                 * The basic constructor
+                 * @param num_helpers the number of helper threads
+                 */
+                fork_join_pool(const size_t num_helpers)
+                : m_jobs(), m_mutex(), m_job_cond(), m_done_cond(), m_stop(false), m_threads() {
+                    for (size_t idx = 0; idx < num_helpers; ++idx) {
+                        m_threads.emplace_back(thread(&fork_join_pool::run_helper, this));
+                    }
+                }
+
+                /**
+                 * The basic destructor, stops and joins the helper threads
+                 */
+                virtual ~fork_join_pool() {
+                    {
+                        scoped_guard guard(m_mutex);
+                        m_stop = true;
+                    }
+                    m_job_cond.notify_all();
+                    for (auto & helper : m_threads) {
+                        helper.join();
+                    }
+                }
+
+                /**
+                 * Allows to get the number of threads that can execute a job, including the calling one
+                 * @return the number of helper threads plus one
+                 */
+                inline size_t get_num_threads() const {
+                    return m_threads.size() + 1;
+                }
+
+                /**
+                 * Allows to execute the given number of job parts, returns once all the parts are finished.
+                 * If a part throws then the first thrown exception is re-thrown by this method.
+                 * @param num_parts the number of job parts
+                 * @param func the part function to be called for every part index
+                 */
+                inline void run(const size_t num_parts, const part_function & func) {
+                    //There is nothing to be done for an empty job
+                    if (num_parts == 0) {
+                        return;
+                    }
+
+                    fork_join_job job(num_parts, func);
+
+                    //Make the job available to the helper threads
+                    {
+                        scoped_guard guard(m_mutex);
+                        m_jobs.push_back(&job);
+                    }
+                    m_job_cond.notify_all();
+
+                    //Execute the job parts until there is no more parts to claim
+                    size_t part_idx = 0;
+                    while (claim_part(job, part_idx)) {
+                        execute_part(job, part_idx);
+                    }
+
+                    //Wait until the parts claimed by the helpers are finished
+                    {
+                        unique_guard guard(m_mutex);
+                        m_done_cond.wait(guard, [&job] {
+                            return (job.m_num_done == job.m_num_parts);
+                        });
+                    }
+
+                    //Re-throw the part exception, if any
+                    if (job.m_error) {
+                        rethrow_exception(job.m_error);
+                    }
+                }
+
+            private:
+
+                /**
+                 * This structure stores the job being executed
+                 */
+                struct fork_join_job {
+
+                    /**
+                     * The basic constructor
+                     * @param num_parts the number of job parts
+                     * @param func the part function
+                     */
+                    fork_join_job(const size_t num_parts, const part_function & func)
+                    : m_num_parts(num_parts), m_func(func), m_next_part(0), m_num_done(0), m_error() {
+                    }
+
+                    //Stores the number of job parts
+                    const size_t m_num_parts;
+                    //Stores the part function
+                    const part_function & m_func;
+                    //Stores the next part to be claimed
+                    size_t m_next_part;
+                    //Stores the number of finished parts
+                    size_t m_num_done;
+                    //Stores the first exception thrown by a part
+                    exception_ptr m_error;
+                };
+
+                //Stores the jobs with parts to be claimed
+                deque<fork_join_job *> m_jobs;
+                //Stores the pool mutex
+                mutex m_mutex;
+                //Stores the condition for the helpers waiting for a job
+                condition_variable m_job_cond;
+                //Stores the condition for the callers waiting for a job to finish
+                condition_variable m_done_cond;
+                //Stores the stopping flag
+                bool m_stop;
+                //Stores the helper threads
+                vector<thread> m_threads;
+
+                /**
+                 * Allows to claim the next part of the given job
+                 * @param job the job to claim the part of
+                 * @param part_idx [out] the claimed part index
+                 * @return true if a part was claimed, false if there is no more parts
+                 */
+                inline bool claim_part(fork_join_job & job, size_t & part_idx) {
+                    scoped_guard guard(m_mutex);
+                    if (job.m_next_part < job.m_num_parts) {
+                        part_idx = job.m_next_part++;
+                        //Remove the fully claimed job from the queue
+                        if (job.m_next_part == job.m_num_parts) {
+                            m_jobs.erase(std::find(m_jobs.begin(), m_jobs.end(), &job));
+                        }
+                        return true;
+                    }
+                    return false;
+                }
+
+                /**
+                 * Allows to execute the given claimed job part
+                 * @param job the job to execute the part of
+                 * @param part_idx the claimed part index
+                 */
+                inline void execute_part(fork_join_job & job, const size_t part_idx) {
+                    exception_ptr error;
+                    try {
+                        job.m_func(part_idx);
+                    } catch (...) {
+                        error = current_exception();
+                    }
+
+                    //Mark the part as done, the job can not be used after that
+                    bool is_done = false;
+                    {
+                        scoped_guard guard(m_mutex);
+                        if (error && !job.m_error) {
+                            job.m_error = error;
+                        }
+                        is_done = (++job.m_num_done == job.m_num_parts);
+                    }
+                    if (is_done) {
+                        m_done_cond.notify_all();
+                    }
+                }
+
+                /**
+                 * The helper thread function, executes the parts of the queued jobs
+                 */
+                inline void run_helper() {
+                    while (true) {
+                        fork_join_job * job = NULL;
+                        size_t part_idx = 0;
+                        {
+                            unique_guard guard(m_mutex);
+                            m_job_cond.wait(guard, [this] {
+                                return m_stop || !m_jobs.empty();
+                            });
+                            if (m_stop) {
+                                return;
+                            }
+                            //Claim the next part of the first job
+                            job = m_jobs.front();
+                            part_idx = job->m_next_part++;
+                            if (job->m_next_part == job->m_num_parts) {
+                                m_jobs.pop_front();
+                            }
+                        }
+                        execute_part(*job, part_idx);
+                    }
+                }
+            };
+        }
+    }
+}
+
+#endif /* FORK_JOIN_POOL_HPP */
+
@@ -0,0 +1,190 @@
+/*
+ * File:   keyed_task_pool.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 17, 2026, 6:30 PM
+ */
+
+#ifndef KEYED_TASK_POOL_HPP
+#define KEYED_TASK_POOL_HPP
+
+#include <deque>
+#include <vector>
+#include <functional>
+
+#include "common/utils/logging/logger.hpp"
+#include "common/utils/exceptions.hpp"
+#include "common/utils/hashing_utils.hpp"
+#include "common/utils/threads/threads.hpp"
+
+using namespace std;
+
+using namespace uva::utils::logging;
+using namespace uva::utils::exceptions;
+using namespace uva::utils::hashing;
+
+namespace uva {
+    namespace utils {
+        namespace threads {
+
+            /**
+             * This class represents a pool of worker threads executing keyed tasks.
+             * Each worker has its own task queue and a task is always queued to the
+             * worker selected by the task key. Therefore the tasks with the same key
+             * are executed one after another in the order they were planned, and
+             * the tasks with different keys are likely to be executed in parallel.
+             * The task exceptions are logged and swallowed. This class is thread safe.
+             */
+            class keyed_task_pool {
+            public:
+                //Typedef the task function
+                typedef function<void() > task_function;
+
+                /**
+                 * The basic constructor
+                 * @param num_workers the number of worker threads, must be positive
+                 */
+                keyed_task_pool(const size_t num_workers)
+                : m_workers() {
+                    ASSERT_CONDITION_THROW((num_workers == 0),
+                            "The number of keyed task pool workers must be positive!");
+                    for (size_t idx = 0; idx < num_workers; ++idx) {
+                        m_workers.push_back(new pool_worker());
+                    }
+                    for (auto * worker : m_workers) {
+                        worker->m_thread = thread(&keyed_task_pool::run_worker, worker);
+                    }
+                }
+
+                /**
+                 * The basic destructor, stops and joins the worker threads
+                 */
+                virtual ~keyed_task_pool() {
+                    stop();
+                    for (auto * worker : m_workers) {
+                        delete worker;
+                    }
+                }
+
+                /**
+                 * Allows to stop the pool, the workers finish their current tasks and
+                 * exit, the not yet started tasks are dropped. Can be called repeatedly.
+                 */
+                inline void stop() {
+                    for (auto * worker : m_workers) {
+                        {
+                            scoped_guard guard(worker->m_mutex);
+                            worker->m_stop = true;
+                        }
+                        worker->m_cond.notify_one();
+                    }
+                    for (auto * worker : m_workers) {
+                        if (worker->m_thread.joinable()) {
+                            worker->m_thread.join();
+                        }
+                    }
+                }
+
+                /**
+                 * Allows to plan a new task, the task is executed after all
+                 * the previously planned tasks with the same key. The key bits are
+                 * mixed before choosing the worker, so the keys such as the aligned
+                 * pointers, differing in the higher bits only, are spread evenly.
+                 * @param key the task key
+                 * @param task the task function
+                 */
+                inline void plan(const size_t key, task_function && task) {
+                    uint_fast64_t mixed_key = key;
+                    pool_worker * worker = m_workers[mix_fasthash(mixed_key) % m_workers.size()];
+                    {
+                        scoped_guard guard(worker->m_mutex);
+                        if (worker->m_stop) {
+                            LOG_DEBUG << "The keyed task pool is stopped, the task is dropped!" << END_LOG;
+                            return;
+                        }
+                        worker->m_tasks.push_back(move(task));
+                    }
+                    worker->m_cond.notify_one();
+                }
+
+            private:
+
+                /**
+                 * This structure stores the worker thread and its task queue
+                 */
+                struct pool_worker {
+
+                    /**
+                     * The basic constructor
+                     */
+                    pool_worker()
+                    : m_mutex(), m_cond(), m_tasks(), m_stop(false), m_thread() {
+                    }
+
+                    //Stores the worker mutex
+                    mutex m_mutex;
+                    //Stores the condition for the worker waiting for a task
+                    condition_variable m_cond;
+                    //Stores the planned tasks
+                    deque<task_function> m_tasks;
+                    //Stores the stopping flag
+                    bool m_stop;
+                    //Stores the worker thread
+                    thread m_thread;
+                };
+
+                //Stores the workers
+                vector<pool_worker *> m_workers;
+
+                /**
+                 * The worker thread function, executes the queued tasks one after another
+                 * @param worker the worker to execute the tasks of
+                 */
+                static inline void run_worker(pool_worker * worker) {
+                    while (true) {
+                        task_function task;
+                        {
+                            unique_guard guard(worker->m_mutex);
+                            worker->m_cond.wait(guard, [worker] {
+                                return worker->m_stop || !worker->m_tasks.empty();
+                            });
+                            if (worker->m_stop) {
+                                return;
+                            }
+                            task = move(worker->m_tasks.front());
+                            worker->m_tasks.pop_front();
+                        }
+                        try {
+                            task();
+                        } catch (std::exception & ex) {
+                            LOG_ERROR << "A keyed pool task has failed: " << ex.what() << END_LOG;
+                        } catch (...) {
+                            LOG_ERROR << "A keyed pool task has failed with an unknown exception!" << END_LOG;
+                        }
+                    }
+                }
+            };
+        }
+    }
+}
+
+#endif /* KEYED_TASK_POOL_HPP */
+
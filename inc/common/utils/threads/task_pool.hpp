@@ -26,14 +26,14 @@
 #ifndef TASK_POOL_HPP
 #define TASK_POOL_HPP
 
-#include <queue>
-#include <deque>
 #include <vector>
+#include <algorithm>
 #include <functional>
 
 #include "common/utils/logging/logger.hpp"
 #include "common/utils/exceptions.hpp"
 #include "common/utils/threads/threads.hpp"
+#include "common/utils/threads/task_pool_queue.hpp"
 #include "common/utils/threads/task_pool_worker.hpp"
 
 using namespace std;
@@ -51,6 +51,13 @@ namespace uva {
              * This class represents a translation tasks pool which is in essence a thread pool.
              * One should add the translation tasks into this class and using the pre-configured
              * number of threads it will execute these tasks one by one. This class is thread safe. 
+             * The tasks are distributed over a number of queues, one per initial worker, each with
+             * its own lock. A worker takes the highest rank task, from its home queue if it has
+             * one of the highest rank, otherwise the task is stolen from another queue. Without
+             * aging the task rank is its priority, so the tasks of higher priority are executed
+             * first and the tasks of equal priority are executed in the order they were planned,
+             * per queue. With aging the rank grows by one priority level per aging period that the
+             * task waits, so that the low priority tasks are not starved.
              */
             template<typename pool_task>
             class task_pool {
@@ -58,25 +65,14 @@ namespace uva {
                 //Typedef the pointer to the pool task
                 typedef pool_task * pool_task_ptr;
 
-                /**
-                 * This structure encapsulates the priority comparison operator
-                 */
-                struct less_task_priority {
-
-                    /**
-                     * Allows to check whether the left task has lower priority than the right one.
-                     * I.e. this method implements the predicate (left < right)
-                     * @param left the task on the left of the less operator
-                     * @param right the task on the right of the less operator
-                     * @return true if the priority of the left task is lower than that of the right task, otherwise false.
-                     */
-                    inline bool operator()(const pool_task_ptr left, const pool_task_ptr right) const {
-                        return left->get_priority() < right->get_priority();
-                    }
-                };
+                //Define the tasks queue type and its entry type
+                typedef task_pool_queue<pool_task> tasks_queue_type;
+                typedef typename tasks_queue_type::queued_task queued_task;
+                typedef typename tasks_queue_type::clock_type clock_type;
+                typedef typename clock_type::time_point time_point_type;
 
-                //Define the tasks queue type and its iterator
-                typedef priority_queue<pool_task_ptr, deque<pool_task_ptr>, less_task_priority > tasks_queue_type;
+                //Define the tasks queues list type
+                typedef vector<tasks_queue_type *> queues_list_type;
 
                 //Define the thread list type
                 typedef vector<thread> threads_list_type;
@@ -85,15 +81,26 @@ namespace uva {
 
                 /**
                  * This is a basic constructor accepting the number of threads parameter.
+                 * The number of task queues is the initial number of threads.
                  * @param num_threads the number of threads to be run by this task pool.
+                 * @param aging_period the waiting time, in seconds, after which the task
+                 *                     rank is increased by one priority level, if zero
+                 *                     then there is no aging, default is zero.
                  */
-                task_pool(const size_t num_threads)
-                : m_tasks(), m_queue_mutex(), m_condition(), m_stop(false), m_threads(), m_workers() {
+                task_pool(const size_t num_threads, const double aging_period = 0.0)
+                : m_aging_period_ms(static_cast<int64_t> (aging_period * 1000.0)),
+                m_start_time(clock_type::now()), m_next_seq(0),
+                m_queues(), m_next_queue_idx(0), m_num_pending(0), m_num_idle(0),
+                m_idle_mutex(), m_condition(), m_stop(false), m_num_done(0),
+                m_wait_time_total(0.0), m_wait_time_max(0.0), m_stats_mutex(),
+                m_next_home_idx(0), m_threads(), m_workers() {
+                    //Create the task queues, there is at least one
+                    for (size_t i = 0; i < max<size_t>(num_threads, 1); ++i) {
+                        m_queues.push_back(new tasks_queue_type());
+                    }
+
                     for (size_t i = 0; i < num_threads; ++i) {
-                        //Add the new worker
-                        m_workers.emplace_back(new task_pool_worker<pool_task>(*this));
-                        //Add the worker thread
-                        m_threads.emplace_back(thread(&task_pool_worker<pool_task>::operator(), m_workers.back()));
+                        add_worker();
                     }
                 };
 
@@ -104,7 +111,7 @@ namespace uva {
                     //Set the stopping flag
                     m_stop = true;
                     //Notify all the sleeping threads
-                    m_condition.notify_all();
+                    notify_workers(true);
                     //Iterate through all the workers and wait until they exit
                     for (size_t i = 0; i < m_threads.size(); ++i) {
                         //Wait until the thread is finished
@@ -112,6 +119,10 @@ namespace uva {
                         //Delete the worker
                         delete m_workers[i];
                     }
+                    //Delete the queues
+                    for (size_t i = 0; i < m_queues.size(); ++i) {
+                        delete m_queues[i];
+                    }
                 };
 
                 /**
@@ -134,10 +145,7 @@ namespace uva {
                     if (new_num_threads > curr_num_threads) {
                         //We are to add more worker threads
                         for (size_t count = curr_num_threads; count < new_num_threads; ++count) {
-                            //Add the new worker
-                            m_workers.emplace_back(new task_pool_worker<pool_task>(*this));
-                            //Add the worker thread
-                            m_threads.emplace_back(thread(&task_pool_worker<pool_task>::operator(), m_workers.back()));
+                            add_worker();
                         }
                     } else {
                         if (new_num_threads < curr_num_threads) {
@@ -161,7 +169,7 @@ namespace uva {
 
                                     //Wake up all sleeping threads as the notify_one sends a wake 
                                     //up signal to a random thread but not the one we want to stop.
-                                    m_condition.notify_all();
+                                    notify_workers(true);
 
                                     //If the thread is joinable
                                     if (m_threads[idx].joinable()) {
@@ -196,22 +204,26 @@ namespace uva {
                  * @param prefix the prefix to be used when reporting the run time information.
                  */
                 inline void report_run_time_info(const string & prefix) {
-                    //Add the task to the pool
+                    //Count the active workers
+                    size_t count = 0;
+                    for (size_t idx = 0; idx < m_workers.size(); ++idx) {
+                        if (m_workers[idx]->is_busy()) {
+                            ++count;
+                        }
+                    }
+
+                    LOG_USAGE << prefix << ":" << END_LOG;
+                    LOG_USAGE << "\t#pending tasks: " << m_num_pending
+                            << ", #active threads: " << count
+                            << "/" << m_threads.size() << END_LOG;
+
+                    //Report the queue wait times
                     {
-                        unique_guard guard(m_queue_mutex);
+                        scoped_guard guard(m_stats_mutex);
 
-                        //Count the active workers
-                        size_t count = 0;
-                        for (size_t idx = 0; idx < m_workers.size(); ++idx) {
-                            if (m_workers[idx]->is_busy()) {
-                                ++count;
-                            }
-                        }
-                        
-                        LOG_USAGE << prefix << ":" << END_LOG;
-                        LOG_USAGE << "\t#pending tasks: " << m_tasks.size()
-                                << ", #active threads: " << count
-                                << "/" << m_threads.size() << END_LOG;
+                        LOG_USAGE << "\t#started tasks: " << m_num_done << ", queue wait time avg: "
+                                << (m_num_done > 0 ? (m_wait_time_total / m_num_done) : 0.0)
+                                << ", max: " << m_wait_time_max << " sec." << END_LOG;
                     }
                 }
 
@@ -222,40 +234,204 @@ namespace uva {
                 inline void plan_new_task(pool_task_ptr task) {
                     LOG_DEBUG << "Request adding a new task " << *task << " to the pool!" << END_LOG;
 
-                    //Add the task to the pool
-                    {
-                        unique_guard guard(m_queue_mutex);
-
-                        LOG_DEBUG << "Pushing the task " << *task << " to the list of translation tasks." << END_LOG;
-
-                        //Add the translation task to the queue
-                        m_tasks.push(task);
-                    }
+                    //Add the translation task to the next queue
+                    m_queues[m_next_queue_idx++ % m_queues.size()]->push(
+                            make_queued_task(task, m_next_seq++, clock_type::now()));
+                    ++m_num_pending;
 
                     LOG_DEBUG << "Notifying threads that there is a translation task present!" << END_LOG;
 
                     //Wake up a thread to do a translation job
-                    m_condition.notify_one();
+                    notify_workers(false);
 
                     LOG_DEBUG << "Done planning a new task." << END_LOG;
                 }
 
+                /**
+                 * This method allows to plan a number of tasks at once, e.g. all the tasks
+                 * of one job. The tasks are dealt over the queues in a round-robin fashion,
+                 * keeping their order within each queue, so that the tasks planned first
+                 * are also executed first. Each queue is locked just once and the workers
+                 * are woken up once.
+                 * @param begin the iterator pointing to the first task to plan
+                 * @param end the iterator pointing behind the last task to plan
+                 */
+                template<typename iter_type>
+                inline void plan_new_tasks(const iter_type begin, const iter_type end) {
+                    const size_t num_tasks = distance(begin, end);
+
+                    LOG_DEBUG << "Request adding " << num_tasks << " new tasks to the pool!" << END_LOG;
+
+                    if (num_tasks > 0) {
+                        //Reserve the sequence numbers and get the planning time
+                        const uint64_t first_seq = (m_next_seq += num_tasks) - num_tasks;
+                        const time_point_type now = clock_type::now();
+
+                        //Deal the tasks over the queues, starting from the next queue
+                        const size_t num_queues = m_queues.size();
+                        const size_t first_queue_idx = m_next_queue_idx++;
+                        vector<vector<queued_task> > dealt(min(num_queues, num_tasks));
+                        size_t task_idx = 0;
+                        for (iter_type iter = begin; iter != end; ++iter, ++task_idx) {
+                            dealt[task_idx % dealt.size()].push_back(make_queued_task(*iter, first_seq + task_idx, now));
+                        }
+
+                        //Add the dealt tasks to the queues
+                        for (size_t idx = 0; idx < dealt.size(); ++idx) {
+                            m_queues[(first_queue_idx + idx) % num_queues]->push(dealt[idx].begin(), dealt[idx].end());
+                        }
+                        m_num_pending += num_tasks;
+
+                        //Wake up the threads to do the translation job
+                        notify_workers(num_tasks > 1);
+                    }
+
+                    LOG_DEBUG << "Done planning " << num_tasks << " new tasks." << END_LOG;
+                }
+
             protected:
                 //The worker class is a friend of this one, for simplicity
                 friend class task_pool_worker<pool_task>;
 
-                //This is the queue of scheduled tasks
-                tasks_queue_type m_tasks;
+                /**
+                 * Allows to take the highest rank task. The queue with the highest top rank
+                 * is chosen, the home queue is preferred if it has a task of the same rank.
+                 * @param home_idx the index of the worker's home queue
+                 * @param task [out] the task to be executed
+                 * @return true if a task was taken, otherwise false
+                 */
+                inline bool get_task(const size_t home_idx, pool_task_ptr & task) {
+                    const size_t num_queues = m_queues.size();
+
+                    //Find the queue with the highest top rank
+                    size_t best_idx = home_idx % num_queues;
+                    int64_t best_rank = m_queues[best_idx]->get_top_rank();
+                    for (size_t count = 1; count < num_queues; ++count) {
+                        const size_t queue_idx = (home_idx + count) % num_queues;
+                        const int64_t rank = m_queues[queue_idx]->get_top_rank();
+                        if (rank > best_rank) {
+                            best_rank = rank;
+                            best_idx = queue_idx;
+                        }
+                    }
 
-                //Stores the synchronization primitive instances
-                mutex m_queue_mutex;
+                    //Try to take the task, it can be taken by another worker in the mean time
+                    double wait_time = 0.0;
+                    if ((best_rank != tasks_queue_type::EMPTY_QUEUE_RANK) &&
+                            m_queues[best_idx]->pop(task, wait_time)) {
+                        --m_num_pending;
+
+                        LOG_DEBUG1 << "The task " << *task << " waited " << wait_time
+                                << " sec. in queue " << best_idx << END_LOG;
+
+                        //Update the queue wait time statistics
+                        {
+                            scoped_guard guard(m_stats_mutex);
+
+                            ++m_num_done;
+                            m_wait_time_total += wait_time;
+                            m_wait_time_max = max(m_wait_time_max, wait_time);
+                        }
+                        return true;
+                    }
+                    return false;
+                }
+
+                /**
+                 * Allows the worker to wait until there is a task pending or the worker is to stop
+                 * @param is_on the worker's flag indicating whether the worker is on
+                 */
+                inline void wait_for_task(acr_bool_flag is_on) {
+                    unique_guard guard(m_idle_mutex);
+
+                    ++m_num_idle;
+                    while (!m_stop && is_on && (m_num_pending == 0)) {
+                        m_condition.wait(guard);
+                    }
+                    --m_num_idle;
+                }
+
+                //Stores the aging period in milliseconds, zero if there is no aging
+                const int64_t m_aging_period_ms;
+                //Stores the pool creation time, the aging ranks are relative to it
+                const time_point_type m_start_time;
+                //Stores the sequence number of the next planned task
+                atomic<uint64_t> m_next_seq;
+
+                //Stores the task queues
+                queues_list_type m_queues;
+                //Stores the index of the next queue to add tasks to
+                atomic<size_t> m_next_queue_idx;
+                //Stores the number of pending tasks
+                atomic<size_t> m_num_pending;
+                //Stores the number of idle workers
+                atomic<size_t> m_num_idle;
+
+                //Stores the synchronization primitive instances for idle workers
+                mutex m_idle_mutex;
                 condition_variable m_condition;
 
                 //Stores the stopping flag
                 a_bool_flag m_stop;
 
+                //Stores the number of tasks taken from the queues
+                size_t m_num_done;
+                //Stores the total queue wait time in seconds
+                double m_wait_time_total;
+                //Stores the maximum queue wait time in seconds
+                double m_wait_time_max;
+                //Stores the statistics mutex
+                mutex m_stats_mutex;
+
             private:
 
+                /**
+                 * Allows to create the queue entry for the task. The entry rank is the task
+                 * priority or, with aging, (priority * aging_period - planning_time). As all
+                 * the queued tasks age equally, comparing the latter ranks is the same as
+                 * comparing the task priorities increased by one per waited aging period.
+                 * @param task the task to be queued
+                 * @param seq the task sequence number
+                 * @param now the task planning time
+                 * @return the queue entry for the task
+                 */
+                inline queued_task make_queued_task(pool_task_ptr task, const uint64_t seq, const time_point_type now) const {
+                    int64_t rank = task->get_priority();
+                    if (m_aging_period_ms > 0) {
+                        rank = rank * m_aging_period_ms - duration_cast<milliseconds>(now - m_start_time).count();
+                    }
+                    return {task, rank, seq, now};
+                }
+
+                /**
+                 * Allows to add a new worker and its thread
+                 */
+                inline void add_worker() {
+                    //Add the new worker
+                    m_workers.emplace_back(new task_pool_worker<pool_task>(*this, m_next_home_idx++ % m_queues.size()));
+                    //Add the worker thread
+                    m_threads.emplace_back(thread(&task_pool_worker<pool_task>::operator(), m_workers.back()));
+                }
+
+                /**
+                 * Allows to wake up the idle workers, if any. The idle workers
+                 * mutex is locked so that a worker going idle can not miss it.
+                 * @param is_all true if all the idle workers are to be woken up, otherwise one
+                 */
+                inline void notify_workers(const bool is_all) {
+                    if (m_stop || (m_num_idle > 0)) {
+                        scoped_guard guard(m_idle_mutex);
+                        if (is_all) {
+                            m_condition.notify_all();
+                        } else {
+                            m_condition.notify_one();
+                        }
+                    }
+                }
+
+                //Stores the index of the home queue of the next worker
+                size_t m_next_home_idx;
+
                 //Stores the worker threads
                 threads_list_type m_threads;
 
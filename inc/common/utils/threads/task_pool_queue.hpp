@@ -0,0 +1,184 @@
+/*
+ * File:   task_pool_queue.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 17, 2026, 11:40 AM
+ */
+
+#ifndef TASK_POOL_QUEUE_HPP
+#define TASK_POOL_QUEUE_HPP
+
+#include <queue>
+#include <vector>
+#include <limits>
+
+#include "common/utils/threads/threads.hpp"
+
+using namespace std;
+using namespace std::chrono;
+
+using namespace uva::utils::threads;
+
+namespace uva {
+    namespace utils {
+        namespace threads {
+
+            /**
+             * This class represents a queue of the task pool. Each task pool worker
+             * has its home queue, the tasks are added to the queues in a round-robin
+             * fashion and the workers take tasks from the other queues if their home
+             * queue has no task of the highest rank. The rank of a task is computed
+             * by the pool from the task priority, the higher rank tasks are served
+             * first and the tasks of equal rank in the order they were planned.
+             * This class is thread safe.
+             */
+            template<typename pool_task>
+            class task_pool_queue {
+            public:
+                //Typedef the pointer to the pool task
+                typedef pool_task * pool_task_ptr;
+                //Typedef the clock used to measure the queue wait time
+                typedef steady_clock clock_type;
+
+                //Stores the top rank value of an empty queue
+                static constexpr int64_t EMPTY_QUEUE_RANK = numeric_limits<int64_t>::min();
+
+                /**
+                 * This structure stores the queued task, its rank, sequence number and the time it was queued at
+                 */
+                struct queued_task {
+                    //Stores the task pointer
+                    pool_task_ptr m_task;
+                    //Stores the task rank, the higher rank tasks are served first
+                    int64_t m_rank;
+                    //Stores the task sequence number, for the equal rank tasks the lower one is served first
+                    uint64_t m_seq;
+                    //Stores the time the task was queued
+                    clock_type::time_point m_time;
+                };
+
+                /**
+                 * The basic constructor
+                 */
+                task_pool_queue()
+                : m_mutex(), m_tasks(), m_top_rank(EMPTY_QUEUE_RANK) {
+                }
+
+                /**
+                 * Allows to add a task to the queue
+                 * @param task the task to add
+                 */
+                inline void push(const queued_task & task) {
+                    scoped_guard guard(m_mutex);
+
+                    m_tasks.push(task);
+                    m_top_rank = m_tasks.top().m_rank;
+                }
+
+                /**
+                 * Allows to add a number of tasks to the queue under one lock
+                 * @param begin the iterator pointing to the first task to add
+                 * @param end the iterator pointing behind the last task to add
+                 */
+                template<typename iter_type>
+                inline void push(iter_type begin, const iter_type end) {
+                    scoped_guard guard(m_mutex);
+
+                    for (; begin != end; ++begin) {
+                        m_tasks.push(*begin);
+                    }
+                    if (!m_tasks.empty()) {
+                        m_top_rank = m_tasks.top().m_rank;
+                    }
+                }
+
+                /**
+                 * Allows to take the highest rank task from the queue
+                 * @param task [out] the task taken from the queue
+                 * @param wait_time [out] the time, in seconds, the task spent in the queue
+                 * @return true if the task was taken, false if the queue is empty
+                 */
+                inline bool pop(pool_task_ptr & task, double & wait_time) {
+                    scoped_guard guard(m_mutex);
+
+                    if (m_tasks.empty()) {
+                        return false;
+                    } else {
+                        //Retrieve the highest rank task
+                        const queued_task & top = m_tasks.top();
+                        task = top.m_task;
+                        wait_time = duration_cast<duration<double>>(clock_type::now() - top.m_time).count();
+                        m_tasks.pop();
+
+                        //Update the top rank
+                        m_top_rank = m_tasks.empty() ? EMPTY_QUEUE_RANK : m_tasks.top().m_rank;
+
+                        return true;
+                    }
+                }
+
+                /**
+                 * Allows to get the rank of the highest rank task in the queue,
+                 * the value is read without locking so it can already be out-dated.
+                 * @return the highest task rank or EMPTY_QUEUE_RANK if the queue is empty
+                 */
+                inline int64_t get_top_rank() const {
+                    return m_top_rank;
+                }
+
+            private:
+
+                /**
+                 * This structure encapsulates the task order comparison operator
+                 */
+                struct less_queued_task {
+
+                    /**
+                     * Allows to check whether the left task is to be served after the right one.
+                     * @param left the task on the left of the less operator
+                     * @param right the task on the right of the less operator
+                     * @return true if the left task has lower rank or the same rank and was planned later
+                     */
+                    inline bool operator()(const queued_task & left, const queued_task & right) const {
+                        return (left.m_rank < right.m_rank) ||
+                                ((left.m_rank == right.m_rank) && (left.m_seq > right.m_seq));
+                    }
+                };
+
+                //Define the tasks heap type
+                typedef priority_queue<queued_task, vector<queued_task>, less_queued_task> tasks_heap;
+
+                //Stores the queue mutex
+                mutex m_mutex;
+                //Stores the queued tasks
+                tasks_heap m_tasks;
+                //Stores the highest rank of the queued tasks
+                atomic<int64_t> m_top_rank;
+            };
+
+            template<typename pool_task>
+            constexpr int64_t task_pool_queue<pool_task>::EMPTY_QUEUE_RANK;
+        }
+    }
+}
+
+#endif /* TASK_POOL_QUEUE_HPP */
+
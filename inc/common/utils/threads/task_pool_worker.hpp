@@ -55,9 +55,10 @@ namespace uva {
                 /**
                  * This is a basic constructor that needs the thread pool reference as an argument.
                  * @param pool the task pool reference
+                 * @param home_idx the index of the worker's home queue in the pool
                  */
-                task_pool_worker(task_pool<pool_task> & pool)
-                : m_is_on(true), m_is_busy(false), m_pool(pool) {
+                task_pool_worker(task_pool<pool_task> & pool, const size_t home_idx)
+                : m_is_on(true), m_is_busy(false), m_pool(pool), m_home_idx(home_idx) {
                 }
 
                 /**
@@ -91,30 +92,16 @@ namespace uva {
 
                     //Run the thread as long as it is not stopped
                     while (!m_pool.m_stop && m_is_on) {
-                        //Lock the critical waiting section
-                        {
-                            unique_guard guard(m_pool.m_queue_mutex);
-
+                        //Take the highest priority task, from the home queue if possible
+                        if (m_pool.get_task(m_home_idx, task)) {
+                            //Execute the newly obtained task
+                            m_is_busy = true;
+                            task->execute();
+                            m_is_busy = false;
+                        } else {
                             //Wait for the new task is scheduled or we need to stop
-                            while (!m_pool.m_stop && m_is_on && m_pool.m_tasks.empty()) {
-                                m_pool.m_condition.wait(guard);
-                            }
-
-                            //Check on the situation we are in
-                            if (m_pool.m_stop || !m_is_on) {
-                                //If we need to stop then return - finish the thread
-                                return;
-                            } else {
-                                //There is a task to be processed, retrieve it
-                                task = m_pool.m_tasks.top();
-                                m_pool.m_tasks.pop();
-                            }
+                            m_pool.wait_for_task(m_is_on);
                         }
-
-                        //Execute the newly obtained task
-                        m_is_busy = true;
-                        task->execute();
-                        m_is_busy = false;
                     }
                 }
 
@@ -126,6 +113,8 @@ namespace uva {
                 a_bool_flag m_is_busy;
                 //Keeps the reference to the pool
                 task_pool<pool_task> & m_pool;
+                //Stores the index of the worker's home queue
+                const size_t m_home_idx;
             };
         }
     }
@@ -174,7 +174,7 @@ namespace uva {
 
                 bool get_bool(INI<> &ini, const string & section, const string & key,
                         const bool & unk_value, const bool is_compulsory = true) {
-                    return get_bool(ini, section, key, to_string(unk_value), is_compulsory);
+                    return get_bool(ini, section, key, string(unk_value ? "true" : "false"), is_compulsory);
                 }
             }
         }
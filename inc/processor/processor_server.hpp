@@ -69,7 +69,7 @@ namespace uva {
                         //Provide the manager with the functional for sending
                         //the translation response and getting the adapters
                         m_manager.set_response_sender(
-                                bind(&processor_server::send_response, this, _1, _2));
+                                bind(&processor_server::send_msg_response, this, _1, _2));
                     }
 
                     /**
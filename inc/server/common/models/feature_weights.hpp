@@ -0,0 +1,184 @@
+/*
+ * File:   feature_weights.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 17, 2026, 10:12 AM
+ */
+
+#ifndef FEATURE_WEIGHTS_HPP
+#define FEATURE_WEIGHTS_HPP
+
+#include <string>
+#include <ostream>
+#include <cstring>
+
+#include "common/utils/exceptions.hpp"
+#include "common/utils/logging/logger.hpp"
+#include "common/utils/hashing_utils.hpp"
+#include "common/utils/text/string_utils.hpp"
+
+#include "server/server_configs.hpp"
+
+using namespace std;
+
+using namespace uva::utils::exceptions;
+using namespace uva::utils::logging;
+using namespace uva::utils::hashing;
+using namespace uva::utils::text;
+
+namespace uva {
+    namespace smt {
+        namespace bpbd {
+            namespace server {
+                namespace common {
+                    namespace models {
+
+                        /**
+                         * Allows to compute the dot product of the feature values and the weights.
+                         * The loop has no dependencies other than the sum, so that it can be
+                         * vectorised by the compiler.
+                         * @param size the number of features
+                         * @param features the feature values
+                         * @param lambdas the feature weights
+                         * @return the weighted sum of the features
+                         */
+                        static inline prob_weight dot_product(const size_t size,
+                                const prob_weight * features, const prob_weight * lambdas) {
+                            prob_weight result = 0.0;
+                            for (size_t idx = 0; idx < size; ++idx) {
+                                result += features[idx] * lambdas[idx];
+                            }
+                            return result;
+                        }
+
+                        /**
+                         * This structure stores the feature weights, lambdas, of the models.
+                         * The models store the raw log_e feature values and these weights are
+                         * applied when scoring, so they can be changed without reloading the
+                         * models. The initial values come from the model parameters.
+                         */
+                        struct feature_weights_struct {
+                            //Stores the language model weight
+                            prob_weight m_lm_lambda;
+                            //Stores the number of translation model weights
+                            size_t m_num_tm_lambdas;
+                            //Stores the translation model weights
+                            prob_weight m_tm_lambdas[tm::MAX_NUM_TM_FEATURES];
+                            //Stores the word penalty weight
+                            prob_weight m_wp_lambda;
+                            //Stores the number of reordering model weights
+                            size_t m_num_rm_lambdas;
+                            //Stores the reordering model weights
+                            prob_weight m_rm_lambdas[rm::MAX_NUM_RM_FEATURES];
+
+                            /**
+                             * The basic constructor, sets all the weights to zero
+                             */
+                            feature_weights_struct()
+                            : m_lm_lambda(0.0), m_num_tm_lambdas(0), m_tm_lambdas(),
+                            m_wp_lambda(0.0), m_num_rm_lambdas(0), m_rm_lambdas() {
+                            }
+
+                            /**
+                             * Allows to set the translation model weights
+                             * @param num_lambdas the number of weights, must be equal to the current one
+                             * @param lambdas the weights to set
+                             */
+                            inline void set_tm_lambdas(const size_t num_lambdas, const prob_weight * lambdas) {
+                                ASSERT_CONDITION_THROW((num_lambdas != m_num_tm_lambdas),
+                                        string("The number of TM weights: ") + to_string(num_lambdas) +
+                                        string(" must be ") + to_string(m_num_tm_lambdas));
+                                memcpy(m_tm_lambdas, lambdas, num_lambdas * sizeof (prob_weight));
+                            }
+
+                            /**
+                             * Allows to set the reordering model weights
+                             * @param num_lambdas the number of weights, must be equal to the current one
+                             * @param lambdas the weights to set
+                             */
+                            inline void set_rm_lambdas(const size_t num_lambdas, const prob_weight * lambdas) {
+                                ASSERT_CONDITION_THROW((num_lambdas != m_num_rm_lambdas),
+                                        string("The number of RM weights: ") + to_string(num_lambdas) +
+                                        string(" must be ") + to_string(m_num_rm_lambdas));
+                                memcpy(m_rm_lambdas, lambdas, num_lambdas * sizeof (prob_weight));
+                            }
+
+                            /**
+                             * Allows to check whether the weights influencing the translation costs
+                             * pre-computed by the translation model, i.e. the language model, the
+                             * translation model and the word penalty weights, are the same.
+                             * @param other the weights to compare with
+                             * @return true if the weights are the same, otherwise false
+                             */
+                            inline bool is_equal_tm_weights(const feature_weights_struct & other) const {
+                                return (m_lm_lambda == other.m_lm_lambda) &&
+                                        (m_wp_lambda == other.m_wp_lambda) &&
+                                        (m_num_tm_lambdas == other.m_num_tm_lambdas) &&
+                                        (memcmp(m_tm_lambdas, other.m_tm_lambdas,
+                                        m_num_tm_lambdas * sizeof (prob_weight)) == 0);
+                            }
+
+                            /**
+                             * Allows to compute the hash of the weights
+                             * @param seed the hash seed, e.g. the hash of other values
+                             * @return the hash of the weights
+                             */
+                            inline uint64_t get_hash(const uint64_t seed) const {
+                                uint_fast64_t hash = mix_value_hash(seed, m_lm_lambda);
+                                hash = mix_value_hash(hash, m_wp_lambda);
+                                hash = mix_value_hash(hash, static_cast<uint_fast64_t> (m_num_tm_lambdas));
+                                for (size_t idx = 0; idx < m_num_tm_lambdas; ++idx) {
+                                    hash = mix_value_hash(hash, m_tm_lambdas[idx]);
+                                }
+                                hash = mix_value_hash(hash, static_cast<uint_fast64_t> (m_num_rm_lambdas));
+                                for (size_t idx = 0; idx < m_num_rm_lambdas; ++idx) {
+                                    hash = mix_value_hash(hash, m_rm_lambdas[idx]);
+                                }
+                                return hash;
+                            }
+                        };
+
+                        //Typedef the structure
+                        typedef feature_weights_struct feature_weights;
+
+                        /**
+                         * Allows to output the weights object to the stream
+                         * @param stream the stream to output into
+                         * @param weights the weights object
+                         * @return the stream that we output into
+                         */
+                        static inline std::ostream& operator<<(std::ostream& stream, const feature_weights & weights) {
+                            return stream << "weights: { lm = " << weights.m_lm_lambda
+                                    << ", tm(" << weights.m_num_tm_lambdas << ") = "
+                                    << array_to_string<prob_weight>(weights.m_num_tm_lambdas, weights.m_tm_lambdas)
+                                    << ", wp = " << weights.m_wp_lambda
+                                    << ", rm(" << weights.m_num_rm_lambdas << ") = "
+                                    << array_to_string<prob_weight>(weights.m_num_rm_lambdas, weights.m_rm_lambdas)
+                                    << " }";
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif /* FEATURE_WEIGHTS_HPP */
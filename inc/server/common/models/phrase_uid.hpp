@@ -80,6 +80,18 @@ namespace uva {
                             return uid;
                         }
 
+                        /**
+                         * Allows to get the phrase uid for the given token without copying it into a string.
+                         * The resulting uid is the same as the one computed by get_phrase_uid<true>.
+                         * @param token the pointer to the first character of the token
+                         * @param len the length of the token in characters
+                         * @return the uid of the token
+                         */
+                        static inline phrase_uid get_token_uid(const char * token, const size_t len) {
+                            //Compute the token hash and shift the value up to get the minimum valid id
+                            return compute_hash(token, len) | (1 << 1);
+                        }
+
                         /**
                          * Allows to get the phrase uid for the given phrase.
                          * Note: The current implementation uses the hash function to compute the uid.
@@ -41,6 +41,9 @@ namespace uva {
                 namespace decoder {
                     //Stores the maximum considered number of words per sentence
                     static constexpr size_t MAX_WORDS_PER_SENTENCE = 256;
+                    //Stores the maximum number of words of a short sentence, the short
+                    //sentences are decoded with single 64-bit word coverage vectors
+                    static constexpr size_t SHORT_SENTENCE_MAX_WORDS = 64;
                     //Stores the maximum number of features to be used in the
                     //decoding process, the only purpose of this variable is to
                     //simplify the code and avoid dynamic array allocations
@@ -26,6 +26,8 @@
 #ifndef DE_CONFIGURATOR_HPP
 #define DE_CONFIGURATOR_HPP
 
+#include "common/utils/threads/fork_join_pool.hpp"
+
 #include "server/decoder/de_parameters.hpp"
 #include "server/decoder/sentence/sentence_decoder.hpp"
 
@@ -56,15 +58,33 @@ namespace uva {
                          */
                         static void connect(const de_parameters & params) {
                             m_params = &params;
+
+                            //Create the shared level expansion pool, if needed, the
+                            //decoding thread is always the one of the expansion threads
+                            if (m_params->m_num_expand_threads > 1) {
+                                m_expand_pool = new fork_join_pool(m_params->m_num_expand_threads - 1);
+                            }
                         }
 
                         /**
                          * Allows to disconnect from the decoder, i.e. clean up the memory etc.
                          */
                         static void disconnect() {
-                            //Nothing to be done, no dynamically allocated resources at the moment.
+                            //Stop the level expansion pool, if any
+                            if (m_expand_pool != NULL) {
+                                delete m_expand_pool;
+                                m_expand_pool = NULL;
+                            }
                         }
-                        
+
+                        /**
+                         * Allows to get the shared pool for the parallel stack level expansion
+                         * @return the pointer to the expansion pool or NULL if the levels are not expanded in parallel
+                         */
+                        static fork_join_pool * get_expand_pool() {
+                            return m_expand_pool;
+                        }
+
                         /**
                          * Allows to get the decoder parameters
                          * @return the reference to the decoder parameters
@@ -76,6 +96,8 @@ namespace uva {
                     private:
                         //Stores the pointer to the configuration parameters
                         static const de_parameters * m_params;
+                        //Stores the pointer to the shared level expansion pool
+                        static fork_join_pool * m_expand_pool;
                     };
                 }
             }
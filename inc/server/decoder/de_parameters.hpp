@@ -39,6 +39,7 @@
 #include "server/decoder/de_configs.hpp"
 #include "server/server_consts.hpp"
 #include "server/common/feature_id_registry.hpp"
+#include "server/common/models/feature_weights.hpp"
 
 using namespace std;
 
@@ -47,6 +48,7 @@ using namespace uva::utils::logging;
 using namespace uva::utils::threads;
 
 using namespace uva::smt::bpbd::server::common;
+using namespace uva::smt::bpbd::server::common::models;
 using namespace uva::smt::bpbd::server::lm;
 using namespace uva::smt::bpbd::server::rm;
 using namespace uva::smt::bpbd::server::tm;
@@ -75,6 +77,26 @@ namespace uva {
                         static const string DE_DIST_LIMIT_PARAM_NAME;
                         //The distortion limit parameter name
                         static const string DE_LD_PENALTY_PARAM_NAME;
+                        //The stack level type parameter name
+                        static const string DE_STACK_LEVEL_TYPE_PARAM_NAME;
+                        //The list stack level type value, the default one
+                        static const string DE_LIST_STACK_LEVEL_TYPE;
+                        //The hash stack level type value
+                        static const string DE_HASH_STACK_LEVEL_TYPE;
+                        //The hypothesis expansion mode parameter name
+                        static const string DE_EXPANSION_MODE_PARAM_NAME;
+                        //The full expansion mode value, the default one
+                        static const string DE_FULL_EXPANSION_MODE;
+                        //The cube pruning expansion mode value
+                        static const string DE_CUBE_EXPANSION_MODE;
+                        //The cube pruning pop limit parameter name
+                        static const string DE_CUBE_POP_LIMIT_PARAM_NAME;
+                        //The number of stack level expansion threads parameter name
+                        static const string DE_NUM_EXPAND_THREADS_PARAM_NAME;
+                        //The is-reordering-future-cost parameter name
+                        static const string DE_IS_REORD_FUTURE_COST_PARAM_NAME;
+                        //The per source phrase translation limit parameter name
+                        static const string DE_TRANS_LIMIT_PARAM_NAME;
 
                         //The is-generate-search-lattice parameter name
                         static const string DE_IS_GEN_LATTICE_PARAM_NAME;
@@ -90,6 +112,9 @@ namespace uva {
                         //The global id of the linear distortion feature
                         static size_t DE_LD_PENALTY_GLOBAL_ID;
 
+                        //The default cube pruning pop limit per stack level
+                        static constexpr uint32_t DE_DEF_CUBE_POP_LIMIT = 1000;
+
                         //The distortion limit to use; <integer>
                         //The the number of words to the right and left
                         //from the last phrase end word to consider
@@ -109,6 +134,32 @@ namespace uva {
                         atomic<uint32_t> m_stack_capacity;
                         //Stores the linear distortion lambda parameter value
                         atomic<float> m_lin_dist_penalty;
+                        //Stores the stack level type: list or hash
+                        string m_stack_level_type;
+                        //Stores the flag indicating whether the hash stack levels
+                        //are to be used, is computed from the stack level type
+                        bool m_is_hash_level;
+                        //Stores the hypothesis expansion mode: full or cube
+                        string m_expansion_mode;
+                        //Stores the flag indicating whether the cube pruning
+                        //is to be used, is computed from the expansion mode
+                        bool m_is_cube_mode;
+                        //Stores the maximum number of hypothesis expansions
+                        //to materialize per stack level in the cube mode
+                        uint32_t m_cube_pop_limit;
+                        //Stores the number of threads expanding one stack level,
+                        //including the decoding one, is only set on start up
+                        uint32_t m_num_expand_threads;
+                        //Stores the flag indicating whether the future cost estimate is to
+                        //include the linear distortion and lexicalized reordering costs
+                        bool m_is_reord_future_cost;
+                        //Stores the maximum number of translations to consider per source
+                        //phrase, the best ones under the job's weights; zero means all the
+                        //translations kept by the translation model when it was loaded
+                        atomic<uint32_t> m_trans_limit;
+                        //Stores the model feature weights to score the translations with,
+                        //are set from the model parameters but can be changed at run time
+                        feature_weights m_weights;
 
                         //This flag is needed for when the server is compiled in the tuning mode.
                         //This flag should allow to set the tuning lattice generation of and off.
@@ -151,7 +202,11 @@ namespace uva {
                         /**
                          * The basic constructor, does nothing
                          */
-                        de_parameters_struct() {
+                        de_parameters_struct()
+                        : m_stack_level_type(DE_LIST_STACK_LEVEL_TYPE), m_is_hash_level(false),
+                        m_expansion_mode(DE_FULL_EXPANSION_MODE), m_is_cube_mode(false),
+                        m_cube_pop_limit(DE_DEF_CUBE_POP_LIMIT), m_num_expand_threads(1),
+                        m_is_reord_future_cost(false), m_trans_limit(0) {
                         }
 
                         /**
@@ -168,6 +223,15 @@ namespace uva {
                                 this->m_pruning_threshold_log = other.m_pruning_threshold_log.load();
                                 this->m_stack_capacity = other.m_stack_capacity.load();
                                 this->m_lin_dist_penalty = other.m_lin_dist_penalty.load();
+                                this->m_stack_level_type = other.m_stack_level_type;
+                                this->m_is_hash_level = other.m_is_hash_level;
+                                this->m_expansion_mode = other.m_expansion_mode;
+                                this->m_is_cube_mode = other.m_is_cube_mode;
+                                this->m_cube_pop_limit = other.m_cube_pop_limit;
+                                this->m_num_expand_threads = other.m_num_expand_threads;
+                                this->m_is_reord_future_cost = other.m_is_reord_future_cost;
+                                this->m_trans_limit = other.m_trans_limit.load();
+                                this->m_weights = other.m_weights;
                                 this->m_is_gen_lattice = other.m_is_gen_lattice.load();
                                 this->m_lattices_folder = other.m_lattices_folder;
                                 this->m_li2n_file_ext = other.m_li2n_file_ext;
@@ -187,6 +251,25 @@ namespace uva {
                             *this = other;
                         }
 
+                        /**
+                         * Allows to compute the hash of the parameters influencing the translation result.
+                         * @return the hash of the parameters influencing the translation result
+                         */
+                        inline uint64_t get_hash() const {
+                            uint_fast64_t hash = mix_value_hash(0, static_cast<uint_fast64_t> (m_dist_limit.load()));
+                            hash = mix_value_hash(hash, static_cast<uint_fast64_t> (m_max_s_phrase_len));
+                            hash = mix_value_hash(hash, static_cast<uint_fast64_t> (m_max_t_phrase_len));
+                            hash = mix_value_hash(hash, static_cast<float> (m_pruning_threshold.load()));
+                            hash = mix_value_hash(hash, static_cast<uint_fast64_t> (m_stack_capacity.load()));
+                            hash = mix_value_hash(hash, static_cast<float> (m_lin_dist_penalty.load()));
+                            hash = mix_value_hash(hash, static_cast<uint_fast64_t> (m_is_hash_level));
+                            hash = mix_value_hash(hash, static_cast<uint_fast64_t> (m_is_cube_mode));
+                            hash = mix_value_hash(hash, static_cast<uint_fast64_t> (m_cube_pop_limit));
+                            hash = mix_value_hash(hash, static_cast<uint_fast64_t> (m_is_reord_future_cost));
+                            hash = mix_value_hash(hash, static_cast<uint_fast64_t> (m_trans_limit.load()));
+                            return m_weights.get_hash(hash);
+                        }
+
                         /**
                          * Allows to verify the parameters to be correct.
                          */
@@ -212,6 +295,32 @@ namespace uva {
                                     string("The ") + DE_STACK_CAPACITY_PARAM_NAME +
                                     string(" must be > 0!"));
 
+                            ASSERT_CONDITION_THROW(((m_stack_level_type != DE_LIST_STACK_LEVEL_TYPE) &&
+                                    (m_stack_level_type != DE_HASH_STACK_LEVEL_TYPE)),
+                                    string("The ") + DE_STACK_LEVEL_TYPE_PARAM_NAME +
+                                    string(" must be either '") + DE_LIST_STACK_LEVEL_TYPE +
+                                    string("' or '") + DE_HASH_STACK_LEVEL_TYPE + string("'!"));
+
+                            //Compute the hash level flag
+                            m_is_hash_level = (m_stack_level_type == DE_HASH_STACK_LEVEL_TYPE);
+
+                            ASSERT_CONDITION_THROW(((m_expansion_mode != DE_FULL_EXPANSION_MODE) &&
+                                    (m_expansion_mode != DE_CUBE_EXPANSION_MODE)),
+                                    string("The ") + DE_EXPANSION_MODE_PARAM_NAME +
+                                    string(" must be either '") + DE_FULL_EXPANSION_MODE +
+                                    string("' or '") + DE_CUBE_EXPANSION_MODE + string("'!"));
+
+                            //Compute the cube mode flag
+                            m_is_cube_mode = (m_expansion_mode == DE_CUBE_EXPANSION_MODE);
+
+                            ASSERT_CONDITION_THROW((m_is_cube_mode && (m_cube_pop_limit == 0)),
+                                    string("The ") + DE_CUBE_POP_LIMIT_PARAM_NAME +
+                                    string(" must be > 0!"));
+
+                            ASSERT_CONDITION_THROW((m_num_expand_threads == 0),
+                                    string("The ") + DE_NUM_EXPAND_THREADS_PARAM_NAME +
+                                    string(" must be > 0!"));
+
 #if IS_SERVER_TUNING_MODE
                             if (this->m_is_gen_lattice) {
                                 //Check if the lattices folder is set
@@ -278,9 +387,21 @@ namespace uva {
                         //Log simple value parameters
                         stream << ", " << de_parameters::DE_PRUNING_THRESHOLD_PARAM_NAME << " = " << params.m_pruning_threshold
                                 << ", " << de_parameters::DE_STACK_CAPACITY_PARAM_NAME << " = " << params.m_stack_capacity
+                                << ", " << de_parameters::DE_STACK_LEVEL_TYPE_PARAM_NAME << " = " << params.m_stack_level_type
+                                << ", " << de_parameters::DE_EXPANSION_MODE_PARAM_NAME << " = " << params.m_expansion_mode;
+
+                        //Log the cube pruning pop limit, if needed
+                        if (params.m_is_cube_mode) {
+                            stream << ", " << de_parameters::DE_CUBE_POP_LIMIT_PARAM_NAME << " = " << params.m_cube_pop_limit;
+                        }
+
+                        stream << ", " << de_parameters::DE_NUM_EXPAND_THREADS_PARAM_NAME << " = " << params.m_num_expand_threads
+                                << ", " << de_parameters::DE_IS_REORD_FUTURE_COST_PARAM_NAME << " = " << (params.m_is_reord_future_cost ? "true" : "false")
+                                << ", " << de_parameters::DE_TRANS_LIMIT_PARAM_NAME << " = " << params.m_trans_limit
                                 << ", " << de_parameters::DE_MAX_SP_LEN_PARAM_NAME << " = " << to_string(params.m_max_s_phrase_len)
                                 << ", " << de_parameters::DE_MAX_TP_LEN_PARAM_NAME << " = " << to_string(params.m_max_t_phrase_len)
-                                << ", " << de_parameters::DE_IS_GEN_LATTICE_PARAM_NAME << " = " << (params.m_is_gen_lattice ? "true" : "false");
+                                << ", " << de_parameters::DE_IS_GEN_LATTICE_PARAM_NAME << " = " << (params.m_is_gen_lattice ? "true" : "false")
+                                << ", " << params.m_weights;
 
                         //Log the additional lattice related parameters, if needed
                         if (params.m_is_gen_lattice) {
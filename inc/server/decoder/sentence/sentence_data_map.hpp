@@ -37,6 +37,7 @@
 
 #include "server/decoder/de_configs.hpp"
 #include "server/tm/models/tm_source_entry.hpp"
+#include "server/tm/models/tm_ranking_cache.hpp"
 
 using namespace std;
 
@@ -71,7 +72,8 @@ namespace uva {
                              */
                             phrase_data_entry()
                             : m_begin_ch_idx(0), m_end_ch_idx(0), m_phrase_uid(UNDEFINED_PHRASE_ID),
-                            m_source_entry(NULL), future_cost(UNKNOWN_LOG_PROB_WEIGHT) {
+                            m_source_entry(NULL), m_ranking(NULL), m_num_targets(0),
+                            future_cost(UNKNOWN_LOG_PROB_WEIGHT) {
                             }
 
                             /**
@@ -90,9 +92,32 @@ namespace uva {
 
                             //Stores the pointer to the translation model source entry
                             tm_const_source_entry_ptr m_source_entry;
-                            
+
+                            //Stores the translations ranking under the job's weights,
+                            //or NULL if the stored, i.e. the model, order is to be used
+                            const tm_trans_ranking * m_ranking;
+                            //Stores the number of the best translations to consider
+                            size_t m_num_targets;
+
                             //Stores the future cost, log scale, for the given phrase.
                             prob_weight future_cost;
+
+                            /**
+                             * Allows to get the index of the ranked translation within the source entry
+                             * @param rank the rank of the translation, the best one has rank zero
+                             * @return the index of the translation target within the source entry
+                             */
+                            inline size_t get_target_idx(const size_t rank) const {
+                                return (m_ranking == NULL) ? rank : m_ranking->m_target_ids[rank];
+                            }
+
+                            /**
+                             * Allows to get the minimum translation cost of the source phrase
+                             * @return the minimum translation cost of the source phrase
+                             */
+                            inline prob_weight get_min_cost() const {
+                                return (m_ranking == NULL) ? m_source_entry->get_min_cost() : m_ranking->m_min_cost;
+                            }
                         };
 
                         //Define the sentence data map that stores some of the sentence related data
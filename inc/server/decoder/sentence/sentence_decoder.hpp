@@ -43,6 +43,7 @@
 
 #include "server/lm/lm_configurator.hpp"
 #include "server/tm/tm_configurator.hpp"
+#include "server/tm/models/tm_ranking_cache.hpp"
 #include "server/rm/rm_configurator.hpp"
 
 using namespace std;
@@ -82,6 +83,10 @@ namespace uva {
                             /**
                              * The basic constructor
                              * @param params the reference to the decoder parameters
+                             * @param ranking_cache the translations ranking cache of the job, is NULL if
+                             *                      the job's weights are the model ones, then the stored
+                             *                      targets order and the pre-computed costs are used
+                             * @param expand_pool the pool for the parallel level expansion or NULL if none
                              * @param is_stop the flag that will be set to true in case 
                              *                one needs to abort the translation process.
                              * @param source_sent [in] the source language sentence to translate
@@ -89,11 +94,14 @@ namespace uva {
                              *                         tokenized, reduced, and in the lower case.
                              * @param target_sent [out] the resulting target language sentence
                              */
-                            sentence_decoder(const de_parameters & params, acr_bool_flag is_stop,
+                            sentence_decoder(const de_parameters & params, tm_ranking_cache * ranking_cache,
+                                    fork_join_pool * expand_pool, acr_bool_flag is_stop,
                                     const string & source_sent, string & target_sent)
-                            : m_stack_info_prov(NULL), m_de_params(params), m_is_stop(is_stop),
+                            : m_stack_info_prov(NULL), m_de_params(params), m_ranking_cache(ranking_cache),
+                            m_tm_weights((ranking_cache == NULL) ? NULL : &ranking_cache->get_weights()),
+                            m_expand_pool(expand_pool), m_is_stop(is_stop),
                             m_source_sent(source_sent), m_target_sent(target_sent),
-                            m_sent_data(count_words(m_source_sent)),
+                            m_sent_data(count_words(m_source_sent)), m_is_tm_queried(false),
                             m_lm_query(lm_configurator::allocate_fast_query_proxy()),
                             m_tm_query(tm_configurator::allocate_query_proxy()),
                             m_rm_query(rm_configurator::allocate_query_proxy()) {
@@ -129,8 +137,10 @@ namespace uva {
                                             string(") exceeds the maximum allowed number of words per sentence (") +
                                             to_string(MAX_WORDS_PER_SENTENCE) + string(")"));
 
-                                    //Query the translation model
-                                    query_translation_model();
+                                    //Query the translation model, unless done when estimating the cost
+                                    if (!m_is_tm_queried) {
+                                        query_translation_model();
+                                    }
 
                                     //Return in case we need to stop translating
                                     if (m_is_stop) return;
@@ -141,12 +151,6 @@ namespace uva {
                                     //Return in case we need to stop translating
                                     if (m_is_stop) return;
 
-                                    //Query the reordering model
-                                    query_reordering_model();
-
-                                    //Return in case we need to stop translating
-                                    if (m_is_stop) return;
-
                                     //Perform the translation
                                     perform_translation();
                                 } else {
@@ -155,6 +159,41 @@ namespace uva {
                                 }
                             }
 
+                            /**
+                             * Allows to estimate the relative cost of translating the sentence, before it is
+                             * translated. The translation model is queried here, so it is not done again when
+                             * translating, therefore this is to be called outside of the jobs pool locks. The
+                             * estimate is the number of words times the number of translation options of all
+                             * the sentence phrases found in the model, as there is a stack level per word and
+                             * the hypotheses are expanded with the translation options.
+                             * @return the relative translation cost estimate
+                             */
+                            inline uint64_t estimate_cost() {
+                                const int32_t num_words = static_cast<int32_t> (m_sent_data.get_dim());
+
+                                //The empty and too long sentences are not translated, an error is reported
+                                if ((m_source_sent.size() == 0) || (m_sent_data.get_dim() > MAX_WORDS_PER_SENTENCE)) {
+                                    return 0;
+                                }
+
+                                //Query the translation model
+                                if (!m_is_tm_queried) {
+                                    query_translation_model();
+                                    m_is_tm_queried = true;
+                                }
+
+                                //Count the translation options of the sentence phrases
+                                uint64_t num_options = 0;
+                                for (int32_t end_wd_idx = MIN_SENT_WORD_INDEX; end_wd_idx < num_words; ++end_wd_idx) {
+                                    const int32_t first_wd_idx = max(MIN_SENT_WORD_INDEX, end_wd_idx - m_de_params.m_max_s_phrase_len + 1);
+                                    for (int32_t begin_wd_idx = first_wd_idx; begin_wd_idx <= end_wd_idx; ++begin_wd_idx) {
+                                        num_options += m_sent_data[begin_wd_idx][end_wd_idx].m_num_targets;
+                                    }
+                                }
+
+                                return num_words * num_options;
+                            }
+
                             /**
                              * Allows to obtain the translation info for the translation task.
                              * @param sent_data [in/out] the container object for the translation task info
@@ -212,8 +251,8 @@ namespace uva {
                                     //Check if this is a phrase with translation
                                     if (source_entry->has_translations()) {
                                         LOG_DEBUG1 << "The source entry [" << start_idx << ", " << end_idx << "] has translations." << END_LOG;
-                                        //Set the value with the pre-computed minimum cost
-                                        cost = source_entry->get_min_cost();
+                                        //Set the value with the minimum cost, pre-computed if the weights are the model ones
+                                        cost = phrase_data.get_min_cost();
                                         LOG_DEBUG1 << "Initialize phrase cost [" << start_idx << ", " << end_idx << "] = " << cost << END_LOG;
                                     } else {
                                         LOG_DEBUG1 << "The source entry of phrase [" << start_idx << ", " << end_idx << "] is UNK translation." << END_LOG;
@@ -221,13 +260,19 @@ namespace uva {
                                         if (start_idx == end_idx) {
                                             //For a single UNK word we take its minimum cost which will be actually 
                                             //just the UNK translation cost plus the UNK language model probability
-                                            cost = source_entry->get_min_cost();
+                                            cost = phrase_data.get_min_cost();
                                             LOG_DEBUG1 << "Initialize UNK word cost [" << start_idx << ", " << end_idx << "] = " << cost << END_LOG;
                                         } else {
                                             //The undefined log probability value "-1000" is set in the phrase data entry in its constructor!
                                             LOG_DEBUG1 << "Initialize UNK phrase cost [" << start_idx << ", " << end_idx << "] = " << cost << END_LOG;
                                         }
                                     }
+
+                                    //Add the best case lexicalized reordering costs, if needed
+                                    if (m_de_params.m_is_reord_future_cost && (phrase_data.m_num_targets > 0)) {
+                                        cost += get_best_rm_cost(phrase_data);
+                                        LOG_DEBUG1 << "Phrase cost [" << start_idx << ", " << end_idx << "] + RM = " << cost << END_LOG;
+                                    }
                                 } else {
                                     //The longer phrases do not have translations, this is normal!
                                     LOG_DEBUG1 << "Initialize TOO-LONG phrase cost [" << start_idx << ", " << end_idx << "] = " << cost << END_LOG;
@@ -237,6 +282,35 @@ namespace uva {
                                 return cost;
                             }
 
+                            /**
+                             * Allows to compute the best case lexicalized reordering cost of the source phrase.
+                             * Every translated phrase gets one "to" cost, for the orientation from the previous
+                             * phrase, and one "from" cost, for the orientation to the next phrase. So we take
+                             * the best sum of the two over the considered phrase translations.
+                             * @param phrase_data the source phrase data, with the source entry
+                             * @return the best case lexicalized reordering cost, log scale
+                             */
+                            inline prob_weight get_best_rm_cost(const phrase_data_entry & phrase_data) const {
+                                tm_const_target_entry * targets = phrase_data.m_source_entry->get_targets();
+                                const prob_weight * lambdas = m_de_params.m_weights.m_rm_lambdas;
+                                prob_weight best_cost = 0.0;
+                                for (size_t idx = 0; idx < phrase_data.m_num_targets; ++idx) {
+                                    //Get the target's reordering entry and start with the monotone orientation
+                                    const rm_entry & entry = targets[phrase_data.get_target_idx(idx)].get_rm_entry();
+                                    prob_weight from_cost = entry.get_weight<true, false>(MONOTONE_ORIENT, lambdas);
+                                    prob_weight to_cost = entry.get_weight<false, false>(MONOTONE_ORIENT, lambdas);
+                                    //Consider the other known orientations
+                                    for (int8_t orient = SWAP_ORIENT; orient < UNKNOWN_ORIENT; ++orient) {
+                                        const reordering_orientation r_orient = static_cast<reordering_orientation> (orient);
+                                        from_cost = max(from_cost, entry.get_weight<true, false>(r_orient, lambdas));
+                                        to_cost = max(to_cost, entry.get_weight<false, false>(r_orient, lambdas));
+                                    }
+                                    //Take the best sum of the costs
+                                    best_cost = ((idx == 0) ? (from_cost + to_cost) : max(best_cost, from_cost + to_cost));
+                                }
+                                return best_cost;
+                            }
+
                             /**
                              * Allows to compute the future costs for the sentence.
                              */
@@ -310,9 +384,35 @@ namespace uva {
                             }
 
                             /**
-                             * Allows to set the source sentence, this includes preparing things for decoding
+                             * Allows to set the source entry of the source phrase and to select the best
+                             * translations to consider. With the model weights the targets are stored in
+                             * the best-first order, otherwise they are ranked with the job's weights.
+                             * @param phrase_data the source phrase data to set the source entry into
+                             * @param source_entry the source entry of the phrase, not NULL
+                             */
+                            inline void set_source_entry(phrase_data_entry & phrase_data, const tm_source_entry * source_entry) {
+                                phrase_data.m_source_entry = source_entry;
+                                if (m_ranking_cache == NULL) {
+                                    const size_t trans_limit = m_de_params.m_trans_limit;
+                                    phrase_data.m_num_targets = ((trans_limit > 0) ?
+                                            min(trans_limit, source_entry->num_targets()) : source_entry->num_targets());
+                                } else {
+                                    phrase_data.m_ranking = &m_ranking_cache->get_ranking(source_entry);
+                                    phrase_data.m_num_targets = phrase_data.m_ranking->m_target_ids.size();
+                                }
+                            }
+
+                            /**
+                             * Allows to set the source sentence, this includes preparing things for decoding.
+                             * The sentence data map is the only storage used, the tokens are not copied, and
+                             * the translation model is queried once per word for all the phrases ending at it.
                              */
                             inline void query_translation_model() {
+                                //Declare the uids and the source entries of the phrases ending at the current word,
+                                //the first one is the word itself and then the longer phrases, longest first.
+                                phrase_uid phrase_uids[MAX_WORDS_PER_SENTENCE];
+                                tm_const_source_entry_ptr source_entries[MAX_WORDS_PER_SENTENCE];
+
                                 //Fill in the matrix with the phrases and their uids
                                 int32_t end_wd_idx = MIN_SENT_WORD_INDEX;
                                 //Declare the begin and end character index variables
@@ -322,38 +422,27 @@ namespace uva {
                                     //Get the appropriate map entry reference
                                     phrase_data_entry & end_word_data = m_sent_data[end_wd_idx][end_wd_idx];
 
-                                    //Get the token from the source phrase
-                                    const string token = m_source_sent.substr(ch_b_idx, ch_e_idx - ch_b_idx);
-
-                                    LOG_DEBUG1 << "Found the new token @ [" << ch_b_idx << ","
-                                            << ch_e_idx << "): ___" << token << "___" << END_LOG;
+                                    LOG_DEBUG1 << "Found the new token @ [" << ch_b_idx << "," << ch_e_idx << "): ___"
+                                            << m_source_sent.substr(ch_b_idx, ch_e_idx - ch_b_idx) << "___" << END_LOG;
 
                                     //Store the phrase begin and end character indexes
                                     end_word_data.m_begin_ch_idx = ch_b_idx;
                                     end_word_data.m_end_ch_idx = ch_e_idx;
 
-                                    //Compute the phrase id and store it as well
-                                    end_word_data.m_phrase_uid = get_phrase_uid<true>(token);
-
-                                    LOG_DEBUG1 << "The token ___" << token << "___ @ [" << ch_b_idx << ","
-                                            << ch_e_idx << ") uid is: " << end_word_data.m_phrase_uid << END_LOG;
-
-                                    LOG_DEBUG1 << "Considering the token [" << end_wd_idx << ", " << end_wd_idx << "] translation." << END_LOG;
+                                    //Compute the phrase id directly from the sentence characters and store it as well
+                                    const size_t token_len = min(ch_e_idx, m_source_sent.length()) - ch_b_idx;
+                                    end_word_data.m_phrase_uid = get_token_uid(m_source_sent.data() + ch_b_idx, token_len);
+                                    phrase_uids[0] = end_word_data.m_phrase_uid;
 
-                                    //Get the uni-gram phrase (word) translations
-                                    m_tm_query.execute(end_word_data.m_phrase_uid, end_word_data.m_source_entry);
-
-                                    LOG_DEBUG1 << "The token ___" << token << "___ @ [" << ch_b_idx << ","
-                                            << ch_e_idx << ") HAS" << (end_word_data.m_source_entry->has_translations() ? "" : " NO")
-                                            << " translation(s), num entries: " << end_word_data.m_source_entry->num_targets() << END_LOG;
+                                    LOG_DEBUG1 << "The token [" << end_wd_idx << ", " << end_wd_idx << "] uid is: "
+                                            << end_word_data.m_phrase_uid << END_LOG;
 
                                     //Compute the new phrases and phrase ids for the new column elements,
                                     //Note that, the longest phrase length to consider is defined by the
                                     //decoding parameters. It is the end word plus several previous.
-                                    int32_t begin_wd_idx = max(MIN_SENT_WORD_INDEX, end_wd_idx - m_de_params.m_max_s_phrase_len + 1);
-                                    for (; (begin_wd_idx < end_wd_idx); ++begin_wd_idx) {
-                                        LOG_DEBUG1 << "Considering the phrase [" << begin_wd_idx << ", " << end_wd_idx << "] translation." << END_LOG;
-
+                                    const int32_t first_wd_idx = max(MIN_SENT_WORD_INDEX, end_wd_idx - m_de_params.m_max_s_phrase_len + 1);
+                                    size_t num_phrases = 1;
+                                    for (int32_t begin_wd_idx = first_wd_idx; (begin_wd_idx < end_wd_idx); ++begin_wd_idx) {
                                         //Get the previous column entry
                                         phrase_data_entry & prev_entry = m_sent_data[begin_wd_idx][end_wd_idx - 1];
                                         //Get the new column entry
@@ -363,28 +452,37 @@ namespace uva {
                                         new_entry.m_begin_ch_idx = prev_entry.m_begin_ch_idx; // All the phrases in the row begin at the same place
                                         new_entry.m_end_ch_idx = end_word_data.m_end_ch_idx; //All the phrases in the column end at the same place
 
-                                        //Get the phrase for logging
-                                        const string phrase = m_source_sent.substr(new_entry.m_begin_ch_idx, new_entry.m_end_ch_idx - new_entry.m_begin_ch_idx);
-
-                                        LOG_DEBUG1 << "The phrase [" << begin_wd_idx << ", " << end_wd_idx << "] is ___" << phrase << "___" << END_LOG;
-
                                         //Compute the phrase uid
                                         new_entry.m_phrase_uid = combine_phrase_uids(prev_entry.m_phrase_uid, end_word_data.m_phrase_uid);
+                                        phrase_uids[num_phrases++] = new_entry.m_phrase_uid;
 
-                                        LOG_DEBUG1 << "The phrase ___" << phrase << "___ uid = combine(" << prev_entry.m_phrase_uid
-                                                << "," << end_word_data.m_phrase_uid << ") = " << new_entry.m_phrase_uid << END_LOG;
+                                        LOG_DEBUG1 << "The phrase [" << begin_wd_idx << ", " << end_wd_idx << "] ___"
+                                                << m_source_sent.substr(new_entry.m_begin_ch_idx, new_entry.m_end_ch_idx - new_entry.m_begin_ch_idx)
+                                                << "___ uid = combine(" << prev_entry.m_phrase_uid << "," << end_word_data.m_phrase_uid
+                                                << ") = " << new_entry.m_phrase_uid << END_LOG;
+                                    }
 
-                                        //Add the m-gram phrase to the query
-                                        m_tm_query.execute(new_entry.m_phrase_uid, new_entry.m_source_entry);
+                                    //Get the translations of all the phrases ending at this word at once
+                                    m_tm_query.execute(num_phrases, phrase_uids, source_entries);
 
-                                        LOG_DEBUG1 << "Phrase: ___" << phrase << "___ uid: " << new_entry.m_phrase_uid << " HAS"
-                                                << (new_entry.m_source_entry->has_translations() ? "" : " NO") << " translation(s),"
-                                                << " num entries: " << new_entry.m_source_entry->num_targets() << END_LOG;
+                                    //Store the source entries into the matrix
+                                    set_source_entry(end_word_data, source_entries[0]);
+                                    for (size_t idx = 1; idx < num_phrases; ++idx) {
+                                        phrase_data_entry & new_entry = m_sent_data[first_wd_idx + idx - 1][end_wd_idx];
+                                        set_source_entry(new_entry, source_entries[idx]);
 
-                                        //Check if we need to stop, if yes, then return
-                                        if (m_is_stop) return;
+                                        LOG_DEBUG1 << "The phrase [" << (first_wd_idx + idx - 1) << ", " << end_wd_idx << "] HAS"
+                                                << (new_entry.m_source_entry->has_translations() ? "" : " NO") << " translation(s),"
+                                                << " num entries: " << new_entry.m_num_targets << END_LOG;
                                     }
 
+                                    LOG_DEBUG1 << "The token [" << end_wd_idx << ", " << end_wd_idx << "] HAS"
+                                            << (end_word_data.m_source_entry->has_translations() ? "" : " NO")
+                                            << " translation(s), num entries: " << end_word_data.m_num_targets << END_LOG;
+
+                                    //Check if we need to stop, if yes, then return
+                                    if (m_is_stop) return;
+
                                     //Check on the stop condition 
                                     if (ch_e_idx == std::string::npos) {
                                         break;
@@ -399,24 +497,6 @@ namespace uva {
                                 }
                             }
 
-                            /**
-                             * Allows to query the reordering model based on the set sentence phrases
-                             */
-                            inline void query_reordering_model() {
-                                //Declare the source-target phrase uid container
-                                vector<phrase_uid> st_uids;
-
-                                //Obtain the list of source-target ids available
-                                if (!m_is_stop) {
-                                    m_tm_query.get_st_uids(st_uids);
-                                }
-
-                                //Execute the reordering model query
-                                if (!m_is_stop) {
-                                    m_rm_query.execute(st_uids);
-                                }
-                            }
-
                             /**
                              * Performs the sentence translation 
                              */
@@ -432,16 +512,32 @@ namespace uva {
                         protected:
 
                             /**
-                             * Performs the sentence translation.
+                             * Performs the sentence translation, the coverage vectors are sized
+                             * to the sentence, so that the short sentences, the common case,
+                             * have their coverage stored in a single 64-bit word.
                              * @tparam is_dist true if we need to 
                              */
                             template<bool is_dist>
                             inline void perform_translation() {
-                                typedef multi_stack_templ<is_dist, MAX_WORDS_PER_SENTENCE, LM_HISTORY_LEN_MAX, LM_MAX_QUERY_LEN> stack_type;
+                                if (m_sent_data.get_dim() <= SHORT_SENTENCE_MAX_WORDS) {
+                                    perform_translation<is_dist, SHORT_SENTENCE_MAX_WORDS>();
+                                } else {
+                                    perform_translation<is_dist, MAX_WORDS_PER_SENTENCE>();
+                                }
+                            }
+
+                            /**
+                             * Performs the sentence translation.
+                             * @tparam is_dist true if we need to 
+                             * @tparam NUM_WORDS_PER_SENTENCE the maximum number of words in the sentence
+                             */
+                            template<bool is_dist, size_t NUM_WORDS_PER_SENTENCE>
+                            inline void perform_translation() {
+                                typedef multi_stack_templ<is_dist, NUM_WORDS_PER_SENTENCE, LM_HISTORY_LEN_MAX, LM_MAX_QUERY_LEN> stack_type;
 
                                 //Instantiate the multi-stack
-                                stack_type * stack = new stack_type(m_de_params, m_is_stop,
-                                        m_source_sent, m_sent_data, m_rm_query, m_lm_query);
+                                stack_type * stack = new stack_type(m_de_params, m_tm_weights, m_is_stop,
+                                        m_source_sent, m_sent_data, m_rm_query, m_lm_query, m_expand_pool);
 
                                 //Store the stack pointer for getting the translation info
                                 //later, if needed, and also for a safe destruction
@@ -476,6 +572,12 @@ namespace uva {
 
                             //Stores the reference to the decoder parameters
                             const de_parameters & m_de_params;
+                            //Stores the translations ranking cache of the job, NULL if the model weights are used
+                            tm_ranking_cache * m_ranking_cache;
+                            //Stores the weights to compute the translation costs with, NULL if the model ones
+                            const feature_weights * m_tm_weights;
+                            //Stores the pointer to the parallel level expansion pool or NULL
+                            fork_join_pool * m_expand_pool;
                             //Stores the stopping flag
                             acr_bool_flag m_is_stop;
 
@@ -486,6 +588,8 @@ namespace uva {
 
                             //Stores the pointer to the sentence data map
                             sentence_data_map m_sent_data;
+                            //Stores the flag indicating whether the translation model was already queried
+                            bool m_is_tm_queried;
 
                             //The reference to the translation model query proxy
                             lm_fast_query_proxy & m_lm_query;
@@ -0,0 +1,237 @@
+/*
+ * File:   coverage_vector.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 17, 2026, 5:50 PM
+ */
+
+#ifndef COVERAGE_VECTOR_HPP
+#define COVERAGE_VECTOR_HPP
+
+#include <cstdint>
+#include <algorithm>
+
+#include "common/utils/hashing_utils.hpp"
+
+using namespace std;
+
+using namespace uva::utils::hashing;
+
+namespace uva {
+    namespace smt {
+        namespace bpbd {
+            namespace server {
+                namespace decoder {
+                    namespace stack {
+
+                        /**
+                         * This class represents the source sentence coverage vector of a hypothesis state.
+                         * The covered word positions are stored as bits in 64-bit words, so that the
+                         * covered and not-covered positions are searched for a word at a time, by means
+                         * of counting the trailing and leading zeros, and not a position at a time.
+                         * The positions beyond the sentence end are never covered.
+                         * @param NUM_WORDS_PER_SENTENCE the maximum number of words in the sentence
+                         */
+                        template<size_t NUM_WORDS_PER_SENTENCE>
+                        class coverage_vector_templ {
+                        public:
+                            //Stores the number of bits per bit-storage word
+                            static constexpr int32_t NUM_WORD_BITS = 64;
+                            //Stores the number of bit-storage words
+                            static constexpr int32_t NUM_WORDS = (NUM_WORDS_PER_SENTENCE + NUM_WORD_BITS - 1) / NUM_WORD_BITS;
+                            //Stores the number of positions in the vector
+                            static constexpr int32_t NUM_POSITIONS = NUM_WORDS * NUM_WORD_BITS;
+
+                            /**
+                             * The basic constructor, nothing is covered
+                             */
+                            coverage_vector_templ() : m_words() {
+                            }
+
+                            /**
+                             * Allows to check if the given position is covered
+                             * @param pos the position to check
+                             * @return true if the position is covered, otherwise false
+                             */
+                            inline bool operator[](const int32_t pos) const {
+                                return (m_words[pos / NUM_WORD_BITS] >> (pos % NUM_WORD_BITS)) & 1u;
+                            }
+
+                            /**
+                             * Allows to mark the range of positions as covered
+                             * @param begin_pos the first position to cover
+                             * @param end_pos the last position to cover, not smaller than the first one
+                             */
+                            inline void set(const int32_t begin_pos, const int32_t end_pos) {
+                                const int32_t end_idx = end_pos / NUM_WORD_BITS;
+                                for (int32_t idx = begin_pos / NUM_WORD_BITS; idx <= end_idx; ++idx) {
+                                    //Get the first and the last bits to set in this word
+                                    const int32_t first_bit = max(begin_pos - idx * NUM_WORD_BITS, 0);
+                                    const int32_t last_bit = min(end_pos - idx * NUM_WORD_BITS, NUM_WORD_BITS - 1);
+                                    m_words[idx] |= (ALL_ONES >> (NUM_WORD_BITS - 1 - last_bit + first_bit)) << first_bit;
+                                }
+                            }
+
+                            /**
+                             * Allows to count the number of covered positions
+                             * @return the number of covered positions
+                             */
+                            inline int32_t count() const {
+                                int32_t result = 0;
+                                for (int32_t idx = 0; idx < NUM_WORDS; ++idx) {
+                                    result += __builtin_popcountll(m_words[idx]);
+                                }
+                                return result;
+                            }
+
+                            /**
+                             * Allows to find the first covered position starting from the given one
+                             * @param pos the position to start from, inclusive
+                             * @return the found position or NUM_POSITIONS if there is none
+                             */
+                            inline int32_t next_covered(const int32_t pos) const {
+                                return find_next<false>(pos);
+                            }
+
+                            /**
+                             * Allows to find the first not-covered position starting from the given one
+                             * @param pos the position to start from, inclusive
+                             * @return the found position or NUM_POSITIONS if there is none
+                             */
+                            inline int32_t next_uncovered(const int32_t pos) const {
+                                return find_next<true>(pos);
+                            }
+
+                            /**
+                             * Allows to find the last covered position up to the given one
+                             * @param pos the position to search back from, inclusive
+                             * @return the found position or -1 if there is none
+                             */
+                            inline int32_t prev_covered(const int32_t pos) const {
+                                return find_prev<false>(pos);
+                            }
+
+                            /**
+                             * Allows to find the last not-covered position up to the given one
+                             * @param pos the position to search back from, inclusive
+                             * @return the found position or -1 if there is none
+                             */
+                            inline int32_t prev_uncovered(const int32_t pos) const {
+                                return find_prev<true>(pos);
+                            }
+
+                            /**
+                             * Allows to compare two coverage vectors
+                             * @param other the coverage vector to compare with
+                             * @return true if the same positions are covered, otherwise false
+                             */
+                            inline bool operator==(const coverage_vector_templ & other) const {
+                                for (int32_t idx = 0; idx < NUM_WORDS; ++idx) {
+                                    if (m_words[idx] != other.m_words[idx]) {
+                                        return false;
+                                    }
+                                }
+                                return true;
+                            }
+
+                            /**
+                             * Allows to compute the hash of the coverage vector
+                             * @return the hash of the covered positions
+                             */
+                            inline uint_fast64_t get_hash() const {
+                                return MurmurHash64A(m_words, sizeof (m_words));
+                            }
+
+                        private:
+                            //Stores the bit-storage word with all the bits set
+                            static constexpr uint64_t ALL_ONES = ~static_cast<uint64_t> (0);
+
+                            /**
+                             * Allows to find the first position, starting from the given one, with the given coverage
+                             * @param is_not if true then search for a not-covered position, otherwise for a covered one
+                             * @param pos the position to start from, inclusive
+                             * @return the found position or NUM_POSITIONS if there is none
+                             */
+                            template<bool is_not>
+                            inline int32_t find_next(const int32_t pos) const {
+                                int32_t idx = pos / NUM_WORD_BITS;
+                                if (idx < NUM_WORDS) {
+                                    //Mask the bits before the position in the first word
+                                    uint64_t word = (is_not ? ~m_words[idx] : m_words[idx]) & (ALL_ONES << (pos % NUM_WORD_BITS));
+                                    while (true) {
+                                        if (word != 0) {
+                                            return idx * NUM_WORD_BITS + __builtin_ctzll(word);
+                                        }
+                                        if (++idx == NUM_WORDS) {
+                                            break;
+                                        }
+                                        word = (is_not ? ~m_words[idx] : m_words[idx]);
+                                    }
+                                }
+                                return NUM_POSITIONS;
+                            }
+
+                            /**
+                             * Allows to find the last position, up to the given one, with the given coverage
+                             * @param is_not if true then search for a not-covered position, otherwise for a covered one
+                             * @param pos the position to search back from, inclusive
+                             * @return the found position or -1 if there is none
+                             */
+                            template<bool is_not>
+                            inline int32_t find_prev(const int32_t pos) const {
+                                int32_t idx = pos / NUM_WORD_BITS;
+                                if (pos >= 0) {
+                                    //Mask the bits after the position in the first word
+                                    uint64_t word = (is_not ? ~m_words[idx] : m_words[idx]) &
+                                            (ALL_ONES >> (NUM_WORD_BITS - 1 - (pos % NUM_WORD_BITS)));
+                                    while (true) {
+                                        if (word != 0) {
+                                            return idx * NUM_WORD_BITS + (NUM_WORD_BITS - 1 - __builtin_clzll(word));
+                                        }
+                                        if (--idx < 0) {
+                                            break;
+                                        }
+                                        word = (is_not ? ~m_words[idx] : m_words[idx]);
+                                    }
+                                }
+                                return -1;
+                            }
+
+                            //Stores the bits of the covered positions
+                            uint64_t m_words[NUM_WORDS];
+                        };
+
+                        template<size_t NUM_WORDS_PER_SENTENCE>
+                        constexpr int32_t coverage_vector_templ<NUM_WORDS_PER_SENTENCE>::NUM_WORD_BITS;
+                        template<size_t NUM_WORDS_PER_SENTENCE>
+                        constexpr int32_t coverage_vector_templ<NUM_WORDS_PER_SENTENCE>::NUM_WORDS;
+                        template<size_t NUM_WORDS_PER_SENTENCE>
+                        constexpr int32_t coverage_vector_templ<NUM_WORDS_PER_SENTENCE>::NUM_POSITIONS;
+                        template<size_t NUM_WORDS_PER_SENTENCE>
+                        constexpr uint64_t coverage_vector_templ<NUM_WORDS_PER_SENTENCE>::ALL_ONES;
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif /* COVERAGE_VECTOR_HPP */
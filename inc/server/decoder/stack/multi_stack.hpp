@@ -28,10 +28,14 @@
 
 #include <string>
 #include <sstream>
+#include <vector>
+#include <deque>
 #include <functional>
+#include <type_traits>
 
 #include "common/utils/text/string_utils.hpp"
 #include "common/utils/threads/threads.hpp"
+#include "common/utils/threads/fork_join_pool.hpp"
 #include "common/utils/exceptions.hpp"
 #include "common/utils/logging/logger.hpp"
 
@@ -74,6 +78,10 @@ namespace uva {
                         //Stores the minimum stack level index
                         static constexpr int32_t MIN_STACK_LEVEL = 0;
 
+                        //Stores the minimum number of level states per parallel expansion part,
+                        //the smaller levels are expanded by the decoding thread only
+                        static constexpr size_t MIN_STATES_PER_EXPAND_PART = 4;
+
                         /**
                          * This is the translation stack class that is responsible for the sentence translation
                          * @param is_dist the flag indicating whether there is a left distortion limit or not
@@ -94,24 +102,114 @@ namespace uva {
                             typedef typename stack_data::stack_state_ptr stack_state_ptr;
                             //Typedef the state
                             typedef typename stack_data::stack_state stack_state;
+                            //Typedef the state memory pool
+                            typedef typename stack_data::state_pool state_pool;
+
+                            /**
+                             * This structure stores the data of a parallel level expansion part. The part
+                             * has its own LM query and uses its own state memory pool, the new states and cube pruning
+                             * candidates are buffered and are merged into the multi-stack by the decoding
+                             * thread after all the parts are done, in the order of the parts. The memory
+                             * pools are not thread safe so no state may be destroyed, by pruning or
+                             * recombination, while the parts are expanding. The states created by
+                             * the part refer to its stack data, so it is to live as long as the multi-stack.
+                             */
+                            struct expand_part {
+
+                                /**
+                                 * This structure stores the buffered cube pruning candidate
+                                 */
+                                struct cand_entry {
+                                    //Stores the pointer to the state to be expanded
+                                    stack_state_ptr m_parent;
+                                    //Stores the first non-covered word search position for the new state
+                                    int32_t m_fncs_pos;
+                                    //Stores the source phrase begin position
+                                    int32_t m_begin_pos;
+                                    //Stores the source phrase end position
+                                    int32_t m_end_pos;
+                                    //Stores the score estimate without the translation costs
+                                    prob_weight m_base_score;
+                                };
+
+                                /**
+                                 * The basic constructor
+                                 * @param data the multi-stack's shared stack data
+                                 * @param pool the part's state memory pool
+                                 */
+                                expand_part(const stack_data & data, state_pool & pool)
+                                : m_pool(pool), m_lm_query(lm_configurator::allocate_fast_query_proxy()),
+                                m_states(), m_cands(), m_data(data.m_params, data.m_tm_weights, data.m_is_stop, data.m_source_sent,
+                                data.m_sent_data, data.m_rm_query, m_lm_query, m_pool,
+                                bind(&expand_part::add_state, this, _1),
+                                bind(&expand_part::add_cand, this, _1, _2, _3, _4, _5)) {
+                                }
+
+                                /**
+                                 * The basic destructor
+                                 */
+                                ~expand_part() {
+                                    lm_configurator::dispose_fast_query_proxy(m_lm_query);
+                                }
+
+                                /**
+                                 * Allows to buffer the new stack state
+                                 * @param new_state the new stack state, not NULL
+                                 */
+                                inline void add_state(stack_state_ptr new_state) {
+                                    m_states.push_back(new_state);
+                                }
+
+                                /**
+                                 * Allows to buffer the new cube pruning candidate
+                                 * @see stack_level::add_cand
+                                 */
+                                inline void add_cand(stack_state_ptr parent, const int32_t fncs_pos,
+                                        const int32_t begin_pos, const int32_t end_pos, const prob_weight base_score) {
+                                    m_cands.push_back({parent, fncs_pos, begin_pos, end_pos, base_score});
+                                }
+
+                                //Stores the reference to the part's memory pool for the stack states
+                                state_pool & m_pool;
+                                //Stores the part's language model query
+                                lm_fast_query_proxy & m_lm_query;
+                                //Stores the buffered new states
+                                vector<stack_state_ptr> m_states;
+                                //Stores the buffered new cube pruning candidates
+                                vector<cand_entry> m_cands;
+                                //Stores the part's stack data, is to be declared last
+                                const stack_data m_data;
+                            };
 
                             /**
                              * The basic constructor
                              * @param params the decoder parameters, stores the reference to it
+                             * @param tm_weights the weights to compute the translation costs with,
+                             *                   NULL if the pre-computed model ones are to be used
                              * @param is_stop the stop flag
                              * @param source_sent the reference to the source sentence
                              * @param sent_data the retrieved sentence data
                              * @param rm_query the reordering model query
                              * @param lm_query the language model query object
+                             * @param expand_pool the pool for the parallel level expansion or NULL if none
                              */
                             multi_stack_templ(const de_parameters & params,
+                                    const feature_weights * tm_weights,
                                     acr_bool_flag is_stop,
                                     const string & source_sent,
                                     const sentence_data_map & sent_data,
                                     const rm_query_proxy & rm_query,
-                                    lm_fast_query_proxy & lm_query)
-                            : m_data(params, is_stop, source_sent, sent_data, rm_query, lm_query, bind(&multi_stack_templ::add_stack_state, this, _1)),
-                            m_num_levels(m_data.m_sent_data.get_dim() + NUM_EXTRA_STACK_LEVELS) {
+                                    lm_fast_query_proxy & lm_query,
+                                    fork_join_pool * expand_pool)
+                            : m_state_pool(get_thread_pool(0)), m_data(params, tm_weights, is_stop, source_sent, sent_data, rm_query, lm_query,
+                            m_state_pool, bind(&multi_stack_templ::add_stack_state, this, _1),
+                            bind(&multi_stack_templ::add_cube_cand, this, _1, _2, _3, _4, _5)),
+                            m_num_levels(m_data.m_sent_data.get_dim() + NUM_EXTRA_STACK_LEVELS),
+                            m_expand_pool(expand_pool), m_parts(), m_bounds(), m_num_allocs(0), m_num_bytes(0) {
+                                //The states of the previous sentence are dropped by resetting their pool
+                                static_assert(is_trivially_destructible<stack_state>::value,
+                                        "The pooled stack states must be trivially destructible!");
+
                                 LOG_DEBUG1 << "Created a multi stack with parameters: " << m_data.m_params << END_LOG;
 
                                 LOG_DEBUG2 << "Creating a stack levels array of " << m_num_levels << " elements." << END_LOG;
@@ -135,7 +233,7 @@ namespace uva {
                                 //information about the sentence data, rm and lm query and 
                                 //have a method for adding a state expansion to the stack.
                                 LOG_DEBUG2 << "Creating the begin stack state" << END_LOG;
-                                stack_state_ptr begin_state = new stack_state(m_data);
+                                stack_state_ptr begin_state = new(m_state_pool) stack_state(m_data);
                                 LOG_DEBUG2 << "Adding the begin stack state to level " << MIN_STACK_LEVEL << END_LOG;
                                 add_stack_state(begin_state);
 
@@ -161,6 +259,14 @@ namespace uva {
                                     delete[] m_levels;
                                     m_levels = NULL;
                                 }
+
+                                LOG_INFO1 << "Multi-stack " << this << " allocated " << m_num_allocs
+                                        << " state(s) in " << m_num_bytes << " bytes" << END_LOG;
+
+                                //Delete the expansion parts, their states are dropped with the pools
+                                for (auto part : m_parts) {
+                                    delete part;
+                                }
                             }
 
                             /**
@@ -179,6 +285,9 @@ namespace uva {
 
                                 //Allows to end the loads array entry
                                 sent_data.end_loads_arr();
+
+                                //Add the state memory pool usage
+                                sent_data.set_stack_mem(m_num_allocs, m_num_bytes);
                             }
 
 #if IS_SERVER_TUNING_MODE
@@ -250,7 +359,7 @@ namespace uva {
 
                                     //Here we expand the stack level and then
                                     //increment the current level index variable
-                                    m_levels[curr_level]->expand();
+                                    expand_level(m_levels[curr_level]);
 
                                     LOG_DEBUG << "<<<<< End LEVEL (" << curr_level << "/ " << MAX_STACK_LEVEL
                                             << ") expansion, #states=" << m_levels[curr_level]->get_size() << END_LOG;
@@ -258,6 +367,12 @@ namespace uva {
                                     //Move to the next level
                                     ++curr_level;
                                 }
+
+                                //The last stack level is not expanded but is to be finalized
+                                m_levels[MAX_STACK_LEVEL]->finalize();
+
+                                //Store the pools usage as the pools are reset by the next sentence
+                                store_pools_usage();
                             }
 
                             /**
@@ -280,6 +395,93 @@ namespace uva {
 
                         protected:
 
+                            /**
+                             * Allows to expand the given stack level. If the expansion pool is present
+                             * and the level is large enough then the level states are split into
+                             * contiguous ranges expanded in parallel. The ranges' new states and
+                             * candidates are buffered and then, once all the ranges are expanded,
+                             * added in the order of the ranges. So the result is the same as when
+                             * the states are expanded one by one by this thread.
+                             * @param level the stack level to expand
+                             */
+                            inline void expand_level(stack_level_ptr level) {
+                                //Make sure the states are in the level list
+                                level->finalize();
+
+                                //Compute the number of expansion parts
+                                const size_t num_parts = (m_expand_pool == NULL) ? 1 :
+                                        min(m_expand_pool->get_num_threads(), level->get_size() / MIN_STATES_PER_EXPAND_PART);
+
+                                if (num_parts <= 1) {
+                                    //Expand the level by this thread
+                                    level->expand(m_data);
+                                } else {
+                                    //Create the missing expansion parts
+                                    while (m_parts.size() < num_parts) {
+                                        m_parts.push_back(new expand_part(m_data, get_thread_pool(m_parts.size() + 1)));
+                                    }
+
+                                    //Split the level states and expand the ranges in parallel
+                                    level->split_states(num_parts, m_bounds);
+                                    m_expand_pool->run(num_parts, [this, level](const size_t part_idx) {
+                                        level->expand_states(m_parts[part_idx]->m_data,
+                                                m_bounds[part_idx], m_bounds[part_idx + 1]);
+                                    });
+
+                                    //Add the buffered states and candidates in the order of the parts
+                                    for (size_t idx = 0; idx < num_parts; ++idx) {
+                                        expand_part & part = *m_parts[idx];
+                                        for (auto new_state : part.m_states) {
+                                            add_stack_state(new_state);
+                                        }
+                                        part.m_states.clear();
+                                        for (auto & cand : part.m_cands) {
+                                            add_cube_cand(cand.m_parent, cand.m_fncs_pos, cand.m_begin_pos,
+                                                    cand.m_end_pos, cand.m_base_score);
+                                        }
+                                        part.m_cands.clear();
+                                    }
+
+                                    //In the cube mode the states only registered their expansion candidates
+                                    if (m_data.m_is_cube_mode) {
+                                        level->expand_cands(m_data);
+                                    }
+                                }
+                            }
+
+                            /**
+                             * Allows to get the memory pool for the stack states from the pools of the
+                             * decoding thread. The pools are kept per decoding thread and are re-used
+                             * for the next sentences, the first pool is for the decoding thread itself
+                             * and the others are for the parallel expansion parts. The pool is reset,
+                             * so the states of the previous sentence decoded by this thread are gone.
+                             * @param pool_idx the index of the pool
+                             * @return the reset memory pool
+                             */
+                            static inline state_pool & get_thread_pool(const size_t pool_idx) {
+                                //The deque is used as it does not move the pools when growing
+                                static thread_local deque<state_pool> pools;
+                                while (pools.size() <= pool_idx) {
+                                    pools.emplace_back();
+                                }
+                                state_pool & pool = pools[pool_idx];
+                                pool.reset();
+                                return pool;
+                            }
+
+                            /**
+                             * Allows to store the number of states allocated and the number of bytes
+                             * used by the memory pools, is to be called once the expansion is done
+                             */
+                            inline void store_pools_usage() {
+                                m_num_allocs = m_state_pool.get_num_allocs();
+                                m_num_bytes = m_state_pool.get_num_bytes();
+                                for (auto part : m_parts) {
+                                    m_num_allocs += part->m_pool.get_num_allocs();
+                                    m_num_bytes += part->m_pool.get_num_bytes();
+                                }
+                            }
+
                             /**
                              * Allows to add a new stack state into the proper stack level
                              * @param new_state the new stack state, not NULL
@@ -319,7 +521,25 @@ namespace uva {
                                 LOG_DEBUG1 << "++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++++" << END_LOG;
                             }
 
+                            /**
+                             * Allows to add a new cube pruning expansion candidate into the stack level of its state
+                             * @param parent the state to be expanded, not NULL
+                             * @param fncs_pos the first non-covered word search position for the new state
+                             * @param begin_pos the source phrase begin position
+                             * @param end_pos the source phrase end position
+                             * @param base_score the score estimate without the translation costs
+                             */
+                            inline void add_cube_cand(stack_state_ptr parent, const int32_t fncs_pos,
+                                    const int32_t begin_pos, const int32_t end_pos, const prob_weight base_score) {
+                                //The candidate belongs to the level being expanded, i.e. the one of its state
+                                m_levels[parent->get_stack_level()]->add_cand(parent, fncs_pos, begin_pos, end_pos, base_score);
+                            }
+
                         private:
+                            //Stores the reference to the decoding thread's memory pool for the
+                            //stack states, is to be declared before the stack data that refers to it
+                            state_pool & m_state_pool;
+
                             //Stores the shared data for the stack and its elements
                             const stack_data m_data;
 
@@ -329,6 +549,20 @@ namespace uva {
                             //This is a pointer to the array of stacks, one stack per number of covered words.
                             stack_level_ptr * m_levels;
 
+                            //Stores the pool for the parallel level expansion or NULL if none
+                            fork_join_pool * m_expand_pool;
+
+                            //Stores the parallel level expansion parts, are created on demand
+                            vector<expand_part *> m_parts;
+
+                            //Stores the state range bounds of the parallel level expansion
+                            vector<stack_state_ptr> m_bounds;
+
+                            //Stores the number of states allocated from the memory pools
+                            size_t m_num_allocs;
+                            //Stores the number of bytes used by the memory pools
+                            size_t m_num_bytes;
+
 #if IS_SERVER_TUNING_MODE
                             //Stores the number of allocated states
                             int32_t m_state_counter;
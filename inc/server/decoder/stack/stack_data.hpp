@@ -11,6 +11,7 @@
 #include <functional>
 
 #include "common/utils/threads/threads.hpp"
+#include "common/utils/containers/object_pool.hpp"
 
 #include "server/decoder/sentence/sentence_data_map.hpp"
 #include "server/rm/proxy/rm_query_proxy.hpp"
@@ -19,6 +20,7 @@
 using namespace std;
 
 using namespace uva::utils::threads;
+using namespace uva::utils::containers;
 
 using namespace uva::smt::bpbd::server::rm::proxy;
 using namespace uva::smt::bpbd::server::lm::proxy;
@@ -56,29 +58,53 @@ namespace uva {
                             //Define the multi state pointer
                             typedef const stack_state * const_stack_state_ptr;
 
+                            //Define the memory pool for the multi states
+                            typedef object_pool<stack_state> state_pool;
+
                             //The typedef for a function that adds a new state to the multi-stack
                             typedef function<void(stack_state_ptr) > add_new_state_function;
 
+                            //The typedef for a function that adds a new cube pruning expansion candidate, the arguments
+                            //are: the parent state, the first non-covered search position, the source phrase begin and
+                            //end positions and the estimated score of the expansions without the translation costs.
+                            typedef function<void(stack_state_ptr, const int32_t, const int32_t, const int32_t, const prob_weight) > add_new_cand_function;
+
                             /**
                              * The basic constructor to initialize the stored references
                              * @param params the decoder parameters
+                             * @param tm_weights the weights to compute the translation costs with,
+                             *                   NULL if the pre-computed model ones are to be used
                              * @param is_stop the stopping flag
                              * @param source_sent the reference to the source sentence
                              * @param sent_data the sentence data
                              * @param rm_query the reordering model query
                              * @param lm_query the language model query to be used
+                             * @param pool the memory pool for the multi states
                              * @param add_state the function needed to add new states
+                             * @param add_cand the function needed to add new cube pruning candidates
                              */
-                            stack_data_templ(const de_parameters & params, acr_bool_flag is_stop, const string & source_sent,
+                            stack_data_templ(const de_parameters & params, const feature_weights * tm_weights,
+                                    acr_bool_flag is_stop, const string & source_sent,
                                     const sentence_data_map & sent_data, const rm_query_proxy & rm_query,
-                                    lm_fast_query_proxy & lm_query, const add_new_state_function & add_state)
-                            : m_params(params), m_is_stop(is_stop), m_source_sent(source_sent), m_sent_data(sent_data),
-                            m_rm_query(rm_query), m_lm_query(lm_query), m_add_state(add_state) {
+                                    lm_fast_query_proxy & lm_query, state_pool & pool,
+                                    const add_new_state_function & add_state,
+                                    const add_new_cand_function & add_cand)
+                            : m_params(params), m_tm_weights(tm_weights),
+                            m_is_cube_mode(params.m_is_cube_mode), m_is_stop(is_stop), m_source_sent(source_sent), m_sent_data(sent_data),
+                            m_rm_query(rm_query), m_lm_query(lm_query), m_state_pool(pool), m_add_state(add_state),
+                            m_add_cand(add_cand) {
                             }
 
                             //The decoder parameters
                             const de_parameters & m_params;
 
+                            //The weights to compute the translation costs with, NULL for the model ones
+                            const feature_weights * m_tm_weights;
+
+                            //The cube pruning mode flag, the cube pruning relies on the translations
+                            //being ranked by their costs, with the job's weights if they are not the model ones
+                            const bool m_is_cube_mode;
+
                             //The stopping flag
                             acr_bool_flag m_is_stop;
 
@@ -94,9 +120,15 @@ namespace uva {
                             //The language model query to be used
                             lm_fast_query_proxy & m_lm_query;
 
+                            //The memory pool for the multi states
+                            state_pool & m_state_pool;
+
                             //The function needed to add new states
                             const add_new_state_function m_add_state;
 
+                            //The function needed to add new cube pruning candidates
+                            const add_new_cand_function m_add_cand;
+
                             /**
                              * Allows to retrieve the number of feature scores for the lattice dump
                              * @return the number of features used in the model
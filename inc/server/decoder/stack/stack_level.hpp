@@ -10,6 +10,10 @@
 
 #include <string>
 #include <sstream>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include <queue>
 
 #include "common/utils/threads/threads.hpp"
 #include "common/utils/exceptions.hpp"
@@ -39,7 +43,16 @@ namespace uva {
                     namespace stack {
 
                         /**
-                         * Represents the multi-stack level
+                         * Represents the multi-stack level. Depending on the decoder parameters the level
+                         * is either a list level or a hash level. The list level keeps the states in a
+                         * score-sorted list and does a linear search for recombination. The hash level
+                         * indexes the states by their recombination signature and keeps them in a min-heap
+                         * bounded by the stack capacity, the states are only sorted once the level is
+                         * finalized, i.e. before its expansion. In the cube pruning mode the level
+                         * states only register their expansion candidates, i.e. the (state, source
+                         * phrase) pairs. The candidates are then popped best-first from a priority
+                         * queue, one translation at a time, and only up to the pop limit of the new
+                         * states are created and fully scored per level expansion.
                          * @param is_dist the flag indicating whether there is a left distortion limit or not
                          * @param NUM_WORDS_PER_SENTENCE the maximum allowed number of words per sentence
                          * @param MAX_HISTORY_LENGTH the maximum allowed length of the target translation hystory
@@ -57,6 +70,58 @@ namespace uva {
                             //Typedef the state pointer
                             typedef typename stack_state::const_stack_state_ptr const_stack_state_ptr;
 
+                            /**
+                             * This structure represents a cube pruning expansion candidate, i.e.
+                             * the state expansion with the given source phrase. The candidate
+                             * keeps the index of its next, yet not materialized, translation.
+                             */
+                            struct cube_cand {
+                                //Stores the pointer to the state to be expanded
+                                stack_state_ptr m_parent;
+                                //Stores the first non-covered word search position for the new state
+                                int32_t m_fncs_pos;
+                                //Stores the source phrase begin position
+                                int32_t m_begin_pos;
+                                //Stores the source phrase end position
+                                int32_t m_end_pos;
+                                //Stores the source phrase data
+                                const phrase_data_entry * m_phrase;
+                                //Stores the rank of the next translation target
+                                size_t m_rank;
+                                //Stores the index of the next translation target
+                                size_t m_target_idx;
+                                //Stores the score estimate without the translation costs
+                                prob_weight m_base_score;
+                                //Stores the score estimate of the next translation target
+                                prob_weight m_score;
+
+                                /**
+                                 * Allows to compare the candidates by their score estimates
+                                 * @param other the other candidate to compare with
+                                 * @return true if this candidate is less probable than the other one
+                                 */
+                                inline bool operator<(const cube_cand & other) const {
+                                    return m_score < other.m_score;
+                                }
+
+                                /**
+                                 * Allows to set the translation target to be expanded next,
+                                 * if present, and to re-compute the candidate's score estimate.
+                                 * @param rank the rank of the translation target
+                                 * @return true if there is such a target, otherwise false
+                                 */
+                                inline bool set_target(const size_t rank) {
+                                    m_rank = rank;
+                                    if (m_rank < m_phrase->m_num_targets) {
+                                        m_target_idx = m_phrase->get_target_idx(m_rank);
+                                        m_score = m_base_score + m_phrase->m_source_entry->template get_tm_cost<false>(
+                                                m_target_idx, m_parent->m_state_data.m_stack_data.m_tm_weights);
+                                        return true;
+                                    }
+                                    return false;
+                                }
+                            };
+
                             /**
                              * This class represents the constant stack level iterator
                              */
@@ -118,27 +183,17 @@ namespace uva {
                              */
                             stack_level_templ(const de_parameters & params, acr_bool_flag is_stop)
                             : m_params(params), m_is_stop(is_stop), m_first_state(NULL),
-                            m_last_state(NULL), m_size(0), m_score_bound(0.0) {
+                            m_last_state(NULL), m_size(0), m_score_bound(0.0),
+                            m_is_hash_level(params.m_is_hash_level), m_heap(), m_sig_map(), m_cube_queue() {
                                 LOG_DEBUG3 << "stack_level create, with parameters: " << m_params << END_LOG;
                             }
 
                             /**
-                             * The basic destructor, this implementation is iterative.
+                             * The basic destructor, the states are not destroyed one by one
+                             * as their memory pools are reset for the next sentence
                              */
                             ~stack_level_templ() {
                                 LOG_DEBUG1 << "Destructing level " << this << ", # states: " << m_size << END_LOG;
-
-                                //Delete the states one by one
-                                stack_state_ptr curr_state = m_first_state;
-                                stack_state_ptr next_state = NULL;
-                                while (curr_state != NULL) {
-                                    //Store the next state
-                                    next_state = curr_state->m_next;
-                                    //Delete the current state
-                                    delete curr_state;
-                                    //Set the next state as the current one
-                                    curr_state = next_state;
-                                }
                             }
 
                             /**
@@ -172,43 +227,47 @@ namespace uva {
                                 LOG_DEBUG1 << "Adding a new state (" << new_state << ") to the "
                                         << "level with " << m_size << " state(s)." << END_LOG;
 
-                                //If there is no states in the level yet, then set this one as the first
-                                if (m_first_state == NULL) {
-                                    LOG_DEBUG1 << "Setting (" << new_state
-                                            << ") as the first/last in the level!" << END_LOG;
-
-                                    //Insert this state as the first one
-                                    insert_as_first(new_state);
+                                if (m_is_hash_level) {
+                                    add_state_hash(new_state);
                                 } else {
-                                    //Do not even consider the new state unless it is above the threshold
-                                    if (new_state->is_above_threshold(m_score_bound)) {
-                                        //Declare the state pointer that shall point to the
-                                        //position prior to which the new state is to be added.
-                                        stack_state_ptr curr_state = NULL;
+                                    add_state_list(new_state);
+                                }
 
-                                        //Find the position the new state is to be inserted
-                                        //into or possibly recombine, with an existing state.
-                                        if (!find_pos_recombine(curr_state, *new_state)) {
-                                            LOG_DEBUG1 << "The last considered state is: " << curr_state << END_LOG;
+                                LOG_DEBUG1 << "The new number of level states: " << m_size << END_LOG;
+                            }
 
-                                            //Check if we found a state which is less probable than the new one
-                                            if (curr_state != NULL) {
-                                                //We need to add the new state before some existing state
-                                                add_before(curr_state, new_state);
-                                            } else {
-                                                //Add the new state as the last state inside the level
-                                                add_last(new_state);
-                                            }
+                            /**
+                             * Allows to finalize the level, is to be called once no new states are
+                             * to be added into it. For the hash level, the heap states are sorted
+                             * by their total score and linked into the level list, so that they can
+                             * be expanded and iterated over. For the list level it does nothing.
+                             */
+                            inline void finalize() {
+                                if (m_is_hash_level && !m_heap.empty()) {
+                                    LOG_DEBUG1 << "Finalizing the hash level with " << m_size << " state(s)." << END_LOG;
+
+                                    //Sort the states in the descending order of their total scores
+                                    sort(m_heap.begin(), m_heap.end(), [] (stack_state_ptr first, stack_state_ptr second) {
+                                        return (*second < *first);
+                                    });
+
+                                    //Link the sorted states into the level list, the size does not change
+                                    stack_state_ptr prev_state = NULL;
+                                    for (auto state : m_heap) {
+                                        state->m_prev = prev_state;
+                                        state->m_next = NULL;
+                                        if (prev_state != NULL) {
+                                            prev_state->m_next = state;
                                         }
-                                    } else {
-                                        //The new state is below the threshold, so delete it
-                                        LOG_DEBUG1 << "Deleting (threshold pruning) the ("
-                                                << new_state << ") state!" << END_LOG;
-                                        delete new_state;
+                                        prev_state = state;
                                     }
-                                }
+                                    m_first_state = m_heap.front();
+                                    m_last_state = m_heap.back();
 
-                                LOG_DEBUG1 << "The new number of level states: " << m_size << END_LOG;
+                                    //The heap and the index are not needed any more
+                                    m_heap.clear();
+                                    m_sig_map.clear();
+                                }
                             }
 
                             /**
@@ -216,17 +275,60 @@ namespace uva {
                              * goes through all the stack elements one by one and expands them.
                              * We could have done this recursively but this way we avoid stack
                              * allocations so we might be just faster.
+                             * @param data the multi-stack's shared stack data
                              */
-                            inline void expand() {
-                                //Get the pointer to the first state
+                            inline void expand(const stack_data & data) {
+                                //Make sure the states are in the level list
+                                finalize();
+
+                                //Expand all the level states
+                                expand_states(data, m_first_state, NULL);
+
+                                //In the cube mode the states only registered their expansion candidates
+                                if (data.m_is_cube_mode) {
+                                    expand_cands(data);
+                                }
+                            }
+
+                            /**
+                             * Allows to split the finalized level states into the given number of
+                             * contiguous state ranges of about the same size, to be expanded in parallel.
+                             * @param num_parts the number of ranges, must not exceed the level size
+                             * @param bounds [out] the first states of the ranges followed by NULL, i.e.
+                             *               the range idx is from bounds[idx] until bounds[idx + 1].
+                             */
+                            inline void split_states(const size_t num_parts, vector<stack_state_ptr> & bounds) const {
+                                bounds.clear();
+
+                                //Iterate the states and remember the first state of every range
                                 stack_state_ptr curr_state = m_first_state;
+                                for (size_t idx = 0; (idx < m_size) && (curr_state != NULL); ++idx) {
+                                    if ((idx * num_parts) % m_size < num_parts) {
+                                        bounds.push_back(curr_state);
+                                    }
+                                    curr_state = curr_state->m_next;
+                                }
+
+                                //Add the end of the last range
+                                bounds.push_back(NULL);
+                            }
+
+                            /**
+                             * Allows to expand the given range of the level states
+                             * @param data the stack data of the expanding thread
+                             * @param first_state the first state of the range to expand
+                             * @param end_state the state after the last one of the range, or NULL
+                             */
+                            inline void expand_states(const stack_data & data, stack_state_ptr first_state, const_stack_state_ptr end_state) {
+                                //Get the pointer to the first state
+                                stack_state_ptr curr_state = first_state;
 
-                                //Iterate while we do not need to stop or we reach the end of the stack
-                                while (!m_is_stop && (curr_state != NULL)) {
+                                //Iterate while we do not need to stop or we reach the end of the range
+                                while (!m_is_stop && (curr_state != end_state)) {
                                     LOG_DEBUG << ">>>>> Start STATE (" << curr_state << ") expansion" << END_LOG;
 
                                     //Allow the state to expand itself
-                                    curr_state->expand();
+                                    curr_state->expand(data);
 
                                     LOG_DEBUG << "<<<<< End STATE (" << curr_state << ") expansion" << END_LOG;
 
@@ -235,6 +337,31 @@ namespace uva {
                                 }
                             }
 
+                            /**
+                             * Allows to add a new cube pruning expansion candidate of this level's state.
+                             * The candidate's translations are only materialized during the level expansion.
+                             * @param parent the state to be expanded, not NULL
+                             * @param fncs_pos the first non-covered word search position for the new state
+                             * @param begin_pos the source phrase begin position
+                             * @param end_pos the source phrase end position
+                             * @param base_score the score estimate without the translation costs
+                             */
+                            inline void add_cand(stack_state_ptr parent, const int32_t fncs_pos,
+                                    const int32_t begin_pos, const int32_t end_pos, const prob_weight base_score) {
+                                cube_cand cand;
+                                cand.m_parent = parent;
+                                cand.m_fncs_pos = fncs_pos;
+                                cand.m_begin_pos = begin_pos;
+                                cand.m_end_pos = end_pos;
+                                cand.m_phrase = &parent->m_state_data.m_stack_data.m_sent_data[begin_pos][end_pos];
+                                cand.m_base_score = base_score;
+
+                                //Add the candidate with its best translation, the targets are ranked by their costs
+                                if (cand.set_target(0)) {
+                                    m_cube_queue.push(cand);
+                                }
+                            }
+
                             /**
                              * Allows to get the best translation target string for this stack.
                              * To do that, it takes the first element/state in the level's ordered 
@@ -274,8 +401,305 @@ namespace uva {
                                 return m_size;
                             }
 
+                            /**
+                             * Allows to materialize the best cube pruning candidates' expansions. The
+                             * candidates are popped in the best-first order of their score estimates,
+                             * once a candidate's translation is expanded the candidate is pushed back
+                             * with its next translation. At most the pop limit of the new states is
+                             * created, the remaining candidates are dropped.
+                             * @param data the multi-stack's shared stack data
+                             */
+                            inline void expand_cands(const stack_data & data) {
+                                LOG_DEBUG << "Expanding " << m_cube_queue.size() << " cube candidates, the pop limit is: "
+                                        << m_params.m_cube_pop_limit << END_LOG;
+
+                                //Pop the best candidates until the limit is reached or we need to stop
+                                uint32_t num_pops = 0;
+                                while (!m_is_stop && !m_cube_queue.empty() && (num_pops < m_params.m_cube_pop_limit)) {
+                                    //Get the best candidate
+                                    cube_cand cand = m_cube_queue.top();
+                                    m_cube_queue.pop();
+
+                                    //Materialize the candidate's current translation
+                                    cand.m_parent->expand_cand(data, cand.m_fncs_pos, cand.m_begin_pos, cand.m_end_pos,
+                                            cand.m_phrase->m_source_entry, cand.m_target_idx);
+                                    ++num_pops;
+
+                                    //Push the candidate back with its next translation, if any
+                                    if (cand.set_target(cand.m_rank + 1)) {
+                                        m_cube_queue.push(cand);
+                                    }
+                                }
+
+                                LOG_DEBUG << "Expanded " << num_pops << " cube candidates, dropping "
+                                        << m_cube_queue.size() << " candidates" << END_LOG;
+
+                                //Drop the remaining candidates
+                                m_cube_queue = priority_queue<cube_cand>();
+                            }
+
                         protected:
 
+                            /**
+                             * Allows to add a new state into the list level
+                             * @param new_state the new state to add
+                             */
+                            inline void add_state_list(stack_state_ptr new_state) {
+                                //If there is no states in the level yet, then set this one as the first
+                                if (m_first_state == NULL) {
+                                    LOG_DEBUG1 << "Setting (" << new_state
+                                            << ") as the first/last in the level!" << END_LOG;
+
+                                    //Insert this state as the first one
+                                    insert_as_first(new_state);
+                                } else {
+                                    //Do not even consider the new state unless it is above the threshold
+                                    if (new_state->is_above_threshold(m_score_bound)) {
+                                        //Declare the state pointer that shall point to the
+                                        //position prior to which the new state is to be added.
+                                        stack_state_ptr curr_state = NULL;
+
+                                        //Find the position the new state is to be inserted
+                                        //into or possibly recombine, with an existing state.
+                                        if (!find_pos_recombine(curr_state, *new_state)) {
+                                            LOG_DEBUG1 << "The last considered state is: " << curr_state << END_LOG;
+
+                                            //Check if we found a state which is less probable than the new one
+                                            if (curr_state != NULL) {
+                                                //We need to add the new state before some existing state
+                                                add_before(curr_state, new_state);
+                                            } else {
+                                                //Add the new state as the last state inside the level
+                                                add_last(new_state);
+                                            }
+                                        }
+                                    } else {
+                                        //The new state is below the threshold, so delete it
+                                        LOG_DEBUG1 << "Deleting (threshold pruning) the ("
+                                                << new_state << ") state!" << END_LOG;
+                                        stack_state::destroy(new_state);
+                                    }
+                                }
+                            }
+
+                            /**
+                             * Allows to add a new state into the hash level. The equivalent state, if
+                             * any, is found by the recombination signature in constant time. The
+                             * least probable state is on top of the heap so the histogram and threshold
+                             * pruning are logarithmic in the number of level states.
+                             * @param new_state the new state to add
+                             */
+                            inline void add_state_hash(stack_state_ptr new_state) {
+                                ASSERT_SANITY_THROW((m_first_state != NULL),
+                                        "Adding a new state into a finalized hash level!");
+
+                                //Do not even consider the new state unless it is above the threshold
+                                if (m_heap.empty() || new_state->is_above_threshold(m_score_bound)) {
+                                    //Compute the signature and search for an equivalent state
+                                    const uint_fast64_t sig = new_state->compute_recomb_sig();
+                                    auto equal_iter = find_equal_state(sig, *new_state);
+
+                                    if (equal_iter == m_sig_map.end()) {
+                                        //Check if there is space left or the new state is better than the worst one
+                                        if (is_space_left() || (*m_heap.front() < *new_state)) {
+                                            //Add the new state into the heap and the index
+                                            heap_push(new_state);
+                                            m_sig_map.emplace(sig, new_state);
+
+                                            //Update the threshold and prune the states
+                                            remember_best_score(new_state);
+                                            prune_heap();
+                                        } else {
+                                            //There is no place for this state, histogram pruning
+                                            LOG_DEBUG1 << "Deleting (histogram pruning) the ("
+                                                    << new_state << ") state!" << END_LOG;
+                                            stack_state::destroy(new_state);
+                                        }
+                                    } else {
+                                        //Get the equivalent state
+                                        stack_state_ptr equal_state = equal_iter->second;
+
+                                        if (*new_state < *equal_state) {
+                                            //The new state is less probable, recombine it into the existing one
+                                            equal_state->recombine_from(new_state);
+                                        } else {
+                                            LOG_DEBUG << "Found an equivalent state " << equal_state
+                                                    << " == " << new_state << " !" << END_LOG;
+
+                                            //The new state takes the place of the equivalent one
+                                            equal_iter->second = new_state;
+                                            new_state->m_heap_idx = equal_state->m_heap_idx;
+                                            m_heap[new_state->m_heap_idx] = new_state;
+                                            //The score did not get smaller so we can only go down
+                                            heap_sift_down(new_state->m_heap_idx);
+
+                                            //Recombine the equivalent state into the new one
+                                            new_state->recombine_from(equal_state);
+
+                                            //Update the threshold and prune the states
+                                            remember_best_score(new_state);
+                                            prune_heap();
+                                        }
+                                    }
+                                } else {
+                                    //The new state is below the threshold, so delete it
+                                    LOG_DEBUG1 << "Deleting (threshold pruning) the ("
+                                            << new_state << ") state!" << END_LOG;
+                                    stack_state::destroy(new_state);
+                                }
+                            }
+
+                            /**
+                             * Allows to find the hash level state equivalent to the given one
+                             * @param sig the recombination signature of the state
+                             * @param state the state to search the equivalent for
+                             * @return the index iterator pointing to the equivalent state or the end iterator
+                             */
+                            inline typename unordered_multimap<uint_fast64_t, stack_state_ptr>::iterator
+                            find_equal_state(const uint_fast64_t sig, const stack_state & state) {
+                                auto range = m_sig_map.equal_range(sig);
+                                for (auto iter = range.first; iter != range.second; ++iter) {
+                                    if (*iter->second == state) {
+                                        return iter;
+                                    }
+                                }
+                                return m_sig_map.end();
+                            }
+
+                            /**
+                             * Allows to update the threshold, if the given new hash level state is the best one
+                             * @param state the new hash level state
+                             */
+                            inline void remember_best_score(const_stack_state_ptr state) {
+                                //Compute the score lower bound, remember that we are in the log space
+                                const prob_weight score_bound = state->m_state_data.m_total_score + m_params.m_pruning_threshold_log;
+
+                                //Update the bound if the state is the only one or is better than the best
+                                if ((m_size == 1) || (score_bound > m_score_bound)) {
+                                    m_score_bound = score_bound;
+
+                                    LOG_DEBUG1 << "new best state: " << state << ", new threshold: " << m_score_bound << END_LOG;
+                                }
+                            }
+
+                            /**
+                             * Removes the least probable hash level states until the level
+                             * size is within the capacity and all states are above the threshold.
+                             * This method decrements the level size counter.
+                             */
+                            inline void prune_heap() {
+                                while (!m_heap.empty() && ((m_size > m_params.m_stack_capacity) ||
+                                        !m_heap.front()->is_above_threshold(m_score_bound))) {
+                                    //Remove the least probable state from the heap
+                                    stack_state_ptr state_to_delete = heap_pop();
+
+                                    //Remove the state from the index
+                                    auto range = m_sig_map.equal_range(state_to_delete->m_recomb_sig);
+                                    for (auto iter = range.first; iter != range.second; ++iter) {
+                                        if (iter->second == state_to_delete) {
+                                            m_sig_map.erase(iter);
+                                            break;
+                                        }
+                                    }
+
+                                    LOG_DEBUG1 << "Deleting the (" << state_to_delete << ") state!" << END_LOG;
+                                    stack_state::destroy(state_to_delete);
+                                }
+
+                                ASSERT_SANITY_THROW(m_heap.empty(),
+                                        "This should not be happening, we deleted all states!");
+                            }
+
+                            /**
+                             * Allows to push a new state into the hash level heap.
+                             * This method increments the level size counter.
+                             * @param state the state to push
+                             */
+                            inline void heap_push(stack_state_ptr state) {
+                                //Reserve the space once, when the first state comes
+                                if (m_heap.empty()) {
+                                    m_heap.reserve(m_params.m_stack_capacity + 1);
+                                    m_sig_map.reserve(m_params.m_stack_capacity + 1);
+                                }
+
+                                state->m_heap_idx = m_heap.size();
+                                m_heap.push_back(state);
+                                heap_sift_up(state->m_heap_idx);
+
+                                ++m_size;
+                            }
+
+                            /**
+                             * Allows to pop the least probable state from the hash level heap.
+                             * This method decrements the level size counter.
+                             * @return the least probable state
+                             */
+                            inline stack_state_ptr heap_pop() {
+                                stack_state_ptr state = m_heap.front();
+
+                                //Move the last state to the top and restore the heap
+                                m_heap.front() = m_heap.back();
+                                m_heap.front()->m_heap_idx = 0;
+                                m_heap.pop_back();
+                                if (!m_heap.empty()) {
+                                    heap_sift_down(0);
+                                }
+
+                                m_size--;
+
+                                return state;
+                            }
+
+                            /**
+                             * Allows to move the heap state up until its parent is less probable
+                             * @param idx the index of the state to move
+                             */
+                            inline void heap_sift_up(uint32_t idx) {
+                                while (idx > 0) {
+                                    const uint32_t parent = (idx - 1) / 2;
+                                    if (*m_heap[idx] < *m_heap[parent]) {
+                                        heap_swap(idx, parent);
+                                        idx = parent;
+                                    } else {
+                                        break;
+                                    }
+                                }
+                            }
+
+                            /**
+                             * Allows to move the heap state down until its children are more probable
+                             * @param idx the index of the state to move
+                             */
+                            inline void heap_sift_down(uint32_t idx) {
+                                const uint32_t size = m_heap.size();
+                                uint32_t min_idx = idx;
+                                do {
+                                    idx = min_idx;
+                                    const uint32_t left = 2 * idx + 1;
+                                    const uint32_t right = left + 1;
+                                    if ((left < size) && (*m_heap[left] < *m_heap[min_idx])) {
+                                        min_idx = left;
+                                    }
+                                    if ((right < size) && (*m_heap[right] < *m_heap[min_idx])) {
+                                        min_idx = right;
+                                    }
+                                    if (min_idx != idx) {
+                                        heap_swap(idx, min_idx);
+                                    }
+                                } while (min_idx != idx);
+                            }
+
+                            /**
+                             * Allows to swap two heap states, updates their heap indexes
+                             * @param first the first state index
+                             * @param second the second state index
+                             */
+                            inline void heap_swap(const uint32_t first, const uint32_t second) {
+                                swap(m_heap[first], m_heap[second]);
+                                m_heap[first]->m_heap_idx = first;
+                                m_heap[second]->m_heap_idx = second;
+                            }
+
                             /**
                              * This method allows to search for a position to insert the new state into.
                              * We known that the state satisfies the total weight threshold. This function
@@ -346,7 +770,7 @@ namespace uva {
                                     //destroy it. This is part of histogram pruning method.
                                     LOG_DEBUG1 << "Deleting (histogram pruning) the ("
                                             << new_state << ") state!" << END_LOG;
-                                    delete new_state;
+                                    stack_state::destroy(new_state);
                                 }
                             }
 
@@ -452,7 +876,7 @@ namespace uva {
                                     remove_from_level(m_last_state);
 
                                     LOG_DEBUG1 << "Deleting the (" << state_to_delete << ") state!" << END_LOG;
-                                    delete state_to_delete;
+                                    stack_state::destroy(state_to_delete);
                                 }
 
                                 ASSERT_SANITY_THROW((m_first_state == NULL),
@@ -659,6 +1083,20 @@ namespace uva {
 
                             //Stores the probability score bound for threshold pruning
                             prob_weight m_score_bound;
+
+                            //Stores the flag indicating whether this is a hash level
+                            const bool m_is_hash_level;
+
+                            //Stores the min-heap of the hash level states, the least probable
+                            //state is on top, is empty for the list and finalized hash level
+                            vector<stack_state_ptr> m_heap;
+
+                            //Stores the recombination signature to state index of the hash level
+                            unordered_multimap<uint_fast64_t, stack_state_ptr> m_sig_map;
+
+                            //Stores the cube pruning expansion candidates, the best one is on top,
+                            //is only used in the cube mode and is empty outside the level expansion
+                            priority_queue<cube_cand> m_cube_queue;
                         };
                     }
                 }
@@ -28,10 +28,13 @@
 
 #include <vector>
 #include <algorithm>
+#include <bitset>
+#include <functional>
 
 #include "common/utils/exceptions.hpp"
 #include "common/utils/logging/logger.hpp"
 #include "common/utils/text/string_utils.hpp"
+#include "common/utils/hashing_utils.hpp"
 
 #include "server/lm/lm_configurator.hpp"
 #include "server/rm/proxy/rm_query_proxy.hpp"
@@ -46,6 +49,7 @@ using namespace std;
 using namespace uva::utils::exceptions;
 using namespace uva::utils::logging;
 using namespace uva::utils::text;
+using namespace uva::utils::hashing;
 
 using namespace uva::smt::bpbd::server::lm::proxy;
 using namespace uva::smt::bpbd::server::rm::proxy;
@@ -83,6 +87,8 @@ namespace uva {
                             typedef typename stack_data::const_stack_state_ptr const_stack_state_ptr;
                             //Typedef the state
                             typedef typename stack_data::stack_state stack_state;
+                            //Typedef the state memory pool
+                            typedef typename stack_data::state_pool state_pool;
 
                             //Stores the undefined and initial ids for the state 
                             static constexpr int32_t UNDEFINED_STATE_ID = -1;
@@ -101,69 +107,94 @@ namespace uva {
                             stack_state_templ(const stack_data & data)
                             : m_parent(NULL), m_state_data(data), m_prev(NULL), m_next(NULL),
                             m_fncs_pos(m_state_data.m_stack_data.m_sent_data.m_min_idx),
-                            m_recomb_from(NULL) INIT_STACK_STATE_TUNING_DATA{
+                            m_recomb_from(NULL), m_recomb_sig(0), m_heap_idx(0) INIT_STACK_STATE_TUNING_DATA{
                                 LOG_DEBUG1 << "New BEGIN state: " << this << ", parent: " << m_parent << END_LOG;
                             }
 
                             /**
                              * The basic constructor for the END stack state, corresponding to the &lt;/s&gt; tag.
+                             * @param data the stack data of the expanding thread
                              * @param parent the parent state pointer, NOT NULL!
                              */
-                            stack_state_templ(stack_state_ptr parent) :
-                            m_parent(parent), m_state_data(parent->m_state_data), m_prev(NULL), m_next(NULL),
+                            stack_state_templ(const stack_data & data, stack_state_ptr parent) :
+                            m_parent(parent), m_state_data(data, parent->m_state_data), m_prev(NULL), m_next(NULL),
                             m_fncs_pos(m_state_data.m_stack_data.m_sent_data.m_max_idx),
-                            m_recomb_from(NULL) INIT_STACK_STATE_TUNING_DATA{
+                            m_recomb_from(NULL), m_recomb_sig(0), m_heap_idx(0) INIT_STACK_STATE_TUNING_DATA{
                                 LOG_DEBUG1 << "New END state: " << this << ", parent: " << m_parent << END_LOG;
                             }
 
                             /**
                              * The basic constructor for the non-begin/end (&lt;s&gt;/&lt;/s&gt;) stack state.
+                             * @param data the stack data of the expanding thread
                              * @param parent the parent state pointer, NOT NULL!
                              * @param fncs_pos the position which will be used for searching for the 
                              *                 first non-covered words in this new state expansions.
                              * @param begin_pos this state translated source phrase begin position
                              * @param end_pos this state translated source phrase end position
                              * @param covered the pre-cooked covered vector, for efficiency reasons.
-                             * @param target the new translation target
+                             * @param source_entry the source entry of the translated source phrase
+                             * @param target_idx the index of the new translation target within the source entry
                              */
-                            stack_state_templ(stack_state_ptr parent, const int32_t fncs_pos,
+                            stack_state_templ(const stack_data & data, stack_state_ptr parent, const int32_t fncs_pos,
                                     const int32_t begin_pos, const int32_t end_pos,
                                     const typename state_data::covered_info & covered,
-                                    tm_const_target_entry* target)
-                            : m_parent(parent), m_state_data(parent->m_state_data, begin_pos, end_pos, covered, target),
-                            m_prev(NULL), m_next(NULL), m_fncs_pos(fncs_pos), m_recomb_from(NULL) INIT_STACK_STATE_TUNING_DATA{
+                                    tm_const_source_entry_ptr source_entry, const size_t target_idx)
+                            : m_parent(parent), m_state_data(data, parent->m_state_data, begin_pos, end_pos, covered, source_entry, target_idx),
+                            m_prev(NULL), m_next(NULL), m_fncs_pos(fncs_pos), m_recomb_from(NULL),
+                            m_recomb_sig(0), m_heap_idx(0) INIT_STACK_STATE_TUNING_DATA{
                                 LOG_DEBUG1 << "New state: " << this << ", parent: " << m_parent
                                 << ", source[" << begin_pos << "," << end_pos << "], target ___"
-                                << target->get_target_phrase() << "___" << END_LOG;
+                                << m_state_data.get_target().get_target_phrase() << "___" << END_LOG;
                             }
                             
                             /**
-                             * The basic destructor, should free all the allocated
-                             * resources. Deletes the states that are recombined
-                             * into this state as they are not in any stack level
+                             * The states are only to be allocated from the decoding thread's memory pool,
+                             * the pool is reset for the next sentence so the state is trivially destructible
+                             * @param size the size of the state object, is fixed
+                             * @param pool the multi-stack state memory pool
+                             * @return the pointer to the allocated memory
                              */
-                            ~stack_state_templ() {
+                            static inline void * operator new(size_t size, state_pool & pool) {
+                                return pool.allocate();
+                            }
+
+                            /**
+                             * Is only used if the state constructor throws, returns the memory into the pool
+                             * @param ptr the pointer to the allocated memory
+                             * @param pool the multi-stack state memory pool
+                             */
+                            static inline void operator delete(void * ptr, state_pool & pool) {
+                                pool.deallocate(ptr);
+                            }
+
+                            /**
+                             * Allows to destroy the state pruned during the decoding and to return its memory
+                             * into the pool. The states that are recombined into this state are destroyed
+                             * too as they are not in any stack level. The states remaining in the stack at
+                             * the end of the sentence are not destroyed, their pools are reset instead.
+                             * @param state the state to destroy, not NULL
+                             */
+                            static inline void destroy(stack_state_ptr state) {
                                 //We need two pointers one to point to the current state to
                                 //be deleted and another one for the next state to move to.
-                                stack_state_ptr curr_state = m_recomb_from;
+                                stack_state_ptr curr_state = state->m_recomb_from;
                                 stack_state_ptr next_state = NULL;
 
-                                LOG_DEBUG1 << "Destructing state " << this << ", recombined-"
+                                LOG_DEBUG1 << "Destroying state " << state << ", recombined-"
                                         << "from states ptr: " << curr_state << END_LOG;
 
                                 //While there is states to delete
                                 while (curr_state != NULL) {
                                     //Save the next state
                                     next_state = curr_state->m_next;
-
-                                    LOG_DEBUG1 << "Deleting recombined from state: " << curr_state << END_LOG;
-
-                                    //Delete the revious state
-                                    delete curr_state;
-
+                                    //Delete the recombined from state
+                                    destroy(curr_state);
                                     //Move on to the next state;
                                     curr_state = next_state;
                                 }
+
+                                //Return the memory, the state is trivially destructible
+                                state->m_state_data.m_stack_data.m_state_pool.deallocate(state);
                             }
 
 #if IS_SERVER_TUNING_MODE
@@ -380,10 +411,14 @@ namespace uva {
                             }
 
                             /**
-                             * Allows the state to expand itself, it will
-                             * add itself to the proper stack.
+                             * Allows the state to expand itself, it will add the new states
+                             * to the proper stack. The new states are allocated and added
+                             * by means of the stack data of the expanding thread, it is
+                             * the multi-stack's shared one unless the level is expanded
+                             * by multiple threads.
+                             * @param data the stack data of the expanding thread
                              */
-                            inline void expand() {
+                            inline void expand(const stack_data & data) {
                                 //Create shorthands for the data to compare and log
                                 const size_t curr_count = m_state_data.m_covered.count();
                                 const size_t & num_words = m_state_data.m_stack_data.m_sent_data.get_dim();
@@ -395,11 +430,11 @@ namespace uva {
                                 //Check if this is the last state, i.e. we translated everything
                                 if (curr_count == num_words) {
                                     //All of the words have been translated, add the end state
-                                    stack_state_ptr end_state = new stack_state(this);
-                                    m_state_data.m_stack_data.m_add_state(end_state);
+                                    stack_state_ptr end_state = new(data.m_state_pool) stack_state(data, this);
+                                    data.m_add_state(end_state);
                                 } else {
                                     //Do the "from first not-covered" expansion - the Oister style.
-                                    expand_from_first_non_covered();
+                                    expand_from_first_non_covered(data);
                                 }
                             }
 
@@ -448,7 +483,8 @@ namespace uva {
                              * the same sub-problem i.e. are eligible for recombination.
                              * The states are equal if and only if:
                              *    1. They have the same last translated word
-                             *    2. They have the same history of target words
+                             *    2. They have the same LM right state, i.e. the same last target
+                             *       words that can influence the LM scores of the next words
                              *    3. They cover the same source words
                              * @param other the other state to compare with
                              * @return true if this state is equal to the other one, otherwise false.
@@ -460,14 +496,16 @@ namespace uva {
                                 //Log the state data that will be compared
                                 LOG_DEBUG1 << "--- State recombination check: " << this << " =?= " << &other << END_LOG;
                                 LOG_DEBUG1 << "--- " << m_state_data.m_s_end_word_idx << " =?= " << other_data.m_s_end_word_idx << END_LOG;
-                                LOG_DEBUG1 << "--- Checking tail history of " << MAX_HISTORY_LENGTH << " elements" << END_LOG;
+                                LOG_DEBUG1 << "--- Checking tail history of " << m_state_data.m_lm_state_len << " =?= "
+                                        << other_data.m_lm_state_len << " elements" << END_LOG;
                                 LOG_DEBUG1 << "--- " << m_state_data.m_trans_frame.to_string() << " =?= " << other_data.m_trans_frame.to_string() << END_LOG;
                                 LOG_DEBUG1 << "--- " << m_state_data.covered_to_string() << " =?= " << other_data.covered_to_string() << END_LOG;
                                 LOG_DEBUG1 << "--- " << m_state_data.rm_entry_data << " =(second 1/2)?= " << other_data.rm_entry_data << END_LOG;
 
                                 //Compute the comparison result
                                 const bool is_equal = (m_state_data.m_s_end_word_idx == other_data.m_s_end_word_idx) &&
-                                        m_state_data.m_trans_frame.is_equal_last(other_data.m_trans_frame, MAX_HISTORY_LENGTH) &&
+                                        (m_state_data.m_lm_state_len == other_data.m_lm_state_len) &&
+                                        m_state_data.m_trans_frame.is_equal_last(other_data.m_trans_frame, m_state_data.m_lm_state_len) &&
                                         (m_state_data.m_covered == other_data.m_covered) &&
                                         m_state_data.rm_entry_data.is_equal_from_weights(other_data.rm_entry_data);
 
@@ -488,6 +526,29 @@ namespace uva {
                                 return !(*this == other);
                             }
 
+                            /**
+                             * Allows to compute and store the recombination signature of the state.
+                             * The signature is a hash of exactly the data compared by the == operator,
+                             * so two states that can be recombined are guaranteed to have the same
+                             * signature. The opposite is not true, so the == operator is still to be
+                             * used for the states with equal signatures.
+                             * @return the computed recombination signature
+                             */
+                            inline uint_fast64_t compute_recomb_sig() {
+                                //Start with the covered source words
+                                uint_fast64_t sig = m_state_data.m_covered.get_hash();
+                                //Add the last translated word index
+                                sig = MurmurHash64A(&m_state_data.m_s_end_word_idx, sizeof (int32_t), sig);
+                                //Add the history of target words, within the LM right state
+                                sig = m_state_data.m_trans_frame.hash_last(m_state_data.m_lm_state_len, sig);
+                                //Add the reordering from weights
+                                m_recomb_sig = m_state_data.rm_entry_data.hash_from_weights(sig);
+
+                                LOG_DEBUG1 << "State " << this << " recombination signature: " << m_recomb_sig << END_LOG;
+
+                                return m_recomb_sig;
+                            }
+
                             /**
                              * Allows to check if the given new state is within the
                              * threshold limit.
@@ -585,7 +646,7 @@ namespace uva {
                                         //Store the next element
                                         next = tail->m_next;
                                         //Delete the tail first element
-                                        delete tail;
+                                        destroy(tail);
                                         //Move to the next tail element
                                         tail = next;
                                     }
@@ -601,8 +662,9 @@ namespace uva {
                              * position with the given distortion limit to each side. This first implementation is
                              * sub optimal and is for now only made to see what happens to the BLEU scores. If the
                              * result will be better than with the our version of expansions, we will optimize speed.
+                             * @param data the stack data of the expanding thread
                              */
-                            inline void expand_from_first_non_covered() {
+                            inline void expand_from_first_non_covered(const stack_data & data) {
                                 LOG_DEBUG1 << ">>>>> starting expansions" << END_LOG;
 
                                 //Store the shorthand to the minimum possible word index
@@ -612,44 +674,39 @@ namespace uva {
                                         << m_fncs_pos << ", " << MAX_WORD_IDX << "]" << END_LOG;
 
                                 //Search for the first not covered element
-                                for (int32_t first_nc_pos = m_fncs_pos; first_nc_pos <= MAX_WORD_IDX; ++first_nc_pos) {
-                                    LOG_DEBUG2 << "Considering " << m_state_data.covered_to_string() << " @ "
-                                            << first_nc_pos << " = " << m_state_data.m_covered[first_nc_pos] << END_LOG;
-                                    //Check if the last position is not covered,
-                                    //if not then we can expand starting from here.
-                                    if (!m_state_data.m_covered[first_nc_pos]) {
-                                        LOG_DEBUG1 << "Found an uncovered position @ " << first_nc_pos << END_LOG;
-
-                                        //We shall not expand in two direction to the left and to the right
-                                        //of the last phrase, but the expansion to the left is only limited
-                                        //by the number of uncovered positions on the left and the expansions
-                                        //to the right is limited by the first non-covered position and the
-                                        //distortion limit given in the parameters So here we shall first compute
-                                        //the left and right boundaries for the expansions we are to make
-
-                                        //The maximum position to consider to the left is the
-                                        //first non-covered word position in the sentence.
-                                        const int32_t max_left_pos = first_nc_pos;
-                                        //Get the distortion limit and store it locally
-                                        const int32_t & d_limit = m_state_data.m_stack_data.m_params.m_dist_limit;
-                                        //The maximum position to consider to the right is the
-                                        //first non-covered word position in the sentence plus
-                                        //the distortion limit, if it is set, otherwise the
-                                        //end position of the sentence.
-                                        const int32_t max_right_pos = (is_dist) ? min(MAX_WORD_IDX, first_nc_pos + d_limit) : MAX_WORD_IDX;
-
-                                        LOG_DEBUG1 << "Max [Left, Right] = [" << max_left_pos << ", " << max_right_pos << "]" << END_LOG;
-                                        LOG_DEBUG1 << "Last phrase [Left, Right] = [" << m_state_data.m_s_begin_word_idx
-                                                << ", " << m_state_data.m_s_end_word_idx << "]" << END_LOG;
-
-                                        //Expand the states to the right first and then to the left
-                                        expand_states_right(first_nc_pos, m_state_data.m_s_end_word_idx + 1, max_right_pos);
-                                        expand_states_left(first_nc_pos, m_state_data.m_s_begin_word_idx - 1, max_left_pos);
-
-                                        LOG_DEBUG1 << "Finished all possible expansions in the state." << END_LOG;
-                                        //Once we finish the expansions we shall break from the outer cycle
-                                        break;
-                                    }
+                                const int32_t first_nc_pos = m_state_data.m_covered.next_uncovered(m_fncs_pos);
+                                //Check if the position is within the sentence,
+                                //if so then we can expand starting from here.
+                                if (first_nc_pos <= MAX_WORD_IDX) {
+                                    LOG_DEBUG1 << "Found an uncovered position @ " << first_nc_pos << END_LOG;
+
+                                    //We shall not expand in two direction to the left and to the right
+                                    //of the last phrase, but the expansion to the left is only limited
+                                    //by the number of uncovered positions on the left and the expansions
+                                    //to the right is limited by the first non-covered position and the
+                                    //distortion limit given in the parameters So here we shall first compute
+                                    //the left and right boundaries for the expansions we are to make
+
+                                    //The maximum position to consider to the left is the
+                                    //first non-covered word position in the sentence.
+                                    const int32_t max_left_pos = first_nc_pos;
+                                    //Get the distortion limit and store it locally
+                                    const int32_t & d_limit = m_state_data.m_stack_data.m_params.m_dist_limit;
+                                    //The maximum position to consider to the right is the
+                                    //first non-covered word position in the sentence plus
+                                    //the distortion limit, if it is set, otherwise the
+                                    //end position of the sentence.
+                                    const int32_t max_right_pos = (is_dist) ? min(MAX_WORD_IDX, first_nc_pos + d_limit) : MAX_WORD_IDX;
+
+                                    LOG_DEBUG1 << "Max [Left, Right] = [" << max_left_pos << ", " << max_right_pos << "]" << END_LOG;
+                                    LOG_DEBUG1 << "Last phrase [Left, Right] = [" << m_state_data.m_s_begin_word_idx
+                                            << ", " << m_state_data.m_s_end_word_idx << "]" << END_LOG;
+
+                                    //Expand the states to the right first and then to the left
+                                    expand_states_right(data, first_nc_pos, m_state_data.m_s_end_word_idx + 1, max_right_pos);
+                                    expand_states_left(data, first_nc_pos, m_state_data.m_s_begin_word_idx - 1, max_left_pos);
+
+                                    LOG_DEBUG1 << "Finished all possible expansions in the state." << END_LOG;
                                 }
 
                                 LOG_DEBUG1 << "<<<<< finished expansions" << END_LOG;
@@ -658,77 +715,73 @@ namespace uva {
                             /**
                              * Allows to expand to the right from the last expanded phrase, if possible.
                              * We expand from the positions closest to the last phrase and then move away.
+                             * @param data the stack data of the expanding thread
                              * @param first_nc_pos the first non-covered word index in the current hypothesis
                              * @param begin_pos the first position to attempt an expansion for
                              * @param end_pos the last position to attempt an expansion for
                              */
-                            inline void expand_states_right(const int32_t & first_nc_pos, int32_t begin_pos, const int32_t end_pos) {
-                                //Iterate through the allowed positions and try the length expansions
+                            inline void expand_states_right(const stack_data & data, const int32_t & first_nc_pos, int32_t begin_pos, const int32_t end_pos) {
+                                //Iterate through the allowed not-covered positions and try the length expansions
                                 // begin_pos ----- > ---- end_pos
+                                begin_pos = m_state_data.m_covered.next_uncovered(begin_pos);
                                 while (begin_pos <= end_pos) {
-                                    //If the position is not covered then expand the lengths
-                                    if (!m_state_data.m_covered[begin_pos]) {
-                                        //Expand the lengths from the last position
-                                        expand_length(first_nc_pos, begin_pos);
-                                    }
-                                    //Increment the current position - moving to the right
-                                    ++begin_pos;
+                                    //Expand the lengths from the last position
+                                    expand_length(data, first_nc_pos, begin_pos);
+                                    //Move to the next not-covered position - moving to the right
+                                    begin_pos = m_state_data.m_covered.next_uncovered(begin_pos + 1);
                                 }
                             }
 
                             /**
                              * Allows to expand to the left from the last expanded phrase, if possible
                              * We expand from the positions closest to the last phrase and then move away.
+                             * @param data the stack data of the expanding thread
                              * @param first_nc_pos the first non-covered word index in the current hypothesis
                              * @param begin_pos the first position to attempt an expansion for
                              * @param end_pos the last position to attempt an expansion for
                              */
-                            inline void expand_states_left(const int32_t & first_nc_pos, int32_t begin_pos, const int32_t end_pos) {
-                                //Iterate through the allowed positions and try the length expansions
+                            inline void expand_states_left(const stack_data & data, const int32_t & first_nc_pos, int32_t begin_pos, const int32_t end_pos) {
+                                //Iterate through the allowed not-covered positions and try the length expansions
                                 // end_pos ----- < ---- begin_pos
+                                begin_pos = m_state_data.m_covered.prev_uncovered(begin_pos);
                                 while (begin_pos >= end_pos) {
-                                    //If the position is not covered then expand the lengths
-                                    if (!m_state_data.m_covered[begin_pos]) {
-                                        //Expand the lengths from the last position
-                                        expand_length(first_nc_pos, begin_pos);
-                                    }
-                                    //Decrement the current position - moving to the left
-                                    begin_pos--;
+                                    //Expand the lengths from the last position
+                                    expand_length(data, first_nc_pos, begin_pos);
+                                    //Move to the previous not-covered position - moving to the left
+                                    begin_pos = m_state_data.m_covered.prev_uncovered(begin_pos - 1);
                                 }
                             }
 
                             /**
                              * Allows to expand for all the possible phrase lengths
+                             * @param data the stack data of the expanding thread
                              * @param first_nc_pos the index of the first non-covered word in the given hypothesis
                              * @param start_pos the position to start the word expansions from.
                              */
-                            inline void expand_length(const int32_t first_nc_pos, const int32_t start_pos) {
+                            inline void expand_length(const stack_data & data, const int32_t first_nc_pos, const int32_t start_pos) {
                                 LOG_DEBUG1 << ">>>>> [start_pos] = [" << start_pos << "]" << END_LOG;
 
                                 //Always take the one word translation even if
                                 //It is an unknown entry.
                                 int32_t end_pos = start_pos;
                                 //Just expand the single word, this is always needed and possible
-                                expand_trans<true>(first_nc_pos, start_pos, end_pos);
+                                expand_trans<true>(data, first_nc_pos, start_pos, end_pos);
 
                                 LOG_DEBUG1 << "Expanded the single word @ [" << start_pos << ", " << end_pos << "]" << END_LOG;
 
                                 //Get the maximum position
                                 const int32_t & MAX_WORD_IDX = m_state_data.m_stack_data.m_sent_data.m_max_idx;
 
-                                //Iterate through lengths > 1 until the maximum possible source phrase length is 
-                                //reached or we hit the end of the sentence or the end of the uncovered region
-                                for (size_t len = 2; len <= m_state_data.m_stack_data.m_params.m_max_s_phrase_len; ++len) {
-                                    //Move to the next end position
-                                    ++end_pos;
-                                    //Check if we are in a good state
-                                    if ((end_pos <= MAX_WORD_IDX) && (!m_state_data.m_covered[end_pos])) {
-                                        //Expand the source phrase which is not a single word
-                                        expand_trans<false>(first_nc_pos, start_pos, end_pos);
-                                    } else {
-                                        //We've hit the last possible length here, time to stop
-                                        break;
-                                    }
+                                //The phrases are bounded by the maximum possible source phrase length,
+                                //the end of the sentence and the end of the not-covered region
+                                const int32_t max_end_pos = min(min(MAX_WORD_IDX,
+                                        m_state_data.m_covered.next_covered(start_pos) - 1),
+                                        start_pos + static_cast<int32_t> (m_state_data.m_stack_data.m_params.m_max_s_phrase_len) - 1);
+
+                                //Iterate through lengths > 1 until the maximum end position
+                                while (++end_pos <= max_end_pos) {
+                                    //Expand the source phrase which is not a single word
+                                    expand_trans<false>(data, first_nc_pos, start_pos, end_pos);
                                 }
 
                                 LOG_DEBUG1 << "<<<<< [start_pos] = [" << start_pos << "]" << END_LOG;
@@ -736,13 +789,15 @@ namespace uva {
 
                             /**
                              * Allows to expand for all the possible translations
+                             * @param data the stack data of the expanding thread
                              */
                             template<bool single_word>
-                            inline void expand_trans(const int32_t first_nc_pos, const int32_t start_pos, const int32_t end_pos) {
+                            inline void expand_trans(const stack_data & data, const int32_t first_nc_pos, const int32_t start_pos, const int32_t end_pos) {
                                 LOG_DEBUG1 << ">>>>> [start_pos, end_pos] = [" << start_pos << ", " << end_pos << "]" << END_LOG;
 
-                                //Obtain the source entry for the currently considered source phrase
-                                tm_const_source_entry_ptr entry = m_state_data.m_stack_data.m_sent_data[start_pos][end_pos].m_source_entry;
+                                //Obtain the data and the source entry for the currently considered source phrase
+                                const phrase_data_entry & phrase_data = m_state_data.m_stack_data.m_sent_data[start_pos][end_pos];
+                                tm_const_source_entry_ptr entry = phrase_data.m_source_entry;
 
                                 ASSERT_SANITY_THROW((entry == NULL),
                                         string("The source entry [") + to_string(start_pos) +
@@ -751,14 +806,9 @@ namespace uva {
                                 //Check if we are in the situation of a single word or in the
                                 //situation when we actually have translations for a phrase
                                 if (single_word || entry->has_translations()) {
-                                    //Get the targets
-                                    tm_const_target_entry* targets = entry->get_targets();
-
                                     //Initialize the new covered vector, take the old one plus enable the new states
                                     typename state_data::covered_info covered(m_state_data.m_covered);
-                                    for (int32_t idx = start_pos; idx <= end_pos; ++idx) {
-                                        covered.set(idx);
-                                    }
+                                    covered.set(start_pos, end_pos);
 
                                     //Compute the first non-covered word start search position for the subsequent states
                                     //In case the first not-covered position is the same as the start position of the
@@ -766,10 +816,18 @@ namespace uva {
                                     //Otherwise, there is a possible gap of not-covered positions starting from the given one.
                                     const int32_t fncs_pos = ((first_nc_pos == start_pos) ? (end_pos + 1) : first_nc_pos);
 
-                                    //Iterate through all the available target translations
-                                    for (size_t idx = 0; idx < entry->num_targets(); ++idx) {
-                                        //Add a new hypothesis state to the multi-stack
-                                        m_state_data.m_stack_data.m_add_state(new stack_state(this, fncs_pos, start_pos, end_pos, covered, &targets[idx]));
+                                    if (m_state_data.m_stack_data.m_is_cube_mode) {
+                                        //Only register the expansion candidate, the translations are to be materialized
+                                        //lazily, the score estimate is the partial score plus the new future costs.
+                                        data.m_add_cand(this, fncs_pos, start_pos, end_pos,
+                                                m_state_data.m_partial_score + m_state_data.compute_future_cost(covered, start_pos, end_pos));
+                                    } else {
+                                        //Iterate through the best available target translations
+                                        for (size_t rank = 0; rank < phrase_data.m_num_targets; ++rank) {
+                                            //Add a new hypothesis state to the multi-stack
+                                            data.m_add_state(new(data.m_state_pool) stack_state(data, this, fncs_pos,
+                                                    start_pos, end_pos, covered, entry, phrase_data.get_target_idx(rank)));
+                                        }
                                     }
                                 } else {
                                     //Do nothing we have an unknown phrase of length > 1
@@ -779,6 +837,27 @@ namespace uva {
                                 LOG_DEBUG1 << "<<<<< [start_pos, end_pos] = [" << start_pos << ", " << end_pos << "]" << END_LOG;
                             }
 
+                            /**
+                             * Allows to materialize a single expansion candidate registered in the cube mode,
+                             * i.e. to create the new state with the given translation and to add it to the stack.
+                             * @param data the stack data of the expanding thread
+                             * @param fncs_pos the first non-covered word search position for the new state
+                             * @param start_pos the source phrase begin position
+                             * @param end_pos the source phrase end position
+                             * @param entry the source entry of the source phrase
+                             * @param target_idx the index of the translation target to expand with
+                             */
+                            inline void expand_cand(const stack_data & data, const int32_t fncs_pos, const int32_t start_pos,
+                                    const int32_t end_pos, tm_const_source_entry_ptr entry, const size_t target_idx) {
+                                //Initialize the new covered vector, take the old one plus enable the new states
+                                typename state_data::covered_info covered(m_state_data.m_covered);
+                                covered.set(start_pos, end_pos);
+
+                                //Add a new hypothesis state to the multi-stack
+                                data.m_add_state(new(data.m_state_pool)
+                                        stack_state(data, this, fncs_pos, start_pos, end_pos, covered, entry, target_idx));
+                            }
+
                         private:
                             //This variable stores the pointer to the parent state or NULL if it is the root state
                             stack_state_ptr m_parent;
@@ -804,6 +883,12 @@ namespace uva {
                             //This double-linked list stores the list of states recombined into this state
                             stack_state_ptr m_recomb_from;
 
+                            //Stores the recombination signature, is only computed by the hash stack level
+                            uint_fast64_t m_recomb_sig;
+
+                            //Stores the state position within the hash stack level heap
+                            uint32_t m_heap_idx;
+
 #if IS_SERVER_TUNING_MODE
                             //Stores the state id unique within the multi-stack
                             //In case the software is compiled for the tuning mode.
@@ -27,17 +27,17 @@
 #define STATE_DATA_HPP
 
 #include <string>
-#include <bitset>
 
 #include "common/utils/exceptions.hpp"
 #include "common/utils/logging/logger.hpp"
 
 #include "common/utils/containers/circular_queue.hpp"
 
-#include "server/tm/models/tm_target_entry.hpp"
+#include "server/tm/models/tm_source_entry.hpp"
 #include "server/rm/models/rm_entry.hpp"
 
 #include "server/decoder/stack/stack_data.hpp"
+#include "server/decoder/stack/coverage_vector.hpp"
 
 using namespace std;
 
@@ -72,8 +72,8 @@ namespace uva {
                             //Make the typedef for the stack state translation frame
                             typedef circular_queue<word_uid, MAX_M_GRAM_QUERY_LENGTH > state_frame;
 
-                            //Make the typedef for the covered bitset
-                            typedef bitset<NUM_WORDS_PER_SENTENCE> covered_info;
+                            //Make the typedef for the covered words vector
+                            typedef coverage_vector_templ<NUM_WORDS_PER_SENTENCE> covered_info;
 
                             //Stores the undefined word index
                             static constexpr int32_t UNDEFINED_WORD_IDX = -1;
@@ -99,12 +99,14 @@ namespace uva {
                             state_data_templ(const stack_data & stack_data)
                             : m_stack_data(stack_data),
                             m_s_begin_word_idx(UNDEFINED_WORD_IDX), m_s_end_word_idx(UNDEFINED_WORD_IDX),
-                            m_stack_level(0), m_target(NULL),
+                            m_stack_level(0), m_source_entry(NULL), m_target_idx(0),
                             rm_entry_data(m_stack_data.m_rm_query.get_begin_tag_reordering()),
                             //Add the sentence begin tag uid to the target, since this is for the begin state
                             m_trans_frame(1, &m_stack_data.m_lm_query.get_begin_tag_uid()),
-                            m_begin_lm_level(M_GRAM_LEVEL_1),
-                            m_covered(), m_partial_score(0.0), m_total_score(0.0) INIT_STATE_DATA_TUNING_DATA{
+                            m_begin_lm_level(M_GRAM_LEVEL_1), m_lm_state_len(M_GRAM_LEVEL_1),
+                            m_covered(), m_gaps_cost(m_stack_data.m_sent_data[m_stack_data.m_sent_data.m_min_idx]
+                            [m_stack_data.m_sent_data.m_max_idx].future_cost),
+                            m_partial_score(0.0), m_total_score(0.0) INIT_STATE_DATA_TUNING_DATA{
                                 LOG_DEBUG1 << "New BEGIN state data: " << this << ", translating [" << m_s_begin_word_idx
                                 << ", " << m_s_end_word_idx << "], stack_level=" << m_stack_level
                                 << ", lm_level=" << m_begin_lm_level << ", target = ___" << BEGIN_SENTENCE_TAG_STR << "___" << END_LOG;
@@ -116,24 +118,23 @@ namespace uva {
 
                             /**
                              * The basic constructor that is to be used for the END STATE &lt;/s&gt;
-                             * @param stack_data the general shared stack data reference 
-                             * @param is_begin_end this flag allows to detect whether this
-                             * data is created for the begin or end tag. If true then it is
-                             * for the begin tag, if false then it is for the end tag
+                             * @param stack_data the stack data reference of the expanding thread
+                             * @param prev_state_data the constant reference to the parent state data
                              */
-                            state_data_templ(const state_data_templ & prev_state_data)
-                            : m_stack_data(prev_state_data.m_stack_data),
+                            state_data_templ(const stack_data & stack_data, const state_data_templ & prev_state_data)
+                            : m_stack_data(stack_data),
                             //Set the start and end word index to be the index after the last word in the sentence
                             m_s_begin_word_idx(m_stack_data.m_sent_data.get_dim()), m_s_end_word_idx(m_s_begin_word_idx),
                             //This is the next state level, i.e. the last one but there is of course no target for &lt;/s&gt;
-                            m_stack_level(prev_state_data.m_stack_level + 1), m_target(NULL),
+                            m_stack_level(prev_state_data.m_stack_level + 1), m_source_entry(NULL), m_target_idx(0),
                             //The reordering entry should contain the end tag reordering
                             rm_entry_data(m_stack_data.m_rm_query.get_end_tag_reordering()),
                             //Add the sentence end tag uid to the target, since this is for the end state
                             m_trans_frame(prev_state_data.m_trans_frame, 1, &m_stack_data.m_lm_query.get_end_tag_uid()),
                             m_begin_lm_level(prev_state_data.m_begin_lm_level),
+                            m_lm_state_len(prev_state_data.m_lm_state_len),
                             //The coverage vector stays the same, nothing new is added, we take over the partial score
-                            m_covered(prev_state_data.m_covered), m_partial_score(prev_state_data.m_partial_score),
+                            m_covered(prev_state_data.m_covered), m_gaps_cost(0.0), m_partial_score(prev_state_data.m_partial_score),
                             m_total_score(0.0) INIT_STATE_DATA_TUNING_DATA{
                                 LOG_DEBUG1 << "New END state data: " << this << " translating [" << m_s_begin_word_idx
                                 << ", " << m_s_end_word_idx << "], stack_level=" << m_stack_level
@@ -158,26 +159,32 @@ namespace uva {
                              * The basic constructor that is to be used for an INTERMEDIATE STATE data,
                              * it takes the parent state data and the new data to be stored/merged
                              * with the parent's data.
-                             * @param state_data the constant reference to the parent state data
+                             * @param stack_data the stack data reference of the expanding thread
+                             * @param prev_state_data the constant reference to the parent state data
                              * @param begin_pos this state translated source phrase begin position
                              * @param end_pos this state translated source phrase end position
-                             * @param target the pointer to the target translation of the source phrase
+                             * @param source_entry the pointer to the source entry of the source phrase
+                             * @param target_idx the index of the target translation within the source entry
                              */
-                            state_data_templ(const state_data_templ & prev_state_data,
-                                    const int32_t & begin_pos, const int32_t & end_pos,
-                                    const covered_info & covered, tm_const_target_entry* target)
-                            : m_stack_data(prev_state_data.m_stack_data),
+                            state_data_templ(const stack_data & stack_data, const state_data_templ & prev_state_data,
+                                    const int32_t & begin_pos, const int32_t & end_pos, const covered_info & covered,
+                                    tm_const_source_entry_ptr source_entry, const size_t target_idx)
+                            : m_stack_data(stack_data),
                             m_s_begin_word_idx(begin_pos), m_s_end_word_idx(end_pos),
                             m_stack_level(prev_state_data.m_stack_level + (m_s_end_word_idx - m_s_begin_word_idx + 1)),
-                            m_target(target), rm_entry_data(m_stack_data.m_rm_query.get_reordering(m_target->get_st_uid())),
-                            m_trans_frame(prev_state_data.m_trans_frame, m_target->get_num_words(), m_target->get_word_ids()),
+                            m_source_entry(source_entry), m_target_idx(target_idx),
+                            rm_entry_data(get_target().get_rm_entry()),
+                            m_trans_frame(prev_state_data.m_trans_frame, m_source_entry->get_num_words(m_target_idx),
+                            get_target().get_word_ids()),
                             m_begin_lm_level(prev_state_data.m_begin_lm_level),
-                            m_covered(covered), m_partial_score(prev_state_data.m_partial_score),
+                            m_lm_state_len(prev_state_data.m_lm_state_len),
+                            m_covered(covered), m_gaps_cost(prev_state_data.get_gaps_cost(begin_pos, end_pos)),
+                            m_partial_score(prev_state_data.m_partial_score),
                             m_total_score(0.0) INIT_STATE_DATA_TUNING_DATA{
                                 LOG_DEBUG1 << "New state data: " << this << ", translating [" << m_s_begin_word_idx
                                 << ", " << m_s_end_word_idx << "], stack_level=" << m_stack_level
                                 << ", lm_level=" << m_begin_lm_level << ", target = ___"
-                                << m_target->get_target_phrase() << "___" << END_LOG;
+                                << get_target().get_target_phrase() << "___" << END_LOG;
 
                                 LOG_DEBUG2 << "Trans frame: " << m_trans_frame << END_LOG;
                                 LOG_DEBUG1 << "Covered: " << covered_to_string() << END_LOG;
@@ -214,6 +221,14 @@ namespace uva {
                                 return result + "]";
                             }
 
+                            /**
+                             * Allows to get the target translation of the last phrase, is not to be called for the begin and end states
+                             * @return the reference to the target translation entry of the last phrase
+                             */
+                            inline tm_const_target_entry & get_target() const {
+                                return m_source_entry->get_targets()[m_target_idx];
+                            }
+
                             /**
                              * Extract the target, including the case when we are in the
                              * begin &lt;s&gt; or end state &lt;/s&gt; or a phrase with no translation.
@@ -227,13 +242,14 @@ namespace uva {
                             void get_target_phrase(string & storage) const {
                                 LOG_DEBUG1 << "The BEGIN storage value is: ___" << storage << "___" << END_LOG;
 
-                                LOG_DEBUG1 << "The target phrase pointer is " << ((m_target != NULL) ? "NOT " : "") << "NULL" << END_LOG;
+                                LOG_DEBUG1 << "The source entry pointer is " << ((m_source_entry != NULL) ? "NOT " : "") << "NULL" << END_LOG;
                                 //Check that the target is not NULL if it is then
                                 //it is either the begin &lt;s&gt; or end &lt;/s&gt; state
-                                if (m_target != NULL) {
-                                    LOG_DEBUG1 << "The source phrase has " << (m_target->is_unk_trans() ? "NO " : "") << "translation" << END_LOG;
+                                if (m_source_entry != NULL) {
+                                    const bool is_unk_trans = m_source_entry->is_unk_trans(m_target_idx);
+                                    LOG_DEBUG1 << "The source phrase has " << (is_unk_trans ? "NO " : "") << "translation" << END_LOG;
                                     //Append the space plus the current state translation
-                                    if (m_target->is_unk_trans()) {
+                                    if (is_unk_trans) {
                                         //If this is an unknown translation then just copy the original source text
 
                                         //Get the begin and end source phrase word indexes
@@ -259,9 +275,9 @@ namespace uva {
                                     } else {
                                         //If this is a known translation then add the translation text
                                         if (is_lattice) {
-                                            storage = m_target->get_target_phrase();
+                                            storage = get_target().get_target_phrase();
                                         } else {
-                                            storage += m_target->get_target_phrase();
+                                            storage += get_target().get_target_phrase();
                                         }
                                     }
 
@@ -294,8 +310,10 @@ namespace uva {
                             //Stores the stack level, i.e. the number of so far translated source words
                             const phrase_length m_stack_level;
 
-                            //Stores the pointer to the target translation of the last phrase
-                            tm_const_target_entry * const m_target;
+                            //Stores the pointer to the source entry of the last phrase, NULL for the begin and end states
+                            tm_const_source_entry * const m_source_entry;
+                            //Stores the index of the target translation of the last phrase within its source entry
+                            const size_t m_target_idx;
 
                             //Stores the reference to the reordering model entry data corresponding to this state
                             const rm_entry & rm_entry_data;
@@ -309,9 +327,18 @@ namespace uva {
                             //Stores the minimum m-gram level to consider when computing the LM probability of the history
                             phrase_length m_begin_lm_level;
 
-                            //Stores the bitset of covered words indexes
+                            //Stores the length of the LM right state, i.e. the number of the last
+                            //translation frame words that influence the LM probabilities of the
+                            //words to follow. The states with equal right states are recombined.
+                            phrase_length m_lm_state_len;
+
+                            //Stores the vector of covered words indexes
                             const covered_info m_covered;
 
+                            //Stores the sum of the future costs of the not-covered phrase spans,
+                            //is computed from the parent's one, so it is kept in double precision
+                            const double m_gaps_cost;
+
                             //Stores the logarithmic partial score of the current hypothesis
                             const prob_weight m_partial_score;
 
@@ -325,6 +352,83 @@ namespace uva {
                             prob_weight * const m_lattice_scores;
 #endif
 
+                            /**
+                             * Allows to compute the sum of the future costs of the not-covered phrase spans of
+                             * a child state, i.e. of this state's coverage plus the given phrase span. Only the
+                             * costs of the not-covered span split by the phrase span are to be updated.
+                             * @param begin_pos the child's translated source phrase begin position
+                             * @param end_pos the child's translated source phrase end position
+                             * @return the sum of the future costs of the child's not-covered spans
+                             */
+                            inline double get_gaps_cost(const int32_t begin_pos, const int32_t end_pos) const {
+                                //Get the not-covered span containing the phrase span
+                                const int32_t gap_begin = m_covered.prev_covered(begin_pos) + 1;
+                                const int32_t gap_end = min(m_covered.next_covered(end_pos),
+                                        m_stack_data.m_sent_data.m_max_idx + 1) - 1;
+
+                                LOG_DEBUG2 << "The phrase [" << begin_pos << ", " << end_pos << "] splits the gap ["
+                                        << gap_begin << ", " << gap_end << "]" << END_LOG;
+
+                                //Replace the span's cost with the costs of the span's parts around the phrase
+                                double gaps_cost = m_gaps_cost - m_stack_data.m_sent_data[gap_begin][gap_end].future_cost;
+                                if (gap_begin < begin_pos) {
+                                    gaps_cost += m_stack_data.m_sent_data[gap_begin][begin_pos - 1].future_cost;
+                                }
+                                if (end_pos < gap_end) {
+                                    gaps_cost += m_stack_data.m_sent_data[end_pos + 1][gap_end].future_cost;
+                                }
+                                return gaps_cost;
+                            }
+
+                            /**
+                             * Allows to compute the linear distortion future cost of the given coverage, if
+                             * enabled, i.e. the cost of translating the not-covered spans from left to right,
+                             * starting after the last translated phrase and finishing with the end tag.
+                             * The jumps between the not-covered spans are over the covered words in between,
+                             * so the distance only depends on the first and the last not-covered words.
+                             * @param covered the covered words vector
+                             * @param end_word_idx the last translated phrase end word index
+                             * @return the linear distortion future cost, log scale
+                             */
+                            inline prob_weight get_dist_future_cost(const covered_info & covered, const int32_t end_word_idx) const {
+                                if (m_stack_data.m_params.m_is_reord_future_cost) {
+                                    const int32_t num_words = m_stack_data.m_sent_data.get_dim();
+                                    const int32_t first_nc_idx = covered.next_uncovered(m_stack_data.m_sent_data.m_min_idx);
+
+                                    int32_t distance = 0;
+                                    if (first_nc_idx < num_words) {
+                                        const int32_t last_nc_idx = covered.prev_uncovered(m_stack_data.m_sent_data.m_max_idx);
+                                        const int32_t num_nc_words = num_words - covered.count();
+                                        //The jump to the first span, over the covered words to the last span and to the end tag
+                                        distance = abs(first_nc_idx - (end_word_idx + 1)) +
+                                                ((last_nc_idx - first_nc_idx + 1) - num_nc_words) +
+                                                (num_words - (last_nc_idx + 1));
+                                    } else {
+                                        //There are no not-covered words, just jump to the end tag
+                                        distance = abs(num_words - (end_word_idx + 1));
+                                    }
+
+                                    LOG_DEBUG1 << "Future distortion distance: " << distance << END_LOG;
+
+                                    return - m_stack_data.m_params.m_lin_dist_penalty * distance;
+                                } else {
+                                    return 0.0;
+                                }
+                            }
+
+                            /**
+                             * Allows to compute the future cost estimate of a child state, i.e. the sum of the
+                             * future costs of the not-covered phrase spans plus the linear distortion future cost.
+                             * @param covered the child's covered words vector
+                             * @param begin_pos the child's translated source phrase begin position
+                             * @param end_pos the child's translated source phrase end position
+                             * @return the future cost estimate, log scale
+                             */
+                            inline prob_weight compute_future_cost(const covered_info & covered,
+                                    const int32_t begin_pos, const int32_t end_pos) const {
+                                return get_gaps_cost(begin_pos, end_pos) + get_dist_future_cost(covered, end_pos);
+                            }
+
                         private:
 
                             /**
@@ -334,7 +438,7 @@ namespace uva {
                             inline prob_weight get_lm_cost() {
                                 //The number of new words that came into translation is either the
                                 //number of words in the target or one, for the &lt;s&gt; or &lt;/s&gt; tags
-                                const size_t num_new_words = ((m_target != NULL) ? m_target->get_num_words() : 1);
+                                const size_t num_new_words = ((m_source_entry != NULL) ? m_source_entry->get_num_words(m_target_idx) : 1);
 
                                 //Do the sanity check
                                 ASSERT_SANITY_THROW(((MAX_HISTORY_LENGTH + num_new_words) > MAX_M_GRAM_QUERY_LENGTH),
@@ -363,9 +467,10 @@ namespace uva {
                                 //Execute the query and return the value
                                 prob_weight cost = m_stack_data.m_lm_query.execute(
                                         num_query_words, query_word_ids,
-                                        m_begin_lm_level, PASS_TUNING_FEATURES_MAP);
-                                LOG_DEBUG1 << "LM costs: " << cost << END_LOG;
-                                return cost;
+                                        m_begin_lm_level, m_lm_state_len, PASS_TUNING_FEATURES_MAP);
+                                LOG_DEBUG1 << "LM costs: " << cost << ", right state length: " << m_lm_state_len << END_LOG;
+                                //The model probabilities are stored without the lambda weight
+                                return m_stack_data.m_params.m_weights.m_lm_lambda * cost;
                             }
 
                             /**
@@ -413,7 +518,8 @@ namespace uva {
                             template<bool is_from>
                             inline const prob_weight get_lex_rm_cost(const reordering_orientation orient, prob_weight * scores = NULL) const {
                                 //Get the lexicolized reordering cost
-                                prob_weight cost = rm_entry_data.template get_weight<is_from>(orient, scores);
+                                prob_weight cost = rm_entry_data.template get_weight<is_from>(
+                                        orient, m_stack_data.m_params.m_weights.m_rm_lambdas, scores);
                                 LOG_DEBUG1 << "Lex RM <" << (is_from ? "from" : "to") << "> costs: " << cost << END_LOG;
                                 return cost;
                             }
@@ -424,7 +530,7 @@ namespace uva {
                              */
                             inline prob_weight get_tm_cost() {
                                 //Get the translation model costs
-                                prob_weight cost = m_target->get_tm_cost(PASS_TUNING_FEATURES_MAP);
+                                prob_weight cost = m_source_entry->get_tm_cost(m_target_idx, m_stack_data.m_tm_weights, PASS_TUNING_FEATURES_MAP);
                                 LOG_DEBUG1 << "TM costs: " << cost << END_LOG;
                                 return cost;
                             }
@@ -517,46 +623,8 @@ namespace uva {
                                 //thus it is declared as constant and here we do a const_cast
                                 prob_weight & total_score = const_cast<prob_weight &> (m_total_score);
 
-                                //Set the total score to the current partial score and then add the future costs
-                                total_score = m_partial_score;
-
-                                LOG_DEBUG2 << "Initial total score: " << total_score << END_LOG;
-
-                                //Iterate through all the non-translated phrase spans and add the future costs thereof
-                                phrase_length begin_idx = m_stack_data.m_sent_data.m_min_idx;
-                                while (begin_idx <= m_stack_data.m_sent_data.m_max_idx) {
-                                    LOG_DEBUG2 << "m_covered[" << begin_idx << "] = "
-                                            << (m_covered[begin_idx] ? "true" : "false") << END_LOG;
-
-                                    if (!m_covered[begin_idx]) {
-                                        //Start from the begin word, as may be this is the only uncovered word left.
-                                        phrase_length end_idx = begin_idx;
-
-                                        LOG_DEBUG2 << "first end_idx: " << end_idx << END_LOG;
-
-                                        //Iterate until we are beyond the last word or the word is covered
-                                        while ((end_idx <= m_stack_data.m_sent_data.m_max_idx) && !m_covered[end_idx]) {
-                                            ++end_idx;
-                                            LOG_DEBUG2 << "Considering end_idx: " << end_idx << END_LOG;
-                                        }
-
-                                        LOG_DEBUG2 << "First bad end_idx: " << end_idx << " the previous was good!" << END_LOG;
-
-                                        //The previous end word was the last good one, add the span's costs
-                                        total_score += m_stack_data.m_sent_data[begin_idx][end_idx - 1].future_cost;
-
-                                        LOG_DEBUG1 << "total future_cost[" << begin_idx << ", " << (end_idx - 1) << "]: "
-                                                << m_stack_data.m_sent_data[begin_idx][end_idx - 1].future_cost << END_LOG;
-
-                                        //Start searching further from the first word after the bad one we just found
-                                        begin_idx = end_idx + 1;
-                                    } else {
-                                        //Move on to the next begin index
-                                        ++begin_idx;
-                                    }
-
-                                    LOG_DEBUG2 << "next begin_idx: " << begin_idx << END_LOG;
-                                }
+                                //Set the total score to the current partial score plus the future costs
+                                total_score = m_partial_score + (m_gaps_cost + get_dist_future_cost(m_covered, m_s_end_word_idx));
 
                                 LOG_DEBUG1 << "Total score: " << total_score << END_LOG;
                             }
@@ -31,9 +31,11 @@
 #include "server/lm/lm_consts.hpp"
 #include "server/lm/lm_parameters.hpp"
 #include "common/utils/file/text_piece_reader.hpp"
+#include "common/utils/threads/fork_join_pool.hpp"
 
 using namespace std;
 using namespace uva::utils::file;
+using namespace uva::utils::threads;
 
 using namespace uva::smt::bpbd::server::lm;
 using namespace uva::smt::bpbd::server::lm::identifiers;
@@ -49,6 +51,8 @@ namespace uva {
                         static const string END_OF_ARPA_FILE = "\\end\\";
                         //The N-gram Data Section Amoung delimiter
                         static const string NGRAM_COUNTS_DELIM = "=";
+                        //The number of M-gram lines per loading thread to be parsed in one go
+                        static constexpr size_t NUM_LINES_PER_LOAD_PART = 8192;
 
                         /**
                          * This is the Trie builder class that reads an input file stream
@@ -88,6 +92,8 @@ namespace uva {
                             const regex m_ng_amount_reg_exp;
                             //The regular expression for matching the n-grams section
                             const regex m_ng_section_reg_exp;
+                            //Stores the pool of helper threads parsing the M-gram lines, or NULL if loading is sequential
+                            fork_join_pool * m_pool;
 
                             /**
                              * The copy constructor
@@ -124,13 +130,20 @@ namespace uva {
                             /**
                              * Allows to read the given Trie level M-grams from the file
                              * @param level the currently read M-gram level M
-                             * @param is_mult_weight true if we need to multiply the lm
-                             * probabilities and back-off weights with the language model
-                             * weight from the model properties
                              */
-                            template<phrase_length CURR_LEVEL, bool is_mult_weight>
+                            template<phrase_length CURR_LEVEL>
                             void read_m_gram_level();
 
+                            /**
+                             * Allows to read the given Trie level M-grams from the file, for M > 1, using
+                             * several threads. The lines are read in batches, every batch is split into
+                             * line aligned parts that are parsed and hashed in parallel. The parsed M-grams
+                             * are then added to the trie by the calling thread, in the order of the file.
+                             * @param level the currently read M-gram level M
+                             */
+                            template<phrase_length CURR_LEVEL>
+                            void read_m_gram_level_parallel();
+
                             template<phrase_length CURR_LEVEL, typename DUMMY = void>
                             struct Func {
 
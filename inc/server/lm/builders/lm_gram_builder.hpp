@@ -54,7 +54,7 @@ namespace uva {
                         /**
                          * This class is responsible for splitting a piece of text in a number of ngrams and place it into the trie
                          */
-                        template<typename WordIndexType, phrase_length CURR_LEVEL, bool is_mult_weight>
+                        template<typename WordIndexType, phrase_length CURR_LEVEL>
                         class lm_gram_builder {
                         public:
 
@@ -79,6 +79,19 @@ namespace uva {
                              */
                             bool parse_line(text_piece_reader & data);
 
+                            /**
+                             * Allows to parse the N-Gram string from the ARPA file format into the
+                             * given m-gram and to prepare it for being added to the trie, but does
+                             * not add it. For 1 < N the method does not change the word index, so
+                             * different builders can be used to parse the lines concurrently.
+                             * @param data the string to process, has to be space a
+                             *             separated sequence of tokens
+                             * @param m_gram the m-gram to parse the string into
+                             * @result returns true if the provided line is NOT recognized
+                             *         as the N-Gram of the specified level.
+                             */
+                            bool parse_line(text_piece_reader & data, model_m_gram & m_gram);
+
                             /**
                              * Takes the uni-gram line and parses it to the word and its probability, no back-off weight!
                              * @param text the piece to read the uni-gram line from
@@ -143,9 +156,10 @@ namespace uva {
                             /**
                              * Parse the given text into a N-Gram entry from the ARPA file
                              * @param line the piece of text to parse into the M-gram
+                             * @param m_gram the m-gram to parse the line into
                              * @return true if the line has been successfully parsed
                              */
-                            bool parse_to_gram(text_piece_reader & line);
+                            bool parse_to_gram(text_piece_reader & line, model_m_gram & m_gram);
 
                             /**
                              * The copy constructor
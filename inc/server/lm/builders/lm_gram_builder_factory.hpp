@@ -77,13 +77,12 @@ namespace uva {
                              * builder is to be freed by the caller!
                              * 
                              * @tparam CURR_LEVEL the level of the N-gram we currently need the builder for
-                             * @tparam is_mult_weight true if the loaded elements are to be multiplied with the weight, otherwise false
-                             * @param params the model parameters weights are to be multiplies with the language model m-gram weight
+                             * @param params the model parameters
                              * @param trie the trie to be filled in with the N-grams
                              * @param ppBuilder the pointer to the pointer to a dynamically allocated N-Gram builder
                              */
-                            template<phrase_length CURR_LEVEL, bool is_mult_weight>
-                            static inline void get_builder(const lm_parameters & params, TrieType & trie, lm_gram_builder<WordIndexType, CURR_LEVEL, is_mult_weight> **ppBuilder) {
+                            template<phrase_length CURR_LEVEL>
+                            static inline void get_builder(const lm_parameters & params, TrieType & trie, lm_gram_builder<WordIndexType, CURR_LEVEL> **ppBuilder) {
                                 //First reset the pointer to NULL
                                 *ppBuilder = NULL;
                                 LOG_DEBUG << "Requested a " << CURR_LEVEL << "-Gram builder, the maximum level is " << LM_M_GRAM_LEVEL_MAX << END_LOG;
@@ -99,8 +98,8 @@ namespace uva {
                                 } else {
                                     //Here we are to get the builder instance
                                     LOG_DEBUG1 << "Instantiating the " << CURR_LEVEL << "-Gram builder.." << END_LOG;
-                                    //Create a builder with the proper lambda as an argument
-                                    *ppBuilder = new lm_gram_builder<WordIndexType, CURR_LEVEL, is_mult_weight>(params, trie.get_word_index(),
+                                    //Create a builder with the trie adding function as an argument
+                                    *ppBuilder = new lm_gram_builder<WordIndexType, CURR_LEVEL>(params, trie.get_word_index(),
                                             [&] (const model_m_gram & gram) {
                                                 trie.template add_m_gram<CURR_LEVEL>(gram);
                                             });
@@ -35,6 +35,7 @@
 #include "server/lm/proxy/lm_proxy_local.hpp"
 #include "server/lm/proxy/lm_slow_query_proxy.hpp"
 #include "server/lm/proxy/lm_fast_query_proxy.hpp"
+#include "server/lm/proxy/lm_query_cache.hpp"
 
 using namespace uva::utils::exceptions;
 using namespace uva::utils::logging;
@@ -65,6 +66,8 @@ namespace uva {
                         static void connect(const lm_parameters & params) {
                             //Store the parameters for future use
                             m_params = &params;
+                            //Set up the per thread query caches, before any query is executed
+                            lm_query_cache::set_capacity(m_params->m_query_cache_size);
 
                             //At the moment we only support a local proxy
                             m_model_proxy = new lm_proxy_local();
@@ -86,6 +89,22 @@ namespace uva {
                             }
                         }
 
+                        /**
+                         * Allows to get the language model parameters the model is connected with
+                         * @return the language model parameters
+                         */
+                        static inline const lm_parameters & get_params() {
+                            return *m_params;
+                        }
+
+                        /**
+                         * Allows to store the connected language model into a binary image file
+                         * @param file_name the name of the binary image file to create
+                         */
+                        static void write_model_image(const string & file_name) {
+                            m_model_proxy->write_model_image(file_name);
+                        }
+
                         /**
                          * Allows to return an instance of the query executor,
                          * is to be returned by calling the dispose method.
@@ -53,6 +53,14 @@ namespace uva {
                     //The base of the logarithm of the probability weights in the ARPA file
                     static constexpr prob_weight ARPA_PROB_WEIGHT_LOG_10_BASE = 10;
 
+                    namespace __lm_image {
+                        //The magic marker the binary language model image files start with
+                        static constexpr char MAGIC[] = "BPBD_LMI";
+                        //The binary language model image format version, is to be
+                        //increased whenever the image layout of any model changes
+                        static constexpr uint32_t VERSION = 4;
+                    }
+
                     namespace dictionary {
 
                         namespace __AWordIndex {
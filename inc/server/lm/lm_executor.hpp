@@ -73,8 +73,11 @@ namespace uva {
                             //Stores the language model specific parameters
                             lm_parameters m_lm_params;
 
-                            //The test file name
+                            //The test file name, may be empty
                             string m_query_file_name;
+
+                            //The binary model image file name to create, may be empty
+                            string m_image_file_name;
                         } lm_exec_params;
 
                         /**
@@ -126,28 +129,36 @@ namespace uva {
                          * @param params the runtime program parameters
                          */
                         static void perform_tasks(const __executor::lm_exec_params & params) {
-                            //Attempt to open the test file
-                            memory_mapped_file_reader test_file(params.m_query_file_name.c_str());
-
-                            //Assert that the query file is opened
-                            ASSERT_CONDITION_THROW(!test_file.is_open(), string("The Test Queries file: '")
-                                    + params.m_query_file_name + string("' does not exist!"));
-
                             //Connect to the language model
                             lm_configurator::connect(params.m_lm_params);
 
-                            //Override the reporting level for testing purposes
-                            //Logger::get_reporting_level() = DebugLevelsEnum::DEBUG2;
+                            //Store the binary model image if requested
+                            if (!params.m_image_file_name.empty()) {
+                                lm_configurator::write_model_image(params.m_image_file_name);
+                            }
+
+                            //Execute the queries if requested
+                            if (!params.m_query_file_name.empty()) {
+                                //Attempt to open the test file
+                                memory_mapped_file_reader test_file(params.m_query_file_name.c_str());
 
-                            //Execute the queries
-                            execute_queries(test_file);
+                                //Assert that the query file is opened
+                                ASSERT_CONDITION_THROW(!test_file.is_open(), string("The Test Queries file: '")
+                                        + params.m_query_file_name + string("' does not exist!"));
+
+                                //Override the reporting level for testing purposes
+                                //Logger::get_reporting_level() = DebugLevelsEnum::DEBUG2;
+
+                                //Execute the queries
+                                execute_queries(test_file);
+
+                                //Close the test file
+                                test_file.close();
+                            }
 
                             //Deallocate the trie
                             LOG_USAGE << "Cleaning up memory ..." << END_LOG;
 
-                            //Close the test file
-                            test_file.close();
-
                             //Disconnect from the trie
                             lm_configurator::disconnect();
                         }
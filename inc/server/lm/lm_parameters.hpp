@@ -36,6 +36,7 @@
 
 #include "server/server_configs.hpp"
 #include "server/common/feature_id_registry.hpp"
+#include "server/common/models/feature_weights.hpp"
 
 using namespace std;
 
@@ -44,6 +45,7 @@ using namespace uva::utils::logging;
 using namespace uva::utils::text;
 
 using namespace uva::smt::bpbd::server::common;
+using namespace uva::smt::bpbd::server::common::models;
 
 namespace uva {
     namespace smt {
@@ -67,6 +69,16 @@ namespace uva {
                         static size_t LM_WEIGHT_GLOBAL_IDS[MAX_NUM_LM_FEATURES];
                         //The unknown word log_e probability parameter name
                         static const string LM_UNK_WORD_LOG_E_PROB_PARAM_NAME;
+                        //The per thread LM query cache size parameter name
+                        static const string LM_QUERY_CACHE_SIZE_PARAM_NAME;
+                        //The default per thread LM query cache size
+                        static constexpr uint32_t LM_DEF_QUERY_CACHE_SIZE = 32768;
+                        //The number of ARPA model loading threads parameter name
+                        static const string LM_NUM_LOAD_THREADS_PARAM_NAME;
+                        //The default number of ARPA model loading threads
+                        static constexpr uint32_t LM_DEF_NUM_LOAD_THREADS = 1;
+                        //The m-gram keys verification flag parameter name
+                        static const string LM_IS_VERIFY_KEYS_PARAM_NAME;
 
                         //The the connection string needed to connect to the model
                         string m_conn_string;
@@ -75,10 +87,14 @@ namespace uva {
                         size_t m_num_lambdas;
                         //Stores the language model weights
                         float m_lambdas[MAX_NUM_LM_FEATURES];
-                        //Stores the flag indicating whether the lm flag is to be used
-                        bool m_is_0_lm_weight;
                         //Stores the unknown word probability in the log_e space
                         float m_unk_word_log_e_prob;
+                        //Stores the number of entries in the per thread LM query cache, zero disables the cache
+                        uint32_t m_query_cache_size;
+                        //Stores the number of threads used to load the ARPA model
+                        uint32_t m_num_load_threads;
+                        //Stores the flag indicating whether the hash-based model verifies the m-gram keys
+                        bool m_is_verify_keys;
 
                         /**
                          * Allows to get the features weights used in the corresponding model.
@@ -95,11 +111,11 @@ namespace uva {
                         }
 
                         /**
-                         * Allows to retrieve the first LM language model m-gram weight
-                         * @return the language model m-gram weight
+                         * Allows to set the language model weight into the feature weights
+                         * @param weights the feature weights to be filled in
                          */
-                        inline const float & get_0_lm_weight() const {
-                            return m_lambdas[0];
+                        inline void fill_weights(feature_weights & weights) const {
+                            weights.m_lm_lambda = m_lambdas[0];
                         }
 
                         /**
@@ -116,8 +132,10 @@ namespace uva {
                             ASSERT_CONDITION_THROW((m_num_lambdas == 0) || (m_lambdas[0] == 0.0),
                                     string("The value of ") + LM_WEIGHT_NAMES[0] + string(" must not be 0.0!"));
 
-                            //Set the flag value, indicating whether the lambda is to be used
-                            m_is_0_lm_weight = ((m_num_lambdas != 0) && (m_lambdas[0] != 1.0));
+                            //Check that there is at least one loading thread
+                            ASSERT_CONDITION_THROW((m_num_load_threads == 0),
+                                    string("The value of ") + LM_NUM_LOAD_THREADS_PARAM_NAME +
+                                    string(" must be > 0!"));
                         }
                     };
 
@@ -137,6 +155,12 @@ namespace uva {
                                 params.m_lambdas, LM_FEATURE_WEIGHTS_DELIMITER_STR)
                                 << ", " << lm_parameters::LM_UNK_WORD_LOG_E_PROB_PARAM_NAME
                                 << " = " << params.m_unk_word_log_e_prob
+                                << ", " << lm_parameters::LM_QUERY_CACHE_SIZE_PARAM_NAME
+                                << " = " << params.m_query_cache_size
+                                << ", " << lm_parameters::LM_NUM_LOAD_THREADS_PARAM_NAME
+                                << " = " << params.m_num_load_threads
+                                << ", " << lm_parameters::LM_IS_VERIFY_KEYS_PARAM_NAME
+                                << " = " << (params.m_is_verify_keys ? "true" : "false")
                                 << " }";
                     }
                 }
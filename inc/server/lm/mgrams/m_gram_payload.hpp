@@ -41,6 +41,7 @@
 #include "server/lm/dictionaries/counting_word_index.hpp"
 #include "server/lm/dictionaries/optimizing_word_index.hpp"
 
+using namespace uva::utils::hashing;
 using namespace uva::smt::bpbd::server::lm::m_grams::m_gram_id;
 
 namespace uva {
@@ -237,6 +238,25 @@ namespace uva {
                                 return m_phrase_id_ptr;
                             }
 
+                            /**
+                             * Allows to compute the fingerprint of the sub-phrase defined by the given word indexes.
+                             * The fingerprint is computed from the word ids independently from the phrase hash
+                             * value, so it can be used to tell apart the phrases with colliding hash values.
+                             * @param begin_word_idx the index of the first word in the sub-phrase
+                             * @param end_word_idx the index of the last word in the sub-phrase
+                             * @return the 32 bit fingerprint of the sub-phrase
+                             */
+                            inline uint32_t get_fingerprint(phrase_length begin_word_idx, const phrase_length end_word_idx) const {
+                                //Use the FNV offset basis and prime, mixing the value after adding every word id
+                                uint_fast64_t fp = 14695981039346656037ULL;
+                                for (; begin_word_idx <= end_word_idx; ++begin_word_idx) {
+                                    fp = (fp ^ m_word_ids[begin_word_idx]) * 1099511628211ULL;
+                                    mix_fasthash(fp);
+                                }
+                                //Fold the value into 32 bits
+                                return static_cast<uint32_t> (fp ^ (fp >> 32));
+                            }
+
                         protected:
 
                             /**
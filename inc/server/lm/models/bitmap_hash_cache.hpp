@@ -35,12 +35,14 @@
 #include "server/lm/mgrams/model_m_gram.hpp"
 #include "common/utils/hashing_utils.hpp"
 #include "common/utils/math_utils.hpp"
+#include "common/utils/file/binary_image.hpp"
 
 using namespace std;
 
 using namespace uva::utils::math;
 using namespace uva::utils::logging;
 using namespace uva::utils::exceptions;
+using namespace uva::utils::file;
 using namespace uva::smt::bpbd::server::lm::m_grams;
 using namespace uva::smt::bpbd::server::lm::identifiers;
 
@@ -64,14 +66,14 @@ namespace uva {
                             /**
                              * The basic constructor, does not do much - only default initialization
                              */
-                            BitmapHashCache() : m_num_buckets(0), m_data_ptr(NULL) {
+                            BitmapHashCache() : m_num_buckets(0), m_data_ptr(NULL), m_is_mapped(false) {
                             }
 
                             /**
                              * The basic destructor
                              */
                             virtual ~BitmapHashCache() {
-                                if (m_data_ptr != NULL) {
+                                if ((m_data_ptr != NULL) && !m_is_mapped) {
                                     delete[] m_data_ptr;
                                 }
                             }
@@ -103,6 +105,30 @@ namespace uva {
                                 }
                             }
 
+                            /**
+                             * Allows to write the bitset into a binary image
+                             * @param image the binary image writer
+                             */
+                            inline void write_image(binary_image_writer & image) const {
+                                image.write<uint64_t>(m_num_buckets);
+                                image.write_array(m_data_ptr, NUM_BYTES_4_BITS(m_num_buckets));
+                            }
+
+                            /**
+                             * Allows to map the bitset from a binary image, the data is not copied
+                             * @param image the binary image reader
+                             */
+                            inline void read_image(binary_image_reader & image) {
+                                if (DO_SANITY_CHECKS && (m_data_ptr != NULL)) {
+                                    THROW_EXCEPTION("The bitset is already pre-allocated!");
+                                }
+
+                                m_num_buckets = image.read<uint64_t>();
+                                m_buckets_capacity = m_num_buckets - 1;
+                                m_data_ptr = const_cast<uint8_t *> (image.read_array<uint8_t>(NUM_BYTES_4_BITS(m_num_buckets)));
+                                m_is_mapped = true;
+                            }
+
                             /**
                              * Allows to add the M-gram to the cache
                              * @param gram the M-gram to cache
@@ -149,6 +175,8 @@ namespace uva {
                             size_t m_buckets_capacity;
                             //Stores the data allocated for the bitset
                             uint8_t * m_data_ptr;
+                            //Stores the flag indicating that the data is memory mapped and not owned
+                            bool m_is_mapped;
 
                             /**
                              * Allows to get the bit position for the M-gram
@@ -166,6 +166,30 @@ namespace uva {
                             }
                         }
 
+                        /**
+                         * Allows to check whether the trie can be stored into and mapped from a binary image
+                         * @return false, by default the tries do not support binary images
+                         */
+                        static constexpr bool is_image_supported() {
+                            return false;
+                        }
+
+                        /**
+                         * Allows to write the fully built trie into a binary image
+                         * @param image the binary image writer
+                         */
+                        inline void write_image(binary_image_writer & image) const {
+                            THROW_MUST_OVERRIDE();
+                        }
+
+                        /**
+                         * Allows to map the trie from a binary image, instead of building it
+                         * @param image the binary image reader
+                         */
+                        inline void read_image(binary_image_reader & image) {
+                            THROW_MUST_OVERRIDE();
+                        }
+
                         /**
                          * This method adds a M-Gram (word) to the trie where 1 < M < N
                          * @param gram the M-Gram data
@@ -235,8 +259,10 @@ namespace uva {
                         /**
                          * This method allows to get the payloads and compute the (joint) m-gram probabilities.
                          * @param query the query execution data for storing the query, and retrieved payloads, and resulting probabilities, and etc.
+                         * @return the length of the longest m-gram, present in the trie, that ends in the last query word.
+                         *         The m-grams are prefix closed, so no longer suffix of the query is present in the trie.
                          */
-                        inline void execute(m_gram_query & query) const {
+                        inline phrase_length execute(m_gram_query & query) const {
                             //Declare the stream-compute result status variable
                             MGramStatusEnum status = MGramStatusEnum::GOOD_PRESENT_MGS;
 
@@ -292,6 +318,9 @@ namespace uva {
                                     ++query.m_curr_end_word_idx;
                                 }
                             }
+
+                            //The last found m-gram starts in the current begin word and ends before the current end word
+                            return (query.m_curr_end_word_idx - query.m_curr_begin_word_idx);
                         };
 
                         /**
@@ -345,6 +374,34 @@ namespace uva {
                         virtual ~generic_trie_base() {
                         }
 
+                    protected:
+
+                        /**
+                         * Is to be used from the sub-classes from the write_image methods.
+                         * Allows to write the bitmap hash caches into the binary image, if present.
+                         * @param image the binary image writer
+                         */
+                        inline void write_bitmap_caches(binary_image_writer & image) const {
+                            if (NEEDS_BITMAP_HASH_CACHE) {
+                                for (size_t idx = 0; idx < NUM_M_N_GRAM_LEVELS; ++idx) {
+                                    m_bitmap_hash_cach[idx].write_image(image);
+                                }
+                            }
+                        }
+
+                        /**
+                         * Is to be used from the sub-classes from the read_image methods.
+                         * Allows to map the bitmap hash caches from the binary image, if present.
+                         * @param image the binary image reader
+                         */
+                        inline void read_bitmap_caches(binary_image_reader & image) {
+                            if (NEEDS_BITMAP_HASH_CACHE) {
+                                for (size_t idx = 0; idx < NUM_M_N_GRAM_LEVELS; ++idx) {
+                                    m_bitmap_hash_cach[idx].read_image(image);
+                                }
+                            }
+                        }
+
                     private:
 
                         //Stores the bitmap hash caches per M-gram level for 1 < M <= N
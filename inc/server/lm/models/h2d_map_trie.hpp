@@ -103,10 +103,47 @@ namespace uva {
                             }
                         };
 #pragma pack(pop) //back to whatever the previous packing mode was 
+
+                        /**
+                         * This template structure is the m-gram look-up key used if the m-gram keys
+                         * are verified. The m-gram fingerprints are stored in an array parallel to
+                         * the map elements, so the element fingerprint is found by the element index.
+                         * @param TElemType the map element type
+                         */
+                        template<typename TElemType>
+                        struct S_M_GramVerifyKey {
+                            //The m-gram id, i.e. its hash value
+                            uint64_t m_id;
+                            //The m-gram fingerprint
+                            uint32_t m_fp;
+                            //The map elements array
+                            const TElemType * m_elems;
+                            //The fingerprints array, parallel to the map elements array
+                            const uint32_t * m_fps;
+                        };
+
+                        /**
+                         * The comparison operator, allows to compare the map element with the verified m-gram key
+                         * @param elem the map element, is to be stored in the elements array of the key
+                         * @param key the verified m-gram key to compare with
+                         * @return true if the m-gram ids and fingerprints are equal, otherwise false
+                         */
+                        template<typename TElemType>
+                        inline bool operator==(const TElemType & elem, const S_M_GramVerifyKey<TElemType> & key) {
+                            return (elem.m_id == key.m_id) && (key.m_fps[&elem - key.m_elems] == key.m_fp);
+                        }
                     }
 
                     /**
                      * This is a Gram to Data trie that is implemented as a HashMap.
+                     * The m-gram id is its 64 bit hash value, so an m-gram that is not in the model
+                     * gets a wrong payload if its hash value equals that of a stored one of the same
+                     * level. For a level of n m-grams this happens with the probability of about
+                     * n / 2^64 per look-up, i.e. 5.4E-11 for a billion m-grams. If the m-gram keys
+                     * are verified then a 32 bit fingerprint, independent from the hash value, is
+                     * stored per m-gram and compared as well, so the probability drops to about
+                     * n / 2^96 at the cost of 4 bytes per m-gram. The stored m-grams with equal
+                     * hash values are then also told apart, they are counted when loading.
                      * @param M_GRAM_LEVEL_MAX - the maximum level of the considered N-gram, i.e. the N value
                      */
                     template<typename WordIndexType>
@@ -137,6 +174,17 @@ namespace uva {
                             LOG_USAGE << "Using the <" << __FILENAME__ << "> model." << END_LOG;
                             LOG_INFO << "The <" << __FILENAME__ << "> model's buckets factor: "
                                     << __H2DMapTrie::BUCKETS_FACTOR << END_LOG;
+                            LOG_INFO << "The <" << __FILENAME__ << "> model's m-gram key verification: "
+                                    << (m_is_verify ? "on" : "off") << END_LOG;
+                        }
+
+                        /**
+                         * If the m-gram keys are verified then the m-gram fingerprints are
+                         * stored, the binary image is then to be created with verification.
+                         * @see word_index_trie_base
+                         */
+                        inline void set_verify_keys(const bool is_verify) {
+                            m_is_verify = is_verify;
                         }
 
                         /**
@@ -144,6 +192,25 @@ namespace uva {
                          */
                         void set_def_unk_word_prob(const prob_weight prob);
 
+                        /**
+                         * The hash-based trie stores all its data in plain arrays and is
+                         * used with the stateless hashing word index, so it can be mapped.
+                         * @see generic_trie_base
+                         */
+                        static constexpr bool is_image_supported() {
+                            return true;
+                        }
+
+                        /**
+                         * @see generic_trie_base
+                         */
+                        void write_image(binary_image_writer & image) const;
+
+                        /**
+                         * @see generic_trie_base
+                         */
+                        void read_image(binary_image_reader & image);
+
                         /**
                          * This method can be used to provide the N-gram count information
                          * That should allow for pre-allocation of the memory
@@ -151,6 +218,33 @@ namespace uva {
                          */
                         virtual void pre_allocate(const size_t counts[LM_M_GRAM_LEVEL_MAX]);
 
+                        /**
+                         * If the m-gram keys are verified, the post processing
+                         * reports the number of the level's m-gram hash collisions.
+                         * @see word_index_trie_base
+                         */
+                        template<phrase_length CURR_LEVEL>
+                        inline bool is_post_grams() const {
+                            return m_is_verify || BASE::template is_post_grams<CURR_LEVEL>();
+                        }
+
+                        /**
+                         * @see word_index_trie_base
+                         */
+                        template<phrase_length CURR_LEVEL>
+                        inline void post_grams() {
+                            //Call the base class method first
+                            if (BASE::template is_post_grams<CURR_LEVEL>()) {
+                                BASE::template post_grams<CURR_LEVEL>();
+                            }
+
+                            //Report the number of the m-gram hash collisions
+                            if (m_is_verify) {
+                                LOG_USAGE << "The number of " << SSTR(CURR_LEVEL) << "-gram hash collisions: "
+                                        << m_num_collisions[CURR_LEVEL - 1] << END_LOG;
+                            }
+                        }
+
                         /**
                          * This method adds a M-Gram (word) to the trie where 1 < M < N
                          * @see GenericTrieBase
@@ -171,24 +265,32 @@ namespace uva {
                             LOG_DEBUG << "Getting the bucket id for the m-gram: " << gram << " hash value: " << hash_value << END_LOG;
 
                             if (CURR_LEVEL == LM_M_GRAM_LEVEL_MAX) {
+                                //Count the m-gram hash collision, if any
+                                count_collision<CURR_LEVEL>(m_n_gram_data, hash_value);
                                 //Create a new M-Gram data entry
                                 T_M_Gram_Prob_Entry & data = m_n_gram_data->add_new_element(hash_value);
-                                //The n-gram id is equal to its hash value
+                                //Set the n-gram id, it is equal to its hash value
                                 data.m_id = hash_value;
                                 //Set the probability data
                                 data.m_payload = gram.m_payload.m_prob;
+                                //Set the n-gram fingerprint, if verified
+                                set_fingerprint<CURR_LEVEL>(m_n_gram_data, data, gram);
                             } else {
                                 //Check if this is an <unk> unigram, in this case we store the payload elsewhere
                                 if ((CURR_LEVEL == M_GRAM_LEVEL_1) && gram.is_unk_unigram()) {
                                     //Store the uni-gram payload - overwrite the default values.
                                     m_unk_data = gram.m_payload;
                                 } else {
+                                    //Count the m-gram hash collision, if any
+                                    count_collision<CURR_LEVEL>(m_m_gram_data[LEVEL_IDX], hash_value);
                                     //Create a new M-Gram data entry
                                     T_M_Gram_PB_Entry & data = m_m_gram_data[LEVEL_IDX]->add_new_element(hash_value);
-                                    //The m-gram id is equal to its hash value
+                                    //Set the m-gram id, it is equal to its hash value
                                     data.m_id = hash_value;
                                     //Set the probability and back-off data
                                     data.m_payload = gram.m_payload;
+                                    //Set the m-gram fingerprint, if verified
+                                    set_fingerprint<CURR_LEVEL>(m_m_gram_data[LEVEL_IDX], data, gram);
                                 }
                             }
                         }
@@ -205,7 +307,7 @@ namespace uva {
                             query.set_curr_payload(m_unk_data);
 
                             //Call the templated part via function pointer
-                            (void) get_payload<TProbBackMap>(m_m_gram_data[0], query);
+                            (void) get_payload<TProbBackMap>(m_m_gram_data[0], m_fps[0], query);
                         }
 
                         /**
@@ -223,7 +325,7 @@ namespace uva {
                             LOG_DEBUG << "Searching in " << SSTR(curr_level) << "-grams, array index: " << layer_idx << END_LOG;
 
                             //Call the templated part via function pointer
-                            status = get_payload<TProbBackMap>(m_m_gram_data[layer_idx], query);
+                            status = get_payload<TProbBackMap>(m_m_gram_data[layer_idx], m_fps[layer_idx], query);
                         }
 
                         /**
@@ -236,7 +338,7 @@ namespace uva {
                             LOG_DEBUG << "Searching in " << SSTR(LM_M_GRAM_LEVEL_MAX) << "-grams" << END_LOG;
 
                             //Call the templated part via function pointer
-                            status = get_payload<TProbMap>(m_n_gram_data, query);
+                            status = get_payload<TProbMap>(m_n_gram_data, m_fps[LM_M_GRAM_LEVEL_MAX - 1], query);
                         }
 
                         /**
@@ -268,23 +370,76 @@ namespace uva {
                         //Stores the number of m-gram ids/buckets per level
                         TShortId m_num_buckets[LM_M_GRAM_LEVEL_MAX];
 
+                        //Stores the flag indicating whether the m-gram keys are verified
+                        bool m_is_verify;
+                        //Stores the flag indicating whether the fingerprints are mapped from a binary image
+                        bool m_is_fps_mapped;
+                        //Stores the m-gram fingerprints per level, parallel to the level
+                        //map elements, the pointers are NULL if the keys are not verified
+                        uint32_t * m_fps[LM_M_GRAM_LEVEL_MAX];
+
+                        //Stores the number of m-gram hash collisions per level, only counted if verified
+                        size_t m_num_collisions[LM_M_GRAM_LEVEL_MAX];
+
+                        /**
+                         * Allows to count the m-gram hash collision for the m-gram to be added.
+                         * The collisions are only counted if the m-gram keys are verified.
+                         * @param STORAGE_MAP the level map type
+                         * @param map the level map the m-gram is to be added to
+                         * @param hash_value the hash value of the m-gram to be added
+                         */
+                        template<phrase_length CURR_LEVEL, typename STORAGE_MAP>
+                        inline void count_collision(const STORAGE_MAP * map, const uint64_t hash_value) {
+                            if (m_is_verify && (map->get_element(hash_value, hash_value) != NULL)) {
+                                LOG_DEBUG << "A " << SSTR(CURR_LEVEL) << "-gram hash collision, hash value: " << hash_value << END_LOG;
+                                ++m_num_collisions[CURR_LEVEL - 1];
+                            }
+                        }
+
+                        /**
+                         * Allows to store the fingerprint of the added m-gram, if the m-gram keys are verified
+                         * @param STORAGE_MAP the level map type
+                         * @param map the level map the m-gram is added to
+                         * @param data the added m-gram map element
+                         * @param gram the added m-gram
+                         */
+                        template<phrase_length CURR_LEVEL, typename STORAGE_MAP>
+                        inline void set_fingerprint(const STORAGE_MAP * map,
+                                const typename STORAGE_MAP::TElemType & data, const model_m_gram & gram) {
+                            if (m_is_verify) {
+                                m_fps[CURR_LEVEL - 1][map->get_element_idx(data)] =
+                                        gram.get_fingerprint(gram.get_first_word_idx(), gram.get_last_word_idx());
+                            }
+                        }
+
                         /**
                          * Gets the probability for the given level M-gram, searches on specific level
                          * @param STORAGE_MAP the level map type
+                         * @param map the level map
+                         * @param fps the level fingerprints or NULL if the m-gram keys are not verified
                          * @param query the query M-gram state 
                          * @return the resulting status of the operation
                          */
                         template<typename STORAGE_MAP>
                         static inline MGramStatusEnum get_payload(const STORAGE_MAP * map,
-                                m_gram_query & query) {
+                                const uint32_t * fps, m_gram_query & query) {
                             LOG_DEBUG << "Getting the bucket id for the sub-m-gram " << query << END_LOG;
 
                             const uint64_t hash_value = query.get_curr_m_gram_hash();
 
                             LOG_DEBUG << "Retrieving payload for a sub-m-gram " << query << END_LOG;
 
-                            //Get the element from the map, note that the key is the hash value
-                            const typename STORAGE_MAP::TElemType * elem = map->get_element(hash_value, hash_value);
+                            //Get the element from the map, note that the key is the hash value and the fingerprint, if verified
+                            typedef typename STORAGE_MAP::TElemType TElemType;
+                            const TElemType * elem = NULL;
+                            if (fps == NULL) {
+                                elem = map->get_element(hash_value, hash_value);
+                            } else {
+                                const __H2DMapTrie::S_M_GramVerifyKey<TElemType> key = {
+                                    hash_value, query.get_curr_m_gram_fp(), map->get_elements(), fps
+                                };
+                                elem = map->get_element(hash_value, key);
+                            }
                             if (elem != NULL) {
                                 //We are now done, the payload is found, can return!
                                 query.set_curr_payload(elem->m_payload);
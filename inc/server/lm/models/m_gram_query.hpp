@@ -185,6 +185,15 @@ namespace uva {
                             return m_gram.get_hash(m_curr_begin_word_idx, m_curr_end_word_idx);
                         }
 
+                        /**
+                         * Allows to compute the fingerprint of the m-gram defined
+                         * by the current begin and end word indexes
+                         * @return the fingerprint of the current m-gram
+                         */
+                        inline uint32_t get_curr_m_gram_fp() const {
+                            return m_gram.get_fingerprint(m_curr_begin_word_idx, m_curr_end_word_idx);
+                        }
+
                         /**
                          * Allows to get the current begin word id
                          * @return the current begin word id
@@ -105,6 +105,19 @@ namespace uva {
                             THROW_MUST_OVERRIDE();
                         }
 
+                        /**
+                         * Allows to request the m-gram keys verification, is to be called before the
+                         * model is built or mapped. Only the hash map model supports it, the others
+                         * just ignore the request.
+                         * @param is_verify true if the m-gram keys are to be verified
+                         */
+                        inline void set_verify_keys(const bool is_verify) {
+                            if (is_verify) {
+                                LOG_WARNING << "The m-gram keys verification is not supported "
+                                        << "by the configured model, ignoring!" << END_LOG;
+                            }
+                        }
+
                         /**
                          * Allows to retrieve the stored word index, if any
                          * @return the pointer to the stored word index or NULL if none
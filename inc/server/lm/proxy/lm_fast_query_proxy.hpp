@@ -139,13 +139,17 @@ namespace uva {
                              * to compute the probability for
                              * @param min_level the first m-gram level to consider, the next
                              * minimum m-gram level to consider, is limited by LM_M_GRAM_LEVEL_MAX
+                             * @param state_len [out] the length of the LM right state, i.e. the number of the
+                             * last query words that can influence the probabilities of the words to follow.
+                             * It is the length of the longest m-gram known to the model that ends in the
+                             * last query word, limited by LM_M_GRAM_LEVEL_MAX - 1.
                              * @param scores the pointer to the array of feature scores that is to 
                              *               be filled in, unless the provided pointer is NULL.
                              * @return the resulting probability weight
                              */
                             virtual prob_weight execute(const phrase_length num_words,
                                     const word_uid * word_ids, phrase_length & min_level, 
-                                    prob_weight * scores) = 0;
+                                    phrase_length & state_len, prob_weight * scores) = 0;
                         };
                     }
                 }
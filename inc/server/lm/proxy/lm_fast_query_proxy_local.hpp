@@ -30,6 +30,7 @@
 
 #include "server/lm/lm_parameters.hpp"
 #include "server/lm/proxy/lm_fast_query_proxy.hpp"
+#include "server/lm/proxy/lm_query_cache.hpp"
 #include "server/lm/models/m_gram_query.hpp"
 
 using namespace std;
@@ -138,7 +139,7 @@ namespace uva {
                                 phrase_length min_level = M_GRAM_LEVEL_1;
 
                                 //Compute the probability value
-                                prob_weight prob = execute_query<false>(num_words, word_ids, min_level);
+                                prob_weight prob = execute_query<false, false>(num_words, word_ids, min_level);
 
                                 LOG_DEBUG1 << "The resulting LM query probability is: " << prob << END_LOG;
 
@@ -151,7 +152,7 @@ namespace uva {
                              */
                             virtual prob_weight execute(const phrase_length num_words,
                                     const word_uid * word_ids, phrase_length & min_level) {
-                                return execute_query<false>(num_words, word_ids, min_level);
+                                return execute_query<false, false>(num_words, word_ids, min_level);
                             }
 
                             /**
@@ -159,16 +160,42 @@ namespace uva {
                              */
                             virtual prob_weight execute(const phrase_length num_words,
                                     const word_uid * word_ids, phrase_length & min_level,
-                                    prob_weight * scores) {
-                                return execute_query(num_words, word_ids, min_level, scores);
+                                    phrase_length & state_len, prob_weight * scores) {
+                                //Get the cache of the current thread
+                                lm_query_cache & cache = lm_query_cache::get_thread_cache();
+
+                                //If there is no cache then just execute the query
+                                if (!cache.is_enabled()) {
+                                    return execute_query(num_words, word_ids, min_level, &state_len, scores);
+                                }
+
+                                //Check if the query has been executed before
+                                lm_query_cache::cache_entry * entry = NULL;
+                                if (cache.find(num_words, word_ids, min_level, entry)) {
+                                    LOG_DEBUG << "The LM query is found in the cache, log_e(Prob) = " << entry->m_prob << END_LOG;
+
+                                    //Take the results from the cache
+                                    m_joint_prob = entry->m_prob;
+                                    min_level = entry->m_next_min_level;
+                                    state_len = entry->m_state_len;
+                                    set_feature_scores(scores);
+                                } else {
+                                    //Execute the query and cache its results
+                                    entry->set_query(num_words, word_ids, min_level);
+                                    entry->m_prob = execute_query(num_words, word_ids, min_level, &state_len, scores);
+                                    entry->m_next_min_level = min_level;
+                                    entry->m_state_len = state_len;
+                                }
+
+                                return m_joint_prob;
                             }
 
                         protected:
 
-                            template<bool is_consider_scores = true >
+                            template<bool is_consider_state = true, bool is_consider_scores = true >
                             inline prob_weight execute_query(const phrase_length num_words,
                                     const word_uid * word_ids, phrase_length & min_level,
-                                    prob_weight * scores = NULL) {
+                                    phrase_length * state_len = NULL, prob_weight * scores = NULL) {
                                 //Re-initialize the joint prob result with zero
                                 m_joint_prob = 0.0;
 
@@ -192,7 +219,7 @@ namespace uva {
                                 m_query.set_word_indxes(begin_word_idx, sub_end_word_idx, end_word_idx);
 
                                 //Execute the first part of the query
-                                m_trie.execute(m_query);
+                                phrase_length matched_len = m_trie.execute(m_query);
 
                                 //Report the partial results, and update the total
                                 get_report_interm_results(begin_word_idx, sub_end_word_idx, end_word_idx);
@@ -211,7 +238,7 @@ namespace uva {
                                     m_query.set_word_indxes(begin_word_idx, end_word_idx);
 
                                     //Execute the query
-                                    m_trie.execute(m_query);
+                                    matched_len = m_trie.execute(m_query);
 
                                     //Report the partial result, and update the total
                                     get_report_interm_results(begin_word_idx, end_word_idx, end_word_idx);
@@ -225,22 +252,38 @@ namespace uva {
 
                                 LOG_DEBUG << "Computed log_e(Prob(" << m_query << ")) = " << m_joint_prob << ", next min_level:  " << min_level << END_LOG;
 
-#if IS_SERVER_TUNING_MODE
-                                //Report the feature scores, here we do it outside the model - for
-                                //simplicity, also only in case that the scores map is present
+                                //Report the right state length, the words before the longest matched
+                                //m-gram have no influence on the probabilities of the next words
+                                if (is_consider_state) {
+                                    ASSERT_SANITY_THROW((state_len == NULL), string("The state length pointer is NULL!"));
+                                    *state_len = std::min<phrase_length>(matched_len, LM_M_GRAM_LEVEL_MAX - 1);
+                                    LOG_DEBUG << "The LM right state length: " << *state_len << END_LOG;
+                                }
+
+                                //Report the feature scores, only in case that the scores map is present
                                 if (is_consider_scores) {
-                                    ASSERT_SANITY_THROW((scores == NULL), string("The scores pointer is NULL!"));
-                                    //Store the score and divide it by the lambda weight to restore the original!
-                                    const prob_weight pure_cost = m_joint_prob / m_params.get_0_lm_weight();
-                                    scores[lm_parameters::LM_WEIGHT_GLOBAL_IDS[0]] = pure_cost;
-                                    LOG_DEBUG2 << lm_parameters::LM_WEIGHT_NAMES[0] << " = " << pure_cost << END_LOG;
+                                    set_feature_scores(scores);
                                 }
-#endif
 
                                 //Return the final result;
                                 return m_joint_prob;
                             }
 
+                            /**
+                             * Allows to report the feature scores of the last query, the joint
+                             * probability must be set. Does nothing outside of the tuning mode.
+                             * @param scores the pointer to the array of feature scores to be filled in
+                             */
+                            inline void set_feature_scores(prob_weight * scores) {
+#if IS_SERVER_TUNING_MODE
+                                //Report the feature scores, here we do it outside the model - for simplicity
+                                ASSERT_SANITY_THROW((scores == NULL), string("The scores pointer is NULL!"));
+                                //Store the score, the model probabilities are stored without the lambda weight
+                                scores[lm_parameters::LM_WEIGHT_GLOBAL_IDS[0]] = m_joint_prob;
+                                LOG_DEBUG2 << lm_parameters::LM_WEIGHT_NAMES[0] << " = " << m_joint_prob << END_LOG;
+#endif
+                            }
+
                             /**
                              * For the given N-gram, for some level M <=N , this method
                              * allows to give the string of the object for which the
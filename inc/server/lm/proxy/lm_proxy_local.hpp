@@ -26,9 +26,12 @@
 #ifndef TRIE_PROXY_IMPL_HPP
 #define TRIE_PROXY_IMPL_HPP
 
+#include <typeinfo>       // std::typeid
+
 #include "common/utils/logging/logger.hpp"
 #include "common/utils/exceptions.hpp"
 #include "common/utils/monitor/statistics_monitor.hpp"
+#include "common/utils/file/binary_image.hpp"
 
 #include "server/server_configs.hpp"
 
@@ -88,9 +91,17 @@ namespace uva {
                                 //Store the parameters
                                 m_params = &params;
 
+                                //Set up the m-gram keys verification before the model is loaded
+                                m_model.set_verify_keys(params.m_is_verify_keys);
+
                                 //The whole purpose of this method connect here is
                                 //just to load the language model into the memory.
-                                load_model_data<lm_builder_type, lm_model_reader>("Language Model", params);
+                                //A pre-compiled binary image is mapped, an ARPA file is parsed.
+                                if (is_binary_image(params.m_conn_string, __lm_image::MAGIC)) {
+                                    load_model_image("Language Model", params);
+                                } else {
+                                    load_model_data<lm_builder_type, lm_model_reader>("Language Model", params);
+                                }
 
                                 //Retrieve the unknown word probability
                                 get_unk_word_prob();
@@ -108,8 +119,34 @@ namespace uva {
                              * @see lm_proxy
                              */
                             virtual void disconnect() {
-                                //Nothing to be done at the moment, the word index
-                                //and trie are stack allocated class data members 
+                                //The word index and trie are stack allocated class data
+                                //members, only the binary image is to be un-mapped, if any
+                                m_image.close();
+                            }
+
+                            /**
+                             * @see lm_proxy
+                             */
+                            virtual void write_model_image(const string & file_name) {
+                                ASSERT_CONDITION_THROW(!lm_model_type::is_image_supported(),
+                                        "The configured language model type does not support binary images!");
+
+                                LOG_USAGE << "Writing the Language Model binary image into: " << file_name << END_LOG;
+                                const double start_time = stat_monitor::get_cpu_time();
+
+                                //Write the image header followed by the model data
+                                binary_image_writer image(file_name);
+                                image.write_array(__lm_image::MAGIC, BINARY_IMAGE_MAGIC_LEN);
+                                image.write<uint32_t>(__lm_image::VERSION);
+                                image.write_string(typeid (lm_model_type).name());
+                                image.write<uint16_t>(LM_M_GRAM_LEVEL_MAX);
+                                image.write<float>(m_params->m_unk_word_log_e_prob);
+                                m_model.write_image(image);
+                                image.close();
+
+                                const double end_time = stat_monitor::get_cpu_time();
+                                LOG_USAGE << "Writing the binary image of " << image.get_size() << " bytes took "
+                                        << (end_time - start_time) << " CPU seconds." << END_LOG;
                             }
 
                             /**
@@ -136,7 +173,7 @@ namespace uva {
                              * @see lm_proxy
                              */
                             virtual lm_slow_query_proxy & allocate_slow_query_proxy() {
-                                return *(new lm_slow_query_proxy_local<lm_model_type>(m_model));
+                                return *(new lm_slow_query_proxy_local<lm_model_type>(m_model, m_params->m_lambdas[0]));
                             }
 
                             /**
@@ -150,6 +187,74 @@ namespace uva {
 
                         private:
 
+                            /**
+                             * Allows to read and check the binary image header against the compiled
+                             * model type and the configured parameters. The LM weight is not stored in the
+                             * image, it is applied when scoring, but the unknown word probability is.
+                             * @param params the model parameters
+                             */
+                            void read_image_header(const lm_parameters & params) {
+                                //The magic marker is already checked, skip it
+                                (void) m_image.read_array<char>(BINARY_IMAGE_MAGIC_LEN);
+
+                                const uint32_t version = m_image.read<uint32_t>();
+                                ASSERT_CONDITION_THROW((version != __lm_image::VERSION),
+                                        string("The binary image version: ") + to_string(version) +
+                                        string(" is not supported, expected: ") + to_string(__lm_image::VERSION));
+
+                                const string model_type = m_image.read_string();
+                                ASSERT_CONDITION_THROW((model_type != typeid (lm_model_type).name()),
+                                        string("The binary image model type: '") + model_type +
+                                        string("' does not match the configured: '") +
+                                        typeid (lm_model_type).name() + string("'"));
+
+                                const uint16_t max_level = m_image.read<uint16_t>();
+                                ASSERT_CONDITION_THROW((max_level != LM_M_GRAM_LEVEL_MAX),
+                                        string("The binary image maximum m-gram level: ") + to_string(max_level) +
+                                        string(" does not match the configured: ") + to_string(LM_M_GRAM_LEVEL_MAX));
+
+                                const float unk_word_log_e_prob = m_image.read<float>();
+                                ASSERT_CONDITION_THROW((unk_word_log_e_prob != params.m_unk_word_log_e_prob),
+                                        string("The binary image is built with ") + lm_parameters::LM_UNK_WORD_LOG_E_PROB_PARAM_NAME +
+                                        string(" = ") + to_string(unk_word_log_e_prob) + string(", re-create the image!"));
+                            }
+
+                            /**
+                             * Allows to map the model from a pre-compiled binary image file
+                             * @param the name of the model being loaded
+                             * @params params the model parameters
+                             */
+                            void load_model_image(char const *model_name, const lm_parameters & params) {
+                                const string & model_file_name = params.m_conn_string;
+
+                                //Declare the statistics monitor and its data
+                                TMemotyUsage mem_stat_start = {}, mem_stat_end = {};
+
+                                LOG_USAGE << "--------------------------------------------------------" << END_LOG;
+                                LOG_USAGE << "Start mapping the " << model_name << " binary image ..." << END_LOG;
+                                LOG_USAGE << model_name << " is located in: " << model_file_name << END_LOG;
+
+                                ASSERT_CONDITION_THROW(!lm_model_type::is_image_supported(),
+                                        "The configured language model type does not support binary images!");
+
+                                //Log the usage information
+                                m_model.log_model_type_info();
+
+                                stat_monitor::get_mem_stat(mem_stat_start);
+                                const double start_time = stat_monitor::get_cpu_time();
+
+                                //Map the image file, check its header and map the model
+                                m_image.open(model_file_name);
+                                read_image_header(params);
+                                m_model.read_image(m_image);
+
+                                const double end_time = stat_monitor::get_cpu_time();
+                                LOG_USAGE << "Mapping the " << model_name << " took " << (end_time - start_time) << " CPU seconds." << END_LOG;
+                                stat_monitor::get_mem_stat(mem_stat_end);
+                                const string action_name = string("Mapping the ") + string(model_name);
+                                report_memory_usage(action_name.c_str(), mem_stat_start, mem_stat_end, true);
+                            }
+
                             /**
                              * Allows to retrieve the unknown word LM probability from the model for the sake of caching
                              */
@@ -236,6 +341,9 @@ namespace uva {
                             }
 
                         protected:
+                            //Stores the binary image the model is mapped from, if any
+                            binary_image_reader m_image;
+
                             //Stores the word index
                             lm_word_index m_word_index;
 
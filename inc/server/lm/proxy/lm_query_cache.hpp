@@ -0,0 +1,246 @@
+/*
+ * File:   lm_query_cache.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 16, 2026, 11:48 PM
+ */
+
+#ifndef LM_QUERY_CACHE_HPP
+#define LM_QUERY_CACHE_HPP
+
+#include <set>
+#include <atomic>
+#include <cstring>
+
+#include "common/utils/logging/logger.hpp"
+#include "common/utils/exceptions.hpp"
+#include "common/utils/hashing_utils.hpp"
+#include "common/utils/threads/threads.hpp"
+
+#include "server/server_configs.hpp"
+
+using namespace std;
+
+using namespace uva::utils::logging;
+using namespace uva::utils::exceptions;
+using namespace uva::utils::hashing;
+using namespace uva::utils::threads;
+
+namespace uva {
+    namespace smt {
+        namespace bpbd {
+            namespace server {
+                namespace lm {
+                    namespace proxy {
+
+                        /**
+                         * This class represents a bounded LM query results cache. Every thread
+                         * gets its own cache instance, so no synchronization is needed for the
+                         * look ups. The cache is direct mapped, i.e. a look up is a single hash
+                         * probe, a new entry just overwrites the one stored in its bucket.
+                         * The entries are keyed by the query word ids and the query min level.
+                         * The word ids are stored and compared, so there are no false hits.
+                         * The cache is valid for as long as the language model is loaded.
+                         */
+                        class lm_query_cache {
+                        public:
+
+                            /**
+                             * This structure represents a cache entry, i.e. a query and its results
+                             */
+                            struct cache_entry {
+                                //Stores the query word ids
+                                word_uid m_word_ids[LM_MAX_QUERY_LEN];
+                                //Stores the number of query word ids, zero for an empty entry
+                                phrase_length m_num_words;
+                                //Stores the query begin m-gram level
+                                phrase_length m_min_level;
+                                //Stores the next m-gram level, as computed by the query
+                                phrase_length m_next_min_level;
+                                //Stores the LM right state length, as computed by the query
+                                phrase_length m_state_len;
+                                //Stores the query probability result
+                                prob_weight m_prob;
+
+                                /**
+                                 * Allows to check if the entry stores the results of the given query
+                                 * @param num_words the number of query words
+                                 * @param word_ids the query word ids
+                                 * @param min_level the query begin m-gram level
+                                 * @return true if the entry is for the given query, otherwise false
+                                 */
+                                inline bool is_for(const phrase_length num_words, const word_uid * word_ids,
+                                        const phrase_length min_level) const {
+                                    return (m_num_words == num_words) && (m_min_level == min_level) &&
+                                            (memcmp(m_word_ids, word_ids, num_words * sizeof (word_uid)) == 0);
+                                }
+
+                                /**
+                                 * Allows to store the given query into the entry, the results are to be set separately
+                                 * @param num_words the number of query words
+                                 * @param word_ids the query word ids
+                                 * @param min_level the query begin m-gram level
+                                 */
+                                inline void set_query(const phrase_length num_words, const word_uid * word_ids,
+                                        const phrase_length min_level) {
+                                    memcpy(m_word_ids, word_ids, num_words * sizeof (word_uid));
+                                    m_num_words = num_words;
+                                    m_min_level = min_level;
+                                }
+                            };
+
+                            /**
+                             * Allows to set the number of entries of the thread caches, is to be called
+                             * before the queries are executed. A zero value disables caching.
+                             * @param capacity the number of entries, is rounded up to a power of two
+                             */
+                            static inline void set_capacity(const uint32_t capacity) {
+                                m_capacity = 0;
+                                if (capacity > 0) {
+                                    m_capacity = 1;
+                                    while (m_capacity < capacity) {
+                                        m_capacity <<= 1;
+                                    }
+                                }
+                                LOG_INFO << "The LM query cache capacity per thread: " << m_capacity << END_LOG;
+                            }
+
+                            /**
+                             * Allows to get the cache of the calling thread, the
+                             * cache is allocated with the first call of the thread.
+                             * @return the cache of the calling thread
+                             */
+                            static inline lm_query_cache & get_thread_cache() {
+                                static thread_local lm_query_cache cache(m_capacity);
+                                return cache;
+                            }
+
+                            /**
+                             * Allows to report the cache statistics of all the threads
+                             * @param prefix the report prefix
+                             */
+                            static inline void report_run_time_info(const string & prefix) {
+                                scoped_guard guard(m_caches_mutex);
+
+                                //Sum up the statistics of the finished and the live caches
+                                uint64_t num_hits = m_num_old_hits;
+                                uint64_t num_misses = m_num_old_misses;
+                                for (const lm_query_cache * cache : m_caches) {
+                                    num_hits += cache->m_num_hits.load(memory_order_relaxed);
+                                    num_misses += cache->m_num_misses.load(memory_order_relaxed);
+                                }
+
+                                const uint64_t num_queries = num_hits + num_misses;
+                                LOG_USAGE << prefix << ":" << END_LOG;
+                                LOG_USAGE << "\t#thread caches: " << m_caches.size() << ", #entries per cache: "
+                                        << m_capacity << ", #queries: " << num_queries << ", hit rate: "
+                                        << ((num_queries > 0) ? (100.0 * num_hits) / num_queries : 0.0) << "%" << END_LOG;
+                            }
+
+                            /**
+                             * The basic destructor, counts the statistics into the finished caches ones
+                             */
+                            virtual ~lm_query_cache() {
+                                if (m_entries != NULL) {
+                                    scoped_guard guard(m_caches_mutex);
+                                    m_num_old_hits += m_num_hits.load(memory_order_relaxed);
+                                    m_num_old_misses += m_num_misses.load(memory_order_relaxed);
+                                    m_caches.erase(this);
+
+                                    delete[] m_entries;
+                                    m_entries = NULL;
+                                }
+                            }
+
+                            /**
+                             * Allows to check if the cache is enabled
+                             * @return true if the cache has entries, otherwise false
+                             */
+                            inline bool is_enabled() const {
+                                return (m_entries != NULL);
+                            }
+
+                            /**
+                             * Allows to look up the query in the cache. The cache must be enabled.
+                             * @param num_words the number of query words
+                             * @param word_ids the query word ids
+                             * @param min_level the query begin m-gram level
+                             * @param entry [out] the entry for the query, if not found then it is
+                             *                    the entry to store the query and its results into
+                             * @return true if the query was found, otherwise false
+                             */
+                            inline bool find(const phrase_length num_words, const word_uid * word_ids,
+                                    const phrase_length min_level, cache_entry *& entry) {
+                                const uint_fast64_t hash = MurmurHash64A(word_ids, num_words * sizeof (word_uid), min_level);
+                                entry = &m_entries[hash & (m_capacity - 1)];
+
+                                //Only the owner thread updates the counters, so no atomic increments are needed
+                                if (entry->is_for(num_words, word_ids, min_level)) {
+                                    m_num_hits.store(m_num_hits.load(memory_order_relaxed) + 1, memory_order_relaxed);
+                                    return true;
+                                } else {
+                                    m_num_misses.store(m_num_misses.load(memory_order_relaxed) + 1, memory_order_relaxed);
+                                    return false;
+                                }
+                            }
+
+                        private:
+
+                            /**
+                             * The basic constructor, registers the cache for the statistics
+                             * @param capacity the number of entries, a power of two or zero
+                             */
+                            lm_query_cache(const uint32_t capacity)
+                            : m_entries((capacity > 0) ? new cache_entry[capacity]() : NULL),
+                            m_num_hits(0), m_num_misses(0) {
+                                if (m_entries != NULL) {
+                                    scoped_guard guard(m_caches_mutex);
+                                    m_caches.insert(this);
+                                }
+                            }
+
+                            //Stores the cache entries
+                            cache_entry * m_entries;
+                            //Stores the number of cache hits
+                            atomic<uint64_t> m_num_hits;
+                            //Stores the number of cache misses
+                            atomic<uint64_t> m_num_misses;
+
+                            //Stores the number of entries per thread cache
+                            static uint32_t m_capacity;
+                            //Stores the mutex guarding the live caches and the finished caches statistics
+                            static mutex m_caches_mutex;
+                            //Stores the live thread caches
+                            static set<const lm_query_cache *> m_caches;
+                            //Stores the number of cache hits of the finished thread caches
+                            static uint64_t m_num_old_hits;
+                            //Stores the number of cache misses of the finished thread caches
+                            static uint64_t m_num_old_misses;
+                        };
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif /* LM_QUERY_CACHE_HPP */
+
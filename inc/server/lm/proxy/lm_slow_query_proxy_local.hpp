@@ -56,9 +56,10 @@ namespace uva {
                             /**
                              * The basic constructor that accepts the trie reference to query to
                              * @param trie the trie to query
+                             * @param lm_lambda the language model weight to multiply the probabilities with
                              */
-                            lm_slow_query_proxy_local(const trie_type & trie)
-                            : m_trie(trie), m_word_idx(m_trie.get_word_index()),
+                            lm_slow_query_proxy_local(const trie_type & trie, const prob_weight lm_lambda)
+                            : m_trie(trie), m_word_idx(m_trie.get_word_index()), m_lm_lambda(lm_lambda),
                             m_query(), m_num_words(0), m_joint_prob(0.0) {
                             }
 
@@ -151,6 +152,9 @@ namespace uva {
                                     const phrase_length last_end_word_idx) {
                                 //Print the intermediate results
                                 for (phrase_length end_word_idx = first_end_word_idx; end_word_idx <= last_end_word_idx; ++end_word_idx) {
+                                    //The model stores the probabilities without the lambda weight
+                                    m_query.m_probs[end_word_idx] *= m_lm_lambda;
+
                                     if (MAXIMUM_LOGGING_LEVEL >= debug_levels_enum::RESULT) {
                                         const string gram_str = get_m_gram_str(begin_word_idx, end_word_idx);
 
@@ -272,6 +276,9 @@ namespace uva {
                             //Stores the reference to the word index
                             const word_index_type & m_word_idx;
 
+                            //Stores the language model weight
+                            const prob_weight m_lm_lambda;
+
                             //Stores the reference to the sliding query
                             m_gram_query m_query;
 
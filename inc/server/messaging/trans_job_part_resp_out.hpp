@@ -0,0 +1,71 @@
+/*
+ * File:   trans_job_part_resp_out.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 17, 2026, 4:10 PM
+ */
+
+#ifndef TRANS_JOB_PART_RESP_OUT_HPP
+#define TRANS_JOB_PART_RESP_OUT_HPP
+
+#include "server/messaging/trans_job_resp_out.hpp"
+
+using namespace uva::smt::bpbd::common::messaging;
+
+namespace uva {
+    namespace smt {
+        namespace bpbd {
+            namespace server {
+                namespace messaging {
+
+                    /**
+                     * This class represents a translation job partial response message to be
+                     * sent to the client. It is sent if the client has requested streaming and
+                     * stores the results of a range of the finished job sentences, the job id
+                     * and the index of the range's first sentence within the job. The job's
+                     * status is sent with the job response message after all the partial ones.
+                     */
+                    class trans_job_part_resp_out : public trans_job_resp_out {
+                    public:
+
+                        /**
+                         * The basic class constructor
+                         * @param is_bin true if the response is to be written in the binary form
+                         */
+                        trans_job_part_resp_out(const bool is_bin)
+                        : trans_job_resp_out(msg_type::MESSAGE_TRANS_JOB_PART_RESP, is_bin) {
+                            //Nothing to be done here
+                        }
+
+                        /**
+                         * The basic class destructor
+                         */
+                        virtual ~trans_job_part_resp_out() {
+                            //Nothing to be done here
+                        }
+                    };
+                }
+            }
+        }
+    }
+}
+
+#endif /* TRANS_JOB_PART_RESP_OUT_HPP */
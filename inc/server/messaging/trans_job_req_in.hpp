@@ -26,12 +26,19 @@
 #ifndef TRANS_JOB_REQ_IN_HPP
 #define TRANS_JOB_REQ_IN_HPP
 
+#include "common/utils/exceptions.hpp"
+
 #include "common/messaging/language_registry.hpp"
 #include "common/messaging/incoming_msg.hpp"
 #include "common/messaging/trans_job_req.hpp"
 #include "common/messaging/job_id.hpp"
 
+#include "server/common/models/feature_weights.hpp"
+
+using namespace uva::utils::exceptions;
+
 using namespace uva::smt::bpbd::common::messaging;
+using namespace uva::smt::bpbd::server::common::models;
 
 namespace uva {
     namespace smt {
@@ -75,8 +82,7 @@ namespace uva {
                          * @return the client-issued job id
                          */
                         inline void set_job_id(job_id_type job_id) {
-                            Document & json = m_inc_msg->get_json();
-                            json[JOB_ID_FIELD_NAME] = job_id;
+                            m_inc_msg->set_uint64_field(JOB_ID_FIELD_NAME, job_id);
                         }
                         
                         /**
@@ -133,6 +139,17 @@ namespace uva {
                             return json[IS_TRANS_INFO_FIELD_NAME].GetBool();
                         }
 
+                        /**
+                         * Allows to check whether the client has requested the sentence results
+                         * to be streamed as they are finished. The flag is optional, it is only
+                         * present in the requests of protocol version 2 and higher.
+                         * @return true if the results are to be streamed, otherwise false
+                         */
+                        inline bool is_stream() const {
+                            const Document & json = m_inc_msg->get_json();
+                            return json.HasMember(IS_STREAM_FIELD_NAME) && json[IS_STREAM_FIELD_NAME].GetBool();
+                        }
+
                         /**
                          * Allows to get the translation job text. This is either
                          * the text translated into the target language or the error
@@ -143,7 +160,55 @@ namespace uva {
                             const Document & json = m_inc_msg->get_json();
                             return json[SOURCE_SENTENCES_FIELD_NAME];
                         }
+
+                        /**
+                         * Allows to get the number of sentences to be translated
+                         * @return the number of source sentences, or zero if the request has none
+                         */
+                        inline size_t get_num_sentences() const {
+                            const Document & json = m_inc_msg->get_json();
+                            if (json.HasMember(SOURCE_SENTENCES_FIELD_NAME) && json[SOURCE_SENTENCES_FIELD_NAME].IsArray()) {
+                                return json[SOURCE_SENTENCES_FIELD_NAME].Size();
+                            } else {
+                                return 0;
+                            }
+                        }
                         
+                        /**
+                         * Allows to apply the feature weights given in the translation job request, if any.
+                         * Any of the language model, translation model, word penalty and reordering model
+                         * weights can be given, the number of the model weights must not change.
+                         * @param weights [in/out] the weights to be updated with the request values
+                         * @throws uva_exception if the request weights are malformed
+                         */
+                        inline void get_weights(feature_weights & weights) const {
+                            const Document & json = m_inc_msg->get_json();
+                            if (json.HasMember(WEIGHTS_FIELD_NAME)) {
+                                const Value & value = json[WEIGHTS_FIELD_NAME];
+                                ASSERT_CONDITION_THROW(!value.IsObject(), string("The '") +
+                                        WEIGHTS_FIELD_NAME + string("' field must be an object!"));
+
+                                if (value.HasMember(LM_WEIGHT_FIELD_NAME)) {
+                                    weights.m_lm_lambda = get_weight(value[LM_WEIGHT_FIELD_NAME], LM_WEIGHT_FIELD_NAME);
+                                }
+                                if (value.HasMember(TM_WEIGHTS_FIELD_NAME)) {
+                                    prob_weight lambdas[tm::MAX_NUM_TM_FEATURES];
+                                    const size_t num_lambdas = get_weights(value[TM_WEIGHTS_FIELD_NAME],
+                                            TM_WEIGHTS_FIELD_NAME, tm::MAX_NUM_TM_FEATURES, lambdas);
+                                    weights.set_tm_lambdas(num_lambdas, lambdas);
+                                }
+                                if (value.HasMember(WP_WEIGHT_FIELD_NAME)) {
+                                    weights.m_wp_lambda = get_weight(value[WP_WEIGHT_FIELD_NAME], WP_WEIGHT_FIELD_NAME);
+                                }
+                                if (value.HasMember(RM_WEIGHTS_FIELD_NAME)) {
+                                    prob_weight lambdas[rm::MAX_NUM_RM_FEATURES];
+                                    const size_t num_lambdas = get_weights(value[RM_WEIGHTS_FIELD_NAME],
+                                            RM_WEIGHTS_FIELD_NAME, rm::MAX_NUM_RM_FEATURES, lambdas);
+                                    weights.set_rm_lambdas(num_lambdas, lambdas);
+                                }
+                            }
+                        }
+
                         /**
                          * Allows to retrieve the incoming message
                          * @return the incoming message
@@ -155,6 +220,39 @@ namespace uva {
                     private:
                         //Stores the pointer to the incoming message
                         incoming_msg * m_inc_msg;
+
+                        /**
+                         * Allows to get a single weight value
+                         * @param value the json value storing the weight
+                         * @param name the weight field name, for error reporting
+                         * @return the weight value
+                         */
+                        static inline prob_weight get_weight(const Value & value, const char * name) {
+                            ASSERT_CONDITION_THROW(!value.IsNumber(), string("The '") +
+                                    name + string("' weight must be a number!"));
+                            return static_cast<prob_weight> (value.GetDouble());
+                        }
+
+                        /**
+                         * Allows to get an array of weight values
+                         * @param value the json value storing the weights array
+                         * @param name the weights field name, for error reporting
+                         * @param max_num_lambdas the maximum number of weights
+                         * @param lambdas [out] the array to store the weights into
+                         * @return the number of read weights
+                         */
+                        static inline size_t get_weights(const Value & value, const char * name,
+                                const size_t max_num_lambdas, prob_weight * lambdas) {
+                            ASSERT_CONDITION_THROW(!value.IsArray(), string("The '") +
+                                    name + string("' weights must be an array!"));
+                            ASSERT_CONDITION_THROW((value.Size() > max_num_lambdas), string("The number of '") +
+                                    name + string("' weights must be <= ") + to_string(max_num_lambdas));
+                            size_t idx = 0;
+                            for (auto iter = value.Begin(); iter != value.End(); ++iter) {
+                                lambdas[idx++] = get_weight(*iter, name);
+                            }
+                            return idx;
+                        }
                     };
                 }
             }
@@ -47,9 +47,10 @@ namespace uva {
 
                         /**
                          * The basic class constructor
+                         * @param is_bin true if the response is to be written in the binary form
                          */
-                        trans_job_resp_out()
-                        : outgoing_msg(msg_type::MESSAGE_TRANS_JOB_RESP),
+                        trans_job_resp_out(const bool is_bin)
+                        : outgoing_msg(msg_type::MESSAGE_TRANS_JOB_RESP, is_bin),
                         trans_job_resp(), m_sent_data(m_writer) {
                             //Nothing to be done here
                         }
@@ -115,6 +116,15 @@ namespace uva {
                             m_writer.Uint64(job_id);
                         }
 
+                        /**
+                         * Allows to set the index of the first sentence of the target data within the job
+                         * @param sent_idx the index of the first target data sentence within the job
+                         */
+                        inline void set_sent_idx(const uint64_t sent_idx) {
+                            m_writer.String(SENT_IDX_FIELD_NAME);
+                            m_writer.Uint64(sent_idx);
+                        }
+
                         /**
                          * Allows to add a new sentence data object into the list and
                          * return it in a wrapped around translation sentence data object.
@@ -127,6 +137,18 @@ namespace uva {
                             return m_sent_data;
                         }
 
+                    protected:
+
+                        /**
+                         * The constructor to be used by the sub-classes
+                         * @param type the message type
+                         * @param is_bin true if the response is to be written in the binary form
+                         */
+                        trans_job_resp_out(const msg_type type, const bool is_bin)
+                        : outgoing_msg(type, is_bin), trans_job_resp(), m_sent_data(m_writer) {
+                            //Nothing to be done here
+                        }
+
                     private:
                         //Stores the pointer to the sentence data
                         trans_sent_data_out m_sent_data;
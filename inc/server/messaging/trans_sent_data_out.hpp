@@ -55,7 +55,7 @@ namespace uva {
                          * JSON object, but it does not own it.
                          * @param writer the reference to the encapsulated JSON object
                          */
-                        trans_sent_data_out(JSONWriter & writer)
+                        trans_sent_data_out(msg_writer & writer)
                         : trans_sent_data(), m_writer(writer) {
                         }
 
@@ -123,9 +123,23 @@ namespace uva {
                             m_writer.Uint(load);
                         }
 
+                        /**
+                         * Allows to set the multi-stack state memory usage
+                         * @param num_states the number of allocated stack states
+                         * @param num_bytes the number of bytes allocated for the stack states
+                         */
+                        inline void set_stack_mem(const uint64_t num_states, const uint64_t num_bytes) {
+                            LOG_DEBUG1 << "Setting the stack memory: " << num_states << " state(s), "
+                                    << num_bytes << " bytes" << END_LOG;
+                            m_writer.String(STACK_STATES_FIELD_NAME);
+                            m_writer.Uint64(num_states);
+                            m_writer.String(STACK_MEM_FIELD_NAME);
+                            m_writer.Uint64(num_bytes);
+                        }
+
                     private:
                         //Stores a non NULL pointer to the encapsulated JSON object
-                        JSONWriter & m_writer;
+                        msg_writer & m_writer;
                     };
 
                 }
@@ -140,8 +140,8 @@ namespace uva {
 
                                     LOG_DEBUG2 << token << " -> " << to_string(weight) << END_LOG;
 
-                                    //Now convert to the log probability and multiply with the appropriate weight
-                                    entry.set_weight(idx, std::log(weight), m_params.m_lambdas[idx]);
+                                    //Now convert to the log probability, the lambda is applied when scoring
+                                    entry.set_weight(idx, std::log(weight));
 
                                     //Increment the index 
                                     ++idx;
@@ -168,8 +168,8 @@ namespace uva {
                                 //Declare the text piece reader for storing the read line and source phrase
                                 text_piece_reader line, source, target;
 
-                                //Store the cached source string and its uid values
-                                string source_str = "";
+                                //Store the cached raw source string and its uid values
+                                string source_raw = "";
                                 phrase_uid source_uid = UNDEFINED_PHRASE_ID;
                                 phrase_uid target_uid = UNDEFINED_PHRASE_ID;
                                 tm_const_source_entry * source_entry = NULL;
@@ -181,14 +181,15 @@ namespace uva {
                                     //Read the source phrase
                                     line.get_first<RM_DELIMITER, RM_DELIMITER_CDTY>(source);
 
-                                    //Get the current source phrase
-                                    string next_source_str = source.str();
-                                    trim(next_source_str);
-
-                                    //Check if this is a new source phrase
-                                    if (source_str != next_source_str) {
-                                        //Store the new source string
-                                        source_str = next_source_str;
+                                    //Check if this is a new source phrase, compare the raw bytes to
+                                    //avoid copying the source of every line. The source phrases
+                                    //filtered out of the TM are not known, so their lines are skipped.
+                                    if (source != source_raw) {
+                                        //Store the new raw source string
+                                        source_raw = source.str();
+                                        //Get the new source phrase string
+                                        string source_str = source_raw;
+                                        trim(source_str);
                                         //Compute the new source string uid
                                         source_uid = get_phrase_uid(source_str);
 
@@ -212,7 +213,7 @@ namespace uva {
                                         string target_str = target.str();
                                         trim(target_str);
 
-                                        LOG_DEBUG1 << "Got the RM source/target entry: " << source_str << " / " << target_str << END_LOG;
+                                        LOG_DEBUG1 << "Got the RM source/target entry: " << source_raw << " / " << target_str << END_LOG;
 
                                         //Parse the rest of the target entry
                                         target_uid = get_phrase_uid<true>(target_str);
@@ -31,17 +31,21 @@
 
 #include "server/rm/rm_consts.hpp"
 #include "server/rm/models/rm_entry.hpp"
-#include "server/rm/models/rm_query.hpp"
+
+#include "server/tm/models/tm_target_entry.hpp"
 
 #include "common/utils/containers/fixed_size_hashmap.hpp"
+#include "common/utils/file/binary_image.hpp"
 
 using namespace std;
 
 using namespace uva::utils::exceptions;
 using namespace uva::utils::logging;
 using namespace uva::utils::containers;
+using namespace uva::utils::file;
 
 using namespace uva::smt::bpbd::server::common::models;
+using namespace uva::smt::bpbd::server::tm::models;
 
 namespace uva {
     namespace smt {
@@ -117,6 +121,11 @@ namespace uva {
                             inline void set_num_entries(size_t num_entries) {
                                 LOG_DEBUG << "The number of source/translation pairs is: " << num_entries << END_LOG;
 
+                                //The entries are indexed with 32 bits, by the map and the target entries, and the 0 index is reserved
+                                ASSERT_CONDITION_THROW((num_entries >= UINT32_MAX),
+                                        string("The number of reordering entries: ") + to_string(num_entries) +
+                                        string(" exceeds the maximum of: ") + to_string(UINT32_MAX - 1));
+
                                 //Initialize the source entries map
                                 m_rm_data = new rm_entry_map(__rm_basic_model::SOURCES_BUCKETS_FACTOR, num_entries);
                             }
@@ -241,6 +250,24 @@ namespace uva {
                                 }
                             }
 
+                            /**
+                             * Allows to attach the reordering entries to the translation model target
+                             * entries. Each target entry gets the index of its source/target pair
+                             * entry, or the UNK/UNK entry, so no look ups are needed when decoding.
+                             * @param targets the pool of target entries
+                             * @param st_uids the source/target phrase pair uids of the target entries
+                             * @param num_targets the number of target entries in the pool
+                             */
+                            inline void link_targets(tm_target_entry * targets, const phrase_uid * st_uids, const size_t num_targets) const {
+                                for (size_t idx = 0; idx < num_targets; ++idx) {
+                                    const rm_entry * entry = get_entry(st_uids[idx]);
+                                    targets[idx].set_rm_entry_idx(m_rm_data->get_element_idx(*entry));
+                                }
+
+                                //Let the target entries know about the reordering entries
+                                set_entries_pool();
+                            }
+
                             /**
                              * Allows to log the model type info
                              */
@@ -248,6 +275,32 @@ namespace uva {
                                 LOG_USAGE << "Using the hash-based reordering model: " << __FILENAME__ << END_LOG;
                             }
 
+                            /**
+                             * Allows to write the model into a binary image, the model
+                             * can be then re-created from the image without copying.
+                             * @param image the binary image writer
+                             */
+                            void write_image(binary_image_writer & image) const {
+                                m_rm_data->write_image(image);
+                            }
+
+                            /**
+                             * Allows to map the model data from a binary image previously
+                             * written by write_image. The data is used in place, the model
+                             * is read-only and the image must outlive it.
+                             * @param image the binary image reader positioned at the model data
+                             */
+                            void read_image(binary_image_reader & image) {
+                                m_rm_data = new rm_entry_map(image);
+
+                                //Find the UNK and the <s>,</s> entries, as it is done after building
+                                find_unk_entry();
+                                find_begin_end_entries();
+
+                                //Let the target entries know about the reordering entries
+                                set_entries_pool();
+                            }
+
                         private:
                             //Stores the translation model data
                             rm_entry_map * m_rm_data;
@@ -257,6 +310,13 @@ namespace uva {
                             const rm_entry * m_begin_entry;
                             //Stores the pointer to the </s>/</s> entry if found
                             const rm_entry * m_end_entry;
+
+                            /**
+                             * Allows to set the reordering entries pool into the target entries
+                             */
+                            inline void set_entries_pool() const {
+                                tm_target_entry::set_rm_entries_pool(m_rm_data->get_elements());
+                            }
                         };
                     }
                 }
@@ -28,6 +28,7 @@
 
 #include <string>
 #include <map>
+#include <cstring>
 
 #include "common/utils/exceptions.hpp"
 #include "common/utils/logging/logger.hpp"
@@ -73,30 +74,15 @@ namespace uva {
                             /**
                              * The basic constructor
                              */
-                            rm_entry() : m_uid(UNDEFINED_PHRASE_ID) {
+                            rm_entry() : m_uid(UNDEFINED_PHRASE_ID), m_weights() {
                                 //Check that the number of features is set
                                 ASSERT_SANITY_THROW((NUMBER_OF_RM_FEATURES == 0),
                                         "The NUMBER_OF_RM_FEATURES has not been set!");
-
-                                m_weights = new prob_weight[NUMBER_OF_RM_FEATURES]();
-#if IS_SERVER_TUNING_MODE
-                                m_pure_features = new prob_weight[NUMBER_OF_RM_FEATURES]();
-#endif
-                            }
-
-                            /**
-                             * The basic destructor
-                             */
-                            ~rm_entry() {
-                                if (m_weights != NULL) delete[] m_weights;
-#if IS_SERVER_TUNING_MODE
-                                if (m_pure_features != NULL) delete[] m_pure_features;
-#endif
                             }
 
                             /**
                              * Allows to get the entry weights array
-                             * @return the entry weights array
+                             * @return the entry weights array, without the lambdas
                              */
                             inline const prob_weight * get_weights() const {
                                 return m_weights;
@@ -109,12 +95,14 @@ namespace uva {
                              * if true then we get the value from the from source phrase case
                              * if false then we get the value for the to source phrase case
                              * @param orient the reordering orientation
+                             * @param lambdas the reordering model lambdas to multiply the weight with
                              * @param scores the pointer to the array of feature scores that is to 
                              *               be filled in, unless the provided pointer is NULL.
-                             * @return the weight for the given distortion value
+                             * @return the weight for the given distortion value, multiplied with its lambda
                              */
                             template<bool is_from, bool is_consider_scores = true >
-                            inline const prob_weight get_weight(const reordering_orientation orient, prob_weight * scores = NULL) const {
+                            inline const prob_weight get_weight(const reordering_orientation orient,
+                                    const prob_weight * lambdas, prob_weight * scores = NULL) const {
                                 //Get the position of the feature value in the features array
                                 const int8_t position = (is_from ? FROM_POSITIONS[orient] : TO_POSITIONS[orient]);
                                 LOG_DEBUG2 << (is_from ? "FROM " : "TO ") << "ORIENTATION " << to_string(orient) << " position: "
@@ -124,27 +112,24 @@ namespace uva {
                                 if (is_consider_scores) {
                                     ASSERT_SANITY_THROW((scores == NULL), string("The scores pointer is NULL!"));
                                     //Store the pure feature weight if in the tuning mode 
-                                    scores[rm_parameters::RM_WEIGHT_GLOBAL_IDS[position]] = m_pure_features[position];
-                                    LOG_DEBUG2 << m_pure_features << "@" << rm_parameters::RM_WEIGHT_NAMES[position] << " = " << m_pure_features[position] << END_LOG;
+                                    scores[rm_parameters::RM_WEIGHT_GLOBAL_IDS[position]] = m_weights[position];
+                                    LOG_DEBUG2 << m_weights << "@" << rm_parameters::RM_WEIGHT_NAMES[position] << " = " << m_weights[position] << END_LOG;
                                 }
 #endif
 
                                 //Return the weight value
-                                return m_weights[position];
+                                return m_weights[position] * lambdas[position];
                             }
 
                             /**
                              * Allows to set the probability weight inside the entry.
                              * This should be the log_10 scale probability weight
                              * @param idx the feature index
-                             * @param weight the log_10 weight of the feature, without lambda
-                             * @param lambda the lambda to multiply the weight with
+                             * @param weight the log_10 weight of the feature, without lambda,
+                             *               the lambda is applied when the weight is queried
                              */
-                            inline void set_weight(const size_t idx, const prob_weight weight, const prob_weight lambda) {
-#if IS_SERVER_TUNING_MODE
-                                m_pure_features[idx] = weight;
-#endif
-                                m_weights[idx] = weight * lambda;
+                            inline void set_weight(const size_t idx, const prob_weight weight) {
+                                m_weights[idx] = weight;
                             }
 
                             /**
@@ -171,6 +156,18 @@ namespace uva {
 
                             }
 
+                            /**
+                             * Allows to compute the hash of the from feature weight entries of this
+                             * reordering entry. Two entries for which is_equal_from_weights returns
+                             * true are guaranteed to get the same hash value.
+                             * @param seed the seed to start hashing from
+                             * @return the hash value of the from feature weights
+                             */
+                            inline uint_fast64_t hash_from_weights(const uint_fast64_t seed) const {
+                                return MurmurHash64A((this->m_weights + HALF_NUMBER_OF_FEATURES),
+                                        HALF_NUMBER_OF_FEATURES * sizeof (prob_weight), seed);
+                            }
+
                             /**
                              * The comparison operator, allows to compare entries
                              * @param uid the unique identifier of the source/target phrase pair entry to compare with
@@ -289,12 +286,9 @@ namespace uva {
 
                             //Stores the phrase id, i.e. the unique identifier for the source/target phrase pair
                             phrase_uid m_uid;
-                            //This is an array of reordering weights
-                            prob_weight * m_weights;
-#if IS_SERVER_TUNING_MODE
-                            //This is an array of reordering weights not multiplied with lambda's
-                            prob_weight * m_pure_features;
-#endif
+                            //This is an array of reordering weights, not multiplied with lambda's, stored
+                            //in place to keep the entry pointer-free for the binary model image
+                            prob_weight m_weights[MAX_NUM_RM_FEATURES];
 
                             //Add a friend operator for easy output
                             friend ostream & operator<<(ostream & stream, const rm_entry & entry);
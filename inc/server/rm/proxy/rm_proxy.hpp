@@ -52,6 +52,13 @@ namespace uva {
                              * Allows to disconnect from the trie
                              */
                             virtual void disconnect() = 0;
+
+                            /**
+                             * Allows to store the connected model into a binary image file,
+                             * the image can be then used as the model connection string.
+                             * @param file_name the name of the binary image file to create
+                             */
+                            virtual void write_model_image(const string & file_name) = 0;
                             
                             /**
                              * The basic virtual destructor
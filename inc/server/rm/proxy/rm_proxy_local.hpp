@@ -29,12 +29,16 @@
 #include "common/utils/logging/logger.hpp"
 #include "common/utils/exceptions.hpp"
 #include "common/utils/monitor/statistics_monitor.hpp"
+#include "common/utils/file/binary_image.hpp"
 
 #include "server/server_configs.hpp"
 #include "server/rm/rm_configs.hpp"
+#include "server/rm/rm_consts.hpp"
 #include "server/rm/proxy/rm_query_proxy.hpp"
 #include "server/rm/proxy/rm_query_proxy_local.hpp"
 
+#include "server/tm/tm_configurator.hpp"
+
 using namespace uva::utils::monitor;
 using namespace uva::utils::exceptions;
 using namespace uva::utils::logging;
@@ -62,7 +66,8 @@ namespace uva {
                             /**
                              * The basic proxy constructor, currently does nothing except for default initialization
                              */
-                            rm_proxy_local() {
+                            rm_proxy_local()
+                            : m_params(NULL), m_image_link_id(0), m_begin_tag_entry(NULL), m_end_tag_entry(NULL) {
                             }
 
                             /**
@@ -77,20 +82,55 @@ namespace uva {
                              * @see rm_proxy
                              */
                             virtual void connect(const rm_parameters & params) {
+                                //Store the parameters
+                                m_params = &params;
+
                                 //The whole purpose of this method connect here is
                                 //just to load the reordering model into the memory.
-                                load_model_data<rm_builder_type, rm_model_reader>("Reordering Model", params);
+                                //A pre-compiled binary image is mapped, a text file is parsed.
+                                if (is_binary_image(params.m_conn_string, __rm_image::MAGIC)) {
+                                    load_model_image("Reordering Model", params);
+                                } else {
+                                    load_model_data<rm_builder_type, rm_model_reader>("Reordering Model", params);
+                                }
 
                                 //Get the pointers to the begin and end tag reordering entries
                                 m_begin_tag_entry = m_model.get_begin_tag_entry();
                                 m_end_tag_entry = m_model.get_end_tag_entry();
+
+                                //Attach the reordering entries to the translation model targets
+                                link_tm_targets();
                             }
 
                             /**
                              * @see rm_proxy
                              */
                             virtual void disconnect() {
-                                //Nothing the be done here yet, the model is allocated on the stack
+                                //The model is allocated on the stack, only
+                                //the binary image is to be un-mapped, if any
+                                m_image.close();
+                            }
+
+                            /**
+                             * @see rm_proxy
+                             */
+                            virtual void write_model_image(const string & file_name) {
+                                LOG_USAGE << "Writing the Reordering Model binary image into: " << file_name << END_LOG;
+                                const double start_time = stat_monitor::get_cpu_time();
+
+                                //Write the image header followed by the model data
+                                binary_image_writer image(file_name);
+                                image.write_array(__rm_image::MAGIC, BINARY_IMAGE_MAGIC_LEN);
+                                image.write<uint32_t>(__rm_image::VERSION);
+                                image.write<uint64_t>(tm_configurator::get_image_link_id());
+                                image.write<bool>(IS_SERVER_TUNING_MODE);
+                                image.write<uint64_t>(m_params->m_num_lambdas);
+                                m_model.write_image(image);
+                                image.close();
+
+                                const double end_time = stat_monitor::get_cpu_time();
+                                LOG_USAGE << "Writing the binary image of " << image.get_size() << " bytes took "
+                                        << (end_time - start_time) << " CPU seconds." << END_LOG;
                             }
 
                             /**
@@ -99,7 +139,7 @@ namespace uva {
                              * @see rm_proxy
                              */
                             virtual rm_query_proxy & allocate_query_proxy() {
-                                return *(new rm_query_proxy_local<rm_model_type>(m_model, *m_begin_tag_entry, *m_end_tag_entry));
+                                return *(new rm_query_proxy_local<rm_model_type>(*m_begin_tag_entry, *m_end_tag_entry));
                             }
 
                             /**
@@ -114,6 +154,88 @@ namespace uva {
 
                         protected:
 
+                            /**
+                             * Allows to attach the reordering entries to the translation model
+                             * target entries. The translation model is connected before this one.
+                             * If it is mapped from a binary image then its target entries are
+                             * already linked and the reordering model must be mapped from the
+                             * image created together with the translation model image.
+                             */
+                            void link_tm_targets() {
+                                size_t num_targets = 0;
+                                const phrase_uid * st_uids = NULL;
+                                tm_target_entry * targets = tm_configurator::get_targets_pool(num_targets, st_uids);
+
+                                if (targets != NULL) {
+                                    LOG_DEBUG << "Linking " << num_targets << " translation model targets to the reordering model" << END_LOG;
+                                    m_model.link_targets(targets, st_uids, num_targets);
+                                } else {
+                                    ASSERT_CONDITION_THROW((tm_configurator::get_image_link_id() != m_image_link_id),
+                                            "The Translation Model binary image is not linked to the Reordering Model, "
+                                            "re-create the Translation and Reordering Model images together!");
+                                }
+                            }
+
+                            /**
+                             * Allows to read and check the binary image header against the compiled
+                             * model layout and the configured reordering model parameters.
+                             * The weights are stored without the lambdas, so only their number must match.
+                             * @param params the model parameters
+                             */
+                            void read_image_header(const rm_parameters & params) {
+                                //Skip the magic marker, it has already been checked
+                                (void) m_image.read_array<char>(BINARY_IMAGE_MAGIC_LEN);
+
+                                const uint32_t version = m_image.read<uint32_t>();
+                                ASSERT_CONDITION_THROW((version != __rm_image::VERSION),
+                                        string("The binary image version: ") + to_string(version) +
+                                        string(" is not supported, expected: ") + to_string(__rm_image::VERSION));
+
+                                //Read the link id of the translation model image to be used with
+                                m_image_link_id = m_image.read<uint64_t>();
+
+                                ASSERT_CONDITION_THROW((m_image.read<bool>() != IS_SERVER_TUNING_MODE),
+                                        "The binary image is built with a different server tuning mode, re-create the image!");
+
+                                m_image.read_check<uint64_t>(params.m_num_lambdas, string("the number of ") + rm_parameters::RM_WEIGHTS_PARAM_NAME);
+                            }
+
+                            /**
+                             * Allows to map the model from a pre-compiled binary image file
+                             * @param model_name the name of the model being loaded
+                             * @param params the model parameters
+                             */
+                            void load_model_image(char const *model_name, const rm_parameters & params) {
+                                const string & model_file_name = params.m_conn_string;
+
+                                //Declare the statistics monitor and its data
+                                TMemotyUsage mem_stat_start = {}, mem_stat_end = {};
+
+                                LOG_USAGE << "--------------------------------------------------------" << END_LOG;
+                                LOG_USAGE << "Start mapping the " << model_name << " binary image ..." << END_LOG;
+                                LOG_USAGE << model_name << " is located in: " << model_file_name << END_LOG;
+
+                                //Log the usage information
+                                m_model.log_model_type_info();
+
+                                stat_monitor::get_mem_stat(mem_stat_start);
+                                const double start_time = stat_monitor::get_cpu_time();
+
+                                //Set the number of RM features, as it is done by the builder
+                                rm_entry::set_num_features(params.m_num_lambdas);
+
+                                //Map the image file, check its header and map the model
+                                m_image.open(model_file_name);
+                                read_image_header(params);
+                                m_model.read_image(m_image);
+
+                                const double end_time = stat_monitor::get_cpu_time();
+                                LOG_USAGE << "Mapping the " << model_name << " took " << (end_time - start_time) << " CPU seconds." << END_LOG;
+                                stat_monitor::get_mem_stat(mem_stat_end);
+                                const string action_name = string("Mapping the ") + string(model_name);
+                                report_memory_usage(action_name.c_str(), mem_stat_start, mem_stat_end, true);
+                            }
+
                             /**
                              * Allows to load the model into the instance of the selected container class
                              * \todo Add the possibility to choose between the file readers from the command line!
@@ -185,6 +307,12 @@ namespace uva {
                         private:
                             //Stores the reordering model instance
                             rm_model_type m_model;
+                            //Stores the pointer to the model parameters
+                            const rm_parameters * m_params;
+                            //Stores the binary image the model is mapped from, if any
+                            binary_image_reader m_image;
+                            //Stores the translation model image link id, zero if the model is not mapped from an image
+                            uint64_t m_image_link_id;
 
                             //Stores the pointer to the begin tag reordering 
                             const rm_entry * m_begin_tag_entry;
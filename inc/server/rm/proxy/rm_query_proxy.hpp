@@ -52,13 +52,6 @@ namespace uva {
                         class rm_query_proxy {
                         public: 
                             
-                            /**
-                             * Allows to execute the query, for the given source/target phrase ids
-                             * @param st_ids is the list of the source/target phrase ids
-                             *               for which the reordering data is needed
-                             */
-                            virtual void execute(const vector<phrase_uid> & st_ids) = 0;
-                            
                             /**
                              * Allows to retrieve the begin tag reordering entry from the reordering model
                              * @return the start tag reordering entry
@@ -71,14 +64,6 @@ namespace uva {
                              */
                             virtual const rm_entry & get_end_tag_reordering() const = 0;
 
-                            /**
-                             * Allows to get the source/target reordering data from the reordering model
-                             * @param uid the source/target phrase uid
-                             * @return the reference to the source entry, might be the one
-                             *         of UNK if the reordering was not found.
-                             */
-                            virtual const rm_entry & get_reordering(const phrase_uid uid) const = 0;
-
                             /**
                              * The basic virtual destructor
                              */
@@ -28,7 +28,6 @@
 
 #include "server/rm/proxy/rm_query_proxy.hpp"
 #include "server/rm/models/rm_entry.hpp"
-#include "server/rm/models/rm_query.hpp"
 
 using namespace uva::smt::bpbd::server::rm;
 using namespace uva::smt::bpbd::server::rm::models;
@@ -49,14 +48,13 @@ namespace uva {
                         public:
 
                             /**
-                             * The basic constructor that accepts the reordering model reference to query to
-                             * @param model the reordering model to query
+                             * The basic constructor that accepts the tag reordering entries, the other
+                             * reordering entries are attached to the translation model target entries.
                              * @param begin_tag_entry the reference to the begin tag reordering
                              * @param end_tag_entry the reference to the end tag reordering
                              */
-                            rm_query_proxy_local(const model_type & model,
-                                    const rm_entry & begin_tag_entry, const rm_entry & end_tag_entry)
-                            : m_query(model), m_begin_tag_entry(begin_tag_entry), m_end_tag_entry(end_tag_entry) {
+                            rm_query_proxy_local(const rm_entry & begin_tag_entry, const rm_entry & end_tag_entry)
+                            : m_begin_tag_entry(begin_tag_entry), m_end_tag_entry(end_tag_entry) {
                             }
 
                             /**
@@ -77,20 +75,6 @@ namespace uva {
                                 return m_end_tag_entry;
                             }
 
-                            /**
-                             * @see rm_query_proxy
-                             */
-                            virtual const rm_entry & get_reordering(const phrase_uid uid) const {
-                                return m_query.get_reordering(uid);
-                            }
-
-                            /**
-                             * @see rm_query_proxy
-                             */
-                            virtual void execute(const vector<phrase_uid> & st_ids) {
-                                m_query.execute(st_ids);
-                            }
-
                             /**
                              * @see rm_query_proxy
                              */
@@ -99,9 +83,6 @@ namespace uva {
                             }
 
                         private:
-                            //Stores the actual query
-                            rm_query<model_type> m_query;
-
                             //Stores the reference to the begin tag reordering 
                             const rm_entry & m_begin_tag_entry;
 
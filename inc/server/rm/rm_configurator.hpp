@@ -83,6 +83,14 @@ namespace uva {
                             }
                         }
 
+                        /**
+                         * Allows to store the connected reordering model into a binary image file
+                         * @param file_name the name of the binary image file to create
+                         */
+                        static void write_model_image(const string & file_name) {
+                            m_model_proxy->write_model_image(file_name);
+                        }
+
                         /**
                          * Allows to return an instance of the query proxy,
                          * is to be returned by calling the dispose method.
@@ -26,6 +26,8 @@
 #ifndef RM_CONSTS_HPP
 #define	RM_CONSTS_HPP
 
+#include <cstdint>
+
 using namespace std;
 
 namespace uva {
@@ -33,6 +35,15 @@ namespace uva {
         namespace bpbd {
             namespace server {
                 namespace rm {
+                    //Stores the binary reordering model image configuration constants
+                    namespace __rm_image {
+                        //The magic marker the binary reordering model image files start with
+                        static constexpr char MAGIC[] = "BPBD_RMI";
+                        //The binary reordering model image format version, is to be
+                        //increased whenever the image layout of the model changes
+                        static constexpr uint32_t VERSION = 3;
+                    }
+
                     namespace models {
                         //Stores the configuration parameters for the basic reordering model implementation
                         namespace __rm_basic_model {
@@ -36,6 +36,7 @@
 
 #include "server/server_configs.hpp"
 #include "server/common/feature_id_registry.hpp"
+#include "server/common/models/feature_weights.hpp"
 
 using namespace std;
 
@@ -44,6 +45,7 @@ using namespace uva::utils::logging;
 using namespace uva::utils::text;
 
 using namespace uva::smt::bpbd::server::common;
+using namespace uva::smt::bpbd::server::common::models;
 
 namespace uva {
     namespace smt {
@@ -89,6 +91,15 @@ namespace uva {
                             }
                         }
 
+                        /**
+                         * Allows to set the reordering model weights into the feature weights
+                         * @param weights the feature weights to be filled in
+                         */
+                        inline void fill_weights(feature_weights & weights) const {
+                            weights.m_num_rm_lambdas = m_num_lambdas;
+                            weights.set_rm_lambdas(m_num_lambdas, m_lambdas);
+                        }
+
                         /**
                          * Allows to verify the parameters to be correct.
                          */
@@ -31,8 +31,14 @@ namespace uva {
                 static const string PROGRAM_SET_EDL_CMD = "set edl ";
                 static const string PROGRAM_SET_PT_CMD = "set pt ";
                 static const string PROGRAM_SET_SC_CMD = "set sc ";
+                static const string PROGRAM_SET_TL_CMD = "set tl ";
                 static const string PROGRAM_SET_LDP_CMD = "set ldp ";
                 static const string PROGRAM_SET_GL_CMD = "set gl ";
+                //Declare the feature weight "set" commands, NOTE the end spaces are needed!
+                static const string PROGRAM_SET_LMW_CMD = "set lmw ";
+                static const string PROGRAM_SET_TMW_CMD = "set tmw ";
+                static const string PROGRAM_SET_WP_CMD = "set wp ";
+                static const string PROGRAM_SET_RMW_CMD = "set rmw ";
 
                 /**
                  * The command line handler class for the translation server.
@@ -71,7 +77,14 @@ namespace uva {
                         print_command_help(PROGRAM_SET_D_CMD, "<integer>", "set the distortion limit");
                         print_command_help(PROGRAM_SET_PT_CMD, "<unsigned float>", "set pruning threshold");
                         print_command_help(PROGRAM_SET_SC_CMD, "<integer>", "set stack capacity");
+                        print_command_help(PROGRAM_SET_TL_CMD, "<unsigned integer>", "set the per phrase translation limit, 0 for all the loaded ones");
                         print_command_help(PROGRAM_SET_LDP_CMD, "<float>", "set linear distortion penalty");
+                        print_command_help(PROGRAM_SET_LMW_CMD, "<float>", "set the language model weight");
+                        print_command_help(PROGRAM_SET_TMW_CMD, "<float>|...|<float>", "set the translation model weights");
+                        print_command_help(PROGRAM_SET_WP_CMD, "<float>", "set the word penalty weight");
+                        LOG_USAGE << "\tNOTE: With other lmw/tmw/wp weights the phrase translations are re-ranked, "
+                                << "but only the ones kept by tm_trans_lim on model loading." << END_LOG;
+                        print_command_help(PROGRAM_SET_RMW_CMD, "<float>|...|<float>", "set the reordering model weights");
 #if IS_SERVER_TUNING_MODE
                         print_command_help(PROGRAM_SET_GL_CMD, "<bool>", "enable/disable search lattice generation");
 #endif
@@ -155,10 +168,40 @@ namespace uva {
                                 de_local.m_stack_capacity = get_int_value(cmd, PROGRAM_SET_SC_CMD);
                                 is_recognized = true;
                             }
+                            if (begins_with(cmd, PROGRAM_SET_TL_CMD)) {
+                                de_local.m_trans_limit = get_int_value(cmd, PROGRAM_SET_TL_CMD);
+                                is_recognized = true;
+                            }
                             if (begins_with(cmd, PROGRAM_SET_LDP_CMD)) {
                                 de_local.m_lin_dist_penalty = get_float_value(cmd, PROGRAM_SET_LDP_CMD);
                                 is_recognized = true;
                             }
+                            if (begins_with(cmd, PROGRAM_SET_LMW_CMD)) {
+                                de_local.m_weights.m_lm_lambda = get_float_value(cmd, PROGRAM_SET_LMW_CMD);
+                                is_recognized = true;
+                            }
+                            if (begins_with(cmd, PROGRAM_SET_TMW_CMD)) {
+                                prob_weight lambdas[tm::MAX_NUM_TM_FEATURES];
+                                size_t num_lambdas = 0;
+                                tokenize_s_t_f<tm::MAX_NUM_TM_FEATURES>("TM weights",
+                                        get_string_value(cmd, PROGRAM_SET_TMW_CMD),
+                                        lambdas, num_lambdas, TM_FEATURE_WEIGHTS_DELIMITER_STR);
+                                de_local.m_weights.set_tm_lambdas(num_lambdas, lambdas);
+                                is_recognized = true;
+                            }
+                            if (begins_with(cmd, PROGRAM_SET_WP_CMD)) {
+                                de_local.m_weights.m_wp_lambda = get_float_value(cmd, PROGRAM_SET_WP_CMD);
+                                is_recognized = true;
+                            }
+                            if (begins_with(cmd, PROGRAM_SET_RMW_CMD)) {
+                                prob_weight lambdas[rm::MAX_NUM_RM_FEATURES];
+                                size_t num_lambdas = 0;
+                                tokenize_s_t_f<rm::MAX_NUM_RM_FEATURES>("RM weights",
+                                        get_string_value(cmd, PROGRAM_SET_RMW_CMD),
+                                        lambdas, num_lambdas, RM_FEATURE_WEIGHTS_DELIMITER_STR);
+                                de_local.m_weights.set_rm_lambdas(num_lambdas, lambdas);
+                                is_recognized = true;
+                            }
 
 #if IS_SERVER_TUNING_MODE
                             if (begins_with(cmd, PROGRAM_SET_GL_CMD)) {
@@ -172,6 +215,11 @@ namespace uva {
 
                             //Set the parameters back
                             de_params = de_local;
+
+                            //Let the server know the parameters have been changed
+                            if (is_recognized) {
+                                m_client.notify_params_changed();
+                            }
                         } catch (std::exception &ex) {
                             LOG_ERROR << ex.what() << " Enter '" << PROGRAM_HELP_CMD << "' for help!" << END_LOG;
                         }
@@ -68,6 +68,12 @@ namespace uva {
                     static const string SE_IS_TLS_SERVER_PARAM_NAME;
                     //Stores the number of threads parameter name
                     static const string SE_NUM_THREADS_PARAM_NAME;
+                    //Stores the task priority aging period parameter name
+                    static const string SE_PRIORITY_AGING_PARAM_NAME;
+                    //Stores the translation cache size parameter name
+                    static const string SE_TRANS_CACHE_SIZE_PARAM_NAME;
+                    //Stores the default translation cache size
+                    static constexpr size_t SE_DEF_TRANS_CACHE_SIZE = 16384;
                     //Stores the source language parameter name
                     static const string SE_SOURCE_LANG_PARAM_NAME;
                     //Stores the target language parameter name
@@ -77,6 +83,11 @@ namespace uva {
                     //for generating the feature to id mapping file.
                     bool m_is_only_f2id;
 
+                    //Stores the file names to store the translation and reordering
+                    //model binary images into, if not empty the server is not started
+                    string m_tm_image_file_name;
+                    string m_rm_image_file_name;
+
                     //The source language name
                     string m_source_lang;
                     //The source language name, lowercased
@@ -89,6 +100,13 @@ namespace uva {
                     //The number of the translation threads to run
                     size_t m_num_threads;
 
+                    //The time period, in seconds, of waiting after which a
+                    //translation task priority is raised by one, 0.0 for none
+                    double m_priority_aging;
+
+                    //The maximum number of sentence translations to cache, 0 for none
+                    size_t m_trans_cache_size;
+
                     //Stores the translation model parameters
                     tm_parameters m_tm_params;
 
@@ -111,13 +129,26 @@ namespace uva {
                             m_lm_params.finalize();
                             m_tm_params.finalize();
                             m_rm_params.finalize();
+
+                            //The decoder scores with the model weights, until changed
+                            m_lm_params.fill_weights(m_de_params.m_weights);
+                            m_tm_params.fill_weights(m_de_params.m_weights);
+                            m_rm_params.fill_weights(m_de_params.m_weights);
                             m_de_params.finalize();
 
+                            //The source phrase filter only needs the phrases the decoder can look up
+                            m_tm_params.m_max_s_phrase_len = m_de_params.m_max_s_phrase_len;
+
                             ASSERT_CONDITION_THROW((m_num_threads == 0),
                                     string("The number of decoding threads: ") +
                                     to_string(m_num_threads) +
                                     string(" must be larger than zero! "));
 
+                            ASSERT_CONDITION_THROW((m_priority_aging < 0.0),
+                                    string("The priority aging period: ") +
+                                    to_string(m_priority_aging) +
+                                    string(" must not be negative! "));
+
                             //Create the lowercase versions of the source and target languages
                             m_source_lang_lower = m_source_lang;
                             (void) to_lower(m_source_lang_lower);
@@ -145,6 +176,10 @@ namespace uva {
                             << " = " << params.m_target_lang
                             << ", " << server_parameters::SE_NUM_THREADS_PARAM_NAME
                             << " = " << params.m_num_threads
+                            << ", " << server_parameters::SE_PRIORITY_AGING_PARAM_NAME
+                            << " = " << params.m_priority_aging
+                            << ", " << server_parameters::SE_TRANS_CACHE_SIZE_PARAM_NAME
+                            << " = " << params.m_trans_cache_size
                             << ", " << params.m_lm_params
                             << ", " << params.m_tm_params
                             << ", " << params.m_rm_params
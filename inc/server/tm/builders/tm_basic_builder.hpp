@@ -27,7 +27,9 @@
 #define TM_LIMITING_BUILDER_HPP
 
 #include <cmath>
+#include <vector>
 #include <unordered_map>
+#include <unordered_set>
 
 #include "tm_builder.hpp"
 
@@ -72,6 +74,8 @@ namespace uva {
                         typedef ordered_list<tm_tmp_target_entry>* targets_list_ptr;
                         //Define the map storing the source phrase ids and the number of translations per phrase
                         typedef unordered_map<phrase_uid, targets_list_ptr> tm_data_map;
+                        //Define the set storing the uids of the source phrases to be loaded
+                        typedef unordered_set<phrase_uid> tm_source_filter;
 
                         /**
                          * This class represents a builder of the translation model.
@@ -99,7 +103,8 @@ namespace uva {
                              */
                             tm_basic_builder(const tm_parameters & params, model_type & model, reader_type & reader)
                             : m_params(params), m_data(NULL), m_model(model), m_reader(reader),
-                            m_lm_query(lm_configurator::allocate_fast_query_proxy()), m_tmp_num_words(0) {
+                            m_lm_query(lm_configurator::allocate_fast_query_proxy()), m_tmp_num_words(0),
+                            m_is_filter(!m_params.m_filter_file.empty()), m_filter(), m_num_filtered(0) {
                                 if (m_params.m_trans_limit <= BEST_TRANS_THRESHOLD) {
                                     LOG_WARNING << "The translation limit: " << m_params.m_trans_limit
                                             << " is too small, will be ignored!" << END_LOG;
@@ -129,6 +134,17 @@ namespace uva {
                                 //Set the number of TM features
                                 tm_target_entry::set_num_features(m_params.m_num_lambdas);
 
+                                //Set the model weights, the target costs are pre-computed with them
+                                feature_weights weights;
+                                lm_configurator::get_params().fill_weights(weights);
+                                m_params.fill_weights(weights);
+                                m_model.set_weights(weights);
+
+                                //Load the source phrases filter, if any
+                                if (m_is_filter) {
+                                    load_source_filter();
+                                }
+
                                 //Load the model data into memory and filter
                                 load_tm_data();
                                 
@@ -138,26 +154,78 @@ namespace uva {
 
                                 //Add the unk (unknown translation) entry
                                 add_unk_translation();
+
+                                //Finalize the model
+                                m_model.finalize();
                             }
 
                         protected:
 
                             /**
-                             * Allows to post-process a single feature, i.e. do:
-                             *         log_e(feature)*lambda
+                             * Allows to load the source phrase filter. The filter file contains
+                             * the source text, one sentence per line, tokenized in the same way
+                             * as the text to be translated. All the sentence m-grams up to the
+                             * maximum source phrase length are the source phrases to be loaded.
+                             */
+                            inline void load_source_filter() {
+                                LOG_USAGE << "Loading the source phrase filter from: " << m_params.m_filter_file << END_LOG;
+
+                                //Open the filter file
+                                reader_type filter_file(m_params.m_filter_file.c_str());
+                                ASSERT_CONDITION_THROW(!filter_file.is_open(), string("The source phrase filter file: '")
+                                        + m_params.m_filter_file + string("' does not exist!"));
+
+                                //Declare the text piece readers for the line and the word
+                                text_piece_reader line, word;
+                                //Stores the line's word uids
+                                vector<phrase_uid> word_uids;
+
+                                //Read the file line by line
+                                while (filter_file.get_first_line(line)) {
+                                    //Get the uids of the line's words, skip the repeated spaces
+                                    word_uids.clear();
+                                    while (line.get_first_space(word)) {
+                                        if (word.length() > 0) {
+                                            word_uids.push_back(get_token_uid(word.get_begin_c_str(), word.length()));
+                                        }
+                                    }
+
+                                    //Add the uids of all the line's m-grams of the allowed length
+                                    for (size_t begin_idx = 0; begin_idx < word_uids.size(); ++begin_idx) {
+                                        const size_t end_idx = min(word_uids.size(), begin_idx + m_params.m_max_s_phrase_len);
+                                        phrase_uid uid = word_uids[begin_idx];
+                                        m_filter.insert(uid);
+                                        for (size_t word_idx = begin_idx + 1; word_idx < end_idx; ++word_idx) {
+                                            uid = combine_phrase_uids(uid, word_uids[word_idx]);
+                                            m_filter.insert(uid);
+                                        }
+                                    }
+                                }
+
+                                LOG_USAGE << "The source phrase filter contains " << m_filter.size() << " phrases" << END_LOG;
+                            }
+
+                            /**
+                             * Allows to check whether the source phrase is to be loaded
+                             * @param source_uid the source phrase uid
+                             * @return true if there is no filter or the phrase is in the filter, otherwise false
+                             */
+                            inline bool is_good_source(const phrase_uid source_uid) const {
+                                return !m_is_filter || (m_filter.find(source_uid) != m_filter.end());
+                            }
+
+                            /**
+                             * Allows to post-process a single feature, i.e. do: log_e(feature)
+                             * The lambda weights are not applied, the model stores the log_e
+                             * features and the weights are applied when scoring.
                              * @param raw_feature the feature to post-process
-                             * @param lambda the lambda weight to multiply the log_e feature with
-                             * @param feature the out parameter into which the resulting value will be placed: log_10(raw_feature)*lambda
-                             * @return the log_10 of the provided raw_feature
+                             * @return the log_e of the provided raw_feature
                              */
-                            inline prob_weight post_process_feature(const prob_weight raw_feature, const prob_weight lambda, prob_weight & feature) {
+                            inline prob_weight post_process_feature(const prob_weight raw_feature) {
                                 //Convert the feature into the log scale
                                 const prob_weight log_feature = std::log(raw_feature);
 
-                                //Multiply the log-scale feature weight with the appropriate lambda
-                                feature = log_feature * lambda;
-
-                                LOG_DEBUG << "log_e(" << raw_feature << ") * " << lambda << " = " << feature << END_LOG;
+                                LOG_DEBUG << "log_e(" << raw_feature << ") = " << log_feature << END_LOG;
 
                                 //Return the log scale of the raw features
                                 return log_feature;
@@ -168,36 +236,30 @@ namespace uva {
                              */
                             inline void add_unk_translation() {
                                 //Declare an array of features, zero-valued
-                                feature_array unk_features = {}, pure_unk_features = {};
+                                feature_array unk_features = {};
 
                                 LOG_DEBUG << "The UNK initial features: "
                                         << array_to_string<prob_weight>(m_params.m_num_unk_features, m_params.m_unk_features) << END_LOG;
-                                LOG_DEBUG << "The lambdas: "
-                                        << array_to_string<prob_weight>(m_params.m_num_lambdas, m_params.m_lambdas) << END_LOG;
 
                                 //Copy the values of the unk features to the writable array
                                 for (size_t idx = 0; idx < m_params.m_num_unk_features; ++idx) {
-                                    //Now convert to the log probability and multiply with the appropriate weight
-                                    pure_unk_features[idx] = post_process_feature(m_params.m_unk_features[idx], m_params.m_lambdas[idx], unk_features[idx]);
+                                    //Now convert to the log probability
+                                    unk_features[idx] = post_process_feature(m_params.m_unk_features[idx]);
                                 }
 
                                 //Set the unk features to the model
-                                m_model.set_unk_entry(UNKNOWN_WORD_ID, unk_features, m_params.m_wp_lambda,
-                                        m_lm_query.get_unk_word_prob(), pure_unk_features);
+                                m_model.set_unk_entry(UNKNOWN_WORD_ID, unk_features, m_lm_query.get_unk_word_prob());
                             }
 
                             /**
                              * Allows to extract the features from the text piece and to
                              * check that they are valid with respect to the option bound
-                             * If needed the weights will be converted to log scale and
-                             * multiplied with the lambda factors
+                             * If needed the weights will be converted to log scale
                              * @param weights [in] the text piece with weights, that starts with a space!
                              * @param features [out] the read and post-processed features features if they satisfy on the constraints
-                             * @param pure_features [out] the non-processed features in case needed for tuning
                              * @return true if the features satisfy the constraints, otherwise false
                              */
-                            inline bool process_features(text_piece_reader weights,
-                                    prob_weight * features, prob_weight * pure_features = NULL) {
+                            inline bool process_features(text_piece_reader weights, prob_weight * features) {
                                 //Declare the token
                                 text_piece_reader token;
                                 //Store the read probability weight
@@ -227,13 +289,8 @@ namespace uva {
                                                 << " < " << m_params.m_min_tran_prob << END_LOG;
                                         return false;
                                     } else {
-                                        //Now convert to the log probability and multiply with the appropriate weight
-#if IS_SERVER_TUNING_MODE
-                                        ASSERT_SANITY_THROW((pure_features == NULL), "The pure_features is NULL!");
-                                        pure_features[idx] = post_process_feature(raw_feature, m_params.m_lambdas[idx], features[idx]);
-#else
-                                        (void) post_process_feature(raw_feature, m_params.m_lambdas[idx], features[idx]);
-#endif
+                                        //Now convert to the log probability
+                                        features[idx] = post_process_feature(raw_feature);
                                     }
 
                                     //Increment the index 
@@ -262,7 +319,7 @@ namespace uva {
                                 LOG_DEBUG2 << "Got translation line to parse: ___" << rest << "___" << END_LOG;
 
                                 //Declare an array of weights for temporary use
-                                feature_array tmp_features = {}, tmp_pure_features = {};
+                                feature_array tmp_features = {};
 
                                 //Declare the target and weights entry reader
                                 text_piece_reader target, weights;
@@ -277,7 +334,7 @@ namespace uva {
                                 rest.get_first<TM_DELIMITER, TM_DELIMITER_CDTY>(weights);
 
                                 //Check that the weights are good and retrieve them if they are
-                                if (process_features(weights, tmp_features, tmp_pure_features)) {
+                                if (process_features(weights, tmp_features)) {
                                     LOG_DEBUG2 << "The target phrase is: " << target << END_LOG;
                                     //Add the translation entry to the model
                                     string target_str = target.str();
@@ -295,19 +352,17 @@ namespace uva {
                                     //Initiate a new temporary target entry
                                     entry = new tm_tmp_target_entry();
                                     
-                                    //Set the target entry data first, to make it distinguishable
-                                    entry->set_data(source_uid, target_str, target_uid,
-                                            tmp_features, m_tmp_num_words, m_tmp_word_ids,
-                                            m_params.m_wp_lambda, tmp_pure_features);
-
                                     //Get the Language Model weight for the target translation
                                     const prob_weight lm_weight = m_lm_query.execute(m_tmp_num_words, m_tmp_word_ids);
                                     LOG_DEBUG << "The phrase: ___" << target_str << "__ lm-weight: " << lm_weight << END_LOG;
-                                    
-                                    //Set the LM target weight, is needed to compute the temporary total
-                                    //weight for ordering the entries and is also later needed to compute
-                                    //the minimum translation cost of the source entry
-                                    entry->set_lm_weight(lm_weight);
+
+                                    //Set the target entry data, the LM target weight is needed to compute
+                                    //the temporary total weight for ordering the entries and is also later
+                                    //needed to compute the minimum translation cost of the source entry
+                                    entry->set_data(source_uid, target_uid, tmp_features,
+                                            m_tmp_num_words, lm_weight, m_model.get_weights());
+                                    entry->set_tmp_word_ids(m_tmp_word_ids);
+                                    entry->set_tmp_target_phrase(target_str);
 
                                     LOG_DEBUG1 << "The source/target (" << source_uid
                                             << "/" << target_uid << ") entry was created!" << END_LOG;
@@ -327,9 +382,11 @@ namespace uva {
                                 //Declare the text piece reader for storing the read line and source phrase
                                 text_piece_reader line, source;
 
-                                //Store the cached source string and its uid values
-                                string source_str = "";
+                                //Store the cached raw source string and its uid values
+                                string source_raw = "";
                                 phrase_uid source_uid = UNDEFINED_PHRASE_ID;
+                                //Stores the flag indicating whether the source is to be loaded
+                                bool is_good = false;
 
                                 //The pointers to the current targets list
                                 targets_list_ptr targets = NULL;
@@ -346,14 +403,17 @@ namespace uva {
                                     //Read the source phrase
                                     line.get_first<TM_DELIMITER, TM_DELIMITER_CDTY>(source);
 
-                                    //Get the current source phrase uid
-                                    string next_source_str = source.str();
-                                    trim(next_source_str);
+                                    //If we are now reading the new source entry, compare the
+                                    //raw bytes to avoid copying the source of every line
+                                    if (source != source_raw) {
+                                        //Store the new raw source string
+                                        source_raw = source.str();
+                                        //Get the new source phrase string
+                                        string source_str = source_raw;
+                                        trim(source_str);
 
-                                    LOG_DEBUG << "Got the source phrase: ___" << next_source_str << "___" << END_LOG;
+                                        LOG_DEBUG << "Got the source phrase: ___" << source_str << "___" << END_LOG;
 
-                                    //If we are now reading the new source entry
-                                    if (source_str != next_source_str) {
                                         //Delete the empty targets of the previous source entry
                                         //and erase the entry as it got no translations
                                         if (targets != NULL && (targets->get_size() == 0)) {
@@ -363,30 +423,38 @@ namespace uva {
                                             m_data->erase(source_uid);
                                         }
 
-                                        //Store the new source string
-                                        source_str = next_source_str;
                                         //Compute the new source string uid
                                         source_uid = get_phrase_uid(source_str);
 
                                         LOG_DEBUG1 << "The NEW source ___" << source_str << "___ id is: " << source_uid << END_LOG;
 
-                                        //Create a new list of targets, or retrieve an existing one
-                                        tm_data_map::iterator iter = m_data->find(source_uid);
-                                        if (iter == m_data->end()) {
-                                            targets = new targets_list(m_params.m_trans_limit);
-                                            m_data->operator[](source_uid) = targets;
+                                        //Check whether the source phrase is to be loaded
+                                        is_good = is_good_source(source_uid);
+                                        if (is_good) {
+                                            //Create a new list of targets, or retrieve an existing one
+                                            tm_data_map::iterator iter = m_data->find(source_uid);
+                                            if (iter == m_data->end()) {
+                                                targets = new targets_list(m_params.m_trans_limit);
+                                                m_data->operator[](source_uid) = targets;
+                                            } else {
+                                                targets = iter->second;
+                                            }
                                         } else {
-                                            targets = iter->second;
+                                            LOG_DEBUG1 << "The source " << source_uid << " is filtered out!" << END_LOG;
+                                            targets = NULL;
+                                            ++m_num_filtered;
                                         }
                                     }
 
-                                    //Get the target entry if it is passes
-                                    if (get_target_entry(line, source_uid, entry)) {
-                                        LOG_DEBUG1 << "Adding the new target entry to the source " << source_uid << END_LOG;
-                                        //Add the translation entry to the list
-                                        targets->add_elemenent(entry);
+                                    //Get the target entry if the source is to be loaded and the entry passes
+                                    if (is_good) {
+                                        if (get_target_entry(line, source_uid, entry)) {
+                                            LOG_DEBUG1 << "Adding the new target entry to the source " << source_uid << END_LOG;
+                                            //Add the translation entry to the list
+                                            targets->add_elemenent(entry);
+                                        }
+                                        LOG_DEBUG1 << "The source " << source_uid << " targets count is " << targets->get_size() << END_LOG;
                                     }
-                                    LOG_DEBUG1 << "The source " << source_uid << " targets count is " << targets->get_size() << END_LOG;
 
                                     //Update the progress bar status
                                     logger::update_progress_bar();
@@ -406,6 +474,9 @@ namespace uva {
                                 logger::stop_progress_bar();
 
                                 LOG_INFO << "The number of loaded TM source entries is: " << m_data->size() << END_LOG;
+                                if (m_is_filter) {
+                                    LOG_INFO << "The number of filtered out TM source entries is: " << m_num_filtered << END_LOG;
+                                }
                             }
 
                             /**
@@ -414,8 +485,20 @@ namespace uva {
                             inline void convert_tm_data() {
                                 logger::start_progress_bar(string("Storing the pre-loaded phrase translations"));
 
+                                //Count the target entries, the target words and the target phrases length
+                                size_t num_targets = 0, num_word_ids = 0, phrases_size = 0;
+                                for (tm_data_map::iterator it = m_data->begin(); it != m_data->end(); ++it) {
+                                    targets_list::elem_container * entry = it->second->get_first();
+                                    while (entry != NULL) {
+                                        ++num_targets;
+                                        num_word_ids += (**entry).get_num_words();
+                                        phrases_size += (**entry).get_tmp_target_phrase().length();
+                                        entry = entry->m_next;
+                                    }
+                                }
+
                                 //Set the number of entries into the model
-                                m_model.set_num_entries(m_data->size());
+                                m_model.set_num_entries(m_data->size(), num_targets, num_word_ids, phrases_size);
 
                                 //Iterate through the map elements and do conversion
                                 for (tm_data_map::iterator it = m_data->begin(); it != m_data->end(); ++it) {
@@ -444,7 +527,7 @@ namespace uva {
                                             //Get the reference to the target entry
                                             tm_tmp_target_entry & target = **entry;
 
-                                            source_entry->emplace_target(target);
+                                            m_model.emplace_target(source_entry, target);
 
                                             //Move on to the next entry
                                             entry = entry->m_next;
@@ -497,6 +580,13 @@ namespace uva {
                             phrase_length m_tmp_num_words;
                             //The temporary variable to store word ids for the target translation phrase LM word ids
                             word_uid m_tmp_word_ids[TM_MAX_TARGET_PHRASE_LEN];
+
+                            //Stores the flag indicating whether the source phrase filter is used
+                            const bool m_is_filter;
+                            //Stores the uids of the source phrases to be loaded
+                            tm_source_filter m_filter;
+                            //Stores the number of filtered out source phrase occurrences
+                            size_t m_num_filtered;
                         };
                     };
                 }
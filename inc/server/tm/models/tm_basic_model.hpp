@@ -36,12 +36,14 @@
 #include "server/tm/models/tm_query.hpp"
 
 #include "common/utils/containers/fixed_size_hashmap.hpp"
+#include "common/utils/file/binary_image.hpp"
 
 using namespace std;
 
 using namespace uva::utils::exceptions;
 using namespace uva::utils::logging;
 using namespace uva::utils::containers;
+using namespace uva::utils::file;
 
 using namespace uva::smt::bpbd::server::common::models;
 using namespace uva::smt::bpbd::server::lm::proxy;
@@ -61,6 +63,14 @@ namespace uva {
                          * but rather the hash values thereof. So it is a hash based
                          * implementation which reduces memory but might occasionally
                          * result in collisions, the latter is not checked.
+                         * The target entries, their word ids, features and the target phrases
+                         * are stored in four flat pools, the entries refer to them by indexes.
+                         * The features are stored without the lambda weights, the model weights
+                         * used to pre-compute the target costs are stored with the model.
+                         * The target entries only keep the data needed for expanding the
+                         * hypothesis, the target phrases are only read when the translation
+                         * is rendered. The model data is pointer-free so it can be written
+                         * into and then memory mapped from a binary model image.
                          */
                         class tm_basic_model {
                         public:
@@ -70,7 +80,13 @@ namespace uva {
                             /**
                              * The basic class constructor
                              */
-                            tm_basic_model() : m_tm_data(NULL), m_unk_entry(NULL) {
+                            tm_basic_model()
+                            : m_tm_data(NULL), m_targets(NULL), m_st_uids(NULL), m_tm_costs(NULL),
+                            m_num_words(NULL), m_num_targets(0), m_next_target_idx(0),
+                            m_word_ids(NULL), m_num_word_ids(0), m_next_word_ids_idx(0),
+                            m_features(NULL), m_num_features(0), m_next_features_idx(0),
+                            m_phrases(NULL), m_phrases_size(0), m_next_phrase_idx(0), m_unk_entry(),
+                            m_weights(), m_is_mapped(false) {
                             }
 
                             /**
@@ -83,30 +99,50 @@ namespace uva {
                                     m_tm_data = NULL;
                                 }
 
-                                //Delete the unk entry if any
-                                if (m_unk_entry != NULL) {
-                                    delete m_unk_entry;
-                                    m_unk_entry = NULL;
+                                //Delete the pools, if they are not owned by the image
+                                if (!m_is_mapped) {
+                                    if (m_targets != NULL) {
+                                        delete[] m_targets;
+                                    }
+                                    if (m_st_uids != NULL) {
+                                        delete[] m_st_uids;
+                                    }
+                                    if (m_tm_costs != NULL) {
+                                        delete[] m_tm_costs;
+                                    }
+                                    if (m_num_words != NULL) {
+                                        delete[] m_num_words;
+                                    }
+                                    if (m_word_ids != NULL) {
+                                        delete[] m_word_ids;
+                                    }
+                                    if (m_features != NULL) {
+                                        delete[] m_features;
+                                    }
+                                    if (m_phrases != NULL) {
+                                        delete[] m_phrases;
+                                    }
                                 }
+                                m_targets = NULL;
+                                m_st_uids = NULL;
+                                m_tm_costs = NULL;
+                                m_num_words = NULL;
+                                m_word_ids = NULL;
+                                m_features = NULL;
+                                m_phrases = NULL;
                             }
 
                             /**
                              * Should be called to add the unk entry to the model
                              * @param unk_word_id the unknown word id from the Language Model
-                             * @param unk_features the unk entry features
-                             * @param wp_lambda the word penalty lambda weight
-                             * @param lm_weight the cost of the target (UNK) translation from the LM model
-                             * @param pure_features the feature values without the lambda weights,
-                             *        to be stored for server tuning mode, default is NULL
+                             * @param unk_features the unk entry log_e features, without the lambda weights
+                             * @param lm_weight the cost of the target (UNK) translation from the LM model, without the lambda
                              */
-                            void set_unk_entry(word_uid unk_word_id, feature_array unk_features, const prob_weight wp_lambda,
-                                    const prob_weight lm_weight, const prob_weight * pure_features = NULL) {
-                                //Initialize the UNK entry
-                                m_unk_entry = new tm_source_entry();
+                            void set_unk_entry(word_uid unk_word_id, feature_array unk_features, const prob_weight lm_weight) {
                                 //Set thew source id
-                                m_unk_entry->set_source_uid(UNKNOWN_PHRASE_ID);
+                                m_unk_entry.set_source_uid(UNKNOWN_PHRASE_ID);
                                 //Start adding the translations to the entry, there will be just one
-                                m_unk_entry->begin(1);
+                                m_unk_entry.begin(reserve_targets(1), 1);
 
                                 //Declare and initialize the word ids array
                                 const phrase_length num_words = 1;
@@ -118,15 +154,18 @@ namespace uva {
                                         << array_to_string<prob_weight>(tm_target_entry::get_num_features(), unk_features) << END_LOG;
 
                                 //Add the translation entry
-                                m_unk_entry->add_target(
-                                        tm::TM_UNKNOWN_TARGET_STR, UNKNOWN_PHRASE_ID,
-                                        unk_features, num_words, word_ids, wp_lambda,
-                                        lm_weight, pure_features);
+                                const uint64_t phrase_idx = store_phrase(tm::TM_UNKNOWN_TARGET_STR);
+                                const uint64_t word_ids_idx = store_word_ids(num_words, word_ids);
+                                const uint32_t features_idx = store_features(unk_features);
+                                m_unk_entry.add_target(
+                                        phrase_idx, tm::TM_UNKNOWN_TARGET_STR.length(), UNKNOWN_PHRASE_ID,
+                                        unk_features, features_idx, num_words, word_ids_idx,
+                                        lm_weight, m_weights);
 
                                 //Finalize the source entry
-                                m_unk_entry->finalize();
+                                m_unk_entry.finalize();
 
-                                LOG_DEBUG << "The UNK translation total weight is: " << m_unk_entry->get_targets()[0].get_tm_cost() << END_LOG;
+                                LOG_DEBUG << "The UNK translation total weight is: " << m_unk_entry.get_tm_cost<false>(0, NULL) << END_LOG;
                             }
 
                             /**
@@ -142,14 +181,39 @@ namespace uva {
                             /**
                              * This method is needed to set the number of source phrase entries
                              * This is to be done before adding the translation entries to the model
-                             * The memory of the map will be allocated by this class.
+                             * The memory of the map and the pools will be allocated by this class.
+                             * The UNK entry is accounted for by the model itself.
                              * @param num_entries the number of source phrase entries
+                             * @param num_targets the total number of target entries
+                             * @param num_word_ids the total number of target phrase words
+                             * @param phrases_size the total length of the target phrases
                              */
-                            inline void set_num_entries(const size_t num_entries) {
-                                LOG_DEBUG << "The number of source phrases is: " << num_entries << END_LOG;
+                            inline void set_num_entries(const size_t num_entries, const size_t num_targets,
+                                    const size_t num_word_ids, const size_t phrases_size) {
+                                LOG_DEBUG << "The number of source phrases is: " << num_entries
+                                        << ", target phrases: " << num_targets << END_LOG;
 
                                 //Initialize the source entries map
                                 m_tm_data = new tm_source_entry_map(__tm_basic_model::SOURCES_BUCKETS_FACTOR, num_entries);
+
+                                //Initialize the pools, reserve space for the UNK entry
+                                m_num_targets = num_targets + 1;
+                                m_targets = new tm_target_entry[m_num_targets]();
+                                m_st_uids = new phrase_uid[m_num_targets]();
+                                m_tm_costs = new prob_weight[m_num_targets]();
+                                m_num_words = new phrase_length[m_num_targets]();
+                                m_num_word_ids = num_word_ids + 1;
+                                m_word_ids = new word_uid[m_num_word_ids]();
+                                ASSERT_CONDITION_THROW((m_num_targets > UINT32_MAX),
+                                        string("The number of targets: ") + to_string(m_num_targets) +
+                                        string(" exceeds the maximum of: ") + to_string(UINT32_MAX));
+                                m_num_features = m_num_targets * tm_target_entry::get_num_features();
+                                m_features = new prob_weight[m_num_features]();
+                                m_phrases_size = phrases_size + tm::TM_UNKNOWN_TARGET_STR.length();
+                                m_phrases = new char[m_phrases_size];
+
+                                //Let the entries know about the pools
+                                set_pools();
                             }
 
                             /**
@@ -172,7 +236,7 @@ namespace uva {
                                 LOG_DEBUG1 << "Initializing the entry: " << entry_id << " with the number of translations." << END_LOG;
 
                                 //Initialize the entry with the number of translations
-                                entry.begin(num_elems);
+                                entry.begin(reserve_targets(num_elems), num_elems);
 
                                 LOG_DEBUG1 << "Adding the new source entry for uid: " << entry_id << " - DONE!" << END_LOG;
 
@@ -180,6 +244,27 @@ namespace uva {
                                 return &entry;
                             }
 
+                            /**
+                             * Allows to add a new translation to the given source entry.
+                             * The target phrase, word ids and features are copied into the pools.
+                             * @param entry the source entry to add the translation to
+                             * @param target the target entry to be copied into the targets pool
+                             */
+                            inline void emplace_target(tm_source_entry * entry, tm_tmp_target_entry & target) {
+                                //Put the target phrase into the phrases pool
+                                const string & phrase = target.get_tmp_target_phrase();
+                                target.set_phrase(store_phrase(phrase), phrase.length());
+
+                                //Put the target phrase word ids into the word ids pool
+                                target.set_word_ids_idx(store_word_ids(target.get_num_words(), target.get_tmp_word_ids()));
+
+                                //Put the target phrase features into the features pool
+                                target.set_features_idx(store_features(target.get_tmp_features()));
+
+                                //Add the target entry to the source entry
+                                entry->emplace_target(target, m_weights);
+                            }
+
                             /**
                              * Allows to finish an entry with the given id. The process
                              * of finishing might include many things but the purpose of
@@ -201,7 +286,8 @@ namespace uva {
                              * This method is to be called when the translation model is fully read
                              */
                             inline void finalize() {
-                                //Nothing to be done here
+                                //Report on the size of the data pools
+                                log_pools_info();
                             }
 
                             /**
@@ -217,20 +303,58 @@ namespace uva {
                                 tm_const_source_entry_ptr entry = m_tm_data->get_element(entry_id, entry_id);
                                 if (do_unk && (entry == NULL)) {
                                     LOG_DEBUG1 << "Returning the UNK translation for the source uid: " << entry_id << END_LOG;
-                                    return m_unk_entry;
+                                    return &m_unk_entry;
                                 } else {
                                     LOG_DEBUG1 << "The ptr to the source entry of uid: " << entry_id << " is " << entry << END_LOG;
                                     return entry;
                                 }
                             }
 
+                            /**
+                             * Allows to prefetch the hash map bucket of the given source entry,
+                             * is to be called before the get_source_entry for the same uid.
+                             * @param entry_id the source entry id
+                             */
+                            inline void prefetch_source_entry(const phrase_uid entry_id) const {
+                                m_tm_data->prefetch_bucket(entry_id);
+                            }
+
                             /**
                              * Allows to check in the given entry is the UNK entry
                              * @param entry the pointer to the entry to be tested
                              * @return true if this is an UNK entry otherwise false
                              */
                             inline bool is_unk_entry(tm_const_source_entry * entry) const {
-                                return (entry == m_unk_entry) || (*entry == *m_unk_entry);
+                                return (entry == &m_unk_entry) || (*entry == m_unk_entry);
+                            }
+
+                            /**
+                             * Allows to get the pool of target entries, e.g. to link them to the reordering model
+                             * @param num_targets [out] the number of target entries in the pool
+                             * @param st_uids [out] the source/target phrase pair uids of the target entries
+                             * @return the pointer to the target entries pool, not writable if the model is mapped
+                             */
+                            inline tm_target_entry * get_targets_pool(size_t & num_targets, const phrase_uid * & st_uids) {
+                                num_targets = m_num_targets;
+                                st_uids = m_st_uids;
+                                return m_is_mapped ? NULL : m_targets;
+                            }
+
+                            /**
+                             * Allows to set the model weights, the target costs are pre-computed with
+                             * them, so this is to be done before adding the translation entries.
+                             * @param weights the model weights
+                             */
+                            inline void set_weights(const feature_weights & weights) {
+                                m_weights = weights;
+                            }
+
+                            /**
+                             * Allows to get the model weights the target costs are pre-computed with
+                             * @return the model weights
+                             */
+                            inline const feature_weights & get_weights() const {
+                                return m_weights;
                             }
 
                             /**
@@ -240,11 +364,181 @@ namespace uva {
                                 LOG_USAGE << "Using the hash-based translation model: " << __FILENAME__ << END_LOG;
                             }
 
+                            /**
+                             * Allows to write the model into a binary image, the model
+                             * can be then re-created from the image without copying.
+                             * @param image the binary image writer
+                             */
+                            void write_image(binary_image_writer & image) const {
+                                m_tm_data->write_image(image);
+                                image.write<uint64_t>(m_num_targets);
+                                image.write_array(m_targets, m_num_targets);
+                                image.write_array(m_st_uids, m_num_targets);
+                                image.write_array(m_tm_costs, m_num_targets);
+                                image.write_array(m_num_words, m_num_targets);
+                                image.write<uint64_t>(m_num_word_ids);
+                                image.write_array(m_word_ids, m_num_word_ids);
+                                image.write<uint64_t>(m_num_features);
+                                image.write_array(m_features, m_num_features);
+                                image.write<uint64_t>(m_phrases_size);
+                                image.write_array(m_phrases, m_phrases_size);
+                                image.write(m_unk_entry);
+                                image.write(m_weights);
+                            }
+
+                            /**
+                             * Allows to map the model data from a binary image previously
+                             * written by write_image. The data is used in place, the model
+                             * is read-only and the image must outlive it.
+                             * @param image the binary image reader positioned at the model data
+                             */
+                            void read_image(binary_image_reader & image) {
+                                m_tm_data = new tm_source_entry_map(image);
+                                m_num_targets = image.read<uint64_t>();
+                                m_targets = const_cast<tm_target_entry *> (image.read_array<tm_target_entry>(m_num_targets));
+                                m_st_uids = const_cast<phrase_uid *> (image.read_array<phrase_uid>(m_num_targets));
+                                m_tm_costs = const_cast<prob_weight *> (image.read_array<prob_weight>(m_num_targets));
+                                m_num_words = const_cast<phrase_length *> (image.read_array<phrase_length>(m_num_targets));
+                                m_num_word_ids = image.read<uint64_t>();
+                                m_word_ids = const_cast<word_uid *> (image.read_array<word_uid>(m_num_word_ids));
+                                m_num_features = image.read<uint64_t>();
+                                m_features = const_cast<prob_weight *> (image.read_array<prob_weight>(m_num_features));
+                                m_phrases_size = image.read<uint64_t>();
+                                m_phrases = const_cast<char *> (image.read_array<char>(m_phrases_size));
+                                m_unk_entry = image.read<tm_source_entry>();
+                                m_weights = image.read<feature_weights>();
+                                //The pools are owned by the image
+                                m_is_mapped = true;
+
+                                //Let the entries know about the pools
+                                set_pools();
+
+                                //Report on the size of the data pools
+                                log_pools_info();
+                            }
+
                         private:
                             //Stores the translation model data
                             tm_source_entry_map * m_tm_data;
-                            //Stores the pointer to the UNK entry
-                            tm_source_entry_ptr m_unk_entry;
+                            //Stores the pool of target entries
+                            tm_target_entry * m_targets;
+                            //Stores the pool of the targets' source/target phrase pair uids, parallel to the targets
+                            phrase_uid * m_st_uids;
+                            //Stores the pool of the targets' total weights, parallel to the targets
+                            prob_weight * m_tm_costs;
+                            //Stores the pool of the targets' numbers of words, parallel to the targets
+                            phrase_length * m_num_words;
+                            //Stores the number of target entries in the pool
+                            size_t m_num_targets;
+                            //Stores the index of the next free target entry in the pool
+                            size_t m_next_target_idx;
+                            //Stores the pool of target phrase word ids
+                            word_uid * m_word_ids;
+                            //Stores the number of word ids in the pool
+                            size_t m_num_word_ids;
+                            //Stores the index of the next free word id in the pool
+                            size_t m_next_word_ids_idx;
+                            //Stores the pool of target phrase features
+                            prob_weight * m_features;
+                            //Stores the number of features in the pool
+                            size_t m_num_features;
+                            //Stores the index of the next free feature in the pool
+                            size_t m_next_features_idx;
+                            //Stores the pool of target phrase characters
+                            char * m_phrases;
+                            //Stores the number of characters in the phrases pool
+                            size_t m_phrases_size;
+                            //Stores the index of the next free character in the phrases pool
+                            size_t m_next_phrase_idx;
+                            //Stores the UNK entry
+                            tm_source_entry m_unk_entry;
+                            //Stores the model weights the target costs are pre-computed with
+                            feature_weights m_weights;
+                            //Stores the flag indicating whether the pools are mapped from an image
+                            bool m_is_mapped;
+
+                            /**
+                             * Allows to set the pools into the source and target entries
+                             */
+                            inline void set_pools() {
+                                tm_source_entry::set_targets_pool(m_targets, m_st_uids, m_tm_costs, m_num_words);
+                                tm_target_entry::set_word_ids_pool(m_word_ids);
+                                tm_target_entry::set_features_pool(m_features);
+                                tm_target_entry::set_phrases_pool(m_phrases);
+                            }
+
+                            /**
+                             * Allows to log the sizes of the data pools
+                             */
+                            inline void log_pools_info() const {
+                                LOG_USAGE << "The translation targets: " << m_num_targets << " entries of "
+                                        << sizeof (tm_target_entry) << " bytes, " << (m_num_targets * sizeof (tm_target_entry))
+                                        << " bytes, hot data: " << (m_num_targets * (sizeof (phrase_uid) + sizeof (prob_weight) + sizeof (phrase_length)))
+                                        << " bytes, word ids: " << (m_num_word_ids * sizeof (word_uid))
+                                        << " bytes, features: " << (m_num_features * sizeof (prob_weight))
+                                        << " bytes, phrases: " << m_phrases_size << " bytes" << END_LOG;
+                            }
+
+                            /**
+                             * Allows to reserve the given number of entries in the targets pool
+                             * @param num_elems the number of target entries to reserve
+                             * @return the index of the first reserved target entry
+                             */
+                            inline size_t reserve_targets(const size_t num_elems) {
+                                ASSERT_SANITY_THROW((m_next_target_idx + num_elems > m_num_targets),
+                                        string("Exceeding the targets pool capacity: ") + to_string(m_num_targets));
+
+                                const size_t targets_idx = m_next_target_idx;
+                                m_next_target_idx += num_elems;
+                                return targets_idx;
+                            }
+
+                            /**
+                             * Allows to copy the given word ids into the word ids pool
+                             * @param num_words the number of word ids to store
+                             * @param word_ids the word ids to store
+                             * @return the index of the first word id in the pool
+                             */
+                            inline uint64_t store_word_ids(const phrase_length num_words, const word_uid * word_ids) {
+                                ASSERT_SANITY_THROW((m_next_word_ids_idx + num_words > m_num_word_ids),
+                                        string("Exceeding the word ids pool capacity: ") + to_string(m_num_word_ids));
+
+                                const uint64_t word_ids_idx = m_next_word_ids_idx;
+                                memcpy(m_word_ids + m_next_word_ids_idx, word_ids, num_words * sizeof (word_uid));
+                                m_next_word_ids_idx += num_words;
+                                return word_ids_idx;
+                            }
+
+                            /**
+                             * Allows to copy the given target phrase features into the features pool
+                             * @param features the features to store, the number of features is that of the model
+                             * @return the index of the features in the pool, counted in the targets' features
+                             */
+                            inline uint32_t store_features(const prob_weight * features) {
+                                const size_t num_features = tm_target_entry::get_num_features();
+                                ASSERT_SANITY_THROW((m_next_features_idx + num_features > m_num_features),
+                                        string("Exceeding the features pool capacity: ") + to_string(m_num_features));
+
+                                const uint32_t features_idx = static_cast<uint32_t> (m_next_features_idx / num_features);
+                                memcpy(m_features + m_next_features_idx, features, num_features * sizeof (prob_weight));
+                                m_next_features_idx += num_features;
+                                return features_idx;
+                            }
+
+                            /**
+                             * Allows to copy the given phrase into the phrases pool
+                             * @param phrase the phrase to store
+                             * @return the index of the phrase in the pool
+                             */
+                            inline uint64_t store_phrase(const string & phrase) {
+                                ASSERT_SANITY_THROW((m_next_phrase_idx + phrase.length() > m_phrases_size),
+                                        string("Exceeding the phrases pool capacity: ") + to_string(m_phrases_size));
+
+                                const uint64_t phrase_idx = m_next_phrase_idx;
+                                memcpy(m_phrases + m_next_phrase_idx, phrase.c_str(), phrase.length());
+                                m_next_phrase_idx += phrase.length();
+                                return phrase_idx;
+                            }
                         };
                     }
                 }
@@ -27,8 +27,6 @@
 #define TM_QUERY_HPP
 
 #include<string>
-#include<unordered_map>
-#include<vector>
 
 #include "common/utils/exceptions.hpp"
 #include "common/utils/logging/logger.hpp"
@@ -50,22 +48,19 @@ namespace uva {
 
                         /**
                          * This class represents a query for the translation model
-                         * In essence it is a map from the source phrases to the
-                         * pointers to maps storing the translations in the target
-                         * language. The query object is not re-usable at the moment
-                         * as during the translation all source translations are
-                         * retrieved once at the beginning of decoding. This query
-                         * is based on hashing, i.e. internally the source phrase
-                         * is stored as a hash value. This might occasionally cause
-                         * collisions, but since this is a local issue it can be
-                         * changed in the future.
+                         * It allows to retrieve the source entries, storing the
+                         * translations in the target language, for the source
+                         * phrases. The query does not keep any data, the retrieved
+                         * source entries are to be stored by the caller, e.g. in
+                         * the sentence data map, where each source phrase span
+                         * is looked up only once. This query is based on hashing,
+                         * i.e. internally the source phrase is stored as a hash
+                         * value. This might occasionally cause collisions, but
+                         * since this is a local issue it can be changed in the future.
                          */
                         template<typename model_type>
                         class tm_query {
                         public:
-                            //Define the query map as a mapping from the source phrase
-                            //id to the pointer to the constant translation data. 
-                            typedef unordered_map<phrase_uid, tm_const_source_entry_ptr> query_map;
 
                             /**
                              * The basic constructor
@@ -81,36 +76,32 @@ namespace uva {
                             }
 
                             /**
-                             * Allows to execute the translation query for the given source phrase.
-                             * This query also keeps the local cache of retrieved source phrase translations.
-                             * @param uid [in] the source phrase uid
-                             * @param entry_ptr [out] the reference to the source entry pointer
-                             * which will be initialized with the found source entry.
+                             * Allows to execute the translation query for a batch of source phrases, e.g. all
+                             * of the sentence phrases ending at the same word. First the hash map buckets of
+                             * all the phrases are prefetched and then the source entries are retrieved, so
+                             * that the memory latencies of the look ups overlap.
+                             * @param num_uids [in] the number of source phrases
+                             * @param uids [in] the source phrase uids
+                             * @param entries [out] the source entry pointers to be set, one per phrase uid,
+                             * if the phrase is not found then it is set to the UNK entry pointer.
                              */
-                            inline void execute(const phrase_uid uid, tm_const_source_entry_ptr & entry_ptr) {
-                                LOG_DEBUG1 << "Requesting the translation for the phrase uid: " << uid << END_LOG;
+                            inline void execute(const size_t num_uids, const phrase_uid * uids, tm_const_source_entry_ptr * entries) const {
+                                //Issue the prefetches for all of the phrases
+                                for (size_t idx = 0; idx < num_uids; ++idx) {
+                                    m_model.prefetch_source_entry(uids[idx]);
+                                }
 
-                                //Check if there has been already retrieved data for this uid
-                                query_map::iterator iter = m_query_data.find(uid);
+                                //Retrieve the source entries
+                                for (size_t idx = 0; idx < num_uids; ++idx) {
+                                    LOG_DEBUG1 << "Requesting the translation for the phrase uid: " << uids[idx] << END_LOG;
 
-                                //If there has not been retrieved anything for this phrase then ask the model                                
-                                if (iter == m_query_data.end()) {
                                     //Search the model and store the pointer to the found entry
-                                    entry_ptr = m_model.template get_source_entry<true>(uid);
-
-                                    //Store the pointer into the local map
-                                    m_query_data[uid] = entry_ptr;
-
-                                    LOG_DEBUG1 << "The translation source entry for: " << uid << " is retrieved!" << END_LOG;
+                                    entries[idx] = m_model.template get_source_entry<true>(uids[idx]);
 
                                     //Perform the sanity check for the sake of safety
-                                    ASSERT_SANITY_THROW((entry_ptr == NULL),
-                                            string("Got a NULL pointer for the ") + to_string(uid) +
+                                    ASSERT_SANITY_THROW((entries[idx] == NULL),
+                                            string("Got a NULL pointer for the ") + to_string(uids[idx]) +
                                             string(" translations, broken translation model implementation!"));
-                                } else {
-                                    LOG_DEBUG1 << "Setting the source entry pointer to the [out] pointer!" << END_LOG;
-                                    //Set the pointer to the proper entry
-                                    entry_ptr = iter->second;
                                 }
                             }
 
@@ -125,23 +116,9 @@ namespace uva {
                                 return m_model.template get_source_entry<false>(uid);
                             }
 
-                            /**
-                             * Allows to get all the source/target phrase identifiers
-                             * for the source target translation in this query.
-                             * Must be called after the query is executed
-                             * @param st_uids the container for the source/target phrase identifiers
-                             */
-                            inline void get_st_uids(vector<phrase_uid> & st_uids) const {
-                                for (query_map::const_iterator iter = m_query_data.begin(); iter != m_query_data.end(); ++iter) {
-                                    iter->second->get_st_uids(st_uids);
-                                }
-                            }
-
                         private:
                             //Stores the reference to the translation model
                             const model_type & m_model;
-                            //Stores the mapping from the source phrase id to the corresponding source entry.
-                            query_map m_query_data;
                         };
                     }
                 }
@@ -0,0 +1,166 @@
+/*
+ * File:   tm_ranking_cache.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 17, 2026, 10:05 PM
+ */
+
+#ifndef TM_RANKING_CACHE_HPP
+#define TM_RANKING_CACHE_HPP
+
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+
+#include "common/utils/threads/threads.hpp"
+
+#include "server/common/models/feature_weights.hpp"
+
+#include "server/tm/models/tm_source_entry.hpp"
+
+using namespace std;
+
+using namespace uva::utils::threads;
+
+using namespace uva::smt::bpbd::server::common::models;
+
+namespace uva {
+    namespace smt {
+        namespace bpbd {
+            namespace server {
+                namespace tm {
+                    namespace models {
+
+                        /**
+                         * This structure stores the ranking of the source entry translations
+                         * under some feature weights, i.e. the indexes of the best targets in
+                         * the best-first order, and the minimum translation cost.
+                         */
+                        struct tm_trans_ranking {
+                            //Stores the minimum translation cost, the cost of the best target
+                            prob_weight m_min_cost;
+                            //Stores the indexes of the best targets within the source entry
+                            vector<uint32_t> m_target_ids;
+                        };
+
+                        /**
+                         * This class caches the rankings of the source entry translations under
+                         * the given feature weights, which differ from the model ones. The targets
+                         * are stored in the best-first order of the model weights, so with other
+                         * weights they are to be re-ranked before the translation limit is applied
+                         * and the minimum translation cost is taken. The cache is shared by the
+                         * sentences of a translation job, and is thread safe.
+                         */
+                        class tm_ranking_cache {
+                        public:
+
+                            /**
+                             * The basic constructor
+                             * @param weights the weights to rank the targets with, must outlive the cache
+                             * @param trans_limit the maximum number of targets to keep, zero for all
+                             */
+                            tm_ranking_cache(const feature_weights & weights, const size_t trans_limit)
+                            : m_weights(weights), m_trans_limit(trans_limit), m_lock(), m_rankings() {
+                            }
+
+                            /**
+                             * Allows to get the weights the targets are ranked with
+                             * @return the weights the targets are ranked with
+                             */
+                            inline const feature_weights & get_weights() const {
+                                return m_weights;
+                            }
+
+                            /**
+                             * Allows to get the translations ranking of the source entry, the ranking is
+                             * computed once and is then cached. This method is synchronized.
+                             * @param entry the source entry, not NULL
+                             * @return the translations ranking of the source entry, stays valid as long as the cache
+                             */
+                            inline const tm_trans_ranking & get_ranking(const tm_source_entry * entry) {
+                                {
+                                    scoped_guard guard(m_lock);
+
+                                    auto iter = m_rankings.find(entry);
+                                    if (iter != m_rankings.end()) {
+                                        return iter->second;
+                                    }
+                                }
+
+                                //Rank the targets without holding the lock, it is the same for all threads
+                                tm_trans_ranking ranking;
+                                rank_targets(entry, ranking);
+
+                                //The map is node based, so the references to the rankings stay valid
+                                scoped_guard guard(m_lock);
+                                return m_rankings.emplace(entry, move(ranking)).first->second;
+                            }
+
+                        private:
+                            //Stores the weights the targets are ranked with
+                            const feature_weights & m_weights;
+                            //Stores the maximum number of targets to keep, zero for all
+                            const size_t m_trans_limit;
+                            //Stores the synchronization mutex
+                            mutex m_lock;
+                            //Stores the source entry to translations ranking mappings
+                            unordered_map<const tm_source_entry *, tm_trans_ranking> m_rankings;
+
+                            /**
+                             * Allows to rank the source entry targets with the cache weights
+                             * @param entry the source entry, not NULL
+                             * @param ranking [out] the ranking to fill in
+                             */
+                            inline void rank_targets(const tm_source_entry * entry, tm_trans_ranking & ranking) const {
+                                const size_t num_targets = entry->num_targets();
+
+                                //Compute the target costs with the cache weights
+                                vector<prob_weight> costs(num_targets);
+                                ranking.m_target_ids.resize(num_targets);
+                                for (size_t idx = 0; idx < num_targets; ++idx) {
+                                    costs[idx] = entry->get_cost(idx, m_weights.m_lm_lambda, &m_weights);
+                                    ranking.m_target_ids[idx] = static_cast<uint32_t> (idx);
+                                }
+
+                                //Order the targets best first, the stable sort keeps the model order of equal costs
+                                stable_sort(ranking.m_target_ids.begin(), ranking.m_target_ids.end(),
+                                        [&costs](const uint32_t first, const uint32_t second) {
+                                            return costs[first] > costs[second];
+                                        });
+
+                                //Apply the translation limit, if any
+                                if ((m_trans_limit > 0) && (num_targets > m_trans_limit)) {
+                                    ranking.m_target_ids.resize(m_trans_limit);
+                                }
+
+                                //The minimum cost, in log space, is the cost of the best target
+                                ranking.m_min_cost = (num_targets > 0) ?
+                                        costs[ranking.m_target_ids[0]] : UNKNOWN_LOG_PROB_WEIGHT;
+                            }
+                        };
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif /* TM_RANKING_CACHE_HPP */
@@ -61,6 +61,14 @@ namespace uva {
                          * Note that the source phrase is not stored, this is to reduce
                          * memory consumption and improve speed. Similar as we did for
                          * the g2dm tried implementation for the language model.
+                         * The target entries are not stored in the source entry but in
+                         * the targets pool of the model, the source entry only keeps the
+                         * index of its first target entry in there. This keeps the entry
+                         * pointer-free so that it can be stored in a binary model image.
+                         * The source/target uids, the total weights and the numbers of
+                         * words of the targets are stored in the parallel pools, at the
+                         * same indexes as the target entries. These are read for every
+                         * translation the decoder considers, so are kept contiguous.
                          */
                         class tm_source_entry {
                         public:
@@ -69,17 +77,7 @@ namespace uva {
                              * The basic constructor
                              */
                             tm_source_entry()
-                            : m_source_uid(UNDEFINED_PHRASE_ID), m_capacity(0), m_targets(NULL), m_next_idx(0), m_min_cost(UNKNOWN_LOG_PROB_WEIGHT) {
-                            }
-
-                            /**
-                             * The basic destructor
-                             */
-                            ~tm_source_entry() {
-                                if (m_targets != NULL) {
-                                    delete[] m_targets;
-                                    m_targets = NULL;
-                                }
+                            : m_source_uid(UNDEFINED_PHRASE_ID), m_capacity(0), m_targets_idx(0), m_next_idx(0), m_min_cost(UNKNOWN_LOG_PROB_WEIGHT) {
                             }
 
                             /**
@@ -113,14 +111,14 @@ namespace uva {
                             }
 
                             /**
-                             * Should be called to start the source entry, i.e. initialize the memory
+                             * Should be called to start the source entry, i.e. reserve the targets memory
+                             * @param targets_idx the index of the first reserved entry in the targets pool
                              * @param capacity the number of translations for this entry
                              */
-                            inline void begin(const size_t capacity) {
-                                //Store the number of translation entries
+                            inline void begin(const size_t targets_idx, const size_t capacity) {
+                                //Store the first target index and the number of translation entries
+                                m_targets_idx = targets_idx;
                                 m_capacity = capacity;
-                                //Instantiate the translations array
-                                m_targets = new tm_target_entry[m_capacity]();
                             }
 
                             /**
@@ -136,60 +134,74 @@ namespace uva {
 
                             /**
                              * Allows to add a new translation to the source entry for the given target phrase
-                             * @param target [in/out] the translation target entry to be moved into the internal data storage
-                             * all the dynamically allocated memory of the entry will be moved to internal storage and set to NULL in the original entry.
+                             * @param target the translation target entry to be copied into the targets pool,
+                             * its target phrase, word ids and features must already be put into the pools.
+                             * @param weights the model weights, to compute the minimum cost with
                              */
-                            inline void emplace_target(tm_tmp_target_entry & target) {
+                            inline void emplace_target(const tm_tmp_target_entry & target, const feature_weights & weights) {
                                 //Perform a sanity check
                                 ASSERT_SANITY_THROW((m_next_idx >= m_capacity),
                                         string("Exceeding the source entry capacity: ") + to_string(m_capacity));
 
-                                //Get the next free entry for the target phrase
-                                tm_target_entry & entry = m_targets[m_next_idx++];
+                                //Get the next free index for the target phrase
+                                const size_t target_idx = m_next_idx++;
+                                const size_t pool_idx = m_targets_idx + target_idx;
 
                                 //Copy the data from the given target entry to storage
-                                entry.move_from(target);
+                                TARGETS_POOL[pool_idx] = target;
+                                ST_UIDS_POOL[pool_idx] = target.get_st_uid();
+                                TM_COSTS_POOL[pool_idx] = target.get_tm_cost();
+                                NUM_WORDS_POOL[pool_idx] = target.get_num_words();
 
                                 //Compute the minimum cost which in log space is a maximum value
-                                update_minimum_cost(entry, target.get_lm_weight());
+                                m_min_cost = max(m_min_cost, get_cost(target_idx, weights.m_lm_lambda, NULL));
                             }
 
                             /**
                              * Allows to add a new translation to the source entry for the given target phrase
-                             * @param target the target phrase string 
+                             * @param phrase_idx the index of the target phrase in the phrases pool
+                             * @param phrase_len the length of the target phrase in the phrases pool
                              * @param target_uid the uid of the target phrase
-                             * @param features the features to put into the entry
+                             * @param features the log_e features to compute the entry weight from
+                             * @param features_idx the index of the features for the target phrase in the features pool
                              * @param num_words the number of words in the target translation
-                             * @param word_ids the LM word ids for the target phrase
-                             * @param wp_lambda the word penalty lambda weight
-                             * @param lm_weight the cost of the target translation from the LM model
-                             * @param pure_features the feature values without the lambda weights,
-                             *        to be stored for server tuning mode, default is NULL
+                             * @param word_ids_idx the index of the LM word ids for the target phrase in the word ids pool
+                             * @param lm_weight the cost of the target translation from the LM model, without the lambda
+                             * @param weights the model weights
                              */
-                            inline void add_target(const string & target, const phrase_uid target_uid,
-                                    const prob_weight * features, const phrase_length num_words,
-                                    const word_uid * word_ids, const prob_weight wp_lambda,
-                                    const prob_weight lm_weight, const prob_weight * pure_features = NULL) {
+                            inline void add_target(const uint64_t phrase_idx, const uint32_t phrase_len, const phrase_uid target_uid,
+                                    const prob_weight * features, const uint32_t features_idx, const phrase_length num_words,
+                                    const uint64_t word_ids_idx, const prob_weight lm_weight, const feature_weights & weights) {
                                 //Perform a sanity check
                                 ASSERT_SANITY_THROW((m_next_idx >= m_capacity),
                                         string("Exceeding the source entry capacity: ") + to_string(m_capacity));
 
-                                //Get the next free entry for the target phrase
-                                tm_target_entry & entry = m_targets[m_next_idx++];
+                                //Get the next free index for the target phrase
+                                const size_t target_idx = m_next_idx++;
+                                const size_t pool_idx = m_targets_idx + target_idx;
+
+                                //Set the entry's target phrase, word ids, features and language model weight
+                                tm_target_entry & entry = TARGETS_POOL[pool_idx];
+                                entry.set_phrase(phrase_idx, phrase_len);
+                                entry.set_word_ids_idx(word_ids_idx);
+                                entry.set_features_idx(features_idx);
+                                entry.set_lm_weight(lm_weight);
 
-                                //Set the entry's target phrase and its id
-                                entry.set_data(m_source_uid, target, target_uid,
-                                        features, num_words, word_ids,
-                                        wp_lambda, pure_features);
+                                //Set the source/target phrase id, the total weight and the number of words
+                                ST_UIDS_POOL[pool_idx] = combine_phrase_uids(m_source_uid, target_uid);
+                                TM_COSTS_POOL[pool_idx] = tm_target_entry::get_total_weight(features, num_words, weights);
+                                NUM_WORDS_POOL[pool_idx] = num_words;
 
                                 //Compute the minimum cost which in log space is a maximum value
-                                update_minimum_cost(entry, lm_weight);
+                                m_min_cost = max(m_min_cost, get_cost(target_idx, weights.m_lm_lambda, NULL));
                             }
 
                             /**
                              * Allows to get the minimum translation cost for the given
                              * source phrase, i.e what we have is:
                              *      "log_10(maximum_t(P_tm(t|s)*P_lm(t)))
+                             * The cost is pre-computed with the model weights, for the other
+                             * weights the decoder ranks the targets per job, see tm_ranking_cache
                              * @return the minimum translation cost for the given source phrase
                              */
                             inline prob_weight get_min_cost() const {
@@ -214,10 +226,9 @@ namespace uva {
                                 LOG_DEBUG1 << "The source/target id is " << m_st_uid << END_LOG;
 
                                 //Search for the uid in the array
+                                const phrase_uid * st_uids = ST_UIDS_POOL + m_targets_idx;
                                 for (size_t idx = 0; idx < m_capacity; ++idx) {
-                                    LOG_DEBUG1 << "The source/target translation for "
-                                            << m_st_uid << " is found!" << END_LOG;
-                                    if (m_targets[idx].get_st_uid() == m_st_uid) {
+                                    if (st_uids[idx] == m_st_uid) {
                                         LOG_DEBUG1 << "The source/target translation for "
                                                 << m_st_uid << " is found!" << END_LOG;
 
@@ -231,17 +242,6 @@ namespace uva {
                                 return false;
                             }
 
-                            /**
-                             * Allows to get all the source/target phrase identifiers
-                             * for the source target translation in this query.
-                             * @param st_uids the container for the source/target phrase identifiers
-                             */
-                            inline void get_st_uids(vector<phrase_uid> & st_uids) const {
-                                for (size_t idx = 0; idx < m_capacity; ++idx) {
-                                    st_uids.push_back(m_targets[idx].get_st_uid());
-                                }
-                            }
-
                             /**
                              * The comparison operator, allows to compare source entries
                              * @param phrase_uid the unique identifier of the source entry to compare with
@@ -273,35 +273,122 @@ namespace uva {
                              * @return the pointer to the first target entry, or NULL if none
                              */
                             tm_const_target_entry* get_targets() const {
-                                return m_targets;
+                                return TARGETS_POOL + m_targets_idx;
+                            }
+
+                            /**
+                             * Allows to retrieve the source/target phrase pair uid of the given target
+                             * @param target_idx the index of the target within this source entry
+                             * @return the source/target phrase pair uid
+                             */
+                            inline phrase_uid get_st_uid(const size_t target_idx) const {
+                                return ST_UIDS_POOL[m_targets_idx + target_idx];
+                            }
+
+                            /**
+                             * Allows to check whether the given target is the unknown translation
+                             * @param target_idx the index of the target within this source entry
+                             * @return true if this is UNK translation, otherwise false
+                             */
+                            inline bool is_unk_trans(const size_t target_idx) const {
+                                return (get_st_uid(target_idx) == tm_target_entry::UNKNOWN_TARGET_ENTRY_UID);
+                            }
+
+                            /**
+                             * Allows to get the number of words in the given target translation
+                             * @param target_idx the index of the target within this source entry
+                             * @return the number of words
+                             */
+                            inline phrase_length get_num_words(const size_t target_idx) const {
+                                return NUM_WORDS_POOL[m_targets_idx + target_idx];
+                            }
+
+                            /**
+                             * Allows to get the total weight of the given target, the weighted sum of
+                             * the log_e features and the word penalty.
+                             * @tparam is_consider_scores if true then the scores will be considered in the tuning mode
+                             * @param target_idx the index of the target within this source entry
+                             * @param weights the weights to compute the total weight with, if NULL
+                             *                then the weight pre-computed with the model weights is used
+                             * @param scores the pointer to the array of feature scores that is to 
+                             *               be filled in, unless the provided pointer is NULL.
+                             * @return the total weight of the target, the sum of feature weights
+                             */
+                            template<bool is_consider_scores = true >
+                            inline prob_weight get_tm_cost(const size_t target_idx, const feature_weights * weights,
+                                    prob_weight * scores = NULL) const {
+#if IS_SERVER_TUNING_MODE
+                                if (is_consider_scores) {
+                                    const size_t num_features = tm_target_entry::get_num_features();
+                                    const prob_weight * features = get_targets()[target_idx].get_features();
+                                    LOG_DEBUG1 << this << ": The features: "
+                                            << array_to_string<prob_weight>(num_features, features) << END_LOG;
+                                    ASSERT_SANITY_THROW((scores == NULL), string("The scores pointer is NULL!"));
+                                    for (size_t idx = 0; idx != num_features; ++idx) {
+                                        scores[tm_parameters::TM_WEIGHT_GLOBAL_IDS[idx]] = features[idx];
+                                        LOG_DEBUG2 << tm_parameters::TM_WEIGHT_NAMES[idx] << " = " << features[idx] << END_LOG;
+                                    }
+                                    //Store the pure word penalty
+                                    scores[tm_parameters::TM_WP_LAMBDA_GLOBAL_ID] = -1 * get_num_words(target_idx);
+                                }
+#endif
+                                return (weights == NULL) ? TM_COSTS_POOL[m_targets_idx + target_idx] :
+                                        tm_target_entry::get_total_weight(get_targets()[target_idx].get_features(),
+                                        get_num_words(target_idx), *weights);
+                            }
+
+                            /**
+                             * Allows to compute the translation cost estimate of the given target.
+                             * We use the total weight (including the phrase penalty) the language model cost of
+                             * the target phrase, and the word penalty
+                             * @param target_idx the index of the target within this source entry
+                             * @param lm_lambda the language model weight
+                             * @param weights the weights to compute the translation cost with, NULL for the model ones
+                             * @return the translation cost estimate of the target
+                             */
+                            inline prob_weight get_cost(const size_t target_idx,
+                                    const prob_weight lm_lambda, const feature_weights * weights) const {
+                                return get_tm_cost<false>(target_idx, weights) + lm_lambda * get_targets()[target_idx].get_lm_weight();
+                            }
+
+                            /**
+                             * Allows to set the pools the target entries and their data are stored
+                             * in, must be called by the model once the pools are allocated or mapped,
+                             * the pools are parallel, the data of a target is at the same index.
+                             * @param targets_pool the targets pool of the model
+                             * @param st_uids_pool the source/target phrase pair uids pool of the model
+                             * @param tm_costs_pool the targets' total weights pool of the model
+                             * @param num_words_pool the targets' numbers of words pool of the model
+                             */
+                            static void set_targets_pool(tm_target_entry * targets_pool, phrase_uid * st_uids_pool,
+                                    prob_weight * tm_costs_pool, phrase_length * num_words_pool) {
+                                TARGETS_POOL = targets_pool;
+                                ST_UIDS_POOL = st_uids_pool;
+                                TM_COSTS_POOL = tm_costs_pool;
+                                NUM_WORDS_POOL = num_words_pool;
                             }
 
                         private:
+                            //Stores the pool of target entries, there is just one
+                            //translation model so the pool is shared by all entries
+                            static tm_target_entry * TARGETS_POOL;
+                            //Stores the pool of the targets' source/target phrase pair uids
+                            static phrase_uid * ST_UIDS_POOL;
+                            //Stores the pool of the targets' total weights computed with the model weights
+                            static prob_weight * TM_COSTS_POOL;
+                            //Stores the pool of the targets' numbers of words
+                            static phrase_length * NUM_WORDS_POOL;
+
                             //Stores the unique identifier of the given source
                             phrase_uid m_source_uid;
                             //Stores the number of translation entries
                             size_t m_capacity;
-                            //Stores the target entries array pointer
-                            tm_target_entry * m_targets;
+                            //Stores the index of the first target entry in the targets pool
+                            size_t m_targets_idx;
                             //Stores the next index for the translation entry
                             size_t m_next_idx;
                             //Stores the maximum cost of all translations
                             prob_weight m_min_cost;
-
-                            /**
-                             * Allows to compute/estimate the minimum translation cost of the given source entry.
-                             * We use the total weight (including the phrase penalty) the language model cost of
-                             * the target phrase, and the word penalty
-                             * @param entry the target entry to consider
-                             * @param lm_weight the language model weight of the given target entry
-                             */
-                            inline void update_minimum_cost(tm_target_entry & entry, const prob_weight lm_weight) {
-                                //Compute the cost for the new entry
-                                const prob_weight new_cost = entry.get_tm_cost<false>() + lm_weight;
-                                
-                                //Take the minimum of the two costs
-                                m_min_cost = max(m_min_cost, new_cost);
-                            }
                         };
 
                         //Define the constant source entry
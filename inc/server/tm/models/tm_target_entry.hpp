@@ -36,9 +36,12 @@
 #include "server/lm/proxy/lm_fast_query_proxy.hpp"
 
 #include "server/common/models/phrase_uid.hpp"
+#include "server/common/models/feature_weights.hpp"
 
 #include "server/tm/tm_parameters.hpp"
 
+#include "server/rm/models/rm_entry.hpp"
+
 using namespace std;
 
 using namespace uva::utils::exceptions;
@@ -47,6 +50,7 @@ using namespace uva::utils::hashing;
 
 using namespace uva::smt::bpbd::server::common::models;
 using namespace uva::smt::bpbd::server::lm::proxy;
+using namespace uva::smt::bpbd::server::rm::models;
 
 namespace uva {
     namespace smt {
@@ -59,10 +63,19 @@ namespace uva {
                          * This structure represents the translation data, i.e. the
                          * the target phrase plus the probability weights. See:
                          * http://www.statmt.org/moses/?n=FactoredTraining.ScorePhrases
-                         * for more details on the weights. Note that for this entry
-                         * we have a uid that is a unique identifier of the target
-                         * phrase string. The latter can be a hash value but then
-                         * there is a possibility for the hash collisions
+                         * for more details on the weights. The entry refers to its
+                         * reordering model entry, so that the reordering weights of
+                         * a translation are available without any lookups. The
+                         * features are stored without the lambda weights, any weights
+                         * other than the model ones are applied when the translation
+                         * is scored. The data needed for every translation considered
+                         * by the decoder: the source/target phrase pair uid, the total
+                         * weight pre-computed with the model weights and the number of
+                         * words, is not stored in here but in the parallel pools of the
+                         * model, see tm_source_entry, at the same index as the entry.
+                         * This way scanning the translations of a source phrase reads
+                         * contiguous memory. The entry itself is only read when the
+                         * translation is expanded into a new hypothesis.
                          */
                         class tm_target_entry {
                         public:
@@ -73,165 +86,148 @@ namespace uva {
                              * The basic constructor
                              */
                             tm_target_entry()
-                            : m_target_phrase(""), m_num_words(0), m_word_ids(NULL),
-                            m_st_uid(UNDEFINED_PHRASE_ID), m_total_weight(UNKNOWN_LOG_PROB_WEIGHT) {
+                            : m_rm_entry_idx(0), m_features_idx(0), m_word_ids_idx(0),
+                            m_lm_weight(0.0), m_phrase_len(0), m_phrase_idx(0) {
                                 //Check that the number of features is set
                                 ASSERT_SANITY_THROW((NUMBER_OF_TM_FEATURES == 0),
                                         "The NUMBER_OF_TM_FEATURES has not been set!");
-#if IS_SERVER_TUNING_MODE
-                                m_pure_features = NULL;
-#endif                        
                             }
 
                             /**
-                             * The basic destructor
+                             * Allows to set the language model weight of the target phrase
+                             * @param lm_weight the language model log_e probability of the target, without the lambda
                              */
-                            ~tm_target_entry() {
-                                //Deallocate the word ids
-                                if (m_word_ids != NULL) {
-                                    delete[] m_word_ids;
-                                    m_word_ids = NULL;
-                                }
-#if IS_SERVER_TUNING_MODE
-                                if (m_pure_features != NULL) {
-                                    delete m_pure_features;
-                                    m_pure_features = NULL;
-                                }
-#endif
+                            inline void set_lm_weight(const prob_weight lm_weight) {
+                                m_lm_weight = lm_weight;
                             }
 
                             /**
-                             * Allows to set the target phrase and its id
-                             * @param source_uid store the source uid for being combined with the
-                             *                   target phrase into the source/target pair uid
-                             * @param target_phrase the target phrase
-                             * @param target_uid the uid of the target phrase
-                             * @param features the weights to be set into the entry
-                             * @param num_words the number of words in the target translation
-                             * @param word_ids the LM word ids for the target phrase 
-                             * @param wp_lambda the word penalty lambda weight
-                             * @param pure_features the feature values without the lambda weights,
-                             *        to be stored for server tuning mode, default is NULL
+                             * Allows to set the location of the target phrase in the phrases pool
+                             * @param phrase_idx the index of the first target phrase character in the pool
+                             * @param phrase_len the number of target phrase characters
                              */
-                            inline void set_data(const phrase_uid source_uid,
-                                    const string & target_phrase, const phrase_uid target_uid,
-                                    const prob_weight * features, const phrase_length num_words,
-                                    const word_uid * word_ids, const prob_weight wp_lambda,
-                                    const prob_weight * pure_features = NULL) {
-                                //Store the target phrase
-                                m_target_phrase = target_phrase;
+                            inline void set_phrase(const uint64_t phrase_idx, const uint32_t phrase_len) {
+                                m_phrase_idx = phrase_idx;
+                                m_phrase_len = phrase_len;
+                            }
 
-                                //Store the number of words and the corresponding word ids
-                                m_num_words = num_words;
-                                m_word_ids = new word_uid[m_num_words];
-                                memcpy(m_word_ids, word_ids, m_num_words * sizeof (word_uid));
+                            /**
+                             * Allows to set the location of the target phrase word ids in the word ids pool,
+                             * the number of word ids is the number of target phrase words.
+                             * @param word_ids_idx the index of the first target phrase word id in the pool
+                             */
+                            inline void set_word_ids_idx(const uint64_t word_ids_idx) {
+                                m_word_ids_idx = word_ids_idx;
+                            }
 
-                                //Compute and store the source/target phrase uid
-                                m_st_uid = combine_phrase_uids(source_uid, target_uid);
+                            /**
+                             * Allows to set the location of the target phrase features in the features pool,
+                             * the number of features is the number of features of the model.
+                             * @param features_idx the index of the target phrase features in the pool, counted
+                             *                     in the targets' features, i.e. in the number of model features
+                             */
+                            inline void set_features_idx(const uint32_t features_idx) {
+                                m_features_idx = features_idx;
+                            }
 
-                                //Set the features 
-                                set_features(features, wp_lambda, pure_features);
+                            /**
+                             * Allows to set the index of the reordering model entry of this translation
+                             * @param rm_entry_idx the index of the entry in the reordering entries pool
+                             */
+                            inline void set_rm_entry_idx(const uint32_t rm_entry_idx) {
+                                m_rm_entry_idx = rm_entry_idx;
+                            }
 
-                                LOG_DEBUG1 << "Adding the source/target (" << source_uid << "/"
-                                        << target_uid << ") entry with id" << m_st_uid << END_LOG;
+                            /**
+                             * Allows to get the reordering model entry of this translation,
+                             * for an unknown source/target pair it is the UNK/UNK entry.
+                             * @return the reordering model entry of this translation
+                             */
+                            inline const rm_entry & get_rm_entry() const {
+                                return RM_ENTRIES_POOL[m_rm_entry_idx];
                             }
 
                             /**
-                             * This method allows to move the data from the given target entry to this one.
-                             * The dynamically allocated data from the given entry is moved to this one,
-                             * the rest is copied.
-                             * @param other the other entry to move the values from
+                             * Allows to get the target phrase
+                             * @return the target phrase taken from the phrases pool
                              */
-                            inline void move_from(tm_target_entry & other) {
-                                //Copy the target phrase
-                                m_target_phrase = other.m_target_phrase;
-
-                                //Copy the number of words in the source phrase and the word ids
-                                m_num_words = other.m_num_words;
-                                m_word_ids = other.m_word_ids;
-
-                                //Set the word ids to null so that the original
-                                //class can not modify/destroy it.
-                                other.m_word_ids = NULL;
-
-                                //Copy the source/target uid
-                                m_st_uid = other.m_st_uid;
-                                //Copy the total weight
-                                m_total_weight = other.m_total_weight;
-
-#if IS_SERVER_TUNING_MODE
-                                m_pure_features = other.m_pure_features;
-                                //Make sure the features in the target
-                                //entry we move from are discarded
-                                other.m_pure_features = NULL;
-#endif
+                            string get_target_phrase() const {
+                                return string(PHRASES_POOL + m_phrase_idx, m_phrase_len);
                             }
 
                             /**
-                             * Allows to check whether this is an unknown translation
-                             * @return true if this is UNK translation, otherwise false
+                             * Allows to get the language model weight of the target phrase
+                             * @return the language model log_e probability of the target, without the lambda
                              */
-                            bool is_unk_trans() const {
-                                return (m_st_uid == UNKNOWN_TARGET_ENTRY_UID);
+                            inline prob_weight get_lm_weight() const {
+                                return m_lm_weight;
                             }
 
                             /**
-                             * Allows to get the target phrase
-                             * @return the reference to the const target phrase
+                             * Allows to get the log_e features of the target phrase
+                             * @return the pointer to the features in the features pool, without the lambda
+                             *         weights, the number of features is the number of features of the model
                              */
-                            const string & get_target_phrase() const {
-                                return m_target_phrase;
+                            inline const prob_weight * get_features() const {
+                                return FEATURES_POOL + static_cast<size_t> (m_features_idx) * NUMBER_OF_TM_FEATURES;
                             }
 
                             /**
-                             * Allows to retrieve the source/target phrase pair uid
-                             * @return the source/target phrase pair uid
+                             * This method allows to get the LM word ids of the target phrase
+                             * @return an array of word ids of the target phrase taken from the word ids pool,
+                             *         the length is equal to the number of target phrase words
                              */
-                            inline const phrase_uid get_st_uid() const {
-                                return m_st_uid;
+                            inline const word_uid* get_word_ids() const {
+                                return WORD_IDS_POOL + m_word_ids_idx;
                             }
 
                             /**
-                             * Allows to get the total weight of the entry, the sum of features 
-                             * that are turned into log_e scale and the word penalty.
-                             * @tparam is_consider_scores if true then the scores will be considered in the tuning mode
-                             * @param scores the pointer to the array of feature scores that is to 
-                             *               be filled in, unless the provided pointer is NULL.
-                             * @return the total weight of the entry, the sum of feature weights
+                             * Allows to compute the total weight of a translation for the given features and weights.
+                             * @param features the log_e features of the translation
+                             * @param num_words the number of words in the target translation
+                             * @param weights the weights to apply to the features and the word penalty
+                             * @return the weighted sum of features minus the weighted number of words
                              */
-                            template<bool is_consider_scores = true >
-                            inline const prob_weight get_tm_cost(prob_weight * scores = NULL) const {
-#if IS_SERVER_TUNING_MODE
-                                if (is_consider_scores) {
-                                    ASSERT_SANITY_THROW((NUMBER_OF_TM_FEATURES == 0), string("The number of features is zero!"));
-                                    LOG_DEBUG1 << this << ": The features: "
-                                            << array_to_string<prob_weight>(NUMBER_OF_TM_FEATURES, m_pure_features) << END_LOG;
-                                    ASSERT_SANITY_THROW((scores == NULL), string("The scores pointer is NULL!"));
-                                    for (int8_t idx = 0; idx != NUMBER_OF_TM_FEATURES; ++idx) {
-                                        scores[tm_parameters::TM_WEIGHT_GLOBAL_IDS[idx]] = m_pure_features[idx];
-                                        LOG_DEBUG2 << tm_parameters::TM_WEIGHT_NAMES[idx] << " = " << m_pure_features[idx] << END_LOG;
-                                    }
-                                    //Store the pure word penalty
-                                    scores[tm_parameters::TM_WP_LAMBDA_GLOBAL_ID] = -1 * m_num_words;
-                                }
-#endif
-                                return m_total_weight;
+                            static inline prob_weight get_total_weight(const prob_weight * features,
+                                    const phrase_length num_words, const feature_weights & weights) {
+                                return dot_product(NUMBER_OF_TM_FEATURES, features, weights.m_tm_lambdas) -
+                                        weights.m_wp_lambda * num_words;
                             }
 
                             /**
-                             * Allows to get the number of words in the target translation
-                             * @return the number of words
+                             * Allows to set the pool the target phrases are stored in, must be
+                             * called by the model once the phrases pool is (re-)allocated
+                             * @param phrases_pool the phrases pool of the model
                              */
-                            inline phrase_length get_num_words() const {
-                                return m_num_words;
+                            static void set_phrases_pool(const char * phrases_pool) {
+                                PHRASES_POOL = phrases_pool;
                             }
 
                             /**
-                             * This method allows to get the
-                             * @return an array of word ids of the target phrase, the length must be equal to LM_QUERY_LENGTH_MAX
+                             * Allows to set the pool the target phrase word ids are stored in, must
+                             * be called by the model once the word ids pool is (re-)allocated
+                             * @param word_ids_pool the word ids pool of the model
                              */
-                            inline const word_uid* get_word_ids() const {
-                                return m_word_ids;
+                            static void set_word_ids_pool(const word_uid * word_ids_pool) {
+                                WORD_IDS_POOL = word_ids_pool;
+                            }
+
+                            /**
+                             * Allows to set the pool the target phrase features are stored in, must
+                             * be called by the model once the features pool is (re-)allocated
+                             * @param features_pool the features pool of the model
+                             */
+                            static void set_features_pool(const prob_weight * features_pool) {
+                                FEATURES_POOL = features_pool;
+                            }
+
+                            /**
+                             * Allows to set the pool the reordering entries are stored in, must
+                             * be called by the reordering model once it is built or mapped
+                             * @param rm_entries_pool the reordering entries pool
+                             */
+                            static void set_rm_entries_pool(const rm_entry * rm_entries_pool) {
+                                RM_ENTRIES_POOL = rm_entries_pool;
                             }
 
                             /**
@@ -260,74 +256,37 @@ namespace uva {
                                 NUMBER_OF_TM_FEATURES = num_features;
                             }
 
-                        protected:
-
-                            /**
-                             * Allows to set the weights into the target entry.
-                             * \todo Get rid of magic constants in this function!
-                             * @param features the weights to be set into the entry
-                             * @param wp_lambda the word penalty lambda weight
-                             * @param pure_features the feature values without the lambda weights,
-                             *        to be stored for server tuning mode, default is NULL
-                             * This is an array of translation weights, as we have here:
-                             * features[0] = lambda_0 * p(f|e);
-                             * features[1] = lambda_1 * lex(p(f|e));
-                             * features[2] = lambda_2 * p(e|f);
-                             * features[3] = lambda_3 * lex(p(e|f));
-                             * features[4] = lambda_4 * phrase penalty;
-                             */
-                            inline void set_features(const prob_weight * features, const prob_weight wp_lambda, const prob_weight * pure_features = NULL) {
-#if IS_SERVER_TUNING_MODE
-                                //Check that the pure features list is present
-                                ASSERT_SANITY_THROW((pure_features == NULL), "The pure_features is NULL!");
-
-                                //Allocate the features storage
-                                m_pure_features = new prob_weight[NUMBER_OF_TM_FEATURES]();
-                                //Store the individual feature weights
-                                memcpy(m_pure_features, pure_features, sizeof (prob_weight) * NUMBER_OF_TM_FEATURES);
-
-                                LOG_DEBUG1 << this << ": The features: "
-                                        << array_to_string<prob_weight>(NUMBER_OF_TM_FEATURES, m_pure_features) << END_LOG;
-#endif
-
-                                //Compute the total weight
-                                m_total_weight = 0.0; //First re-set to zero
-                                for (int8_t idx = 0; idx < NUMBER_OF_TM_FEATURES; ++idx) {
-                                    m_total_weight += features[idx];
-                                }
-
-                                //Add the word penalty to the total score!
-                                m_total_weight -= wp_lambda * m_num_words;
-
-                                //Check that we have enough features
-                                //ToDo: Why 3 and 2, later on? We shall change this into
-                                //      a constant and this kind of check is also bogus ...
-                                ASSERT_SANITY_THROW((NUMBER_OF_TM_FEATURES < 3),
-                                        "The must be at least 3 features, p(e|f) is not known!");
-                            }
-
                         private:
                             //Stores the number of weights constant for the reordering entry
                             //This value is initialized before the RM model is loaded
                             static int8_t NUMBER_OF_TM_FEATURES;
-
-                            //Stores the target phrase of the translation which a key value
-                            string m_target_phrase;
-                            //Stores the number of words in the translation, maximum should be TM_MAX_TARGET_PHRASE_LEN
-                            phrase_length m_num_words;
-                            //Stores the target phrase Language model word ids 
-                            word_uid * m_word_ids;
-
-                            //Stores the source/target phrase id
-                            phrase_uid m_st_uid;
-
-                            //Stores the total features weight of the entity
-                            prob_weight m_total_weight;
-
-#if IS_SERVER_TUNING_MODE
-                            //Stores the the features
-                            prob_weight * m_pure_features;
-#endif                            
+                            //Stores the pool of the target phrase characters, the entries
+                            //store the indexes thereof, so that the entries are pointer-free
+                            //and can be stored in and mapped from a binary model image
+                            static const char * PHRASES_POOL;
+                            //Stores the pool of the target phrase Language model word ids
+                            static const word_uid * WORD_IDS_POOL;
+                            //Stores the pool of the target phrase features
+                            static const prob_weight * FEATURES_POOL;
+                            //Stores the pool of the reordering model entries
+                            static const rm_entry * RM_ENTRIES_POOL;
+
+                            //The data used when expanding the hypothesis goes first, the target
+                            //phrase location is only needed when the translation is rendered.
+
+                            //Stores the index of the reordering entry in the reordering entries pool
+                            uint32_t m_rm_entry_idx;
+                            //Stores the index of the target phrase features in the features pool, counted in the
+                            //targets' features so that the pool can have the features of up to 4G targets
+                            uint32_t m_features_idx;
+                            //Stores the index of the target phrase word ids in the word ids pool
+                            uint64_t m_word_ids_idx;
+                            //Stores the language model weight of the target, without the lambda
+                            prob_weight m_lm_weight;
+                            //Stores the length of the target phrase in the phrases pool
+                            uint32_t m_phrase_len;
+                            //Stores the index of the target phrase in the phrases pool
+                            uint64_t m_phrase_idx;
                         };
 
                         //Define the constant entry
@@ -345,7 +304,9 @@ namespace uva {
                             /**
                              * The basic constructor
                              */
-                            tm_tmp_target_entry() : tm_target_entry() {
+                            tm_tmp_target_entry()
+                            : tm_target_entry(), m_st_uid(UNDEFINED_PHRASE_ID), m_total_weight(UNKNOWN_LOG_PROB_WEIGHT),
+                            m_num_words(0), m_tmp_target_phrase(""), m_tmp_word_ids(), m_tmp_features() {
                                 //Nothing to be done here
                             }
                             
@@ -366,33 +327,125 @@ namespace uva {
                             }
 
                             /**
-                             * Allows to set the language model weight of the target
-                             * @param lm_target_weight the language model weight of the target
+                             * Allows to set the target phrase id and the entry data, the features are kept
+                             * until they are put into the features pool. Also computes the total weight plus
+                             * the weighted language model probability of the target, which is used for
+                             * ordering the entries.
+                             * @param source_uid store the source uid for being combined with the
+                             *                   target phrase into the source/target pair uid
+                             * @param target_uid the uid of the target phrase
+                             * @param features the log_e feature values, without the lambda weights
+                             * @param num_words the number of words in the target translation
+                             * @param lm_weight the language model log_e probability of the target, without the lambda
+                             * @param weights the model weights to pre-compute the total weight with
                              */
-                            inline void set_lm_weight(const prob_weight lm_target_weight) {
-                                //Store the lambda weight
-                                m_lm_weight = lm_target_weight;
-                                //Compute the local total weight based on the tm weight
-                                //of the super class and the lm target weight as given
-                                m_total_weight_plus = this->get_tm_cost<false>() + m_lm_weight;
+                            inline void set_data(const phrase_uid source_uid, const phrase_uid target_uid,
+                                    const prob_weight * features, const phrase_length num_words,
+                                    const prob_weight lm_weight, const feature_weights & weights) {
+                                //Store the number of words, the word ids are set separately
+                                ASSERT_SANITY_THROW((num_words > TM_MAX_TARGET_PHRASE_LEN),
+                                        string("The number of target phrase words: ") + to_string(num_words) +
+                                        string(" exceeds the maximum: ") + to_string(TM_MAX_TARGET_PHRASE_LEN));
+                                m_num_words = num_words;
+
+                                //Compute and store the source/target phrase uid
+                                m_st_uid = combine_phrase_uids(source_uid, target_uid);
+
+                                //Store the language model weight
+                                set_lm_weight(lm_weight);
+
+                                //Pre-compute the total weight with the model weights
+                                m_total_weight = get_total_weight(features, num_words, weights);
+
+                                memcpy(m_tmp_features, features, get_num_features() * sizeof (prob_weight));
+                                m_total_weight_plus = m_total_weight + weights.m_lm_lambda * lm_weight;
+
+                                LOG_DEBUG1 << "Adding the source/target (" << source_uid << "/"
+                                        << target_uid << ") entry with id" << m_st_uid << END_LOG;
                             }
-                            
+
                             /**
-                             * Allows to retrieve the lm model weight of the target 
-                             * @return  the lm model weight of the target 
+                             * Allows to retrieve the source/target phrase pair uid
+                             * @return the source/target phrase pair uid
                              */
-                            inline prob_weight get_lm_weight() const {
-                                return m_lm_weight;
+                            inline phrase_uid get_st_uid() const {
+                                return m_st_uid;
+                            }
+
+                            /**
+                             * Allows to get the total weight of the entry pre-computed with the model weights
+                             * @return the weighted sum of the log_e features and the word penalty
+                             */
+                            inline prob_weight get_tm_cost() const {
+                                return m_total_weight;
+                            }
+
+                            /**
+                             * Allows to get the number of words in the target translation
+                             * @return the number of words
+                             */
+                            inline phrase_length get_num_words() const {
+                                return m_num_words;
+                            }
+
+                            /**
+                             * Allows to get the target phrase features that are not yet put into the features pool
+                             * @return the target phrase features
+                             */
+                            inline const prob_weight * get_tmp_features() const {
+                                return m_tmp_features;
+                            }
+
+                            /**
+                             * Allows to set the target phrase until it is put into the phrases pool
+                             * @param target_phrase the target phrase
+                             */
+                            inline void set_tmp_target_phrase(const string & target_phrase) {
+                                m_tmp_target_phrase = target_phrase;
+                            }
+
+                            /**
+                             * Allows to get the target phrase that is not yet put into the phrases pool
+                             * @return the target phrase
+                             */
+                            inline const string & get_tmp_target_phrase() const {
+                                return m_tmp_target_phrase;
+                            }
+
+                            /**
+                             * Allows to set the target phrase word ids until they are put into the word ids pool
+                             * @param word_ids the LM word ids of the target phrase, as many as the number of words
+                             */
+                            inline void set_tmp_word_ids(const word_uid * word_ids) {
+                                memcpy(m_tmp_word_ids, word_ids, get_num_words() * sizeof (word_uid));
+                            }
+
+                            /**
+                             * Allows to get the target phrase word ids that are not yet put into the word ids pool
+                             * @return the target phrase word ids
+                             */
+                            inline const word_uid * get_tmp_word_ids() const {
+                                return m_tmp_word_ids;
                             }
                             
                         private:
+                            //Stores the source/target phrase id
+                            phrase_uid m_st_uid;
+                            //Stores the total features weight of the entity, computed with the model weights
+                            prob_weight m_total_weight;
+                            //Stores the number of words in the translation, maximum should be TM_MAX_TARGET_PHRASE_LEN
+                            phrase_length m_num_words;
+                            //Stores the target phrase until it is put into the phrases pool
+                            string m_tmp_target_phrase;
+                            //Stores the target phrase word ids until they are put into the word ids pool
+                            word_uid m_tmp_word_ids[TM_MAX_TARGET_PHRASE_LEN];
+                            //Stores the target phrase features until they are put into the features pool
+                            feature_array m_tmp_features;
+
                             //Stores the total weight of the entity which is: 
                             //The total weight of the translation entry plus
                             //the language model joint probability of the target
                             prob_weight m_total_weight_plus;
-                            
-                            //Stores the language model weight of the target
-                            prob_weight m_lm_weight;
                         };
                     }
                 }
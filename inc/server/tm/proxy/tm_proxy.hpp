@@ -27,6 +27,9 @@
 #define TM_PROXY_HPP
 
 #include "server/tm/proxy/tm_query_proxy.hpp"
+#include "server/tm/models/tm_target_entry.hpp"
+
+using namespace uva::smt::bpbd::server::tm::models;
 
 namespace uva {
     namespace smt {
@@ -52,6 +55,37 @@ namespace uva {
                              * Allows to disconnect from the trie
                              */
                             virtual void disconnect() = 0;
+
+                            /**
+                             * Allows to store the connected model into a binary image file,
+                             * the image can be then used as the model connection string.
+                             * @param file_name the name of the binary image file to create
+                             */
+                            virtual void write_model_image(const string & file_name) = 0;
+
+                            /**
+                             * Allows to get the pool of target entries of the model, e.g. to link them
+                             * to the reordering model entries. The pool is only writable if the model
+                             * is not mapped from a binary image, otherwise NULL is returned.
+                             * @param num_targets [out] the number of target entries in the pool
+                             * @param st_uids [out] the source/target phrase pair uids of the target entries
+                             * @return the pointer to the target entries pool or NULL
+                             */
+                            virtual tm_target_entry * get_targets_pool(size_t & num_targets, const phrase_uid * & st_uids) = 0;
+
+                            /**
+                             * Allows to get the binary image link id, the id is shared by the
+                             * translation and reordering model images created together.
+                             * @return the image link id, or zero if the model is not mapped from or written into an image
+                             */
+                            virtual uint64_t get_image_link_id() const = 0;
+
+                            /**
+                             * Allows to get the model weights, the ones the target entry costs
+                             * were pre-computed with when the model was built.
+                             * @return the model weights
+                             */
+                            virtual const feature_weights & get_model_weights() const = 0;
                             
                             /**
                              * The basic virtual destructor
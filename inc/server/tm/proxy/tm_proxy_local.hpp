@@ -29,8 +29,12 @@
 #include "common/utils/logging/logger.hpp"
 #include "common/utils/exceptions.hpp"
 #include "common/utils/monitor/statistics_monitor.hpp"
+#include "common/utils/file/binary_image.hpp"
+
+#include <random>
 
 #include "server/tm/tm_configs.hpp"
+#include "server/tm/tm_consts.hpp"
 #include "server/tm/proxy/tm_query_proxy.hpp"
 #include "server/tm/proxy/tm_query_proxy_local.hpp"
 
@@ -64,7 +68,7 @@ namespace uva {
                              * The basic proxy constructor, currently does nothing except for default initialization
                              */
                             tm_proxy_local()
-                            : m_model() {
+                            : m_model(), m_params(NULL), m_image_link_id(0) {
                             }
 
                             /**
@@ -79,16 +83,84 @@ namespace uva {
                              * @see tm_proxy
                              */
                             virtual void connect(const tm_parameters & params) {
+                                //Store the parameters
+                                m_params = &params;
+
                                 //The whole purpose of this method connect here is
                                 //just to load the translation model into the memory.
-                                load_model_data<tm_builder_type, tm_model_reader>("Translation Model", params);
+                                //A pre-compiled binary image is mapped, a text file is parsed.
+                                if (is_binary_image(params.m_conn_string, __tm_image::MAGIC)) {
+                                    if (!params.m_filter_file.empty()) {
+                                        LOG_WARNING << "The " << tm_parameters::TM_FILTER_FILE_PARAM_NAME
+                                                << " is ignored, the binary image is mapped as is!" << END_LOG;
+                                    }
+                                    load_model_image("Translation Model", params);
+                                } else {
+                                    load_model_data<tm_builder_type, tm_model_reader>("Translation Model", params);
+                                }
                             }
 
                             /**
                              * @see tm_proxy
                              */
                             virtual void disconnect() {
-                                //Nothing the be done here yet, the model is allocated on the stack
+                                //The model is allocated on the stack, only
+                                //the binary image is to be un-mapped, if any
+                                m_image.close();
+                            }
+
+                            /**
+                             * @see tm_proxy
+                             */
+                            virtual void write_model_image(const string & file_name) {
+                                LOG_USAGE << "Writing the Translation Model binary image into: " << file_name << END_LOG;
+                                const double start_time = stat_monitor::get_cpu_time();
+
+                                //The target entries refer to the reordering model entries, so the
+                                //reordering model image must be created together with this one
+                                if (m_image_link_id == 0) {
+                                    random_device rnd;
+                                    m_image_link_id = ((static_cast<uint64_t> (rnd()) << 32) | rnd()) | 1;
+                                }
+
+                                //Write the image header followed by the model data
+                                binary_image_writer image(file_name);
+                                image.write_array(__tm_image::MAGIC, BINARY_IMAGE_MAGIC_LEN);
+                                image.write<uint32_t>(__tm_image::VERSION);
+                                image.write<uint64_t>(m_image_link_id);
+                                image.write<bool>(IS_SERVER_TUNING_MODE);
+                                image.write<uint64_t>(m_params->m_num_lambdas);
+                                image.write<uint64_t>(m_params->m_num_unk_features);
+                                image.write_array(m_params->m_unk_features, m_params->m_num_unk_features);
+                                image.write<uint64_t>(m_params->m_trans_limit);
+                                image.write<float>(m_params->m_min_tran_prob);
+                                m_model.write_image(image);
+                                image.close();
+
+                                const double end_time = stat_monitor::get_cpu_time();
+                                LOG_USAGE << "Writing the binary image of " << image.get_size() << " bytes took "
+                                        << (end_time - start_time) << " CPU seconds." << END_LOG;
+                            }
+
+                            /**
+                             * @see tm_proxy
+                             */
+                            virtual tm_target_entry * get_targets_pool(size_t & num_targets, const phrase_uid * & st_uids) {
+                                return m_model.get_targets_pool(num_targets, st_uids);
+                            }
+
+                            /**
+                             * @see tm_proxy
+                             */
+                            virtual uint64_t get_image_link_id() const {
+                                return m_image_link_id;
+                            }
+
+                            /**
+                             * @see tm_proxy
+                             */
+                            virtual const feature_weights & get_model_weights() const {
+                                return m_model.get_weights();
                             }
 
                             /**
@@ -109,6 +181,79 @@ namespace uva {
 
                         protected:
 
+                            /**
+                             * Allows to read and check the binary image header against the compiled
+                             * model layout and the configured translation model parameters.
+                             * The features are stored without the lambdas, so the weights may differ.
+                             * @param params the model parameters
+                             */
+                            void read_image_header(const tm_parameters & params) {
+                                //Skip the magic marker, it has already been checked
+                                (void) m_image.read_array<char>(BINARY_IMAGE_MAGIC_LEN);
+
+                                const uint32_t version = m_image.read<uint32_t>();
+                                ASSERT_CONDITION_THROW((version != __tm_image::VERSION),
+                                        string("The binary image version: ") + to_string(version) +
+                                        string(" is not supported, expected: ") + to_string(__tm_image::VERSION));
+
+                                //Read the link id of the reordering model image to be used with
+                                m_image_link_id = m_image.read<uint64_t>();
+
+                                ASSERT_CONDITION_THROW((m_image.read<bool>() != IS_SERVER_TUNING_MODE),
+                                        "The binary image is built with a different server tuning mode, re-create the image!");
+
+                                m_image.read_check<uint64_t>(params.m_num_lambdas, string("the number of ") + tm_parameters::TM_WEIGHTS_PARAM_NAME);
+                                m_image.read_check<uint64_t>(params.m_num_unk_features, string("the number of ") + tm_parameters::TM_UNK_FEATURE_PARAM_NAME);
+                                m_image.read_check_array<float>(params.m_unk_features, params.m_num_unk_features, tm_parameters::TM_UNK_FEATURE_PARAM_NAME);
+                                m_image.read_check<uint64_t>(params.m_trans_limit, tm_parameters::TM_TRANS_LIM_PARAM_NAME);
+                                m_image.read_check<float>(params.m_min_tran_prob, tm_parameters::TM_MIN_TRANS_PROB_PARAM_NAME);
+                            }
+
+                            /**
+                             * Allows to map the model from a pre-compiled binary image file
+                             * @param model_name the name of the model being loaded
+                             * @param params the model parameters
+                             */
+                            void load_model_image(char const *model_name, const tm_parameters & params) {
+                                const string & model_file_name = params.m_conn_string;
+
+                                //Declare the statistics monitor and its data
+                                TMemotyUsage mem_stat_start = {}, mem_stat_end = {};
+
+                                LOG_USAGE << "--------------------------------------------------------" << END_LOG;
+                                LOG_USAGE << "Start mapping the " << model_name << " binary image ..." << END_LOG;
+                                LOG_USAGE << model_name << " is located in: " << model_file_name << END_LOG;
+
+                                //Log the usage information
+                                m_model.log_model_type_info();
+
+                                stat_monitor::get_mem_stat(mem_stat_start);
+                                const double start_time = stat_monitor::get_cpu_time();
+
+                                //Set the number of TM features, as it is done by the builder
+                                tm_target_entry::set_num_features(params.m_num_lambdas);
+
+                                //Map the image file, check its header and map the model
+                                m_image.open(model_file_name);
+                                read_image_header(params);
+                                m_model.read_image(m_image);
+
+                                //Report if the configured weights are not the ones the costs were pre-computed with
+                                feature_weights weights;
+                                lm_configurator::get_params().fill_weights(weights);
+                                params.fill_weights(weights);
+                                if (!weights.is_equal_tm_weights(m_model.get_weights())) {
+                                    LOG_INFO << "The " << model_name << " image is built with the " << m_model.get_weights()
+                                            << ", the configured " << weights << " will be applied when scoring" << END_LOG;
+                                }
+
+                                const double end_time = stat_monitor::get_cpu_time();
+                                LOG_USAGE << "Mapping the " << model_name << " took " << (end_time - start_time) << " CPU seconds." << END_LOG;
+                                stat_monitor::get_mem_stat(mem_stat_end);
+                                const string action_name = string("Mapping the ") + string(model_name);
+                                report_memory_usage(action_name.c_str(), mem_stat_start, mem_stat_end, true);
+                            }
+
                             /**
                              * Allows to load the model into the instance of the selected container class
                              * \todo Add the possibility to choose between the file readers from the command line!
@@ -174,6 +319,12 @@ namespace uva {
                         private:
                             //Stores the translation model instance
                             tm_model_type m_model;
+                            //Stores the pointer to the model parameters
+                            const tm_parameters * m_params;
+                            //Stores the binary image the model is mapped from, if any
+                            binary_image_reader m_image;
+                            //Stores the binary image link id, zero if the model is not mapped from or written into an image
+                            uint64_t m_image_link_id;
                         };
                     }
                 }
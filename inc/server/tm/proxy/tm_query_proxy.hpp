@@ -46,11 +46,13 @@ namespace uva {
                         class tm_query_proxy {
                         public:
                             /**
-                             * Allows to add the source phrase to the query.
-                             * @param uid the source phrase uid
-                             * @param entry_ptr the reference to the source entry pointer to be set with the data
+                             * Allows to retrieve the source entries for a batch of source phrases.
+                             * @param num_uids [in] the number of source phrases
+                             * @param uids [in] the source phrase uids
+                             * @param entries [out] the source entry pointers to be set, one per phrase uid,
+                             * if the phrase is not found then it is set to the UNK entry pointer.
                              */
-                            virtual void execute(const phrase_uid uid, tm_const_source_entry_ptr & entry_ptr) = 0;
+                            virtual void execute(const size_t num_uids, const phrase_uid * uids, tm_const_source_entry_ptr * entries) = 0;
                             
                             /**
                              * Allows retrieve the translations of the given source entry
@@ -59,14 +61,6 @@ namespace uva {
                              */
                             virtual tm_const_source_entry * get_source_entry(const phrase_uid uid) = 0;
 
-                            /**
-                             * Allows to get all the source/target phrase identifiers
-                             * for the source target translation in this query.
-                             * Must be called after the query is executed
-                             * @param st_uids the container for the source/target phrase identifiers
-                             */
-                            virtual void get_st_uids(vector<phrase_uid> & st_uids) const = 0;
-
                             /**
                              * The basic virtual destructor
                              */
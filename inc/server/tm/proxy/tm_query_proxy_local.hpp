@@ -57,8 +57,8 @@ namespace uva {
                             /**
                              * @see tm_query_proxy
                              */
-                            virtual void execute(const phrase_uid uid, tm_const_source_entry_ptr & entry_ptr) {
-                                m_query.execute(uid, entry_ptr);
+                            virtual void execute(const size_t num_uids, const phrase_uid * uids, tm_const_source_entry_ptr * entries) {
+                                m_query.execute(num_uids, uids, entries);
                             }
 
                             /**
@@ -68,13 +68,6 @@ namespace uva {
                                 return m_query.get_source_entry(uid);
                             }
 
-                            /**
-                             * @see tm_query_proxy
-                             */
-                            virtual void get_st_uids(vector<phrase_uid> & st_uids) const {
-                                m_query.get_st_uids(st_uids);
-                            }
-
                             /**
                              * @see tm_query_proxy
                              */
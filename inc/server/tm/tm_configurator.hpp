@@ -83,6 +83,40 @@ namespace uva {
                             }
                         }
 
+                        /**
+                         * Allows to store the connected translation model into a binary image file
+                         * @param file_name the name of the binary image file to create
+                         */
+                        static void write_model_image(const string & file_name) {
+                            m_model_proxy->write_model_image(file_name);
+                        }
+
+                        /**
+                         * Allows to get the pool of target entries of the translation model
+                         * @param num_targets [out] the number of target entries in the pool
+                         * @param st_uids [out] the source/target phrase pair uids of the target entries
+                         * @return the target entries pool or NULL if the model is mapped from an image
+                         */
+                        static inline tm_target_entry * get_targets_pool(size_t & num_targets, const phrase_uid * & st_uids) {
+                            return m_model_proxy->get_targets_pool(num_targets, st_uids);
+                        }
+
+                        /**
+                         * Allows to get the binary image link id of the translation model
+                         * @return the image link id, or zero if there is no image
+                         */
+                        static inline uint64_t get_image_link_id() {
+                            return m_model_proxy->get_image_link_id();
+                        }
+
+                        /**
+                         * Allows to get the weights the translation model costs were pre-computed with
+                         * @return the model weights
+                         */
+                        static inline const feature_weights & get_model_weights() {
+                            return m_model_proxy->get_model_weights();
+                        }
+
                         /**
                          * Allows to return an instance of the query proxy,
                          * is to be returned by calling the dispose method.
@@ -27,6 +27,7 @@
 #define	TM_CONSTS_HPP
 
 #include <string>
+#include <cstdint>
 
 using namespace std;
 
@@ -35,6 +36,15 @@ namespace uva {
         namespace bpbd {
             namespace server {
                 namespace tm {
+                    //Stores the binary translation model image configuration constants
+                    namespace __tm_image {
+                        //The magic marker the binary translation model image files start with
+                        static constexpr char MAGIC[] = "BPBD_TMI";
+                        //The binary translation model image format version, is to be
+                        //increased whenever the image layout of the model changes
+                        static constexpr uint32_t VERSION = 6;
+                    }
+
                     namespace models {
                         namespace __tm_basic_model {
                             //Influences the number of buckets that will be created for the basic model implementations
@@ -36,6 +36,7 @@
 
 #include "server/server_configs.hpp"
 #include "server/common/feature_id_registry.hpp"
+#include "server/common/models/feature_weights.hpp"
 
 using namespace std;
 
@@ -44,6 +45,7 @@ using namespace uva::utils::logging;
 using namespace uva::utils::text;
 
 using namespace uva::smt::bpbd::server::common;
+using namespace uva::smt::bpbd::server::common::models;
 
 namespace uva {
     namespace smt {
@@ -67,6 +69,8 @@ namespace uva {
                         static const string TM_TRANS_LIM_PARAM_NAME;
                         //The minimum translation probability parameter name
                         static const string TM_MIN_TRANS_PROB_PARAM_NAME;
+                        //The source phrase filter file parameter name
+                        static const string TM_FILTER_FILE_PARAM_NAME;
                         //The feature weight names
                         static const string TM_WEIGHT_NAMES[MAX_NUM_TM_FEATURES];
                         //The feature weight names
@@ -106,6 +110,15 @@ namespace uva {
                         //Stores the word penalty lambda - the cost of each target word
                         float m_wp_lambda;
 
+                        //Stores the source phrase filter file name, if not empty then
+                        //only the source phrases present in the file text are loaded
+                        string m_filter_file;
+
+                        //Stores the maximum source phrase length to be considered when
+                        //collecting the source phrases of the filter file, the same as
+                        //the maximum source phrase length used by the decoder
+                        phrase_length m_max_s_phrase_len;
+
                         /**
                          * Allows to get the features weights used in the corresponding model.
                          * @param registry the feature registry entity
@@ -122,6 +135,16 @@ namespace uva {
                             registry.add_feature(source, TM_WORD_PENALTY_PARAM_NAME, TM_WP_LAMBDA_GLOBAL_ID);
                         }
 
+                        /**
+                         * Allows to set the translation model and word penalty weights into the feature weights
+                         * @param weights the feature weights to be filled in
+                         */
+                        inline void fill_weights(feature_weights & weights) const {
+                            weights.m_num_tm_lambdas = m_num_lambdas;
+                            weights.set_tm_lambdas(m_num_lambdas, m_lambdas);
+                            weights.m_wp_lambda = m_wp_lambda;
+                        }
+
                         /**
                          * Allows to verify the parameters to be correct.
                          */
@@ -175,6 +198,7 @@ namespace uva {
                                 << ", " << tm_parameters::TM_TRANS_LIM_PARAM_NAME << " = " << params.m_trans_limit
                                 << ", " << tm_parameters::TM_MIN_TRANS_PROB_PARAM_NAME << " = " << params.m_min_tran_prob
                                 << ", " << tm_parameters::TM_WORD_PENALTY_PARAM_NAME << " = " << params.m_wp_lambda
+                                << ", " << tm_parameters::TM_FILTER_FILE_PARAM_NAME << " = " << params.m_filter_file
                                 << " }";
                     }
                 }
@@ -0,0 +1,239 @@
+/*
+ * File:   trans_cache.hpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 17, 2026, 5:05 PM
+ */
+
+#ifndef TRANS_CACHE_HPP
+#define TRANS_CACHE_HPP
+
+#include <list>
+#include <string>
+#include <atomic>
+#include <unordered_map>
+
+#include "common/utils/logging/logger.hpp"
+#include "common/utils/exceptions.hpp"
+#include "common/utils/hashing_utils.hpp"
+#include "common/utils/threads/threads.hpp"
+#include "common/utils/text/string_utils.hpp"
+
+using namespace std;
+
+using namespace uva::utils::logging;
+using namespace uva::utils::exceptions;
+using namespace uva::utils::hashing;
+using namespace uva::utils::threads;
+using namespace uva::utils::text;
+
+namespace uva {
+    namespace smt {
+        namespace bpbd {
+            namespace server {
+
+                /**
+                 * This class represents the translation memory cache of the server. It stores the
+                 * translations of the recently translated sentences, so that a repeated sentence is
+                 * not decoded again. The entries are keyed by the normalised source sentence and the
+                 * hash of the decoder parameters it was translated with. The source sentence is stored
+                 * and compared, so there are no false hits. The cache is split into a number of shards,
+                 * each one is a least recently used cache with its own lock, to reduce the contention
+                 * between the threads. This class is thread safe.
+                 */
+                class trans_cache {
+                public:
+
+                    /**
+                     * The basic constructor
+                     * @param capacity the maximum number of cached translations, 0 disables caching
+                     */
+                    trans_cache(const size_t capacity)
+                    : m_shard_capacity((capacity + NUM_SHARDS - 1) / NUM_SHARDS),
+                    m_num_hits(0), m_num_misses(0) {
+                    }
+
+                    /**
+                     * Allows to check whether the cache is enabled
+                     * @return true if the translations are to be cached, otherwise false
+                     */
+                    inline bool is_enabled() const {
+                        return (m_shard_capacity != 0);
+                    }
+
+                    /**
+                     * Allows to look up the translation of the source sentence, counts the hit or miss
+                     * @param params_hash the hash of the decoder parameters to translate with
+                     * @param source_text the source sentence
+                     * @param target_text [out] the cached translation, only set if found
+                     * @return true if the translation was found, otherwise false
+                     */
+                    inline bool get(const uint64_t params_hash, const string & source_text, string & target_text) {
+                        //Get the normalised sentence and its key hash
+                        string source = source_text;
+                        const uint64_t hash = get_hash(params_hash, reduce(source));
+                        cache_shard & shard = m_shards[hash % NUM_SHARDS];
+
+                        {
+                            scoped_guard guard(shard.m_mutex);
+
+                            auto iter = shard.m_index.find(hash);
+                            if ((iter != shard.m_index.end())
+                                    && (iter->second->m_params_hash == params_hash)
+                                    && (iter->second->m_source == source)) {
+                                //Move the entry to the front as the most recently used one
+                                shard.m_entries.splice(shard.m_entries.begin(), shard.m_entries, iter->second);
+                                target_text = iter->second->m_target;
+
+                                m_num_hits.fetch_add(1, memory_order_relaxed);
+                                return true;
+                            }
+                        }
+
+                        m_num_misses.fetch_add(1, memory_order_relaxed);
+                        return false;
+                    }
+
+                    /**
+                     * Allows to add the translation of the source sentence, evicts the least recently used one if full
+                     * @param params_hash the hash of the decoder parameters translated with
+                     * @param source_text the source sentence
+                     * @param target_text the translation of the source sentence
+                     */
+                    inline void put(const uint64_t params_hash, const string & source_text, const string & target_text) {
+                        //Get the normalised sentence and its key hash
+                        string source = source_text;
+                        const uint64_t hash = get_hash(params_hash, reduce(source));
+                        cache_shard & shard = m_shards[hash % NUM_SHARDS];
+
+                        scoped_guard guard(shard.m_mutex);
+
+                        auto iter = shard.m_index.find(hash);
+                        if (iter != shard.m_index.end()) {
+                            //Re-use the entry stored for the same hash
+                            shard.m_entries.splice(shard.m_entries.begin(), shard.m_entries, iter->second);
+                        } else {
+                            //Evict the least recently used entry if the shard is full
+                            if (shard.m_entries.size() >= m_shard_capacity) {
+                                shard.m_index.erase(shard.m_entries.back().m_hash);
+                                shard.m_entries.pop_back();
+                            }
+                            shard.m_entries.emplace_front();
+                            shard.m_index[hash] = shard.m_entries.begin();
+                        }
+
+                        cache_entry & entry = shard.m_entries.front();
+                        entry.m_hash = hash;
+                        entry.m_params_hash = params_hash;
+                        entry.m_source = source;
+                        entry.m_target = target_text;
+                    }
+
+                    /**
+                     * Allows to remove all the cached translations, e.g. when the decoder parameters are changed
+                     */
+                    inline void clear() {
+                        for (size_t idx = 0; idx < NUM_SHARDS; ++idx) {
+                            scoped_guard guard(m_shards[idx].m_mutex);
+                            m_shards[idx].m_index.clear();
+                            m_shards[idx].m_entries.clear();
+                        }
+                        LOG_DEBUG << "The translation cache is cleared!" << END_LOG;
+                    }
+
+                    /**
+                     * Allows to report the runtime information, the number of entries and the hit rate
+                     * @param prefix the report prefix
+                     */
+                    inline void report_run_time_info(const string & prefix) {
+                        size_t num_entries = 0;
+                        for (size_t idx = 0; idx < NUM_SHARDS; ++idx) {
+                            scoped_guard guard(m_shards[idx].m_mutex);
+                            num_entries += m_shards[idx].m_entries.size();
+                        }
+
+                        const uint64_t num_hits = m_num_hits.load(memory_order_relaxed);
+                        const uint64_t num_misses = m_num_misses.load(memory_order_relaxed);
+                        const uint64_t num_queries = num_hits + num_misses;
+                        LOG_USAGE << prefix << ":" << END_LOG;
+                        LOG_USAGE << "\t#entries: " << num_entries << "/" << (m_shard_capacity * NUM_SHARDS)
+                                << ", #hits: " << num_hits << ", #misses: " << num_misses << ", hit rate: "
+                                << ((num_queries > 0) ? (100.0 * num_hits) / num_queries : 0.0) << "%" << END_LOG;
+                    }
+
+                private:
+                    //Stores the number of cache shards
+                    static constexpr size_t NUM_SHARDS = 16;
+
+                    /**
+                     * This structure represents a cache entry, i.e. a source sentence and its translation
+                     */
+                    struct cache_entry {
+                        //Stores the entry key hash
+                        uint64_t m_hash;
+                        //Stores the hash of the decoder parameters translated with
+                        uint64_t m_params_hash;
+                        //Stores the normalised source sentence
+                        string m_source;
+                        //Stores the target sentence
+                        string m_target;
+                    };
+
+                    //Typedef the list of entries, the most recently used first
+                    typedef list<cache_entry> entries_list;
+
+                    /**
+                     * This structure represents a cache shard, i.e. a least recently used cache
+                     */
+                    struct cache_shard {
+                        //Stores the shard mutex
+                        mutex m_mutex;
+                        //Stores the entries, the most recently used first
+                        entries_list m_entries;
+                        //Stores the mapping from the entry key hashes to the entries
+                        unordered_map<uint64_t, entries_list::iterator> m_index;
+                    };
+
+                    /**
+                     * Allows to compute the entry key hash
+                     * @param params_hash the hash of the decoder parameters
+                     * @param source the normalised source sentence
+                     * @return the entry key hash
+                     */
+                    static inline uint64_t get_hash(const uint64_t params_hash, const string & source) {
+                        return MurmurHash64A(source.c_str(), source.length(), params_hash);
+                    }
+
+                    //Stores the maximum number of entries per shard
+                    const size_t m_shard_capacity;
+                    //Stores the cache shards
+                    cache_shard m_shards[NUM_SHARDS];
+                    //Stores the number of cache hits
+                    atomic<uint64_t> m_num_hits;
+                    //Stores the number of cache misses
+                    atomic<uint64_t> m_num_misses;
+                };
+            }
+        }
+    }
+}
+
+#endif /* TRANS_CACHE_HPP */
@@ -28,6 +28,7 @@
 
 #include <string>
 #include <vector>
+#include <chrono>
 
 #include "server/trans_task.hpp"
 
@@ -39,9 +40,11 @@
 
 #include "server/messaging/trans_job_req_in.hpp"
 #include "server/messaging/trans_job_resp_out.hpp"
+#include "server/messaging/trans_job_part_resp_out.hpp"
 
 using namespace std;
 using namespace std::placeholders;
+using namespace std::chrono;
 
 using namespace uva::smt::bpbd::common::messaging;
 using namespace uva::smt::bpbd::server::messaging;
@@ -71,6 +74,8 @@ namespace uva {
 
                     //Define the function type for the function used to set the translation job result
                     typedef function<void(trans_job_ptr) > done_job_notifier;
+                    //Define the function type for the function used to stream a finished job sentence
+                    typedef function<void(trans_job_ptr, const size_t) > done_part_notifier;
 
                     //Declare the tasks list type and its iterator
                     typedef vector<trans_task_ptr> tasks_list_type;
@@ -84,11 +89,21 @@ namespace uva {
                      */
                     trans_job(const session_id_type session_id, const trans_job_req_in & trans_req)
                     : m_session_id(session_id), m_job_id(trans_req.get_job_id()),
-                    m_is_trans_info(trans_req.is_trans_info()), m_done_tasks_count(0),
-                    m_num_cancel_tasks(0), m_num_error_tasks(0) {
+                    m_is_trans_info(trans_req.is_trans_info()), m_is_stream(trans_req.is_stream()),
+                    m_done_tasks_count(0), m_notify_job_done_func(NULL), m_notify_part_done_func(NULL),
+                    m_de_params(de_configurator::get_params()), m_ranking_cache(NULL), m_num_cancel_tasks(0), m_num_error_tasks(0),
+                    m_start_time(steady_clock::now()) {
                         LOG_DEBUG << "Creating a new translation job " << this << " with job_id: "
                                 << m_job_id << " session id: " << m_session_id << END_LOG;
 
+                        //Apply the job's feature weights, if any, before the tasks use the parameters
+                        trans_req.get_weights(m_de_params.m_weights);
+
+                        //If the weights are not the model ones, the translations are re-ranked for the job
+                        if (!m_de_params.m_weights.is_equal_tm_weights(tm_configurator::get_model_weights())) {
+                            m_ranking_cache = new tm_ranking_cache(m_de_params.m_weights, m_de_params.m_trans_limit);
+                        }
+
                         //Get the text to be translated
                         const Value & source_text = trans_req.get_source_text();
 
@@ -98,8 +113,8 @@ namespace uva {
                         //Read the text line by line, each line must be one sentence
                         //to translate. For each read line create a translation task.
                         for (auto iter = source_text.Begin(); iter != source_text.End(); ++iter) {
-                            m_tasks.push_back(new trans_task(m_session_id, m_job_id, priority,
-                                    iter->GetString(), bind(&trans_job::notify_task_done, this, _1)));
+                            m_tasks.push_back(new trans_task(m_session_id, m_job_id, priority, m_de_params, m_ranking_cache,
+                                    iter->GetString(), bind(&trans_job::notify_task_done, this, _1, m_tasks.size())));
                         }
                     }
 
@@ -112,6 +127,16 @@ namespace uva {
                         m_notify_job_done_func = notify_job_done_func;
                     }
 
+                    /**
+                     * Allows to set the function that should be called when a job sentence is
+                     * done and is to be streamed, it is only called if streaming is requested.
+                     * @param notify_part_done_func the job sentence done notification function
+                     *              to be called with the job and the finished sentence index
+                     */
+                    inline void set_done_part_notifier(done_part_notifier notify_part_done_func) {
+                        m_notify_part_done_func = notify_part_done_func;
+                    }
+
                     /**
                      * The basic destructor
                      */
@@ -126,6 +151,11 @@ namespace uva {
                             LOG_DEBUG << "Deleting translation tasks" << this->get_job_id() << "/" << **it << END_LOG;
                             delete *it;
                         }
+
+                        //Delete the translations ranking cache, if any
+                        if (m_ranking_cache != NULL) {
+                            delete m_ranking_cache;
+                        }
                     }
 
                     /**
@@ -144,6 +174,30 @@ namespace uva {
                         return m_job_id;
                     }
 
+                    /**
+                     * Allows to check whether the translation info is to be sent back
+                     * @return true if the translation info is requested, otherwise false
+                     */
+                    inline bool is_trans_info() const {
+                        return m_is_trans_info;
+                    }
+
+                    /**
+                     * Allows to get the decoder parameters the job is translated with
+                     * @return the decoder parameters of this job
+                     */
+                    inline const de_parameters & get_de_params() const {
+                        return m_de_params;
+                    }
+
+                    /**
+                     * Allows to get the time passed since the job was created, i.e. received
+                     * @return the job run time in seconds
+                     */
+                    inline double get_run_time() const {
+                        return duration_cast<duration<double>>(steady_clock::now() - m_start_time).count();
+                    }
+
                     /**
                      * Allows to get the list of translation tasks
                      * @return the list of translation tasks of this job
@@ -198,8 +252,9 @@ namespace uva {
                      * these should be the ones from the m_tasks list and they must
                      * report themselves only ones. (Optional - for safety).}
                      * @param task the translation task that is finished
+                     * @param sent_idx the index of the task's sentence within the job
                      */
-                    inline void notify_task_done(const trans_task_ptr task) {
+                    inline void notify_task_done(const trans_task_ptr task, const size_t sent_idx) {
                         recursive_guard guard_tasks(m_tasks_lock);
 
                         LOG_DEBUG1 << "The task " << *task << " is done!" << END_LOG;
@@ -219,6 +274,12 @@ namespace uva {
                                 break;
                         }
 
+                        //Stream the sentence result, this is done before the job is
+                        //reported finished so the job response is always sent last
+                        if (m_is_stream && m_notify_part_done_func) {
+                            m_notify_part_done_func(this, sent_idx);
+                        }
+
                         //Increment the finished tasks count
                         m_done_tasks_count++;
 
@@ -253,50 +314,44 @@ namespace uva {
                         //Set the translation job id
                         resp_data.set_job_id(m_job_id);
 
-                        //Begin the sentence data section
-                        resp_data.begin_sent_data_arr();
+                        //The streamed sentence results have already been sent
+                        if (!m_is_stream) {
+                            //Begin the sentence data section
+                            resp_data.begin_sent_data_arr();
 
-                        //Get the sentence data object through which we can build the JSON
-                        trans_sent_data_out & sent_data = resp_data.get_sent_data_writer();
-
-                        //Iterate through the translation tasks and combine the results
-                        for (tasks_iter_type it = m_tasks.begin(); it != m_tasks.end(); ++it) {
-                            //Get the task pointer for future use
-                            trans_task_ptr task = *it;
-
-                            LOG_DEBUG1 << "Adding a new sentence result data" << END_LOG;
-
-                            //Begin the sentence data
-                            sent_data.begin_sent_data_ent();
-
-                            //Set the target sentence
-                            sent_data.set_trans_text(task->get_target_text());
-
-                            //Set the sentence status
-                            sent_data.set_status(task->get_status_code(), task->get_status_msg());
-
-                            //Append the task translation info if needed and the translation was finished
-                            if (m_is_trans_info && (task->get_status_code() == status_code::RESULT_OK)) {
-                                LOG_DEBUG1 << "Getting the translation info data" << END_LOG;
-                                //Get the translation task info
-                                task->get_trans_info(sent_data);
+                            //Iterate through the translation tasks and combine the results
+                            for (tasks_iter_type it = m_tasks.begin(); it != m_tasks.end(); ++it) {
+                                add_task_result(resp_data, *it);
                             }
 
                             //End the sentence data section
-                            sent_data.end_sent_data_ent();
-
-                            LOG_DEBUG1 << "The target text of task: " << *task << " has been retrieved!" << END_LOG;
+                            resp_data.end_sent_data_arr();
                         }
 
-                        //End the sentence data section
-                        resp_data.end_sent_data_arr();
-
                         //Decide on the status code and message
                         set_job_status(resp_data);
 
                         LOG_DEBUG1 << "The translation job " << this << " result is ready!" << END_LOG;
                     }
 
+                    /**
+                     * Allows to compile the partial job result, e.g. the result of a finished sentence.
+                     * @param resp_data [out] the object to store the translation job partial response data to be sent
+                     * @param sent_idx the index of the finished sentence within the job
+                     */
+                    inline void collect_part_results(trans_job_part_resp_out & resp_data, const size_t sent_idx) {
+                        LOG_DEBUG1 << "Streaming the job " << this << " sentence " << sent_idx << " result!" << END_LOG;
+
+                        //Set the translation job id and the sentence index
+                        resp_data.set_job_id(m_job_id);
+                        resp_data.set_sent_idx(sent_idx);
+
+                        //Add the sentence result as a single sentence range
+                        resp_data.begin_sent_data_arr();
+                        add_task_result(resp_data, m_tasks[sent_idx]);
+                        resp_data.end_sent_data_arr();
+                    }
+
                     /**
                      * This function sets the translation job response status
                      * @param resp_data the translation job response to set the status into
@@ -320,6 +375,40 @@ namespace uva {
                     }
 
                 private:
+
+                    /**
+                     * Allows to add the translation task result into the response sentence data array
+                     * @param resp_data the translation job response to add the result to
+                     * @param task the translation task to get the result from
+                     */
+                    inline void add_task_result(trans_job_resp_out & resp_data, const trans_task_ptr task) {
+                        LOG_DEBUG1 << "Adding a new sentence result data" << END_LOG;
+
+                        //Get the sentence data object through which we can build the JSON
+                        trans_sent_data_out & sent_data = resp_data.get_sent_data_writer();
+
+                        //Begin the sentence data
+                        sent_data.begin_sent_data_ent();
+
+                        //Set the target sentence
+                        sent_data.set_trans_text(task->get_target_text());
+
+                        //Set the sentence status
+                        sent_data.set_status(task->get_status_code(), task->get_status_msg());
+
+                        //Append the task translation info if needed and the translation was finished
+                        if (m_is_trans_info && (task->get_status_code() == status_code::RESULT_OK)) {
+                            LOG_DEBUG1 << "Getting the translation info data" << END_LOG;
+                            //Get the translation task info
+                            task->get_trans_info(sent_data);
+                        }
+
+                        //End the sentence data section
+                        sent_data.end_sent_data_ent();
+
+                        LOG_DEBUG1 << "The target text of task: " << *task << " has been retrieved!" << END_LOG;
+                    }
+
                     //Stores the synchronization mutex for working with the m_sessions_map
                     recursive_mutex m_tasks_lock;
 
@@ -332,18 +421,35 @@ namespace uva {
                     //Stores the flag of whether the translation info is to be sent back or not
                     const bool m_is_trans_info;
 
+                    //Stores the flag of whether the finished sentences are to be streamed or not
+                    const bool m_is_stream;
+
                     //The count of the finished tasks
                     atomic<uint32_t> m_done_tasks_count;
 
                     //The done job notifier
                     done_job_notifier m_notify_job_done_func;
 
+                    //The done job sentence notifier, for streaming
+                    done_part_notifier m_notify_part_done_func;
+
+                    //Stores the decoder parameters of this job, the server ones at the time the
+                    //job was received with the job's feature weights applied, are used by the tasks
+                    de_parameters m_de_params;
+
+                    //Stores the translations ranking cache, for the job's weights if
+                    //they differ from the model ones, otherwise NULL, used by the tasks
+                    tm_ranking_cache * m_ranking_cache;
+
                     //Stores the list of translation tasks of this job
                     tasks_list_type m_tasks;
 
                     //Stores the number of canceled and error tasks
                     size_t m_num_cancel_tasks;
                     size_t m_num_error_tasks;
+
+                    //Stores the time the job was created at
+                    const steady_clock::time_point m_start_time;
                 };
             }
         }
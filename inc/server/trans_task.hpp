@@ -76,17 +76,21 @@ namespace uva {
                      * @param session_id the session id of the task, is used for logging
                      * @param job_id the job id of the task, is used for logging
                      * @param priority the translation task priority
+                     * @param de_params the decoder parameters to translate with, must outlive the task
+                     * @param ranking_cache the job's translations ranking cache or NULL, must outlive the task
                      * @param source_text the sentence to be translated
                      * @param notify_task_done_func the function to call when the task is done
                      */
                     trans_task(const session_id_type session_id, const job_id_type job_id,
-                            const int32_t priority, const string & source_text,
+                            const int32_t priority, const de_parameters & de_params,
+                            tm_ranking_cache * ranking_cache, const string & source_text,
                             done_task_notifier notify_task_done_func)
                     : m_is_stop(false), m_session_id(session_id), m_job_id(job_id), m_priority(priority),
                     m_task_id(m_id_mgr.get_next_id()), m_status_code(status_code::RESULT_UNDEFINED),
                     m_status_msg(""), m_source_text(source_text),
-                    m_notify_task_done_func(notify_task_done_func), m_target_text(""),
-                    m_decoder(de_configurator::get_params(), m_is_stop, m_source_text, m_target_text) {
+                    m_notify_task_done_func(notify_task_done_func), m_target_text(""), m_is_cached(false), m_cost(0),
+                    m_decoder(de_params, ranking_cache, de_configurator::get_expand_pool(),
+                    m_is_stop, m_source_text, m_target_text) {
                         LOG_DEBUG1 << "/session id=" << m_session_id << ", job id="
                                 << m_job_id << ", NEW task id=" << m_task_id
                                 << "/ text: " << m_source_text << END_LOG;
@@ -127,17 +131,19 @@ namespace uva {
                     inline void execute() {
                         LOG_DEBUG1 << "Starting the task " << m_task_id << " translation ..." << END_LOG;
 
-                        //Perform the decoding task
-                        try {
-                            LOG_DEBUG1 << "Invoking the sentence translation for task " << m_task_id << END_LOG;
-                            m_decoder.translate();
-                        } catch (std::exception & ex) {
-                            //Set the response code
-                            m_status_code = status_code::RESULT_ERROR;
-                            //Set the error message for the client
-                            m_status_msg = ex.what();
-                            //Do local logging
-                            LOG_DEBUG << "SERVER ERROR: '" << m_status_msg << "'" << END_LOG;
+                        //Perform the decoding task, unless the translation is cached
+                        if (!m_is_cached) {
+                            try {
+                                LOG_DEBUG1 << "Invoking the sentence translation for task " << m_task_id << END_LOG;
+                                m_decoder.translate();
+                            } catch (std::exception & ex) {
+                                //Set the response code
+                                m_status_code = status_code::RESULT_ERROR;
+                                //Set the error message for the client
+                                m_status_msg = ex.what();
+                                //Do local logging
+                                LOG_DEBUG << "SERVER ERROR: '" << m_status_msg << "'" << END_LOG;
+                            }
                         }
 
                         LOG_DEBUG1 << "The task " << m_task_id << " translation part is over." << END_LOG;
@@ -148,8 +154,10 @@ namespace uva {
 
                             LOG_DEBUG1 << "The task " << m_task_id << " is to be finished!" << END_LOG;
 
-                            //Produce the task result
-                            process_task_result();
+                            //Produce the task result, the cached one is already there
+                            if (!m_is_cached) {
+                                process_task_result();
+                            }
 
 #if IS_SERVER_TUNING_MODE
                             //Dump the search lattice for the sentence if needed
@@ -172,6 +180,33 @@ namespace uva {
                         LOG_DEBUG1 << "The task " << m_task_id << " translation is done!" << END_LOG;
                     }
 
+                    /**
+                     * Allows to set the task's sentence translation found in the translation
+                     * cache, is to be called before the task is scheduled. The task is still
+                     * to be executed, it then skips the decoding and reports being done. This
+                     * way the task-done notification is never called from the scheduling
+                     * context, which holds the jobs pool locks.
+                     * @param target_text the cached translation of the task's sentence
+                     */
+                    inline void set_cached_result(const string & target_text) {
+                        LOG_DEBUG1 << "The task " << m_task_id << " translation is cached!" << END_LOG;
+
+                        recursive_guard guard_end(m_end_lock);
+
+                        m_status_code = status_code::RESULT_OK;
+                        m_status_msg = "";
+                        m_target_text = target_text;
+                        m_is_cached = true;
+                    }
+
+                    /**
+                     * Allows to check whether the task's sentence translation was found in the translation cache
+                     * @return true if the task result is the cached translation, otherwise false
+                     */
+                    inline bool is_cached() const {
+                        return m_is_cached;
+                    }
+
                     /**
                      * Allows to get the task priority
                      * @return the priority of this task
@@ -180,6 +215,25 @@ namespace uva {
                         return m_priority;
                     }
 
+                    /**
+                     * Allows to estimate the relative translation cost of the task, is to be
+                     * called before the task is scheduled, the estimate is remembered.
+                     * @return the relative translation cost estimate
+                     */
+                    inline uint64_t estimate_cost() {
+                        m_cost = m_decoder.estimate_cost();
+                        LOG_DEBUG1 << "The task " << m_task_id << " cost estimate is " << m_cost << END_LOG;
+                        return m_cost;
+                    }
+
+                    /**
+                     * Allows to get the relative translation cost estimate of the task
+                     * @return the cost estimate, zero if not estimated
+                     */
+                    inline uint64_t get_cost() const {
+                        return m_cost;
+                    }
+
                     /**
                      * Allows to retrieve the translation task result code
                      * @return the translation task result code
@@ -349,6 +403,12 @@ namespace uva {
                     //Stores the translated sentence or an error message
                     string m_target_text;
 
+                    //Stores the flag indicating whether the translation is taken from the cache
+                    bool m_is_cached;
+
+                    //Stores the relative translation cost estimate
+                    uint64_t m_cost;
+
                     //Stores the pointer to the sentence decoder instance
                     sentence_decoder m_decoder;
 
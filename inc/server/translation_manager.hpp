@@ -27,12 +27,16 @@
 #define TRANSLATION_MANAGER_HPP
 
 #include <functional>
+#include <vector>
+#include <algorithm>
 
 #include "server/trans_job.hpp"
+#include "server/trans_cache.hpp"
 
 #include "common/utils/exceptions.hpp"
 #include "common/utils/logging/logger.hpp"
 #include "common/utils/threads/task_pool.hpp"
+#include "common/utils/monitor/latency_monitor.hpp"
 
 #include "common/messaging/session_manager.hpp"
 #include "common/messaging/job_id.hpp"
@@ -40,6 +44,7 @@
 
 #include "server/messaging/trans_job_req_in.hpp"
 #include "server/messaging/trans_job_resp_out.hpp"
+#include "server/lm/proxy/lm_query_cache.hpp"
 
 using namespace std;
 using namespace std::placeholders;
@@ -47,9 +52,11 @@ using namespace std::placeholders;
 using namespace uva::utils::logging;
 using namespace uva::utils::exceptions;
 using namespace uva::utils::threads;
+using namespace uva::utils::monitor;
 
 using namespace uva::smt::bpbd::common::messaging;
 using namespace uva::smt::bpbd::server::messaging;
+using namespace uva::smt::bpbd::server::lm::proxy;
 
 namespace uva {
     namespace smt {
@@ -66,11 +73,18 @@ namespace uva {
                     /**
                      * The basic constructor.
                      * @param num_threads the number of translation threads to run
+                     * @param priority_aging the time period, in seconds, of waiting
+                     *        after which a task priority is raised by one, or 0.0
+                     *        to disable the priority aging
+                     * @param trans_cache_size the maximum number of the sentence
+                     *        translations to cache, or 0 to disable the caching
                      */
-                    translation_manager(const size_t num_threads)
+                    translation_manager(const size_t num_threads, const double priority_aging,
+                            const size_t trans_cache_size)
                     : session_manager(), session_job_pool_base(
                     bind(&translation_manager::notify_job_done, this, _1)),
-                    m_tasks_pool(num_threads) {
+                    m_tasks_pool(num_threads, priority_aging), m_jobs_latency(JOB_LATENCY_WINDOW),
+                    m_trans_cache(trans_cache_size) {
                     }
 
                     /**
@@ -92,6 +106,14 @@ namespace uva {
                         m_tasks_pool.set_num_threads(num_threads);
                     }
 
+                    /**
+                     * Allows to remove all the cached sentence translations, is to be
+                     * called when the server's decoder parameters are changed.
+                     */
+                    void clear_trans_cache() {
+                        m_trans_cache.clear();
+                    }
+
                     /**
                      * Allows to report the runtime information.
                      */
@@ -101,6 +123,15 @@ namespace uva {
 
                         //Report data from the tasks pool
                         m_tasks_pool.report_run_time_info("Translation tasks pool");
+
+                        //Report the translation jobs latency
+                        m_jobs_latency.report_run_time_info("Translation jobs latency");
+
+                        //Report the translation cache statistics
+                        m_trans_cache.report_run_time_info("Translation cache");
+
+                        //Report the LM query caches statistics
+                        lm_query_cache::report_run_time_info("LM query caches");
                     }
 
                     /**
@@ -126,8 +157,15 @@ namespace uva {
                         //Instantiate a new translation job, it will destroy the translation request in its destructor
                         trans_job_ptr job = new trans_job(session_id, trans_req);
 
+                        //Set the function to stream the finished sentences, if requested
+                        job->set_done_part_notifier(bind(&translation_manager::notify_part_done, this, _1, _2));
+
                         LOG_DEBUG << "Got the new job: " << job << " to translate." << END_LOG;
 
+                        //Look up the job sentences in the translation cache and estimate the
+                        //other sentences' costs, this queries the TM, before any lock is taken
+                        prepare_job_tasks(job);
+
                         //Schedule a translation job request for the session id
                         this->plan_new_job(job);
                     }
@@ -146,10 +184,75 @@ namespace uva {
                      * @see session_job_pool_base
                      */
                     virtual void schedule_new_job(trans_job_ptr trans_job) {
-                        //Add the job tasks to the tasks' pool
-                        const trans_job::tasks_list_type& tasks = trans_job->get_tasks();
-                        for (trans_job::tasks_const_iter_type it = tasks.begin(); it != tasks.end(); ++it) {
-                            m_tasks_pool.plan_new_task(*it);
+                        //Split the cached tasks from the others, the costs are already estimated.
+                        //The cached tasks are still planned, they do not decode but report being
+                        //done from the pool workers, as the job is not to be finished from here.
+                        const trans_job::tasks_list_type & job_tasks = trans_job->get_tasks();
+                        trans_job::tasks_list_type tasks, other_tasks;
+                        tasks.reserve(job_tasks.size());
+                        for (auto iter = job_tasks.begin(); iter != job_tasks.end(); ++iter) {
+                            if ((*iter)->is_cached()) {
+                                tasks.push_back(*iter);
+                            } else {
+                                other_tasks.push_back(*iter);
+                            }
+                        }
+
+                        //Plan the cached tasks first, as they are done right away, and then the most
+                        //expensive tasks, this way the job's longest sentence does not start last
+                        //and the job is finished sooner
+                        stable_sort(other_tasks.begin(), other_tasks.end(),
+                                [] (const trans_task_ptr left, const trans_task_ptr right) {
+                                    return left->get_cost() > right->get_cost();
+                                });
+                        tasks.insert(tasks.end(), other_tasks.begin(), other_tasks.end());
+
+                        //Add the job tasks to the tasks' pool, all at once
+                        m_tasks_pool.plan_new_tasks(tasks.begin(), tasks.end());
+                    }
+
+                    /**
+                     * Allows to set the results of the job tasks whose sentences are in the translation
+                     * cache and to estimate the costs of the other tasks. The cached translations have
+                     * no translation info and produce no search lattices, so the cache is not used if
+                     * these are needed. Is to be called before the job is planned, as the look ups and
+                     * the translation model queries are not to be done under the jobs lock.
+                     * @param trans_job the pointer to the new translation job
+                     */
+                    inline void prepare_job_tasks(trans_job_ptr trans_job) {
+                        const de_parameters & de_params = trans_job->get_de_params();
+                        const bool is_use_cache = m_trans_cache.is_enabled() &&
+                                !trans_job->is_trans_info() && !de_params.m_is_gen_lattice;
+                        const uint64_t params_hash = is_use_cache ? de_params.get_hash() : 0;
+
+                        const trans_job::tasks_list_type & tasks = trans_job->get_tasks();
+                        string target_text;
+                        for (auto iter = tasks.begin(); iter != tasks.end(); ++iter) {
+                            if (is_use_cache && m_trans_cache.get(params_hash, (*iter)->get_source_text(), target_text)) {
+                                (*iter)->set_cached_result(target_text);
+                            } else {
+                                (*iter)->estimate_cost();
+                            }
+                        }
+                    }
+
+                    /**
+                     * Allows to stream the finished job sentence result to the client.
+                     * @param trans_job the pointer to the translation job
+                     * @param sent_idx the index of the finished sentence within the job
+                     */
+                    inline void notify_part_done(trans_job_ptr trans_job, const size_t sent_idx) {
+                        //Create the translation job partial response, in the form negotiated by the session
+                        trans_job_part_resp_out resp(is_bin_session(trans_job->get_session_id()));
+
+                        //Populate the translation job partial response with the data
+                        trans_job->collect_part_results(resp, sent_idx);
+
+                        //Attempt to send the serialized response
+                        if (!this->send_response(trans_job->get_session_id(), resp)) {
+                            LOG_DEBUG << "Could not send the translation partial response for "
+                                    << trans_job->get_session_id() << "/" << trans_job->get_job_id()
+                                    << " as the connection handler has expired!" << END_LOG;
                         }
                     }
 
@@ -165,8 +268,14 @@ namespace uva {
 
                         LOG_DEBUG << "Finished job id: " << job_id << ", session: " << session_id << END_LOG;
 
-                        //Create the translation job response
-                        trans_job_resp_out resp;
+                        //Register the job latency
+                        m_jobs_latency.add(trans_job->get_run_time());
+
+                        //Cache the job's sentence translations
+                        add_to_trans_cache(trans_job);
+
+                        //Create the translation job response, in the form negotiated by the session
+                        trans_job_resp_out resp(is_bin_session(session_id));
 
                         //Populate the translation job response with the data
                         trans_job->collect_job_results(resp);
@@ -178,9 +287,32 @@ namespace uva {
                         }
                     }
 
+                    /**
+                     * Allows to add the successful sentence translations of the finished job to the translation cache
+                     * @param trans_job the pointer to the finished translation job
+                     */
+                    inline void add_to_trans_cache(trans_job_ptr trans_job) {
+                        if (m_trans_cache.is_enabled()) {
+                            const uint64_t params_hash = trans_job->get_de_params().get_hash();
+                            const trans_job::tasks_list_type & tasks = trans_job->get_tasks();
+                            for (auto iter = tasks.begin(); iter != tasks.end(); ++iter) {
+                                if ((*iter)->get_status_code() == status_code::RESULT_OK) {
+                                    m_trans_cache.put(params_hash, (*iter)->get_source_text(), (*iter)->get_target_text());
+                                }
+                            }
+                        }
+                    }
+
                 private:
+                    //Stores the number of the last finished jobs to report the latency for
+                    static constexpr size_t JOB_LATENCY_WINDOW = 1024;
+
                     //Stores the tasks pool
                     task_pool<trans_task> m_tasks_pool;
+                    //Stores the finished jobs latency monitor
+                    latency_monitor m_jobs_latency;
+                    //Stores the sentence translations cache
+                    trans_cache m_trans_cache;
                 };
             }
         }
@@ -59,7 +59,8 @@ namespace uva {
                      */
                     translation_server(const server_parameters &params)
                     : websocket_server<TLS_CLASS>(params),
-                    m_manager(params.m_num_threads), m_params(params) {
+                    m_manager(params.m_num_threads, params.m_priority_aging,
+                    params.m_trans_cache_size), m_params(params) {
                         //Initialize the supported languages and store the response for future use
                         supp_lang_resp_out supp_lang_resp;
                         //Add the supported languages
@@ -72,7 +73,7 @@ namespace uva {
                         m_supp_lang_resp = supp_lang_resp.serialize();
 
                         //Set the reply sending function to the translation manager
-                        m_manager.set_response_sender(bind(&translation_server::send_response, this, _1, _2));
+                        m_manager.set_response_sender(bind(&translation_server::send_msg_response, this, _1, _2));
                     }
 
                     /**
@@ -89,6 +90,14 @@ namespace uva {
                         m_manager.set_num_threads(num_threads);
                     }
 
+                    /**
+                     * @see cmd_line_client
+                     */
+                    virtual void notify_params_changed() override {
+                        //The cached translations were done with the old parameters
+                        m_manager.clear_trans_cache();
+                    }
+
                     /**
                      * @see cmd_line_client
                      */
@@ -111,7 +120,7 @@ namespace uva {
                      * @see websocket_server
                      */
                     virtual void open_session(websocketpp::connection_hdl hdl) override {
-                        m_manager.open_session(hdl);
+                        m_manager.open_session(hdl, this->is_bin_sub_protocol(hdl));
                     }
 
                     /**
@@ -160,7 +169,7 @@ namespace uva {
                             trans_job_resp_out response(job_id_val, status_code::RESULT_ERROR, error_msg);
 
                             //Send the response
-                            websocket_server<TLS_CLASS>::send_response(hdl, response.serialize());
+                            websocket_server<TLS_CLASS>::send_msg_response(hdl, response);
                         }
 
                         //Delete the request message
@@ -38,6 +38,8 @@ namespace uva {
                 const string balancer_parameters::SE_NUM_RESP_THREADS_PARAM_NAME = "num_resp_threads";
                 const string balancer_parameters::SE_TRANSLATION_SERVER_NAMES_PARAM_NAME = "translation_server_names";
                 const string balancer_parameters::SC_RECONNECT_TIME_OUT_PARAM_NAME = "reconnect_time_out";
+                const string balancer_parameters::SE_ROUTING_POLICY_PARAM_NAME = "routing_policy";
+                const string balancer_parameters::SE_DEF_ROUTING_POLICY = "least_work";
                 const string balancer_parameters::TRANS_SERV_NAMES_DELIMITER_STR = "|";
             }
         }
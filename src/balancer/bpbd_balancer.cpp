@@ -132,6 +132,9 @@ static void prepare_config_structures(const uint argc, char const * const * cons
                 balancer_parameters::SE_NUM_RESP_THREADS_PARAM_NAME);
         bl_params.m_recon_time_out = get_integer<uint32_t>(ini, section,
                 balancer_parameters::SC_RECONNECT_TIME_OUT_PARAM_NAME);
+        bl_params.m_routing_policy_name = get_string(ini, section,
+                balancer_parameters::SE_ROUTING_POLICY_PARAM_NAME,
+                balancer_parameters::SE_DEF_ROUTING_POLICY, false);
 
         //Get the translation server names
         vector<string> server_names;
@@ -177,6 +180,9 @@ static void prepare_config_structures(const uint argc, char const * const * cons
  */
 template<typename server_type>
 static void run_server(balancer_parameters & params) {
+    //Switch to the asynchronous logging, if configured
+    logger::start_async(params.m_log_buffer_size * 1024);
+
     //Instantiate the balancer server
     server_type server(params);
 
@@ -190,6 +196,9 @@ static void run_server(balancer_parameters & params) {
     //Wait until the balancer is stopped by pressing and exit button
     balancer_console cmd(params, server, balancer_thread);
     cmd.perform_command_loop();
+
+    //Write out the buffered log lines, the remaining ones are written right away
+    logger::stop_async();
 }
 
 /**
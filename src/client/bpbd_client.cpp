@@ -77,6 +77,8 @@ static ValueArg<uint32_t> * p_max_sent = NULL;
 static ValueArg<uint32_t> * p_min_sent = NULL;
 static ValueArg<int32_t> * p_priority = NULL;
 static SwitchArg * p_trans_info_arg = NULL;
+static SwitchArg * p_stream_arg = NULL;
+static SwitchArg * p_bin_msgs_arg = NULL;
 
 static ValueArg<string> * p_config_file_arg = NULL;
 
@@ -126,6 +128,14 @@ void create_arguments_parser() {
     p_trans_info_arg = new SwitchArg("f", "info", string("Request the server to provide ") +
             string("information about the translation process"), *p_cmd_args, client_parameters::CL_DEF_IS_TRANS_INFO_VAL);
 
+    //Add the results streaming switch parameter - optional, default is false
+    p_stream_arg = new SwitchArg("r", "stream", string("Request the server to stream the ") +
+            string("sentence results as they are translated"), *p_cmd_args, client_parameters::CL_DEF_IS_STREAM_VAL);
+
+    //Add the binary messages switch parameter - optional, default is false
+    p_bin_msgs_arg = new SwitchArg("b", "binary", string("Request the translation server to use the ") +
+            string("compact binary translation messages"), *p_cmd_args, client_parameters::CL_DEF_IS_BIN_MSGS_VAL);
+
     //Add the configuration file parameter - compulsory
     p_config_file_arg = new ValueArg<string>("c", "config", "The configuration file with the client options",
             false, "", "client configuration file", *p_cmd_args);
@@ -155,6 +165,8 @@ void destroy_arguments_parser() {
     SAFE_DESTROY(p_min_sent);
     SAFE_DESTROY(p_priority);
     SAFE_DESTROY(p_trans_info_arg);
+    SAFE_DESTROY(p_stream_arg);
+    SAFE_DESTROY(p_bin_msgs_arg);
 
     SAFE_DESTROY(p_config_file_arg);
 
@@ -207,6 +219,8 @@ static void extract_arguments(const uint argc, char const * const * const argv,
                     client_parameters::CL_PRIORITY_PARAM_NAME, client_parameters::CL_DEF_PRIORITY_VAL, false);
             tc_params.m_is_trans_info = get_bool(ini, section,
                     client_parameters::CL_IS_TRANS_INFO_PARAM_NAME, client_parameters::CL_DEF_IS_TRANS_INFO_VAL, false);
+            tc_params.m_is_stream = get_bool(ini, section,
+                    client_parameters::CL_IS_STREAM_PARAM_NAME, client_parameters::CL_DEF_IS_STREAM_VAL, false);
 
             //Parse the pre-processor server related parameters
             get_client_params<true>(ini,
@@ -239,6 +253,12 @@ static void extract_arguments(const uint argc, char const * const * const argv,
         if (p_trans_info_arg->isSet()) {
             tc_params.m_is_trans_info = p_trans_info_arg->getValue();
         }
+        if (p_stream_arg->isSet()) {
+            tc_params.m_is_stream = p_stream_arg->getValue();
+        }
+        if (p_bin_msgs_arg->isSet()) {
+            tc_params.m_trans_params.m_is_bin_msgs = p_bin_msgs_arg->getValue();
+        }
         if (p_transl_serv_arg->isSet()) {
             tc_params.m_trans_params.m_server_uri = p_transl_serv_arg->getValue();
         }
@@ -263,6 +283,8 @@ static void extract_arguments(const uint argc, char const * const * const argv,
         tc_params.m_max_sent = p_max_sent->getValue();
         tc_params.m_priority = p_priority->getValue();
         tc_params.m_is_trans_info = p_trans_info_arg->getValue();
+        tc_params.m_is_stream = p_stream_arg->getValue();
+        tc_params.m_trans_params.m_is_bin_msgs = p_bin_msgs_arg->getValue();
     }
 
     //Finalize the results
@@ -41,6 +41,8 @@ namespace uva {
                 const uint32_t client_parameters::CL_DEF_MAX_SENT_VAL = 100;
                 const int32_t client_parameters::CL_DEF_PRIORITY_VAL = 0;
                 const bool client_parameters::CL_DEF_IS_TRANS_INFO_VAL = false;
+                const bool client_parameters::CL_DEF_IS_STREAM_VAL = false;
+                const bool client_parameters::CL_DEF_IS_BIN_MSGS_VAL = false;
                 
                 const string client_parameters::CL_CONFIG_SECTION_NAME = "Client Options";
                 const string client_parameters::CL_PRE_PARAMS_SECTION_NAME = "Pre-processor Options";
@@ -51,6 +53,7 @@ namespace uva {
                 const string client_parameters::CL_MAX_SENT_PARAM_NAME = "max_sent_count";
                 const string client_parameters::CL_PRIORITY_PARAM_NAME = "job_priority";
                 const string client_parameters::CL_IS_TRANS_INFO_PARAM_NAME = "is_trans_info";
+                const string client_parameters::CL_IS_STREAM_PARAM_NAME = "is_stream";
             }
         }
     }
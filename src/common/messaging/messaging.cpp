@@ -45,6 +45,7 @@ namespace uva {
                     constexpr uint32_t msg_base::PROTOCOL_VERSION;
                     const char * msg_base::PROT_VER_FIELD_NAME = "prot_ver";
                     const char * msg_base::MSG_TYPE_FIELD_NAME = "msg_type";
+                    const char * msg_base::BIN_SUB_PROTOCOL_NAME = "bpbd.bin";
 
                     const char * response_msg::STAT_CODE_FIELD_NAME = "stat_code";
                     const char * response_msg::STAT_MSG_FIELD_NAME = "stat_msg";
@@ -54,15 +55,24 @@ namespace uva {
                     const char * trans_job_req::SOURCE_LANG_FIELD_NAME = "source_lang";
                     const char * trans_job_req::TARGET_LANG_FIELD_NAME = "target_lang";
                     const char * trans_job_req::IS_TRANS_INFO_FIELD_NAME = "is_trans_info";
+                    const char * trans_job_req::IS_STREAM_FIELD_NAME = "is_stream";
                     const char * trans_job_req::SOURCE_SENTENCES_FIELD_NAME = "source_sent";
+                    const char * trans_job_req::WEIGHTS_FIELD_NAME = "weights";
+                    const char * trans_job_req::LM_WEIGHT_FIELD_NAME = "lm";
+                    const char * trans_job_req::TM_WEIGHTS_FIELD_NAME = "tm";
+                    const char * trans_job_req::WP_WEIGHT_FIELD_NAME = "wp";
+                    const char * trans_job_req::RM_WEIGHTS_FIELD_NAME = "rm";
 
                     const char * supp_lang_resp::LANGUAGES_FIELD_NAME = "langs";
                     
                     const char * trans_job_resp::JOB_ID_FIELD_NAME = "job_id";
                     const char * trans_job_resp::TARGET_DATA_FIELD_NAME = "target_data";
+                    const char * trans_job_resp::SENT_IDX_FIELD_NAME = "sent_idx";
 
                     const char * trans_sent_data::TRANS_TEXT_FIELD_NAME = "trans_text";
                     const char * trans_sent_data::STACK_LOAD_FIELD_NAME = "stack_load";
+                    const char * trans_sent_data::STACK_STATES_FIELD_NAME = "stack_states";
+                    const char * trans_sent_data::STACK_MEM_FIELD_NAME = "stack_mem";
 
                     const char * proc_req::JOB_TOKEN_FIELD_NAME = "job_token";
                     const char * proc_req::PRIORITY_NAME = "priority";
@@ -46,6 +46,8 @@ namespace uva {
                         tls_val_to_str(tls_mode_enum::MOZILLA_MODERN) + string(")");
 
                         const string websocket_client_params::WC_TLS_CIPHERS_PARAM_NAME = "tls_ciphers";
+
+                        const string websocket_client_params::WC_IS_BIN_MSGS_PARAM_NAME = "is_bin_msgs";
                     }
                 }
             }
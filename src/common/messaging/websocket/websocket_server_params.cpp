@@ -52,6 +52,11 @@ namespace uva {
 
                         const string websocket_server_params::WS_TLS_DH_FILE_PARAM_NAME = "tls_tmp_dh_file";
                         const string websocket_server_params::WS_TLS_DH_FILE_REG_EXP_STR = ".*\\.pem$";
+
+                        const string websocket_server_params::WS_NUM_IO_THREADS_PARAM_NAME = "num_io_threads";
+                        constexpr uint16_t websocket_server_params::WS_DEF_NUM_IO_THREADS;
+                        const string websocket_server_params::WS_LOG_BUFFER_SIZE_PARAM_NAME = "log_buffer_size";
+                        constexpr uint32_t websocket_server_params::WS_DEF_LOG_BUFFER_SIZE;
                     }
                 }
             }
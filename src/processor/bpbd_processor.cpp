@@ -161,6 +161,9 @@ static void prepare_config_structures(const uint argc, char const * const * cons
  */
 template<typename server_type>
 static void run_server(processor_parameters & params) {
+        //Switch to the asynchronous logging, if configured
+        logger::start_async(params.m_log_buffer_size * 1024);
+
         //Instantiate the balancer server
         server_type server(params);
 
@@ -174,6 +177,9 @@ static void run_server(processor_parameters & params) {
         //Wait until the balancer is stopped by pressing and exit button
         processor_console cmd(params, server, balancer_thread);
         cmd.perform_command_loop();
+
+        //Write out the buffered log lines, the remaining ones are written right away
+        logger::stop_async();
 }
 
 /**
@@ -84,6 +84,8 @@ static ValueArg<string> * p_config_file_arg = NULL;
 static vector<string> debug_levels;
 static ValuesConstraint<string> * p_debug_levels_constr = NULL;
 static ValueArg<string> * p_debug_level_arg = NULL;
+static ValueArg<string> * p_tm_image_arg = NULL;
+static ValueArg<string> * p_rm_image_arg = NULL;
 #if IS_SERVER_TUNING_MODE
 static SwitchArg * p_gen_fmap_arg = NULL;
 #endif
@@ -107,6 +109,16 @@ void create_arguments_parser() {
             "The debug level to be used", false,
             RESULT_PARAM_VALUE, p_debug_levels_constr, *p_cmd_args);
 
+    //Add the -t the translation model binary image file parameter - optional
+    p_tm_image_arg = new ValueArg<string>("t", "tm-image",
+            "Store the loaded translation model binary image into the given file and exit", false,
+            "", "translation model image file", *p_cmd_args);
+
+    //Add the -r the reordering model binary image file parameter - optional
+    p_rm_image_arg = new ValueArg<string>("r", "rm-image",
+            "Store the loaded reordering model binary image into the given file and exit", false,
+            "", "reordering model image file", *p_cmd_args);
+
 #if IS_SERVER_TUNING_MODE
     //Add the translation details switch parameter - ostring(optional, default is false
     p_gen_fmap_arg = new SwitchArg("f", "feature",
@@ -122,6 +134,8 @@ void destroy_arguments_parser() {
     SAFE_DESTROY(p_config_file_arg);
     SAFE_DESTROY(p_debug_levels_constr);
     SAFE_DESTROY(p_debug_level_arg);
+    SAFE_DESTROY(p_tm_image_arg);
+    SAFE_DESTROY(p_rm_image_arg);
 #if IS_SERVER_TUNING_MODE
     SAFE_DESTROY(p_gen_fmap_arg);
 #endif
@@ -200,6 +214,11 @@ static void parse_config_file(
         
         ts_params.m_num_threads = get_integer<uint16_t>(ini, section,
                 server_parameters::SE_NUM_THREADS_PARAM_NAME);
+        ts_params.m_priority_aging = get_float(ini, section,
+                server_parameters::SE_PRIORITY_AGING_PARAM_NAME, 0.0f, false);
+        ts_params.m_trans_cache_size = get_integer<size_t>(ini, section,
+                server_parameters::SE_TRANS_CACHE_SIZE_PARAM_NAME,
+                server_parameters::SE_DEF_TRANS_CACHE_SIZE, false);
         ts_params.m_source_lang = get_string(ini, section,
                 server_parameters::SE_SOURCE_LANG_PARAM_NAME);
         ts_params.m_target_lang = get_string(ini, section,
@@ -215,6 +234,14 @@ static void parse_config_file(
                 LM_FEATURE_WEIGHTS_DELIMITER_STR);
         ts_params.m_lm_params.m_unk_word_log_e_prob = get_float(ini, section,
                 lm_parameters::LM_UNK_WORD_LOG_E_PROB_PARAM_NAME);
+        ts_params.m_lm_params.m_query_cache_size = get_integer<uint32_t>(ini, section,
+                lm_parameters::LM_QUERY_CACHE_SIZE_PARAM_NAME,
+                lm_parameters::LM_DEF_QUERY_CACHE_SIZE, false);
+        ts_params.m_lm_params.m_num_load_threads = get_integer<uint32_t>(ini, section,
+                lm_parameters::LM_NUM_LOAD_THREADS_PARAM_NAME,
+                lm_parameters::LM_DEF_NUM_LOAD_THREADS, false);
+        ts_params.m_lm_params.m_is_verify_keys = get_bool(ini, section,
+                lm_parameters::LM_IS_VERIFY_KEYS_PARAM_NAME, false, false);
 
         section = tm_parameters::TM_CONFIG_SECTION_NAME;
         ts_params.m_tm_params.m_conn_string = get_string(ini, section,
@@ -235,6 +262,8 @@ static void parse_config_file(
                 tm_parameters::TM_MIN_TRANS_PROB_PARAM_NAME);
         ts_params.m_tm_params.m_wp_lambda = get_float(ini, section,
                 tm_parameters::TM_WORD_PENALTY_PARAM_NAME);
+        ts_params.m_tm_params.m_filter_file = get_string(ini, section,
+                tm_parameters::TM_FILTER_FILE_PARAM_NAME, "", false);
 
         section = rm_parameters::RM_CONFIG_SECTION_NAME;
         ts_params.m_rm_params.m_conn_string = get_string(ini, section,
@@ -260,6 +289,21 @@ static void parse_config_file(
                 de_parameters::DE_DIST_LIMIT_PARAM_NAME);
         ts_params.m_de_params.m_is_gen_lattice = get_bool(ini, section,
                 de_parameters::DE_IS_GEN_LATTICE_PARAM_NAME);
+        ts_params.m_de_params.m_stack_level_type = get_string(ini, section,
+                de_parameters::DE_STACK_LEVEL_TYPE_PARAM_NAME,
+                de_parameters::DE_LIST_STACK_LEVEL_TYPE, false);
+        ts_params.m_de_params.m_expansion_mode = get_string(ini, section,
+                de_parameters::DE_EXPANSION_MODE_PARAM_NAME,
+                de_parameters::DE_FULL_EXPANSION_MODE, false);
+        ts_params.m_de_params.m_cube_pop_limit = get_integer<uint32_t>(ini, section,
+                de_parameters::DE_CUBE_POP_LIMIT_PARAM_NAME,
+                de_parameters::DE_DEF_CUBE_POP_LIMIT, false);
+        ts_params.m_de_params.m_num_expand_threads = get_integer<uint32_t>(ini, section,
+                de_parameters::DE_NUM_EXPAND_THREADS_PARAM_NAME, 1, false);
+        ts_params.m_de_params.m_is_reord_future_cost = get_bool(ini, section,
+                de_parameters::DE_IS_REORD_FUTURE_COST_PARAM_NAME, false, false);
+        ts_params.m_de_params.m_trans_limit = get_integer<uint32_t>(ini, section,
+                de_parameters::DE_TRANS_LIMIT_PARAM_NAME, 0, false);
 #if IS_SERVER_TUNING_MODE
         ts_params.m_de_params.m_li2n_file_ext = get_string(ini, section,
                 de_parameters::DE_LI2N_FILE_EXT_PARAM_NAME);
@@ -319,6 +363,14 @@ static void prepare_config_structures(const uint argc, char const * const * cons
     params.m_is_only_f2id = false;
 #endif
 
+    //Get the model image file names, if any
+    params.m_tm_image_file_name = p_tm_image_arg->getValue();
+    params.m_rm_image_file_name = p_rm_image_arg->getValue();
+
+    //The translation model image refers to the reordering model entries
+    ASSERT_CONDITION_THROW((!params.m_tm_image_file_name.empty() && params.m_rm_image_file_name.empty()),
+            "The translation model image must be created together with the reordering model image, use -r as well!");
+
     //Get the configuration file name and read the config values from the file
     const string config_file_name = p_config_file_arg->getValue();
     parse_config_file(config_file_name, params);
@@ -359,12 +411,34 @@ void disconnect_from_models() {
     de_configurator::disconnect();
 }
 
+/**
+ * Allows to store the binary images of the translation and reordering models, if requested
+ * @param params the server parameters
+ * @return true if at least one binary image was requested and stored, otherwise false
+ */
+static bool write_model_images(const server_parameters & params) {
+    //Store the translation model binary image if requested
+    if (!params.m_tm_image_file_name.empty()) {
+        tm_configurator::write_model_image(params.m_tm_image_file_name);
+    }
+
+    //Store the reordering model binary image if requested
+    if (!params.m_rm_image_file_name.empty()) {
+        rm_configurator::write_model_image(params.m_rm_image_file_name);
+    }
+
+    return !params.m_tm_image_file_name.empty() || !params.m_rm_image_file_name.empty();
+}
+
 /**
  * Allows to run the server of the given type
  * @param params the server parameters
  */
 template<typename server_type>
 static void run_server(server_parameters & params) {
+    //Switch to the asynchronous logging, if configured
+    logger::start_async(params.m_log_buffer_size * 1024);
+
     //Instantiate the translation server
     server_type server(params);
 
@@ -376,6 +450,9 @@ static void run_server(server_parameters & params) {
     //Wait until the server is stopped by pressing and exit button
     server_console cmd(params, server, server_thread);
     cmd.perform_command_loop();
+
+    //Write out the buffered log lines, the remaining ones are written right away
+    logger::stop_async();
 }
 
 /**
@@ -407,8 +484,10 @@ int main(int argc, char** argv) {
             //Initialize connections to the used models
             connect_to_models(params);
 
-            //Run the server
-            if (params.m_is_tls_server) {
+            //Run the server, unless we were only requested to store the model images
+            if (write_model_images(params)) {
+                LOG_USAGE << "We were only requested to store the model binary images, exiting!" << END_LOG;
+            } else if (params.m_is_tls_server) {
 #if defined(WITH_TLS) && WITH_TLS
                 run_server<translation_server_tls_mod>(params);
 #else
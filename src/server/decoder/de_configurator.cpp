@@ -32,6 +32,7 @@ namespace uva {
                 namespace decoder {
                     //Just give a default initialization
                     const de_parameters * de_configurator::m_params = NULL;
+                    fork_join_pool * de_configurator::m_expand_pool = NULL;
                 }
             }
         }
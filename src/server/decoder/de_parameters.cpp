@@ -37,6 +37,16 @@ namespace uva {
                     const string de_parameters_struct::DE_MAX_TP_LEN_PARAM_NAME = "de_max_target_phrase_length";
                     const string de_parameters_struct::DE_DIST_LIMIT_PARAM_NAME = "de_dist_lim";
                     const string de_parameters_struct::DE_LD_PENALTY_PARAM_NAME = "de_lin_dist_penalty";
+                    const string de_parameters_struct::DE_STACK_LEVEL_TYPE_PARAM_NAME = "de_stack_level_type";
+                    const string de_parameters_struct::DE_LIST_STACK_LEVEL_TYPE = "list";
+                    const string de_parameters_struct::DE_HASH_STACK_LEVEL_TYPE = "hash";
+                    const string de_parameters_struct::DE_EXPANSION_MODE_PARAM_NAME = "de_expansion_mode";
+                    const string de_parameters_struct::DE_FULL_EXPANSION_MODE = "full";
+                    const string de_parameters_struct::DE_CUBE_EXPANSION_MODE = "cube";
+                    const string de_parameters_struct::DE_CUBE_POP_LIMIT_PARAM_NAME = "de_cube_pop_limit";
+                    const string de_parameters_struct::DE_NUM_EXPAND_THREADS_PARAM_NAME = "de_num_expand_threads";
+                    const string de_parameters_struct::DE_IS_REORD_FUTURE_COST_PARAM_NAME = "de_is_reordering_future_cost";
+                    const string de_parameters_struct::DE_TRANS_LIMIT_PARAM_NAME = "de_trans_limit";
                     const string de_parameters_struct::DE_IS_GEN_LATTICE_PARAM_NAME = "de_is_gen_lattice";
                     const string de_parameters_struct::DE_LATTICES_FOLDER_PARAM_NAME = "de_lattices_folder";
                     const string de_parameters_struct::DE_LI2N_FILE_EXT_PARAM_NAME = "de_lattice_id2name_file_ext";
@@ -44,6 +54,7 @@ namespace uva {
                     const string de_parameters_struct::DE_LATTICE_FILE_EXT_PARAM_NAME = "de_lattice_file_ext";
 
                     size_t de_parameters_struct::DE_LD_PENALTY_GLOBAL_ID = 0;
+                    constexpr uint32_t de_parameters_struct::DE_DEF_CUBE_POP_LIMIT;
 
                 }
             }
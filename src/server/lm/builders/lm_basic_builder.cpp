@@ -56,16 +56,22 @@ namespace uva {
 
                         template<typename trie_type, typename reader_type>
                         lm_basic_builder<trie_type, reader_type>::lm_basic_builder(const lm_parameters & params, trie_type & trie, reader_type & file)
-                        : m_params(params), m_trie(trie), m_file(file), m_line(), m_ng_amount_reg_exp("ngram [[:d:]]+=[[:d:]]+") {
+                        : m_params(params), m_trie(trie), m_file(file), m_line(), m_ng_amount_reg_exp("ngram [[:d:]]+=[[:d:]]+"),
+                        m_pool((params.m_num_load_threads > 1) ? new fork_join_pool(params.m_num_load_threads - 1) : NULL) {
                         }
 
                         template<typename trie_type, typename reader_type>
                         lm_basic_builder<trie_type, reader_type>::lm_basic_builder(const lm_basic_builder<trie_type, reader_type>& orig)
-                        : m_params(orig.m_params), m_trie(orig.m_trie), m_file(orig.m_file), m_line(orig.m_line), m_ng_amount_reg_exp("ngram [[:d:]]+=[[:d:]]+") {
+                        : m_params(orig.m_params), m_trie(orig.m_trie), m_file(orig.m_file), m_line(orig.m_line), m_ng_amount_reg_exp("ngram [[:d:]]+=[[:d:]]+"),
+                        m_pool(NULL) {
                         }
 
                         template<typename trie_type, typename reader_type>
                         lm_basic_builder<trie_type, reader_type>::~lm_basic_builder() {
+                            if (m_pool != NULL) {
+                                delete m_pool;
+                                m_pool = NULL;
+                            }
                         }
 
                         template<typename trie_type, typename reader_type>
@@ -191,11 +197,17 @@ namespace uva {
                         }
 
                         template<typename trie_type, typename reader_type>
-                        template<phrase_length CURR_LEVEL, bool is_mult_weight>
+                        template<phrase_length CURR_LEVEL>
                         void lm_basic_builder<trie_type, reader_type>::read_m_gram_level() {
+                            //The uni-grams are registered in the word index, so they are always read sequentially
+                            if ((CURR_LEVEL > M_GRAM_LEVEL_1) && (m_pool != NULL)) {
+                                read_m_gram_level_parallel<CURR_LEVEL>();
+                                return;
+                            }
+
                             //Declare the pointer to the N-Grma builder
-                            lm_gram_builder<WordIndexType, CURR_LEVEL, is_mult_weight> *gram_builder_ptr = NULL;
-                            lm_gram_builder_factory<trie_type>::template get_builder<CURR_LEVEL, is_mult_weight>(m_params, m_trie, &gram_builder_ptr);
+                            lm_gram_builder<WordIndexType, CURR_LEVEL> *gram_builder_ptr = NULL;
+                            lm_gram_builder_factory<trie_type>::template get_builder<CURR_LEVEL>(m_params, m_trie, &gram_builder_ptr);
 
                             try {
                                 //The counter of the N-grams
@@ -246,6 +258,107 @@ namespace uva {
                             logger::stop_progress_bar();
                         }
 
+                        template<typename trie_type, typename reader_type>
+                        template<phrase_length CURR_LEVEL>
+                        void lm_basic_builder<trie_type, reader_type>::read_m_gram_level_parallel() {
+                            typedef lm_gram_builder<WordIndexType, CURR_LEVEL> gram_builder;
+
+                            //Get the number of parts to split every batch of lines into
+                            const size_t num_parts = m_pool->get_num_threads();
+                            const size_t max_num_lines = num_parts * NUM_LINES_PER_LOAD_PART;
+
+                            //Declare the N-gram builders, one per part, each has its own parsing buffers
+                            vector<gram_builder *> builders(num_parts, NULL);
+                            //Declare the batch lines text, the file reader may re-use its line buffer so the lines are copied
+                            vector<char> text;
+                            //Declare the batch lines, the begin offsets in the text and the lengths
+                            vector<pair<size_t, size_t>> lines;
+                            lines.reserve(max_num_lines);
+                            //Declare the batch M-grams and the lines parsing results, the M-grams
+                            //are constructed in place as they store pointers to their own data
+                            vector<model_m_gram> grams;
+                            grams.reserve(max_num_lines);
+                            for (size_t idx = 0; idx < max_num_lines; ++idx) {
+                                grams.emplace_back(CURR_LEVEL);
+                            }
+                            vector<uint8_t> is_not_parsed(max_num_lines, false);
+
+                            try {
+                                for (size_t idx = 0; idx < num_parts; ++idx) {
+                                    lm_gram_builder_factory<trie_type>::template get_builder<CURR_LEVEL>(m_params, m_trie, &builders[idx]);
+                                }
+
+                                //The counter of the N-grams
+                                size_t num_m_grams = 0;
+                                bool is_section_end = false;
+                                while (!is_section_end) {
+                                    //Read the next batch of lines, until the next section header or the end tag
+                                    text.clear();
+                                    lines.clear();
+                                    while (lines.size() < max_num_lines) {
+                                        if (!m_file.get_first_line(m_line)) {
+                                            //If the next line does not exist then it an error as we expect the end of data section any way
+                                            stringstream msg;
+                                            msg << "Incorrect ARPA format: Unexpected end of file, missing the '" << END_OF_ARPA_FILE << "' tag!";
+                                            THROW_EXCEPTION(msg.str());
+                                        }
+
+                                        //Empty lines will just be skipped
+                                        if (m_line.has_more()) {
+                                            //The M-gram lines start with a probability, the section headers with a back slash
+                                            if (m_line[0] == '\\') {
+                                                is_section_end = true;
+                                                break;
+                                            }
+                                            lines.push_back(make_pair(text.size(), m_line.length()));
+                                            text.insert(text.end(), m_line.get_begin_c_str(), m_line.get_begin_c_str() + m_line.length());
+                                        }
+
+                                        //Update the progress bar status
+                                        logger::update_progress_bar();
+                                    }
+
+                                    //Parse the lines in parallel, every part gets a contiguous range of lines
+                                    const size_t num_lines = lines.size();
+                                    m_pool->run(num_parts, [&](const size_t part_idx) {
+                                        text_piece_reader line;
+                                        const size_t end_idx = ((part_idx + 1) * num_lines) / num_parts;
+                                        for (size_t idx = (part_idx * num_lines) / num_parts; idx < end_idx; ++idx) {
+                                            line.set(text.data() + lines[idx].first, lines[idx].second);
+                                            is_not_parsed[idx] = builders[part_idx]->parse_line(line, grams[idx]);
+                                        }
+                                    });
+
+                                    //Add the parsed M-grams to the trie in the order of the file
+                                    for (size_t idx = 0; idx < num_lines; ++idx) {
+                                        ASSERT_CONDITION_THROW(is_not_parsed[idx], string("Incorrect ARPA format: Got '") +
+                                                string(text.data() + lines[idx].first, lines[idx].second) +
+                                                string("' when reading the ") + to_string(CURR_LEVEL) + string("-grams section!"));
+                                        m_trie.template add_m_gram<CURR_LEVEL>(grams[idx]);
+                                    }
+                                    num_m_grams += num_lines;
+                                }
+
+                                LOG_DEBUG << "Actual number of " << CURR_LEVEL << "-grams is: " << num_m_grams << END_LOG;
+                            } catch (...) {
+                                //Free the allocated N-gram builders in case of an exception 
+                                for (gram_builder * builder : builders) {
+                                    delete builder;
+                                }
+                                //Re-throw an exception, do not use the exception object as it would
+                                //create a copy of it loosing all needed additional information.
+                                throw;
+                            }
+                            //Free the allocated N-gram builders in case of no exception 
+                            for (gram_builder * builder : builders) {
+                                delete builder;
+                            }
+
+                            LOG_DEBUG << "Finished reading ARPA " << CURR_LEVEL << "-Grams using " << num_parts << " threads." << END_LOG;
+                            //Stop the progress bar in case of no exception
+                            logger::stop_progress_bar();
+                        }
+
                         template<typename trie_type, typename reader_type>
                         template<phrase_length CURR_LEVEL>
                         void lm_basic_builder<trie_type, reader_type>::do_post_m_gram_actions() {
@@ -269,7 +382,12 @@ namespace uva {
 
                         template<typename trie_type, typename reader_type>
                         void lm_basic_builder<trie_type, reader_type>::get_word_counts() {
-                            //Check if we need another pass for words counting.
+                            //Check if we need another pass for words counting. The counting word indexes
+                            //issue the word ids in the order of the counts, and the 1-grams can only be
+                            //added once all the ids are issued, so the counts can not be obtained while
+                            //reading the 1-grams. Only the headers and the 1-grams are read twice, the
+                            //counting stops at the end of the 1-grams section, and the M-gram levels
+                            //M > 1 are read once.
                             if (m_trie.get_word_index().is_word_counts_needed()) {
                                 //Do the progress bard indicator
                                 logger::start_progress_bar(string("Counting all words"));
@@ -325,14 +443,9 @@ namespace uva {
 
                             //Check if the line that was input is the header of the N-grams section for N=level
                             if (regex_match(m_line.str(), n_gram_sect_reg_exp)) {
-                                //Check if we need to multiply with the m-gram weight
-                                if (m_params.m_is_0_lm_weight) {
-                                    //Read the M-grams of the given level
-                                    read_m_gram_level<CURR_LEVEL, true>();
-                                } else {
-                                    //Read the M-grams of the given level
-                                    read_m_gram_level<CURR_LEVEL, false>();
-                                }
+                                //Read the M-grams of the given level, the lambda
+                                //weight is applied when the model is queried
+                                read_m_gram_level<CURR_LEVEL>();
 
                                 //If the first M-gram level has been read then do
                                 //the word index post-actions if needed.
@@ -386,7 +499,7 @@ namespace uva {
                                     if (m_line.has_more()) {
                                         //Parse line to words without probabilities and back-offs
                                         //If it is not the M-gram line then we stop break
-                                        if (lm_gram_builder<WordIndexType, M_GRAM_LEVEL_1, false>::unigram_to_prob(m_line, word, prob)) {
+                                        if (lm_gram_builder<WordIndexType, M_GRAM_LEVEL_1>::unigram_to_prob(m_line, word, prob)) {
                                             //Set the word with its probability into the word index
                                             word_index.count_word(word, prob);
                                             //Update the progress bar status
@@ -440,12 +553,6 @@ namespace uva {
 
                             LOG_DEBUG << "LM default UNK word prob weight: " << unk_prob << END_LOG;
 
-                            //Check if there is a lambda to multiply with
-                            if (m_params.m_is_0_lm_weight) {
-                                LOG_DEBUG << "LM weight: " << m_params.get_0_lm_weight() << END_LOG;
-                                unk_prob *= m_params.get_0_lm_weight();
-                            }
-                            
                             //Set the probability weight
                             m_trie.set_def_unk_word_prob(unk_prob);
                         }
@@ -52,51 +52,45 @@ namespace uva {
                 namespace lm {
                     namespace arpa {
 
-                        template<typename WordIndexType, phrase_length CURR_LEVEL, bool is_mult_weight>
-                        const unsigned short int lm_gram_builder<WordIndexType, CURR_LEVEL, is_mult_weight>::MIN_NUM_TOKENS_NGRAM_STR = 2;
-                        template<typename WordIndexType, phrase_length CURR_LEVEL, bool is_mult_weight>
-                        const unsigned short int lm_gram_builder<WordIndexType, CURR_LEVEL, is_mult_weight>::MAX_NUM_TOKENS_NGRAM_STR = 3;
+                        template<typename WordIndexType, phrase_length CURR_LEVEL>
+                        const unsigned short int lm_gram_builder<WordIndexType, CURR_LEVEL>::MIN_NUM_TOKENS_NGRAM_STR = 2;
+                        template<typename WordIndexType, phrase_length CURR_LEVEL>
+                        const unsigned short int lm_gram_builder<WordIndexType, CURR_LEVEL>::MAX_NUM_TOKENS_NGRAM_STR = 3;
 
-                        template<typename WordIndexType, phrase_length CURR_LEVEL, bool is_mult_weight>
-                        lm_gram_builder<WordIndexType, CURR_LEVEL, is_mult_weight>::lm_gram_builder(const lm_parameters & params, WordIndexType & word_index, typename TAddGramFunct<WordIndexType>::func add_garm_func)
+                        template<typename WordIndexType, phrase_length CURR_LEVEL>
+                        lm_gram_builder<WordIndexType, CURR_LEVEL>::lm_gram_builder(const lm_parameters & params, WordIndexType & word_index, typename TAddGramFunct<WordIndexType>::func add_garm_func)
                         : m_params(params), m_word_idx(word_index), m_add_garm_func(add_garm_func), m_token(), m_m_gram(CURR_LEVEL) {
                             LOG_DEBUG2 << "Constructing ARPANGramBuilder(" << CURR_LEVEL << ", trie)" << END_LOG;
                         }
 
-                        template<typename WordIndexType, phrase_length CURR_LEVEL, bool is_mult_weight>
-                        lm_gram_builder<WordIndexType, CURR_LEVEL, is_mult_weight>::lm_gram_builder(const lm_gram_builder<WordIndexType, CURR_LEVEL, is_mult_weight>& orig)
+                        template<typename WordIndexType, phrase_length CURR_LEVEL>
+                        lm_gram_builder<WordIndexType, CURR_LEVEL>::lm_gram_builder(const lm_gram_builder<WordIndexType, CURR_LEVEL>& orig)
                         : m_params(orig.m_params), m_word_idx(orig.m_word_idx), m_add_garm_func(orig.m_add_garm_func), m_token(), m_m_gram(CURR_LEVEL) {
                         }
 
-                        template<typename WordIndexType, phrase_length CURR_LEVEL, bool is_mult_weight>
-                        lm_gram_builder<WordIndexType, CURR_LEVEL, is_mult_weight>::~lm_gram_builder() {
+                        template<typename WordIndexType, phrase_length CURR_LEVEL>
+                        lm_gram_builder<WordIndexType, CURR_LEVEL>::~lm_gram_builder() {
                         }
 
-                        template<typename WordIndexType, phrase_length CURR_LEVEL, bool is_mult_weight>
-                        bool lm_gram_builder<WordIndexType, CURR_LEVEL, is_mult_weight>::parse_to_gram(text_piece_reader &line) {
+                        template<typename WordIndexType, phrase_length CURR_LEVEL>
+                        bool lm_gram_builder<WordIndexType, CURR_LEVEL>::parse_to_gram(text_piece_reader &line, model_m_gram & m_gram) {
                             //Read the first element until the tab, we read until the tab because it should be the probability
                             if (line.get_first_tab(m_token)) {
                                 //Try to parse the probability to float
-                                if (fast_s_to_f(m_m_gram.m_payload.m_prob, m_token.get_rest_c_str())) {
-                                    LOG_DEBUG2 << "Parsed the N-gram log_10 probability: " << m_m_gram.m_payload.m_prob << END_LOG;
+                                if (fast_s_to_f(m_gram.m_payload.m_prob, m_token.get_rest_c_str())) {
+                                    LOG_DEBUG2 << "Parsed the N-gram log_10 probability: " << m_gram.m_payload.m_prob << END_LOG;
 
                                     //Convert the log_10 probability into the log_e probability weight
-                                    log_10_to_log_e_scale(m_m_gram.m_payload.m_prob);
+                                    log_10_to_log_e_scale(m_gram.m_payload.m_prob);
 
-                                    LOG_DEBUG2 << "Converted the N-gram log_e probability: " << m_m_gram.m_payload.m_prob << END_LOG;
-
-                                    //In case we need to multiply with the lambda weight do it now;
-                                    if (is_mult_weight) {
-                                        m_m_gram.m_payload.m_prob *= m_params.get_0_lm_weight();
-                                        LOG_DEBUG2 << "Weighted N-gram probability: " << m_m_gram.m_payload.m_back << END_LOG;
-                                    }
+                                    LOG_DEBUG2 << "Converted the N-gram log_e probability: " << m_gram.m_payload.m_prob << END_LOG;
 
                                     //Start the new m-gram
-                                    m_m_gram.start_new_m_gram();
+                                    m_gram.start_new_m_gram();
 
                                     //Read the first N-1 tokens of the N-gram - space separated
                                     for (int i = 0; i < (CURR_LEVEL - 1); i++) {
-                                        if (!line.get_first_space(m_m_gram.get_next_new_token())) {
+                                        if (!line.get_first_space(m_gram.get_next_new_token())) {
                                             LOG_WARNING << "An unexpected end of line '" << line.str()
                                                     << "' when reading the " << (i + 1)
                                                     << "'th " << CURR_LEVEL << "-gram token!" << END_LOG;
@@ -106,7 +100,7 @@ namespace uva {
                                     }
 
                                     //Read the last token of the N-gram, which is followed by the new line or a tab
-                                    if (!line.get_first_tab(m_m_gram.get_next_new_token())) {
+                                    if (!line.get_first_tab(m_gram.get_next_new_token())) {
                                         LOG_WARNING << "An unexpected end of line '" << line.str()
                                                 << "' when reading the " << CURR_LEVEL << "'th "
                                                 << CURR_LEVEL << "-gram token!" << END_LOG;
@@ -117,7 +111,7 @@ namespace uva {
                                     //Now if there is something left it should be the back-off weight, otherwise we are done
                                     if (line.has_more()) {
                                         //Take the remainder of the line and try to parse it!
-                                        if (!fast_s_to_f(m_m_gram.m_payload.m_back, line.get_rest_c_str())) {
+                                        if (!fast_s_to_f(m_gram.m_payload.m_back, line.get_rest_c_str())) {
                                             LOG_WARNING << "Could not parse the remainder of the line '" << line.str()
                                                     << "' as a back-off weight!" << END_LOG;
                                             //The first token was not a float, need to skip to another N-Gram section(?)
@@ -125,20 +119,14 @@ namespace uva {
                                         }
 
                                         //Convert the log_10 probability into the log_e probability weight
-                                        log_10_to_log_e_scale(m_m_gram.m_payload.m_back);
-
-                                        LOG_DEBUG2 << "Parsed the N-gram log_e back-off weight: " << m_m_gram.m_payload.m_back << END_LOG;
+                                        log_10_to_log_e_scale(m_gram.m_payload.m_back);
 
-                                        //In case we need to multiply with the lambda weight do it now;
-                                        if (is_mult_weight) {
-                                            m_m_gram.m_payload.m_back *= m_params.get_0_lm_weight();
-                                            LOG_DEBUG2 << "Weighted N-gram back-off weight: " << m_m_gram.m_payload.m_back << END_LOG;
-                                        }
+                                        LOG_DEBUG2 << "Parsed the N-gram log_e back-off weight: " << m_gram.m_payload.m_back << END_LOG;
                                     } else {
                                         //There is no back-off so set it to zero
-                                        m_m_gram.m_payload.m_back = 0.0;
+                                        m_gram.m_payload.m_back = 0.0;
                                         LOG_DEBUG2 << "The parsed N-gram '" << line.str()
-                                                << "' does not have back-off using: " << m_m_gram.m_payload.m_back << END_LOG;
+                                                << "' does not have back-off using: " << m_gram.m_payload.m_back << END_LOG;
                                     }
 
                                     return true;
@@ -163,29 +151,39 @@ namespace uva {
                             }
                         }
 
-                        template<typename WordIndexType, phrase_length CURR_LEVEL, bool is_mult_weight>
-                        bool lm_gram_builder<WordIndexType, CURR_LEVEL, is_mult_weight>::parse_line(text_piece_reader & line) {
+                        template<typename WordIndexType, phrase_length CURR_LEVEL>
+                        bool lm_gram_builder<WordIndexType, CURR_LEVEL>::parse_line(text_piece_reader & line) {
+                            //Parse the line into the local m-gram
+                            if (parse_line(line, m_m_gram)) {
+                                return true;
+                            }
+
+                            //Add the obtained N-gram data to the Trie
+                            m_add_garm_func(m_m_gram);
+
+                            return false;
+                        }
+
+                        template<typename WordIndexType, phrase_length CURR_LEVEL>
+                        bool lm_gram_builder<WordIndexType, CURR_LEVEL>::parse_line(text_piece_reader & line, model_m_gram & m_gram) {
                             LOG_DEBUG << "Processing the " << CURR_LEVEL << "-Gram (?) line: '" << line << "'" << END_LOG;
                             //We expect a good input, so the result is set to false by default.
                             bool result = false;
 
                             //First tokenize as a pattern "prob \t gram \t back-off"
-                            if (parse_to_gram(line)) {
+                            if (parse_to_gram(line, m_gram)) {
                                 //Prepare the N-gram and for being added to the trie
-                                m_m_gram.template prepare_for_adding<WordIndexType>(m_word_idx);
+                                m_gram.template prepare_for_adding<WordIndexType>(m_word_idx);
 
                                 //Check if we are adding an <s> tag, then set the probability to zero
                                 if(CURR_LEVEL == M_GRAM_LEVEL_1) {
-                                    if(m_m_gram.is_sentence_begin()) {
-                                        m_m_gram.m_payload.m_prob = 0.0;
+                                    if(m_gram.is_sentence_begin()) {
+                                        m_gram.m_payload.m_prob = 0.0;
                                     }
                                 }
                                 
-                                LOG_DEBUG << "Adding a " << SSTR(CURR_LEVEL) << "-Gram " << m_m_gram << END_LOG;
-                                ASSERT_SANITY_THROW(isinf(m_m_gram.m_payload.m_prob), "Infinity in m-gram probability!");
-
-                                //Add the obtained N-gram data to the Trie
-                                m_add_garm_func(m_m_gram);
+                                LOG_DEBUG << "Parsed a " << SSTR(CURR_LEVEL) << "-Gram " << m_gram << END_LOG;
+                                ASSERT_SANITY_THROW(isinf(m_gram.m_payload.m_prob), "Infinity in m-gram probability!");
                             } else {
                                 //If we could not parse the line to gram then it should
                                 //be the beginning of the next m-gram section
@@ -200,16 +198,12 @@ namespace uva {
 
                         //Make sure that there will be templates instantiated, at least for the given parameter values
 
-#define INSTANTIATE_ARPA_GRAM_BUILDER_LEVEL_WEIGHT(LEVEL, IS_MULT_WEIGHT) \
-                template class lm_gram_builder<basic_word_index, LEVEL, IS_MULT_WEIGHT>; \
-                template class lm_gram_builder<counting_word_index, LEVEL, IS_MULT_WEIGHT>; \
-                template class lm_gram_builder<hashing_word_index, LEVEL, IS_MULT_WEIGHT>; \
-                template class lm_gram_builder<basic_optimizing_word_index, LEVEL, IS_MULT_WEIGHT>; \
-                template class lm_gram_builder<counting_optimizing_word_index, LEVEL, IS_MULT_WEIGHT>;
-
 #define INSTANTIATE_ARPA_GRAM_BUILDER_LEVEL(LEVEL) \
-                INSTANTIATE_ARPA_GRAM_BUILDER_LEVEL_WEIGHT(LEVEL, true); \
-                INSTANTIATE_ARPA_GRAM_BUILDER_LEVEL_WEIGHT(LEVEL, false);
+                template class lm_gram_builder<basic_word_index, LEVEL>; \
+                template class lm_gram_builder<counting_word_index, LEVEL>; \
+                template class lm_gram_builder<hashing_word_index, LEVEL>; \
+                template class lm_gram_builder<basic_optimizing_word_index, LEVEL>; \
+                template class lm_gram_builder<counting_optimizing_word_index, LEVEL>;
 
                         INSTANTIATE_ARPA_GRAM_BUILDER_LEVEL(M_GRAM_LEVEL_1);
                         INSTANTIATE_ARPA_GRAM_BUILDER_LEVEL(M_GRAM_LEVEL_2);
@@ -38,6 +38,11 @@ namespace uva {
                     };
                     size_t lm_parameters_struct::LM_WEIGHT_GLOBAL_IDS[MAX_NUM_LM_FEATURES] = {};
                     const string lm_parameters_struct::LM_UNK_WORD_LOG_E_PROB_PARAM_NAME = "unk_word_log_e_prob";
+                    const string lm_parameters_struct::LM_QUERY_CACHE_SIZE_PARAM_NAME = "lm_query_cache_size";
+                    constexpr uint32_t lm_parameters_struct::LM_DEF_QUERY_CACHE_SIZE;
+                    const string lm_parameters_struct::LM_NUM_LOAD_THREADS_PARAM_NAME = "lm_num_load_threads";
+                    constexpr uint32_t lm_parameters_struct::LM_DEF_NUM_LOAD_THREADS;
+                    const string lm_parameters_struct::LM_IS_VERIFY_KEYS_PARAM_NAME = "lm_verify_m_gram_keys";
                 }
             }
         }
@@ -68,12 +68,15 @@ static void print_info() {
 static CmdLine * p_cmd_args = NULL;
 static ValueArg<string> * p_model_arg = NULL;
 static ValueArg<string> * p_query_arg = NULL;
+static ValueArg<string> * p_image_arg = NULL;
 static vector<string> trie_types_vec;
 static vector<string> debug_levels;
 static ValuesConstraint<string> * p_debug_levels_constr = NULL;
 static ValueArg<string> * p_debug_level_arg = NULL;
 static ValueArg<float> * p_lm_lambda = NULL;
 static ValueArg<float> * p_lm_unk_word_log_e_prob = NULL;
+static ValueArg<uint32_t> * p_num_load_threads = NULL;
+static SwitchArg * p_verify_keys_arg = NULL;
 
 /**
  * Creates and sets up the command line parameters parser
@@ -83,10 +86,13 @@ void create_arguments_parser() {
     p_cmd_args = new CmdLine("", ' ', PROGRAM_VERSION_STR);
 
     //Add the -m the input language model file parameter - compulsory
-    p_model_arg = new ValueArg<string>("m", "model", "A back-off language model file name in ARPA format", true, "", "model file name", *p_cmd_args);
+    p_model_arg = new ValueArg<string>("m", "model", "A back-off language model file name in ARPA format or its binary image", true, "", "model file name", *p_cmd_args);
 
-    //Add the -q the input test queries file parameter - compulsory 
-    p_query_arg = new ValueArg<string>("q", "query", "A text file containing new line separated M-gram queries", true, "", "query file name", *p_cmd_args);
+    //Add the -q the input test queries file parameter - optional if -c is given
+    p_query_arg = new ValueArg<string>("q", "query", "A text file containing new line separated M-gram queries", false, "", "query file name", *p_cmd_args);
+
+    //Add the -c the output binary model image file parameter - optional
+    p_image_arg = new ValueArg<string>("c", "compile", "A file name to store the loaded model binary image into", false, "", "image file name", *p_cmd_args);
 
     //Add the -d the debug level parameter - optional, default is e.g. RESULT
     logger::get_reporting_levels(&debug_levels);
@@ -98,6 +104,12 @@ void create_arguments_parser() {
 
     //Add the -l the optional LM lambda parameter
     p_lm_unk_word_log_e_prob = new ValueArg<float>("u", "unk", "The Language Model probability for the unknown word in a log_e space", false, -10.0, "lm unk word log_e prob", *p_cmd_args);
+
+    //Add the -t the optional number of ARPA model loading threads parameter
+    p_num_load_threads = new ValueArg<uint32_t>("t", "threads", "The number of threads to load the ARPA model with", false, 1, "number of threads", *p_cmd_args);
+
+    //Add the -v the optional m-gram keys verification switch
+    p_verify_keys_arg = new SwitchArg("v", "verify", "Verify the m-gram keys with fingerprints, the binary image is then to be created with this switch", *p_cmd_args, false);
 }
 
 /**
@@ -106,6 +118,7 @@ void create_arguments_parser() {
 void destroy_arguments_parser() {
     SAFE_DESTROY(p_model_arg);
     SAFE_DESTROY(p_query_arg);
+    SAFE_DESTROY(p_image_arg);
 
     SAFE_DESTROY(p_debug_levels_constr);
     SAFE_DESTROY(p_debug_level_arg);
@@ -114,6 +127,10 @@ void destroy_arguments_parser() {
     
     SAFE_DESTROY(p_lm_unk_word_log_e_prob);
 
+    SAFE_DESTROY(p_num_load_threads);
+
+    SAFE_DESTROY(p_verify_keys_arg);
+
     SAFE_DESTROY(p_cmd_args);
 }
 
@@ -136,8 +153,13 @@ static void extract_arguments(const uint argc, char const * const * const argv,
 
     //Store the parsed parameter values
     params.m_query_file_name = p_query_arg->getValue();
+    params.m_image_file_name = p_image_arg->getValue();
     params.m_lm_params.m_conn_string = p_model_arg->getValue();
 
+    //There must be something to do with the model
+    ASSERT_CONDITION_THROW(params.m_query_file_name.empty() && params.m_image_file_name.empty(),
+            "Either the query file or the binary image file name must be given!");
+
     //Get the lambda weight
     params.m_lm_params.m_num_lambdas = 1;
     params.m_lm_params.m_lambdas[0] = p_lm_lambda->getValue();
@@ -145,6 +167,15 @@ static void extract_arguments(const uint argc, char const * const * const argv,
     //Get the unknown word log_e probability
     params.m_lm_params.m_unk_word_log_e_prob = p_lm_unk_word_log_e_prob->getValue();
 
+    //The queries are executed once, so there is no need for caching
+    params.m_lm_params.m_query_cache_size = 0;
+
+    //Get the number of ARPA model loading threads
+    params.m_lm_params.m_num_load_threads = p_num_load_threads->getValue();
+
+    //Get the m-gram keys verification flag
+    params.m_lm_params.m_is_verify_keys = p_verify_keys_arg->getValue();
+
     //Finalize the LM parameters
     params.m_lm_params.finalize();
 }
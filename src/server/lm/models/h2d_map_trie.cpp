@@ -28,6 +28,7 @@
 #include <algorithm>    // std::max
 
 #include "server/lm/lm_consts.hpp"
+#include "server/lm/lm_parameters.hpp"
 #include "common/utils/logging/logger.hpp"
 #include "common/utils/exceptions.hpp"
 
@@ -47,7 +48,7 @@ namespace uva {
                     template<typename WordIndexType>
                     h2d_map_trie<WordIndexType>::h2d_map_trie(WordIndexType & word_index)
                     : generic_trie_base<h2d_map_trie<WordIndexType>, WordIndexType, __H2DMapTrie::BITMAP_HASH_CACHE_BUCKETS_FACTOR>(word_index),
-                    m_n_gram_data(NULL) {
+                    m_n_gram_data(NULL), m_is_verify(false), m_is_fps_mapped(false) {
                         //Perform an error check! This container has bounds on the supported trie level
                         ASSERT_CONDITION_THROW((LM_M_GRAM_LEVEL_MAX > M_GRAM_LEVEL_6), string("The maximum supported trie level is") + std::to_string(M_GRAM_LEVEL_6));
                         ASSERT_CONDITION_THROW((word_index.is_word_index_continuous()), "This trie can not be used with a continuous word index!");
@@ -56,6 +57,10 @@ namespace uva {
 
                         //Clear the M-Gram bucket arrays
                         memset(m_m_gram_data, 0, NUM_M_GRAM_LEVELS * sizeof (TProbBackMap*));
+                        //Clear the m-gram fingerprint arrays
+                        memset(m_fps, 0, LM_M_GRAM_LEVEL_MAX * sizeof (uint32_t *));
+                        //Clear the m-gram hash collision counters
+                        memset(m_num_collisions, 0, LM_M_GRAM_LEVEL_MAX * sizeof (size_t));
 
                         LOG_DEBUG << "sizeof(T_M_Gram_PB_Entry)= " << sizeof (T_M_Gram_PB_Entry) << END_LOG;
                         LOG_DEBUG << "sizeof(T_M_Gram_Prob_Entry)= " << sizeof (T_M_Gram_Prob_Entry) << END_LOG;
@@ -75,6 +80,13 @@ namespace uva {
 
                         //Initialize the n-gram's map
                         m_n_gram_data = new TProbMap(__H2DMapTrie::BUCKETS_FACTOR, counts[LM_M_GRAM_LEVEL_MAX - 1]);
+
+                        //Initialize the fingerprints, parallel to the map elements, the 0'th element is not used
+                        if (m_is_verify) {
+                            for (phrase_length idx = 0; idx < LM_M_GRAM_LEVEL_MAX; idx++) {
+                                m_fps[idx] = new uint32_t[counts[idx] + 1]();
+                            }
+                        }
                     };
 
                     template<typename WordIndexType>
@@ -84,6 +96,69 @@ namespace uva {
                         m_unk_data.m_back = 0.0;
                     }
 
+                    template<typename WordIndexType>
+                    void h2d_map_trie<WordIndexType>::write_image(binary_image_writer & image) const {
+                        //Write the flag indicating whether the m-gram fingerprints are stored
+                        image.write<bool>(m_is_verify);
+
+                        //Write the unknown word payload
+                        image.write(m_unk_data);
+
+                        //Write the bitmap hash caches, if any
+                        BASE::write_bitmap_caches(image);
+
+                        //Write the m-gram maps
+                        for (phrase_length idx = 0; idx < NUM_M_GRAM_LEVELS; idx++) {
+                            m_m_gram_data[idx]->write_image(image);
+                        }
+
+                        //Write the n-gram's map
+                        m_n_gram_data->write_image(image);
+
+                        //Write the fingerprints, if the m-gram keys are verified
+                        if (m_is_verify) {
+                            for (phrase_length idx = 0; idx < NUM_M_GRAM_LEVELS; idx++) {
+                                image.write_array(m_fps[idx], m_m_gram_data[idx]->MAX_ELEMENT_INDEX + 1);
+                            }
+                            image.write_array(m_fps[LM_M_GRAM_LEVEL_MAX - 1], m_n_gram_data->MAX_ELEMENT_INDEX + 1);
+                        }
+                    }
+
+                    template<typename WordIndexType>
+                    void h2d_map_trie<WordIndexType>::read_image(binary_image_reader & image) {
+                        //Check that the fingerprints are stored if the m-gram keys are to be verified
+                        const bool is_image_fps = image.read<bool>();
+                        ASSERT_CONDITION_THROW((m_is_verify && !is_image_fps),
+                                string("The binary image has no m-gram fingerprints as needed for ") +
+                                lm_parameters::LM_IS_VERIFY_KEYS_PARAM_NAME + string(", re-create it with lm-query -v!"));
+
+                        //Read the unknown word payload
+                        m_unk_data = image.read<m_gram_payload>();
+
+                        //Map the bitmap hash caches, if any
+                        BASE::read_bitmap_caches(image);
+
+                        //Map the m-gram maps
+                        for (phrase_length idx = 0; idx < NUM_M_GRAM_LEVELS; idx++) {
+                            m_m_gram_data[idx] = new TProbBackMap(image);
+                        }
+
+                        //Map the n-gram's map
+                        m_n_gram_data = new TProbMap(image);
+
+                        //Map the fingerprints, if stored, they are only used if the m-gram keys are verified
+                        if (is_image_fps) {
+                            for (phrase_length idx = 0; idx < NUM_M_GRAM_LEVELS; idx++) {
+                                m_fps[idx] = const_cast<uint32_t *> (image.read_array<uint32_t>(m_m_gram_data[idx]->MAX_ELEMENT_INDEX + 1));
+                            }
+                            m_fps[LM_M_GRAM_LEVEL_MAX - 1] = const_cast<uint32_t *> (image.read_array<uint32_t>(m_n_gram_data->MAX_ELEMENT_INDEX + 1));
+                            m_is_fps_mapped = true;
+                            if (!m_is_verify) {
+                                memset(m_fps, 0, LM_M_GRAM_LEVEL_MAX * sizeof (uint32_t *));
+                            }
+                        }
+                    }
+
                     template<typename WordIndexType>
                     h2d_map_trie<WordIndexType>::~h2d_map_trie() {
                         //De-allocate M-Grams
@@ -92,6 +167,12 @@ namespace uva {
                         }
                         //De-allocate N-Grams
                         delete m_n_gram_data;
+                        //De-allocate the fingerprints, unless mapped
+                        if (!m_is_fps_mapped) {
+                            for (phrase_length idx = 0; idx < LM_M_GRAM_LEVEL_MAX; idx++) {
+                                delete[] m_fps[idx];
+                            }
+                        }
                     };
 
                     INSTANTIATE_TRIE_TEMPLATE_TYPE(h2d_map_trie, basic_word_index);
@@ -0,0 +1,47 @@
+/*
+ * File:   lm_query_cache.cpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 16, 2026, 11:48 PM
+ */
+
+#include "server/lm/proxy/lm_query_cache.hpp"
+
+namespace uva {
+    namespace smt {
+        namespace bpbd {
+            namespace server {
+                namespace lm {
+                    namespace proxy {
+                        //The caching is disabled until the capacity is set
+                        uint32_t lm_query_cache::m_capacity = 0;
+
+                        //Just give a default initialization
+                        mutex lm_query_cache::m_caches_mutex;
+                        set<const lm_query_cache *> lm_query_cache::m_caches;
+                        uint64_t lm_query_cache::m_num_old_hits = 0;
+                        uint64_t lm_query_cache::m_num_old_misses = 0;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -33,6 +33,9 @@ namespace uva {
                 const string server_parameters::SE_SERVER_PORT_PARAM_NAME = "server_port";
                 const string server_parameters::SE_IS_TLS_SERVER_PARAM_NAME = "is_tls_server";
                 const string server_parameters::SE_NUM_THREADS_PARAM_NAME = "num_threads";
+                const string server_parameters::SE_PRIORITY_AGING_PARAM_NAME = "priority_aging";
+                const string server_parameters::SE_TRANS_CACHE_SIZE_PARAM_NAME = "trans_cache_size";
+                constexpr size_t server_parameters::SE_DEF_TRANS_CACHE_SIZE;
                 const string server_parameters::SE_SOURCE_LANG_PARAM_NAME = "source_lang";
                 const string server_parameters::SE_TARGET_LANG_PARAM_NAME = "target_lang";
             }
@@ -0,0 +1,44 @@
+/* 
+ * File:   tm_source_entry.cpp
+ * Author: Dr. Ivan S. Zapreev
+ *
+ * Visit my Linked-in profile:
+ *      <https://nl.linkedin.com/in/zapreevis>
+ * Visit my GitHub:
+ *      <https://github.com/ivan-zapreev>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.#
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Created on October 17, 2026, 10:12 AM
+ */
+
+#include "server/tm/models/tm_source_entry.hpp"
+
+namespace uva {
+    namespace smt {
+        namespace bpbd {
+            namespace server {
+                namespace tm {
+                    namespace models {
+                        //The targets pool is set by the model
+                        tm_target_entry * tm_source_entry::TARGETS_POOL = NULL;
+                        phrase_uid * tm_source_entry::ST_UIDS_POOL = NULL;
+                        prob_weight * tm_source_entry::TM_COSTS_POOL = NULL;
+                        phrase_length * tm_source_entry::NUM_WORDS_POOL = NULL;
+                    }
+                }
+            }
+        }
+    }
+}
@@ -33,6 +33,14 @@ namespace uva {
                     namespace models {
                         //Default initialize with zero and negative values
                         int8_t tm_target_entry::NUMBER_OF_TM_FEATURES = 0;
+                        //The phrases pool is set by the model
+                        const char * tm_target_entry::PHRASES_POOL = NULL;
+                        //The word ids pool is set by the model
+                        const word_uid * tm_target_entry::WORD_IDS_POOL = NULL;
+                        //The features pool is set by the model
+                        const prob_weight * tm_target_entry::FEATURES_POOL = NULL;
+                        //The reordering entries pool is set by the reordering model
+                        const rm_entry * tm_target_entry::RM_ENTRIES_POOL = NULL;
 
                         //Initialize the unknown target entry UID constant 
                         const phrase_uid tm_target_entry::UNKNOWN_TARGET_ENTRY_UID = combine_phrase_uids(UNKNOWN_PHRASE_ID, UNKNOWN_PHRASE_ID);
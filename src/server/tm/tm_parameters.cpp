@@ -36,6 +36,7 @@ namespace uva {
                     const string tm_parameters_struct::TM_UNK_FEATURE_PARAM_NAME = "tm_unk_features";
                     const string tm_parameters_struct::TM_TRANS_LIM_PARAM_NAME = "tm_trans_lim";
                     const string tm_parameters_struct::TM_MIN_TRANS_PROB_PARAM_NAME = "tm_min_trans_prob";
+                    const string tm_parameters_struct::TM_FILTER_FILE_PARAM_NAME = "tm_filter_file";
                     const string tm_parameters_struct::TM_WEIGHT_NAMES[MAX_NUM_TM_FEATURES] = {
                         TM_WEIGHTS_PARAM_NAME + string("[0]"),
                         TM_WEIGHTS_PARAM_NAME + string("[1]"),